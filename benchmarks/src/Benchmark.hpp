@@ -0,0 +1,51 @@
+// Timing helpers shared by the benchmarks
+
+#ifndef JOP_BENCHMARK_HPP
+#define JOP_BENCHMARK_HPP
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace bench
+{
+    // Results are accumulated here so that the optimizer can't remove the measured work
+    static volatile double ns_sink = 0.0;
+
+    template<typename T>
+    inline void consume(const T& value)
+    {
+        ns_sink = ns_sink + static_cast<double>(value);
+    }
+
+    // Print a single result
+    inline void report(const std::string& name, const double value, const std::string& unit)
+    {
+        std::cout << std::left << std::setw(56) << name
+                  << std::right << std::setw(14) << std::fixed << std::setprecision(1) << value << " " << unit << std::endl;
+    }
+
+    // Run a function repeatedly and print the mean time of a single run in nanoseconds
+    template<typename F>
+    inline double measure(const std::string& name, const unsigned int iterations, F func)
+    {
+        typedef std::chrono::high_resolution_clock Clock;
+
+        // Warm up the caches and any lazily allocated memory
+        func();
+
+        const auto start = Clock::now();
+
+        for (unsigned int i = 0; i < iterations; ++i)
+            func();
+
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+
+        report(name, ns, "ns");
+
+        return ns;
+    }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,113 @@
+// Broadcast benchmark
+//
+// Sends a broadcast through Engine::sendMessage() while the current scene grows
+// from 1000 to 100000 objects, each with one component. One command has a
+// single subscribed component and goes through the subscriber table, the other
+// has none and walks the whole tree. Needs a display, since a scene can't be
+// created without a window.
+
+#include "Benchmark.hpp"
+#include <Jopnal/Jopnal.hpp>
+
+namespace
+{
+    jop::uint32 ns_ping = 0;
+    jop::uint32 ns_walk = 0;
+
+    // Counts the benchmark commands it receives, subscribed only to the first
+    class Receiver : public jop::Component
+    {
+    public:
+
+        Receiver(jop::Object& object)
+            : jop::Component(object, 0),
+              received      (0)
+        {
+            subscribe("benchPing");
+        }
+
+        ~Receiver() override
+        {}
+
+        jop::Message::Result receiveMessage(const jop::Message& message) override
+        {
+            const jop::uint32 id = message.getCommandID();
+
+            if (id == ns_ping || id == ns_walk)
+                ++received;
+
+            return jop::Message::Result::Continue;
+        }
+
+        unsigned int received;
+    };
+
+    // Stands for the components that don't care about either command
+    class Filler : public jop::Component
+    {
+    public:
+
+        Filler(jop::Object& object)
+            : jop::Component(object, 0)
+        {}
+
+        ~Filler() override
+        {}
+    };
+
+    class BroadcastScene : public jop::Scene
+    {
+    public:
+
+        BroadcastScene()
+            : jop::Scene("BroadcastScene"),
+              objects   (1)
+        {
+            receiver = &createChild("receiver")->createComponent<Receiver>();
+        }
+
+        void grow(const unsigned int count)
+        {
+            for (; objects < count; ++objects)
+                createChild("filler")->createComponent<Filler>();
+        }
+
+        Receiver* receiver;
+        unsigned int objects;
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace jop;
+
+    JOP_ENGINE_INIT("broadcast_benchmark", argc, argv);
+
+    ns_ping = Message::internCommand("benchPing");
+    ns_walk = Message::internCommand("benchWalk");
+
+    Engine::createScene<BroadcastScene>();
+    auto& scene = static_cast<BroadcastScene&>(Engine::getCurrentScene());
+
+    for (unsigned int count = 1000; count <= 100000; count *= 10)
+    {
+        scene.grow(count);
+
+        const unsigned int iterations = 1000000 / count;
+        const std::string size = std::to_string(count) + " objects";
+
+        bench::measure("broadcast, subscriber table, " + size, iterations, []()
+        {
+            Engine::sendMessage(Message("benchPing"));
+        });
+
+        bench::measure("broadcast, tree walk, " + size, iterations, []()
+        {
+            Engine::sendMessage(Message("benchWalk"));
+        });
+    }
+
+    bench::consume(scene.receiver->received);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+// Frustum culling benchmark
+//
+// Culls 10000 drawables scattered around a camera, once through the culling
+// tree (Renderer::queryDrawables()) and once the way "engine@Graphics|bCulling"
+// used to: phantom bodies in a Bullet world, stepped at 1/60, with the visible
+// set maintained from overlap callbacks and searched per drawable. The scene
+// is static. Needs a display, since a scene can't be created without a window.
+
+#include "Benchmark.hpp"
+#include <Jopnal/Jopnal.hpp>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace
+{
+    const unsigned int ns_drawables = 10000;
+
+    // Visible set of the previous implementation
+    class CameraListener : public jop::ContactListener
+    {
+    public:
+
+        void beginOverlap(jop::Collider& collider) override
+        {
+            visible.insert(&collider);
+        }
+
+        void endOverlap(jop::Collider& collider) override
+        {
+            visible.erase(&collider);
+        }
+
+        std::set<const jop::Collider*> visible;
+    };
+
+    class CullingScene : public jop::Scene
+    {
+    public:
+
+        CullingScene()
+            : jop::Scene("CullingScene")
+        {
+            auto cam = createChild("cam");
+            camera = &cam->createComponent<jop::Camera>(getRenderer(), jop::Camera::Projection::Perspective);
+
+            world = &createComponent<jop::World>(getRenderer());
+
+            // Shapes are resources, so that they outlive the bodies
+            auto& box = jop::ResourceManager::getEmpty<jop::BoxShape>("culling_benchmark_box");
+            box.load(2.f);
+
+            auto& frustum = jop::ResourceManager::getEmpty<jop::FrustumShape>("culling_benchmark_frustum");
+            frustum.load(camera->getClippingPlanes(), camera->getFieldOfView(), camera->getAspectRatio(), glm::quat());
+
+            auto& camBody = cam->createComponent<jop::PhantomBody>(*world, frustum);
+            camBody.registerListener(listener);
+
+            std::mt19937 random(1);
+            std::uniform_real_distribution<float> coord(-100.f, 100.f);
+
+            for (unsigned int i = 0; i < ns_drawables; ++i)
+            {
+                auto obj = createChild("drawable");
+                obj->setPosition(coord(random), coord(random), coord(random));
+
+                obj->createComponent<jop::Drawable>(getRenderer());
+                bodies.push_back(&obj->createComponent<jop::PhantomBody>(*world, box));
+            }
+        }
+
+        jop::Camera* camera;
+        jop::World* world;
+        CameraListener listener;
+        std::vector<const jop::Collider*> bodies;
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace jop;
+
+    JOP_ENGINE_INIT("culling_benchmark", argc, argv);
+
+    // Read once when the first drawable is created
+    SettingManager::set<bool>("engine@Graphics|bCulling", true);
+
+    CullingScene scene;
+    std::vector<const Drawable*> visible;
+
+    const glm::mat4 pvMatrix = scene.camera->getProjectionMatrix() * scene.camera->getViewMatrix();
+
+    bench::measure("culling tree query, 10000 drawables", 1000, [&]()
+    {
+        scene.getRenderer().queryDrawables(pvMatrix, scene.camera->getRenderMask(), visible);
+        bench::consume(visible.size());
+    });
+
+    bench::measure("Bullet world step + set search, 10000 drawables", 1000, [&]()
+    {
+        scene.world->update(1.f / 60.f);
+
+        unsigned int count = 0;
+
+        for (auto body : scene.bodies)
+            count += scene.listener.visible.find(body) != scene.listener.visible.end();
+
+        bench::consume(count);
+    });
+
+    std::cout << "    visible: " << visible.size() << " (tree), " << scene.listener.visible.size() << " (Bullet)" << std::endl;
+
+    return 0;
+}
\ No newline at end of file
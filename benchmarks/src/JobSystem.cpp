@@ -0,0 +1,68 @@
+// Job system benchmark
+//
+// Measures the overhead of dispatching a single job and how a CPU bound
+// parallelFor scales with the number of worker threads.
+
+#include "Benchmark.hpp"
+#include <Jopnal/Utility/JobSystem.hpp>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+int main()
+{
+    using namespace jop;
+
+    const uint32 hardware = std::max(1u, std::thread::hardware_concurrency());
+
+    // Dispatch overhead, per empty job
+    {
+        JobSystem jobs(hardware - 1);
+        const unsigned int amount = 10000;
+
+        const double ns = bench::measure("run + wait, 10000 empty jobs", 20, [&jobs, amount]()
+        {
+            JobSystem::Counter counter;
+
+            for (unsigned int i = 0; i < amount; ++i)
+                jobs.run([](){}, counter);
+
+            jobs.wait(counter);
+        });
+
+        std::cout << "    " << ns / amount << " ns per job" << std::endl;
+    }
+
+    // Scaling of a CPU bound range
+    const uint32 count = 1 << 20;
+    std::vector<float> data(count);
+
+    for (uint32 i = 0; i < count; ++i)
+        data[i] = static_cast<float>(i % 1000);
+
+    double serial = 0.0;
+
+    for (uint32 workers = 0; workers < hardware; workers = std::max(workers * 2, workers + 1))
+    {
+        JobSystem jobs(workers);
+
+        const double ns = bench::measure("parallelFor, 2^20 elements, " + std::to_string(workers) + " worker(s)", 20, [&jobs, &data, count]()
+        {
+            jobs.parallelFor(count, 4096, [&data](const uint32 begin, const uint32 end)
+            {
+                for (uint32 i = begin; i < end; ++i)
+                    data[i] = std::sqrt(data[i] * data[i] + 1.f);
+            });
+        });
+
+        if (workers == 0)
+            serial = ns;
+        else
+            std::cout << "    speedup " << serial / ns << "x" << std::endl;
+    }
+
+    bench::consume(data[count / 2]);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+// Message dispatch benchmark
+//
+// Measures building a message and dispatching it through a command handler,
+// for a single receiver, for many receivers sharing one message and for a
+// command nobody has bound.
+
+#include "Benchmark.hpp"
+#include <Jopnal/Utility/CommandHandler.hpp>
+#include <Jopnal/Utility/Message.hpp>
+#include <vector>
+
+namespace
+{
+    struct Receiver
+    {
+        int value;
+
+        void add(const int amount)
+        {
+            value += amount;
+        }
+    };
+}
+
+int main()
+{
+    using namespace jop;
+
+    CommandHandler handler;
+    handler.bindMember("benchAdd", &Receiver::add, Message::Result::Continue);
+
+    std::vector<Receiver> receivers(100, Receiver{0});
+
+    bench::measure("new message, 1 receiver", 100000, [&handler, &receivers]()
+    {
+        const Message message("benchAdd 1");
+        handler.execute(message, &receivers[0]);
+    });
+
+    const double ns = bench::measure("new message, 100 receivers", 10000, [&handler, &receivers]()
+    {
+        const Message message("benchAdd 1");
+
+        for (auto& r : receivers)
+            handler.execute(message, &r);
+    });
+
+    std::cout << "    " << ns / receivers.size() << " ns per receiver" << std::endl;
+
+    bench::measure("new message, unknown command", 100000, [&handler, &receivers]()
+    {
+        const Message message("benchUnknown 1");
+        handler.execute(message, &receivers[0]);
+    });
+
+    bench::consume(receivers[0].value);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+// Object lookup benchmark
+//
+// Measures finding objects by identifier and tag in a tree of 100000 objects.
+// Strict searches go through the object index, while non-strict searches
+// still walk the tree, which makes them a baseline for the indexed lookups.
+
+#include "Benchmark.hpp"
+#include <Jopnal/Core/Object.hpp>
+#include <string>
+
+int main()
+{
+    using namespace jop;
+
+    const unsigned int children = 100;
+    const unsigned int leaves = 1000;
+
+    // 100 children with 1000 children each, every tenth object tagged. The
+    // first leaf of every child shares an identifier, so that the results
+    // need to be put in tree order
+    Object root("root");
+
+    for (unsigned int i = 0; i < children; ++i)
+    {
+        auto child = root.createChild("child" + std::to_string(i));
+
+        for (unsigned int j = 0; j < leaves; ++j)
+        {
+            auto leaf = child->createChild(j == 0 ? std::string("first") : "leaf" + std::to_string(i * leaves + j));
+
+            if (j % 10 == 0)
+                leaf->addTag("marked");
+        }
+    }
+
+    const std::string last = "leaf" + std::to_string(children * leaves - 1);
+
+    bench::measure("findChild, direct child", 100000, [&root]()
+    {
+        bench::consume(!root.findChild("child50").expired());
+    });
+
+    bench::measure("findChild recursive, strict", 100000, [&root, &last]()
+    {
+        bench::consume(!root.findChild(last, true).expired());
+    });
+
+    bench::measure("findChild recursive, non-strict (tree walk)", 10, [&root, &last]()
+    {
+        bench::consume(!root.findChild(last, true, false).expired());
+    });
+
+    bench::measure("findChildren recursive, strict, 100 matches", 10000, [&root]()
+    {
+        bench::consume(root.findChildren("first", true, true).size());
+    });
+
+    bench::measure("findChildren recursive, non-strict (tree walk)", 10, [&root]()
+    {
+        bench::consume(root.findChildren("first", true, false).size());
+    });
+
+    bench::measure("findChildrenWithTag recursive, 10000 matches", 100, [&root]()
+    {
+        bench::consume(root.findChildrenWithTag("marked", true).size());
+    });
+
+    return 0;
+}
\ No newline at end of file
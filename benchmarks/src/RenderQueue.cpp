@@ -0,0 +1,95 @@
+// Render queue sort benchmark
+//
+// Sorts a queue of 1000, 10000 and 100000 opaque drawables, once with the
+// radix sort used by SortedRenderPass and once the way the pass used to: by
+// comparing the distances of the drawables' positions to the camera. Both
+// cases start from the same shuffled order every run.
+
+#include "Benchmark.hpp"
+#include <Jopnal/Graphics/RenderPass.hpp>
+#include <glm/gtx/norm.hpp>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Stands in for a drawable, the position was read through its object
+    struct Item
+    {
+        glm::vec3 position;
+    };
+}
+
+int main()
+{
+    using namespace jop;
+    typedef SortedRenderPass::QueueItem QueueItem;
+
+    const glm::vec3 camera(0.f);
+
+    for (const unsigned int count : {1000u, 10000u, 100000u})
+    {
+        std::mt19937_64 random(count);
+        std::uniform_real_distribution<float> coord(-100.f, 100.f);
+
+        std::vector<std::unique_ptr<Item>> items;
+        items.reserve(count);
+
+        for (unsigned int i = 0; i < count; ++i)
+            items.emplace_back(new Item{glm::vec3(coord(random), coord(random), coord(random))});
+
+        std::shuffle(items.begin(), items.end(), random);
+
+        // Previous implementation, one pointer per drawable
+        std::vector<const Item*> source;
+        std::vector<const Item*> sorted;
+
+        for (auto& i : items)
+            source.push_back(i.get());
+
+        const std::string suffix = ", " + std::to_string(count) + " drawables";
+        const unsigned int iterations = 10000000 / count;
+
+        bench::measure("std::sort by camera distance" + suffix, iterations, [&]()
+        {
+            sorted = source;
+
+            std::sort(sorted.begin(), sorted.end(), [&camera](const Item* left, const Item* right)
+            {
+                return glm::distance2(left->position, camera) < glm::distance2(right->position, camera);
+            });
+
+            bench::consume(sorted.front()->position.x);
+        });
+
+        // Keys are built the same way as in the pass: a few shader, material and
+        // mesh combinations above a 22 bit quantized depth
+        std::vector<QueueItem> queue;
+        std::vector<QueueItem> buffer;
+        std::vector<QueueItem> keys;
+
+        const float maxDistance = glm::length2(glm::vec3(100.f));
+
+        for (auto i : source)
+        {
+            const uint64 state = random() & 0xF00F00F;
+            const uint64 depth = static_cast<uint64>(glm::distance2(i->position, camera) / maxDistance * ((1 << 22) - 1));
+
+            keys.push_back(QueueItem{(state << 22) | depth, nullptr, nullptr});
+        }
+
+        bench::measure("SortedRenderPass::sortQueue" + suffix, iterations, [&]()
+        {
+            queue = keys;
+
+            SortedRenderPass::sortQueue(queue, buffer);
+
+            bench::consume(queue.front().key);
+        });
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,186 @@
+// Weak reference benchmark
+//
+// Measures binding and unbinding referenceable objects, taking references to
+// them, dereferencing the references and checking references that have expired.
+// The previous implementation, a shared_ptr in every object with weak_ptr
+// references, is measured alongside. The memory used per object is reported
+// for both.
+
+#include "Benchmark.hpp"
+#include <Jopnal/Utility/SafeReferenceable.hpp>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    std::size_t ns_allocated = 0;
+
+    struct Node : jop::SafeReferenceable<Node>
+    {
+        Node()
+            : jop::SafeReferenceable<Node>(this),
+              value(1)
+        {}
+
+        int value;
+    };
+
+    // Counts the bytes allocated for the shared_ptr control blocks
+    template<typename T>
+    struct CountingAllocator
+    {
+        typedef T value_type;
+
+        CountingAllocator()
+        {}
+
+        template<typename U>
+        CountingAllocator(const CountingAllocator<U>&)
+        {}
+
+        T* allocate(const std::size_t n)
+        {
+            ns_allocated += n * sizeof(T);
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T* ptr, const std::size_t)
+        {
+            ::operator delete(ptr);
+        }
+    };
+
+    template<typename T, typename U>
+    bool operator ==(const CountingAllocator<T>&, const CountingAllocator<U>&)
+    {
+        return true;
+    }
+
+    template<typename T, typename U>
+    bool operator !=(const CountingAllocator<T>&, const CountingAllocator<U>&)
+    {
+        return false;
+    }
+
+    // The previous SafeReferenceable layout
+    struct OldNode
+    {
+        OldNode()
+            : ref   (std::allocate_shared<OldNode*>(CountingAllocator<OldNode*>(), this)),
+              value (1)
+        {}
+
+        std::shared_ptr<OldNode*> ref;
+        int value;
+    };
+}
+
+int main()
+{
+    using namespace jop;
+    using detail::ReferenceTable;
+
+    const unsigned int count = 10000;
+
+    bench::measure("create + destroy, 10000 objects", 100, [count]()
+    {
+        std::unique_ptr<Node[]> nodes(new Node[count]);
+        bench::consume(nodes[count - 1].value);
+    });
+
+    bench::measure("create + destroy, 10000 objects (shared_ptr)", 100, [count]()
+    {
+        std::unique_ptr<OldNode[]> nodes(new OldNode[count]);
+        bench::consume(nodes[count - 1].value);
+    });
+
+    std::unique_ptr<Node[]> nodes(new Node[count]);
+    std::vector<WeakReference<Node>> refs(count);
+
+    std::unique_ptr<OldNode[]> oldNodes(new OldNode[count]);
+    std::vector<std::weak_ptr<OldNode*>> oldRefs(count);
+
+    bench::measure("getReference, 10000 objects", 1000, [&nodes, &refs, count]()
+    {
+        for (unsigned int i = 0; i < count; ++i)
+            refs[i] = nodes[i].getReference();
+    });
+
+    bench::measure("getReference, 10000 objects (shared_ptr)", 1000, [&oldNodes, &oldRefs, count]()
+    {
+        for (unsigned int i = 0; i < count; ++i)
+            oldRefs[i] = oldNodes[i].ref;
+    });
+
+    bench::measure("expired + dereference, 10000 references", 1000, [&refs]()
+    {
+        int sum = 0;
+
+        for (auto& r : refs)
+        {
+            if (!r.expired())
+                sum += r->value;
+        }
+
+        bench::consume(sum);
+    });
+
+    bench::measure("expired + dereference, 10000 references (shared_ptr)", 1000, [&oldRefs]()
+    {
+        int sum = 0;
+
+        for (auto& r : oldRefs)
+        {
+            if (!r.expired())
+                sum += (*r.lock())->value;
+        }
+
+        bench::consume(sum);
+    });
+
+    // Memory per object. The table grows a page at a time, so the slots of the
+    // last page are counted even if unused, along with the fixed page pointers
+    const std::size_t pageSlots = std::size_t(1) << ReferenceTable::PageBits;
+    const std::size_t pages = (count + pageSlots - 1) / pageSlots;
+    const double tableBytes = static_cast<double>(pages * pageSlots * sizeof(ReferenceTable::Slot) + ReferenceTable::MaxPages * sizeof(void*));
+
+    ns_allocated = 0;
+    {
+        OldNode node;
+        bench::consume(node.value);
+    }
+    const std::size_t controlBlock = ns_allocated;
+
+    bench::report("reference handle size", sizeof(WeakReference<Node>), "bytes");
+    bench::report("reference handle size (shared_ptr)", sizeof(std::weak_ptr<OldNode*>), "bytes");
+    bench::report("per object, in the object", sizeof(SafeReferenceable<Node>), "bytes");
+    bench::report("per object, in the object (shared_ptr)", sizeof(std::shared_ptr<OldNode*>), "bytes");
+    bench::report("per object, table slot", sizeof(ReferenceTable::Slot), "bytes");
+    bench::report("per object, table + page overhead, 10000 objects", tableBytes / count, "bytes");
+    bench::report("per object, control block (shared_ptr, no heap header)", static_cast<double>(controlBlock), "bytes");
+
+    nodes.reset();
+    oldNodes.reset();
+
+    bench::measure("expired, 10000 expired references", 1000, [&refs]()
+    {
+        unsigned int expired = 0;
+
+        for (auto& r : refs)
+            expired += r.expired();
+
+        bench::consume(expired);
+    });
+
+    bench::measure("expired, 10000 expired references (shared_ptr)", 1000, [&oldRefs]()
+    {
+        unsigned int expired = 0;
+
+        for (auto& r : oldRefs)
+            expired += r.expired();
+
+        bench::consume(expired);
+    });
+
+    return 0;
+}
\ No newline at end of file
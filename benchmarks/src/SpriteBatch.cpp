@@ -0,0 +1,121 @@
+// Sprite batch benchmark
+//
+// Draws a grid of sprites sharing a texture, first batched and then with one
+// flush per sprite, and prints the draw calls, the mean time of a frame and the
+// sprites drawn per millisecond. The unbatched case still writes each sprite
+// through the sprite batch's streaming buffer and only splits the draw calls.
+// It doesn't reproduce the old per sprite RectangleMesh, so it understates the
+// cost of drawing without batching. Needs a display. Disable "engine@DefaultWindow|bVerticalSync" in the settings,
+// otherwise the frame times are capped by the refresh rate.
+
+#include "Benchmark.hpp"
+#include <Jopnal/Jopnal.hpp>
+#include <chrono>
+#include <string>
+
+namespace
+{
+    const unsigned int ns_sprites = 10000;
+    const unsigned int ns_warmupFrames = 10;
+    const unsigned int ns_frames = 200;
+
+    // Overriding draw() opts out of batching. Sprite::draw() then flushes a batch
+    // of this one sprite, so each sprite gets its own draw call
+    class UnbatchedSprite : public jop::Sprite
+    {
+    public:
+
+        UnbatchedSprite(jop::Object& object, jop::Renderer& renderer, const bool cull)
+            : jop::Sprite(object, renderer, cull)
+        {}
+
+        void draw(const ProjectionInfo& proj, const jop::LightContainer& lights) const override
+        {
+            jop::Sprite::draw(proj, lights);
+        }
+    };
+
+    class SpriteScene : public jop::Scene
+    {
+    private:
+
+        typedef std::chrono::high_resolution_clock Clock;
+
+        jop::WeakReference<jop::Object> m_batched;
+        jop::WeakReference<jop::Object> m_unbatched;
+        Clock::time_point m_start;
+        unsigned int m_frame;
+
+        template<typename T>
+        jop::WeakReference<jop::Object> createGrid(const std::string& name)
+        {
+            auto root = createChild(name);
+            root->reserveChildren(ns_sprites);
+
+            for (unsigned int i = 0; i < ns_sprites; ++i)
+            {
+                auto obj = root->createChild("sprite");
+                obj->setPosition(static_cast<float>(i % 100) - 50.f, static_cast<float>(i / 100) - 50.f, -1.f);
+                obj->setScale(1.f / jop::Texture2D::getDefault().getSize().x);
+
+                obj->createComponent<T>(getRenderer(), false);
+            }
+
+            return root;
+        }
+
+    public:
+
+        SpriteScene()
+            : jop::Scene    ("SpriteScene"),
+              m_batched     (),
+              m_unbatched   (),
+              m_start       (),
+              m_frame       (0)
+        {
+            createChild("cam")->createComponent<jop::Camera>(getRenderer(), jop::Camera::Projection::Orthographic).setSize(100.f, 100.f);
+
+            m_batched = createGrid<jop::Sprite>("batched");
+            m_unbatched = createGrid<UnbatchedSprite>("unbatched");
+            m_unbatched->setActive(false);
+        }
+
+        void postUpdate(const float) override
+        {
+            // Statistics are available for the previous frame only
+            const auto frame = m_frame++ % (ns_warmupFrames + ns_frames);
+
+            if (frame == ns_warmupFrames)
+                m_start = Clock::now();
+
+            else if (frame == 0 && m_frame > 1)
+            {
+                const bool batched = m_batched->isActive();
+                const std::string name = batched ? "batched" : "one flush per sprite";
+                const double ms = std::chrono::duration<double, std::milli>(Clock::now() - m_start).count() / ns_frames;
+
+                bench::report(name + ", 10000 sprites, draw calls", jop::GlState::getStatistics().drawCalls, "calls");
+                bench::report(name + ", 10000 sprites, frame time", ms, "ms");
+                bench::report(name + ", 10000 sprites, throughput", ns_sprites / ms, "sprites/ms");
+
+                if (!batched)
+                {
+                    jop::Engine::exit();
+                    return;
+                }
+
+                m_batched->setActive(false);
+                m_unbatched->setActive(true);
+            }
+        }
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    JOP_ENGINE_INIT("sprite_batch_benchmark", argc, argv);
+
+    jop::Engine::createScene<SpriteScene>();
+
+    return JOP_MAIN_LOOP;
+}
\ No newline at end of file
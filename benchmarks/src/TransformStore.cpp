@@ -0,0 +1,180 @@
+// Transform hierarchy benchmark
+//
+// 100000 nodes in 10000 chains, so that the depths range from 1 to 10. Every
+// frame all the roots move and the global matrices of all the nodes are read,
+// like the renderer does. Timed once with the transform store and once with
+// the previous per-object path: a tree of separately allocated children whose
+// matrices are recomputed lazily by recursing into the parent.
+
+#include "Benchmark.hpp"
+#include <Jopnal/Core/Hierarchy/TransformStore.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+    const unsigned int ns_roots = 10000;
+    const unsigned int ns_depth = 10;
+
+    // Previous implementation, see the old Object::getTransform(). The members
+    // mirror the old Object, so that the nodes are as far apart in memory
+    struct OldNode
+    {
+        OldNode()
+            : transform         (),
+              inverseTransform  (),
+              locals            (glm::vec3(0.f, 1.f, 0.f), glm::vec3(1.f), glm::quat()),
+              globals           (locals),
+              children          (),
+              components        (),
+              tags              (),
+              ID                ("node"),
+              parent            (nullptr),
+              dirty             (true)
+        {}
+
+        void setPosition(const glm::vec3& position)
+        {
+            locals.position = position;
+            propagateDirty();
+        }
+
+        void propagateDirty()
+        {
+            dirty = true;
+
+            for (auto& i : children)
+                i.propagateDirty();
+        }
+
+        const glm::mat4& getMatrix()
+        {
+            if (dirty)
+            {
+                transform.getMatrix() = glm::mat4(1.f);
+                transform.translate(locals.position);
+                transform.rotate(locals.rotation);
+                transform.scale(locals.scale);
+
+                if (parent)
+                {
+                    jop::Transform globalTrans(parent->getMatrix());
+                    transform = globalTrans * transform;
+                }
+
+                dirty = false;
+            }
+
+            return transform.getMatrix();
+        }
+
+        jop::Transform transform;
+        jop::Transform inverseTransform;
+        jop::Transform::Variables locals;
+        jop::Transform::Variables globals;
+        std::vector<OldNode> children;
+        std::vector<std::unique_ptr<int>> components;
+        std::unordered_set<std::string> tags;
+        std::string ID;
+        OldNode* parent;
+        bool dirty;
+    };
+}
+
+int main()
+{
+    using namespace jop;
+
+    float offset = 0.f;
+
+    // Transform store
+    {
+        auto& store = detail::TransformStore::getInstance();
+
+        std::vector<uint32> roots;
+        std::vector<uint32> nodes;
+
+        const Transform::Variables locals(glm::vec3(0.f, 1.f, 0.f), glm::vec3(1.f), glm::quat());
+
+        for (unsigned int i = 0; i < ns_roots; ++i)
+        {
+            uint32 parent = detail::TransformStore::NullHandle;
+
+            for (unsigned int d = 0; d < ns_depth; ++d)
+            {
+                const uint32 handle = store.create();
+                store.setLocals(handle, locals);
+                store.setParent(handle, parent);
+
+                if (parent == detail::TransformStore::NullHandle)
+                    roots.push_back(handle);
+
+                nodes.push_back(handle);
+                parent = handle;
+            }
+        }
+
+        store.update();
+
+        bench::measure("transform store, move roots + update + read", 20, [&]()
+        {
+            offset += 1.f;
+
+            for (auto r : roots)
+                store.setLocals(r, Transform::Variables(glm::vec3(offset, 0.f, 0.f), glm::vec3(1.f), glm::quat()));
+
+            store.update();
+
+            float sum = 0.f;
+
+            for (auto n : nodes)
+                sum += store.getWorld(n)[3].x;
+
+            bench::consume(sum);
+        });
+
+        for (auto n : nodes)
+            store.destroy(n);
+    }
+
+    // Previous per-object path
+    {
+        std::vector<OldNode> roots(ns_roots);
+        std::vector<OldNode*> nodes;
+
+        for (auto& r : roots)
+        {
+            OldNode* node = &r;
+            nodes.push_back(node);
+
+            for (unsigned int d = 1; d < ns_depth; ++d)
+            {
+                node->children.emplace_back();
+                node->children.back().parent = node;
+
+                node = &node->children.back();
+                nodes.push_back(node);
+            }
+        }
+
+        bench::measure("per-object, move roots + read", 20, [&]()
+        {
+            offset += 1.f;
+
+            for (auto& r : roots)
+                r.setPosition(glm::vec3(offset, 0.f, 0.f));
+
+            float sum = 0.f;
+
+            for (auto n : nodes)
+                sum += n->getMatrix()[3].x;
+
+            bench::consume(sum);
+        });
+    }
+
+    return 0;
+}
\ No newline at end of file
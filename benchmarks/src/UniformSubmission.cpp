@@ -0,0 +1,104 @@
+// Uniform submission benchmark
+//
+// Sets the uniforms of a drawable lit by four point lights, once by name the
+// way the engine used to and once through handles resolved up front, and
+// prints the mean cost per drawable. Needs a display for the OpenGL context.
+
+#include "Benchmark.hpp"
+#include <Jopnal/Jopnal.hpp>
+#include <string>
+
+namespace
+{
+    const unsigned int ns_drawables = 1000;
+    const unsigned int ns_lights = 4;
+
+    const char* const ns_vertex =
+        "#include <Jopnal/Compat/Attributes>\n"
+        "uniform mat4 u_PVMMatrix;\n"
+        "uniform mat4 u_VMMatrix;\n"
+        "uniform mat3 u_NMatrix;\n"
+        "struct PointLight { vec3 position; vec3 diffuse; vec3 specular; vec3 attenuation; };\n"
+        "uniform PointLight u_PointLights[4];\n"
+        "JOP_ATTRIBUTE(0) vec3 a_Position;\n"
+        "void main()\n"
+        "{\n"
+        "    vec3 offset = vec3(0.0);\n"
+        "    for (int i = 0; i < 4; ++i)\n"
+        "        offset += u_PointLights[i].position * u_PointLights[i].diffuse + u_PointLights[i].specular * u_PointLights[i].attenuation;\n"
+        "    gl_Position = u_PVMMatrix * u_VMMatrix * vec4(u_NMatrix * a_Position + offset, 1.0);\n"
+        "}\n";
+
+    const char* const ns_fragment =
+        "void main()\n"
+        "{\n"
+        "}\n";
+
+    const char* const ns_fields[] = {"position", "diffuse", "specular", "attenuation"};
+
+    // Same layout as the per-light tables of the engine
+    const jop::ShaderProgram::UniformTable ns_lightUniforms =
+    {
+        "u_PointLights[0].position", "u_PointLights[0].diffuse", "u_PointLights[0].specular", "u_PointLights[0].attenuation",
+        "u_PointLights[1].position", "u_PointLights[1].diffuse", "u_PointLights[1].specular", "u_PointLights[1].attenuation",
+        "u_PointLights[2].position", "u_PointLights[2].diffuse", "u_PointLights[2].specular", "u_PointLights[2].attenuation",
+        "u_PointLights[3].position", "u_PointLights[3].diffuse", "u_PointLights[3].specular", "u_PointLights[3].attenuation"
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace jop;
+
+    JOP_ENGINE_INIT("uniform_submission_benchmark", argc, argv);
+
+    auto& shader = ResourceManager::getEmpty<ShaderProgram>("uniform_submission_benchmark_shader");
+
+    if (!shader.load("", Shader::Type::Vertex, std::string(ns_vertex), Shader::Type::Fragment, std::string(ns_fragment)) || !shader.bind())
+    {
+        std::cerr << "Failed to compile the benchmark shader" << std::endl;
+        return 1;
+    }
+
+    const glm::mat4 matrix(1.f);
+    const glm::mat3 normalMatrix(1.f);
+    const glm::vec3 vector(1.f);
+
+    const double byName = bench::measure("by name, 1000 drawables", 100, [&]()
+    {
+        for (unsigned int d = 0; d < ns_drawables; ++d)
+        {
+            shader.setUniform("u_PVMMatrix", matrix);
+            shader.setUniform("u_VMMatrix", matrix);
+            shader.setUniform("u_NMatrix", normalMatrix);
+
+            for (unsigned int i = 0; i < ns_lights; ++i)
+            {
+                const std::string indexed = "u_PointLights[" + std::to_string(i) + "].";
+
+                for (auto field : ns_fields)
+                    shader.setUniform(indexed + field, vector);
+            }
+        }
+    });
+
+    const double byHandle = bench::measure("by handle, 1000 drawables", 100, [&]()
+    {
+        for (unsigned int d = 0; d < ns_drawables; ++d)
+        {
+            shader.setUniform(shader.getUniformHandle(ShaderProgram::Uniform::PVMMatrix), matrix);
+            shader.setUniform(shader.getUniformHandle(ShaderProgram::Uniform::VMMatrix), matrix);
+            shader.setUniform(shader.getUniformHandle(ShaderProgram::Uniform::NMatrix), normalMatrix);
+
+            const int* handles = shader.getUniformHandles(ns_lightUniforms);
+
+            for (unsigned int i = 0; i < ns_lights * 4; ++i)
+                shader.setUniform(handles[i], vector);
+        }
+    });
+
+    bench::report("by name, per drawable", byName / ns_drawables, "ns");
+    bench::report("by handle, per drawable", byHandle / ns_drawables, "ns");
+
+    return 0;
+}
\ No newline at end of file
@@ -191,6 +191,81 @@ macro(jopAddExample target)
 endmacro()
 
 
+# Add test
+macro(jopAddTest target)
+
+    # Parse the arguments
+    cmake_parse_arguments(THIS "" "" "SOURCES" ${ARGN})
+
+    # Set a source group for the sources
+    source_group("src" FILES ${THIS_SOURCES})
+
+    # Tests run without a window, so they're always console applications
+    add_executable(${target} ${THIS_SOURCES})
+
+    # Set the target's folder
+    set_target_properties(${target} PROPERTIES FOLDER "tests")
+
+    # Link the target to Jopnal
+    target_link_libraries(${target} jopnal)
+    
+    # Add Jopnal as a dependency
+    add_dependencies(${target} jopnal)
+
+    # Register the test
+    add_test(NAME ${target} COMMAND ${target})
+
+    # Copy dll's on Windows
+    if (JOP_OS_WINDOWS AND BUILD_SHARED_LIBS)
+
+        add_custom_command(TARGET ${target} POST_BUILD
+                           DEPENDS ALL
+                           COMMAND ${CMAKE_COMMAND} -E copy_directory
+                           ${PROJECT_BINARY_DIR}/lib/${CMAKE_CFG_INTDIR} $<TARGET_FILE_DIR:${target}>)
+
+    endif()
+
+endmacro()
+
+
+# Add benchmark
+macro(jopAddBenchmark target)
+
+    # Parse the arguments
+    cmake_parse_arguments(THIS "" "" "SOURCES" ${ARGN})
+
+    # Set a source group for the sources
+    source_group("src" FILES ${THIS_SOURCES})
+
+    # Benchmarks print their results into the console. They're not registered
+    # as tests, since their results depend on the machine
+    add_executable(${target} ${THIS_SOURCES})
+
+    # Set the target's folder
+    set_target_properties(${target} PROPERTIES FOLDER "benchmarks")
+
+    # Some benchmarks time internal classes
+    target_include_directories(${target} PRIVATE ${PROJECT_SOURCE_DIR}/src)
+
+    # Link the target to Jopnal
+    target_link_libraries(${target} jopnal)
+    
+    # Add Jopnal as a dependency
+    add_dependencies(${target} jopnal)
+
+    # Copy dll's on Windows
+    if (JOP_OS_WINDOWS AND BUILD_SHARED_LIBS)
+
+        add_custom_command(TARGET ${target} POST_BUILD
+                           DEPENDS ALL
+                           COMMAND ${CMAKE_COMMAND} -E copy_directory
+                           ${PROJECT_BINARY_DIR}/lib/${CMAKE_CFG_INTDIR} $<TARGET_FILE_DIR:${target}>)
+
+    endif()
+
+endmacro()
+
+
 # Macro to find packages on the host OS
 # This is the same as in the toolchain file, here for Nsight Tegra VS
 if(CMAKE_VS_PLATFORM_NAME STREQUAL "Tegra-Android")
@@ -105,6 +105,12 @@ namespace jop
         ///
         bool load(const void* ptr, const uint32 size);
 
+        /// \brief Get the memory usage
+        ///
+        /// \return The size of the decoded samples
+        ///
+        MemoryUsage getMemoryUsage() const override;
+
         /// \brief Get default sound buffer
         ///
         /// \return Reference to the buffer
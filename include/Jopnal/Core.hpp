@@ -27,6 +27,7 @@
 #include <Jopnal/Core/Engine.hpp>
 #include <Jopnal/Core/FileLoader.hpp>
 #include <Jopnal/Core/Object.hpp>
+#include <Jopnal/Core/Profiler.hpp>
 #include <Jopnal/Core/Resource.hpp>
 #include <Jopnal/Core/ResourceManager.hpp>
 #include <Jopnal/Core/Scene.hpp>
@@ -26,6 +26,7 @@
 #include <Jopnal/Header.hpp>
 #include <Jopnal/Utility/SafeReferenceable.hpp>
 #include <Jopnal/Utility/Message.hpp>
+#include <vector>
 
 //////////////////////////////////////////////
 
@@ -41,6 +42,7 @@ namespace jop
         JOP_DISALLOW_COPY_MOVE(Component);
 
         friend class Object;
+        friend class Engine;
 
         /// \brief Clone function
         ///
@@ -83,6 +85,27 @@ namespace jop
         virtual ~Component() = 0;
 
 
+        /// \brief Allocate memory for a component
+        ///
+        /// Components are allocated from pools, one per size class. The pools are
+        /// carved from larger chunks, which avoids a heap allocation per component.
+        /// Components of different types but similar size share a pool, so a pool
+        /// doesn't hold only one type.
+        ///
+        /// \param size Size of the component
+        ///
+        /// \return Pointer to the memory
+        ///
+        static void* operator new(std::size_t size);
+
+        /// \brief Release memory of a component
+        ///
+        /// \param ptr Pointer to the memory
+        /// \param size Size of the component
+        ///
+        static void operator delete(void* ptr, std::size_t size);
+
+
         /// \brief Send a message to this component
         ///
         /// \param message The message
@@ -97,6 +120,18 @@ namespace jop
         ///
         virtual void update(const float deltaTime);
 
+        /// \brief Parallel update function
+        ///
+        /// Override this to opt into the parallel update phase. It's called
+        /// from a worker thread before update(), and different objects' components
+        /// may be updated at the same time. Only touch the state of this component
+        /// and read the transformation of its object. Anything else, such as creating
+        /// objects or sending messages, belongs in update().
+        ///
+        /// \param deltaTime The delta time
+        ///
+        virtual void parallelUpdate(const float deltaTime);
+
         /// \brief Get the identifier
         ///
         /// \return The identifier
@@ -149,10 +184,49 @@ namespace jop
         ///
         virtual Message::Result receiveMessage(const Message& message);
 
+        /// \brief Subscribe to a command
+        ///
+        /// Once a command has any subscribers, broadcasts of it through Engine::sendMessage()
+        /// are delivered only to the subscribed components, instead of walking through
+        /// every object in the scenes. The subscribers receive the same broadcasts the
+        /// traversal would give them: without the object filter bit only the components
+        /// of the scenes themselves are reached. The delivery follows the subscription
+        /// order rather than the tree order. If a scene or an object has bound the command
+        /// in its command handler, the scenes are walked as before.
+        ///
+        /// Use this for commands that are broadcast often and handled by few components.
+        /// Components that only handle the command in their receiveMessage() or command
+        /// handler without subscribing don't receive it. Messages sent directly to an
+        /// object or a scene are not affected.
+        ///
+        /// \param command The command name
+        ///
+        void subscribe(const std::string& command);
+
+        /// \brief Unsubscribe from a command
+        ///
+        /// \param command The command name
+        ///
+        void unsubscribe(const std::string& command);
+
     private:
 
-        uint32 m_ID;                        ///< Identifier
-        WeakReference<Object> m_objectRef;  ///< Reference to the object this component is bound to
+        /// \brief Deliver a broadcast to the subscribers of its command
+        ///
+        /// \param message The message
+        /// \param result The message result, set if the message was delivered
+        ///
+        /// \return True if the message was delivered. False if the command has no subscribers, the
+        ///         filter excludes components or a scene or an object has bound the command, in
+        ///         which case the message should be delivered normally
+        ///
+        static bool sendToSubscribers(const Message& message, Message::Result& result);
+
+
+        uint32 m_ID;                            ///< Identifier
+        uint32 m_typeID;                        ///< Exact type identifier, set by Object::createComponent(). 0 if unknown
+        WeakReference<Object> m_objectRef;      ///< Reference to the object this component is bound to
+        std::vector<uint32> m_subscriptions;    ///< Identifiers of the subscribed commands
     };
 }
 
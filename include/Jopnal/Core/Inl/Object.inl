@@ -20,33 +20,38 @@
 //////////////////////////////////////////////
 
 
-namespace detail
+template<typename T>
+Component* Object::findComponent(const uint32* ID) const
 {
-    template<typename T = ::jop::Component>
-    T* componentGetter(const std::vector<std::unique_ptr<::jop::Component>>& comps, const uint32* ID)
-    {
-        static_assert(std::is_base_of<::jop::Component, T>::value, "Object::getComponent(): Tried to get a component that doesn't inherit from jop::Component");
+    static_assert(std::is_base_of<::jop::Component, T>::value, "Object::getComponent(): Tried to get a component that doesn't inherit from jop::Component");
 
-        for (auto& i : comps)
-        {
-            if ((ID == nullptr || i->getID() == *ID) && dynamic_cast<T*>(i.get()) != nullptr)
-                return static_cast<T*>(i.get());
-        }
+    const uint32 type = detail::getComponentTypeID<typename std::remove_const<T>::type>();
+
+    for (auto& i : m_components)
+    {
+        auto comp = i.get();
 
-        return nullptr;
+        // An exact type match doesn't need the cast. Derived types and components
+        // of unknown type still go through it
+        if ((ID == nullptr || comp->getID() == *ID) && (comp->m_typeID == type || dynamic_cast<const T*>(comp) != nullptr))
+            return comp;
     }
+
+    return nullptr;
 }
 
+//////////////////////////////////////////////
+
 template<typename T>
 T* Object::getComponent()
 {
-    return detail::componentGetter<T>(m_components, nullptr);
+    return static_cast<T*>(findComponent<T>(nullptr));
 }
 
 template<typename T>
 const T* Object::getComponent() const
 {
-    return detail::componentGetter<const T>(m_components, nullptr);
+    return static_cast<const T*>(findComponent<T>(nullptr));
 }
 
 //////////////////////////////////////////////
@@ -54,13 +59,13 @@ const T* Object::getComponent() const
 template<typename T>
 T* Object::getComponent(const uint32 ID)
 {
-    return detail::componentGetter<T>(m_components, &ID);
+    return static_cast<T*>(findComponent<T>(&ID));
 }
 
 template<typename T>
 const T* Object::getComponent(const uint32 ID) const
 {
-    return detail::componentGetter<const T>(m_components, &ID);
+    return static_cast<const T*>(findComponent<T>(&ID));
 }
 
 //////////////////////////////////////////////
@@ -71,6 +76,8 @@ T& Object::createComponent(Args&&... args)
     static_assert(std::is_base_of<Component, T>::value, "Object::createComponent(): Tried to create a component that doesn't inherit from jop::Component");
     
     m_components.emplace_back(std::make_unique<T>(*this, std::forward<Args>(args)...));
+    m_components.back()->m_typeID = detail::getComponentTypeID<T>();
+
     return static_cast<T&>(*m_components.back());
 }
 
@@ -105,6 +105,124 @@ namespace detail
 
         JOP_ASSERT(instance != nullptr, "Tried to load a resource without there being a valid ResourceManager instance!");
     }
+
+    //////////////////////////////////////////////
+
+    template<typename T>
+    struct AsyncArgImpl
+    {
+        typedef T type;
+    };
+    template<>
+    struct AsyncArgImpl<const char*>
+    {
+        typedef std::string type;
+    };
+    template<>
+    struct AsyncArgImpl<char*>
+    {
+        typedef std::string type;
+    };
+
+    // Asynchronous load arguments are stored by value, string literals as std::string
+    template<typename T>
+    struct AsyncArg : AsyncArgImpl<typename std::decay<T>::type>
+    {};
+
+    //////////////////////////////////////////////
+
+    template<typename T>
+    struct IsReloadableArg
+    {
+        typedef typename AsyncArg<T>::type Type;
+
+        static const bool value = std::is_arithmetic<Type>::value || std::is_enum<Type>::value || std::is_same<Type, std::string>::value;
+    };
+
+    // Resources can be reloaded if their load arguments are cheap to store and can't dangle
+    template<typename ... Args>
+    struct IsReloadable : std::true_type
+    {};
+    template<typename First, typename ... Rest>
+    struct IsReloadable<First, Rest...> : std::integral_constant<bool, IsReloadableArg<First>::value && IsReloadable<Rest...>::value>
+    {};
+
+    // Reloads go through the asynchronous loader, so the preparation runs on a worker
+    template<typename T, typename ... Args>
+    std::function<std::function<bool(Resource&)>()> makeReloader(std::true_type, typename AsyncArg<Args>::type... args)
+    {
+        return [args...]() -> std::function<bool(Resource&)>
+        {
+            auto upload = AsyncLoadTraits<T>::prepare(args...);
+
+            if (!upload)
+                return nullptr;
+
+            return [upload](Resource& resource)
+            {
+                return upload(static_cast<T&>(resource));
+            };
+        };
+    }
+
+    template<typename T, typename ... Args, typename ... Params>
+    std::function<std::function<bool(Resource&)>()> makeReloader(std::false_type, Params&&...)
+    {
+        return nullptr;
+    }
+
+    //////////////////////////////////////////////
+
+    template<typename T, typename ... Args>
+    std::function<void(AsyncLoad&)> makeAsyncJob(typename AsyncArg<Args>::type... args)
+    {
+        return [args...](AsyncLoad& load)
+        {
+            auto upload = AsyncLoadTraits<T>::prepare(args...);
+
+            if (upload)
+            {
+                const std::string name = load.key.first;
+
+                load.finish = [upload, name]() -> std::unique_ptr<Resource>
+                {
+                    auto res = std::make_unique<T>(name);
+
+                    if (upload(*res))
+                        return std::move(res);
+
+                    return nullptr;
+                };
+            }
+        };
+    }
+}
+
+//////////////////////////////////////////////
+
+template<typename T>
+bool AsyncResource<T>::isReady() const
+{
+    return !m_state || m_state->status.load() >= detail::AsyncLoad::Done;
+}
+
+//////////////////////////////////////////////
+
+template<typename T>
+bool AsyncResource<T>::isLoaded() const
+{
+    return m_state && m_state->status.load() == detail::AsyncLoad::Done && !m_state->resource.expired();
+}
+
+//////////////////////////////////////////////
+
+template<typename T>
+T& AsyncResource<T>::get() const
+{
+    if (isLoaded())
+        return static_cast<T&>(*m_state->resource);
+
+    return detail::LoadFallback<T>::load(m_state ? m_state->key.first : std::string());
 }
 
 //////////////////////////////////////////////
@@ -120,29 +238,27 @@ T& ResourceManager::get(Args&&... args)
 template<typename T, typename ... Args> 
 T& ResourceManager::getNamed(const std::string& name, Args&&... args)
 {
+    // Another thread may load the same resource simultaneously, in which case
+    // whichever finishes first is kept
     if (exists<T>(name))
         return getExisting<T>(name);
 
     else
     {
+        JOP_PROFILE("ResourceManager::load");
+
     #if JOP_CONSOLE_VERBOSITY >= 3
         Clock clk;
     #endif
 
         auto res = std::make_unique<T>(name);
+        auto reloader = detail::makeReloader<T, Args...>(detail::IsReloadable<Args...>(), args...);
 
         if (res->load(std::forward<Args>(args)...))
         {
-            T& ptr = *res;
-
-            {
-                std::lock_guard<std::recursive_mutex> lock(m_instance->m_mutex);
+            res->m_reloader = std::move(reloader);
 
-                m_instance->m_resources[std::make_pair(name, std::type_index(typeid(T)))] = std::move(res);
-
-                if (m_instance->m_loadPhase.load())
-                    m_instance->m_loadPhaseResources.emplace(name, std::type_index(typeid(T)));
-            }
+            T& ptr = static_cast<T&>(m_instance->insert(std::make_pair(name, std::type_index(typeid(T))), std::move(res)));
 
             JOP_DEBUG_DIAG("\"" << name << "\" (" << typeid(T).name() << ") loaded, took " << clk.getElapsedTime().asSeconds() << "s");
 
@@ -156,27 +272,85 @@ T& ResourceManager::getNamed(const std::string& name, Args&&... args)
 //////////////////////////////////////////////
 
 template<typename T, typename ... Args>
-T& ResourceManager::getEmpty(Args&&... args)
+AsyncResource<T> ResourceManager::getAsync(Args&&... args)
 {
-    const std::string name = detail::getStringArg(args...);
+    return getNamedAsync<T>(detail::getStringArg(args...), std::forward<Args>(args)...);
+}
 
-    if (exists<T>(name))
-        return getExisting<T>(name);
+//////////////////////////////////////////////
 
-    else
+template<typename T, typename ... Args>
+AsyncResource<T> ResourceManager::getNamedAsync(const std::string& name, Args&&... args)
+{
+    detail::basicErrorCheck<T>(m_instance);
+
+    const auto key = std::make_pair(name, std::type_index(typeid(T)));
+
+    AsyncResource<T> handle;
     {
-        auto res = std::make_unique<T>(args...);
-        T& ptr = *res;
+        std::lock_guard<std::recursive_mutex> lock(m_instance->m_mutex);
+
+        if (m_instance->m_loadPhase.load())
+            m_instance->m_loadPhaseResources.insert(key);
 
+        auto resItr = m_instance->m_resources.find(key);
+        if (resItr != m_instance->m_resources.end())
         {
-            std::lock_guard<std::recursive_mutex> lock(m_instance->m_mutex);
+            handle.m_state = std::make_shared<detail::AsyncLoad>(name, key.second);
+            handle.m_state->resource = resItr->second->getReference();
+            handle.m_state->status.store(detail::AsyncLoad::Done);
 
-            m_instance->m_resources[std::make_pair(name, std::type_index(typeid(T)))] = std::move(res);
+            return handle;
+        }
 
-            if (m_instance->m_loadPhase.load())
-                m_instance->m_loadPhaseResources.emplace(name, std::type_index(typeid(T)));
+        auto loadItr = m_instance->m_asyncLoads.find(key);
+        if (loadItr != m_instance->m_asyncLoads.end())
+        {
+            handle.m_state = loadItr->second;
+            return handle;
         }
 
+        if (m_instance->m_asyncQueue.empty())
+            m_instance->m_asyncRequested = m_instance->m_asyncFinished = 0;
+
+        handle.m_state = std::make_shared<detail::AsyncLoad>(name, key.second);
+
+        m_instance->m_asyncLoads[key] = handle.m_state;
+        m_instance->m_asyncQueue.push_back(handle.m_state);
+        ++m_instance->m_asyncRequested;
+    }
+
+    auto state = handle.m_state;
+    state->reloader = detail::makeReloader<T, Args...>(detail::IsReloadable<Args...>(), args...);
+
+    auto job = detail::makeAsyncJob<T, Args...>(std::forward<Args>(args)...);
+
+    JobSystem::getDefault().run([state, job]()
+    {
+        JOP_PROFILE("ResourceManager::prepareAsync");
+
+        job(*state);
+        state->status.store(detail::AsyncLoad::Prepared);
+
+    }, state->counter);
+
+    return handle;
+}
+
+//////////////////////////////////////////////
+
+template<typename T, typename ... Args>
+T& ResourceManager::getEmpty(Args&&... args)
+{
+    const std::string name = detail::getStringArg(args...);
+
+    if (exists<T>(name))
+        return getExisting<T>(name);
+
+    else
+    {
+        T& ptr = static_cast<T&>(m_instance->insert(std::make_pair(name, std::type_index(typeid(T))), std::make_unique<T>(args...)));
+
         JOP_DEBUG_DIAG("\"" << name << "\" (" << typeid(T).name() << ") created");
 
         return ptr;
@@ -193,7 +367,10 @@ T& ResourceManager::getExisting(const std::string& name)
         if (m_instance->m_loadPhase.load())
             m_instance->m_loadPhaseResources.emplace(name, std::type_index(typeid(T)));
 
-        return static_cast<T&>(*m_instance->m_resources.find(std::make_pair(name, std::type_index(typeid(T))))->second);
+        auto& res = *m_instance->m_resources.find(std::make_pair(name, std::type_index(typeid(T))))->second;
+        res.markUsed();
+
+        return static_cast<T&>(res);
     }
 
     return detail::LoadFallback<T>::load(name);
@@ -267,6 +444,16 @@ void ResourceManager::unload(const std::string& name)
 
 //////////////////////////////////////////////
 
+template<typename T>
+void ResourceManager::setMemoryBudget(const std::size_t cpu, const std::size_t gpu)
+{
+    detail::basicErrorCheck<T>(m_instance);
+
+    setTypeBudget(std::type_index(typeid(T)), cpu, gpu);
+}
+
+//////////////////////////////////////////////
+
 template<typename T>
 bool ResourceManager::isDefault(const T& resource)
 {
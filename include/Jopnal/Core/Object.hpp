@@ -40,6 +40,24 @@ namespace jop
 {
     class Scene;
 
+    namespace detail
+    {
+        /// \brief Get the next free component type identifier
+        ///
+        JOP_API uint32 nextComponentTypeID();
+
+        /// \brief Get the identifier of a component type
+        ///
+        /// \return The identifier, assigned on the first call. Never 0
+        ///
+        template<typename T>
+        uint32 getComponentTypeID()
+        {
+            static const uint32 id = nextComponentTypeID();
+            return id;
+        }
+    }
+
     class JOP_API Object : public SafeReferenceable<Object>, public SerializeInfo
     {
     private:
@@ -56,14 +74,13 @@ namespace jop
             ChildrenRemovedFlag = 1 << 3,
 
             // Transformations
-            MatrixDirty         = 1 << 4,
             InverseMatrixDirty  = 1 << 5,
 
             GlobalRotationDirty = 1 << 6,
             GlobalScaleDirty    = 1 << 7,
             GlobalPositionDirty = 1 << 8,
 
-            TransformDirty      = MatrixDirty | InverseMatrixDirty | GlobalRotationDirty | GlobalScaleDirty | GlobalPositionDirty
+            TransformDirty      = InverseMatrixDirty | GlobalRotationDirty | GlobalScaleDirty | GlobalPositionDirty
         };
 
     public:
@@ -136,6 +153,12 @@ namespace jop
 
         /// \brief Get a component using type info
         ///
+        /// The components are searched in order, and the first one of type T or
+        /// derived from it is returned. Components made with createComponent()
+        /// remember their exact type, so finding them by that type skips the
+        /// dynamic_cast. The search is still linear in the number of components,
+        /// so store the pointer when the same component is needed every frame.
+        ///
         /// \return Pointer to the component. nullptr if not found
         ///
         template<typename T>
@@ -409,6 +432,9 @@ namespace jop
 
         /// \brief Find a child
         ///
+        /// Strict searches are looked up from an index instead of going through the children.
+        /// If several children match, which one is returned is unspecified.
+        ///
         /// \param ID Object identifier
         /// \param recursive Search recursively?
         /// \param strict Does the ID have to match exactly?
@@ -420,6 +446,8 @@ namespace jop
         /// \brief Find all children matching the criteria
         ///
         /// When ID is empty and strict is false, all children will be returned.
+        /// Strict searches are looked up from an index, and the order of the
+        /// results is unspecified.
         /// 
         /// \param ID Object identifier
         /// \param recursive Search recursively?
@@ -431,6 +459,9 @@ namespace jop
 
         /// \brief Find children with a tag
         ///
+        /// The search is looked up from an index, and the order of the
+        /// results is unspecified.
+        ///
         /// \param tag Object identifier
         /// \param recursive Search recursively?
         ///
@@ -542,6 +573,15 @@ namespace jop
         ///
         void update(const float deltaTime);
 
+        /// \brief Parallel update
+        ///
+        /// Calls Component::parallelUpdate() for this object's components
+        /// and the whole subtree. This is for internal use.
+        ///
+        /// \param deltaTime The delta time
+        ///
+        void parallelUpdate(const float deltaTime);
+
         /// \brief Print the tree of objects into the console, this object as root
         ///
         void printDebugTree() const;
@@ -560,6 +600,15 @@ namespace jop
         ///
         const Transform& getInverseTransform() const;
 
+        /// \brief Get the transform version
+        ///
+        /// The version changes whenever the global transformation of this object
+        /// changes, including when one of its parents is moved.
+        ///
+        /// \return The transform version
+        ///
+        uint32 getTransformVersion() const;
+
         /// \brief Get the local transformation variables
         ///
         /// \return Reference to the internal variables
@@ -888,14 +937,29 @@ namespace jop
 
         void setFlagsIf(const uint32 flags, const bool cond) const;
 
-        void propagateFlags(const uint32 flags);
+        void attachTo(Object& parent);
+
+        void updateLocals();
+
+        void syncTransform() const;
+
+        template<typename T>
+        Component* findComponent(const uint32* ID) const;
+
+        void indexSelf() const;
+
+        void unindexSelf() const;
+
+        bool hasAncestor(const Object& ancestor) const;
 
 
         // Transformation
-        mutable Transform m_transform;
-        mutable Transform m_inverseTransform;
-        mutable Transform::Variables m_locals;
-        mutable Transform::Variables m_globals;
+        mutable Transform m_transform;                          ///< Copy of the global matrix in the transform store
+        mutable Transform m_inverseTransform;                   ///< Inverse of the global matrix
+        mutable Transform::Variables m_locals;                  ///< Local transformation variables
+        mutable Transform::Variables m_globals;                 ///< Cached global transformation variables
+        uint32 m_transformHandle;                               ///< Handle into the transform store
+        mutable uint32 m_transformVersion;                      ///< Store version m_transform was copied from
 
         // Object
         std::vector<Object> m_children;                         ///< Container holding this object's children
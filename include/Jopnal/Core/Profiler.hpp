@@ -0,0 +1,189 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+#ifndef JOP_PROFILER_HPP
+#define JOP_PROFILER_HPP
+
+// Headers
+#include <Jopnal/Header.hpp>
+#include <Jopnal/Core/SubSystem.hpp>
+#include <string>
+#include <vector>
+
+//////////////////////////////////////////////
+
+
+#define __JOP_PROFILE_CAT_IMPL(a, b) a##b
+#define __JOP_PROFILE_CAT(a, b) __JOP_PROFILE_CAT_IMPL(a, b)
+
+#ifdef JOP_ENABLE_PROFILING
+
+    /// \brief Profile the enclosing scope
+    ///
+    /// The name must be a string with static storage duration, such as a literal.
+    /// Scopes with the same name and the same enclosing scope are merged, no matter
+    /// where the name is defined.
+    ///
+    #define JOP_PROFILE(name) ::jop::Profiler::Scope __JOP_PROFILE_CAT(__jop_profile_, __LINE__)(name)
+
+#else
+
+    #define JOP_PROFILE(name) {}
+
+#endif
+
+namespace jop
+{
+    class JOP_API Profiler final : public Subsystem
+    {
+    private:
+
+        JOP_DISALLOW_COPY_MOVE(Profiler);
+
+    public:
+
+        /// Scope timer
+        ///
+        /// Use the JOP_PROFILE macro instead of this directly.
+        ///
+        class JOP_API Scope
+        {
+        private:
+
+            JOP_DISALLOW_COPY_MOVE(Scope);
+
+        public:
+
+            /// \brief Constructor
+            ///
+            /// \param name Name of the scope. Must have static storage duration
+            ///
+            explicit Scope(const char* name);
+
+            /// \brief Destructor
+            ///
+            ~Scope();
+
+        private:
+
+            uint32 m_node;      ///< Node in the scope tree
+            uint32 m_parent;    ///< Enclosing node, restored once this scope ends
+            uint64 m_start;     ///< Start time in nanoseconds
+        };
+
+        /// Rolling statistics of a single node in the scope tree
+        ///
+        struct Statistics
+        {
+            std::string name;   ///< Scope name
+            uint32 depth;       ///< Nesting depth, zero for top level scopes
+            bool gpu;           ///< Is this a GPU event?
+            uint64 calls;       ///< Total number of calls
+            double average;     ///< Moving average of the time per frame, in milliseconds
+            double last;        ///< Time spent during the last frame, in milliseconds
+            double max;         ///< Longest time spent during a single frame, in milliseconds
+        };
+
+    public:
+
+        /// \brief Constructor
+        ///
+        Profiler();
+
+        /// \brief Destructor
+        ///
+        ~Profiler() override;
+
+
+        /// \brief Collect the events recorded during the frame
+        ///
+        /// This should be the last subsystem, so that everything
+        /// recorded during the frame is included.
+        ///
+        void draw() override;
+
+        /// \brief Get the scope statistics
+        ///
+        /// The statistics form a tree: each scope is followed by the scopes
+        /// nested in it, with a depth one greater. Siblings are sorted by the
+        /// average time, longest first. CPU scopes come before GPU events.
+        ///
+        /// \return The statistics
+        ///
+        std::vector<Statistics> getStatistics() const;
+
+        /// \brief Print the scope statistics using DebugHandler
+        ///
+        /// \comm printProfile
+        ///
+        void printStatistics() const;
+
+        /// \brief Export the recorded events as Chrome trace event JSON
+        ///
+        /// The file can be opened in chrome://tracing. The number of events kept
+        /// is set with "engine@Profiler|uTraceEvents".
+        ///
+        /// \param path Path of the file to write, relative to the user directory
+        ///
+        /// \return True if successful
+        ///
+        /// \comm exportProfile
+        ///
+        bool exportTrace(const std::string& path) const;
+
+        /// \brief Get the current time
+        ///
+        /// \return Time in nanoseconds since the engine started
+        ///
+        static uint64 now();
+
+        /// \brief Record a GPU event
+        ///
+        /// GPU events are collected like any other scope, but they are placed on their
+        /// own track in the exported trace. This must be called from the main thread.
+        ///
+        /// \param name Name of the event. Must have static storage duration
+        /// \param start Start time in nanoseconds, in the same time base as now()
+        /// \param end End time in nanoseconds
+        ///
+        static void recordGpu(const char* name, const uint64 start, const uint64 end);
+
+    protected:
+
+        /// \copydoc Subsystem::receiveMessage()
+        ///
+        Message::Result receiveMessage(const Message& message) override;
+    };
+}
+
+/// \class jop::Profiler
+/// \ingroup core
+///
+/// Scoped frame profiler.
+///
+/// Scopes are recorded into per-thread ring buffers without locking, and
+/// collected by the main thread at the end of each frame. Scope names are
+/// interned by content and scopes are kept in a tree by their nesting, so
+/// the statistics are hierarchical. Profiling is
+/// compiled in only if JOP_ENABLE_PROFILING is defined (the CMake option
+/// JOP_PROFILING); otherwise JOP_PROFILE expands to nothing.
+
+#endif
\ No newline at end of file
@@ -26,6 +26,7 @@
 #include <Jopnal/Header.hpp>
 #include <Jopnal/Core/SerializeInfo.hpp>
 #include <Jopnal/Utility/SafeReferenceable.hpp>
+#include <functional>
 #include <string>
 #include <memory>
 
@@ -42,6 +43,16 @@ namespace jop
 
         friend class ResourceManager;
 
+    public:
+
+        /// Memory usage in bytes
+        ///
+        struct MemoryUsage
+        {
+            std::size_t cpu;    ///< Main memory
+            std::size_t gpu;    ///< Video memory
+        };
+
     protected:
 
         /// \brief Copy constructor
@@ -94,10 +105,85 @@ namespace jop
         ///
         unsigned short getPersistence() const;
 
+        /// \brief Get the memory usage
+        ///
+        /// The resource manager uses this to enforce its memory budgets.
+        /// The default implementation returns zero.
+        ///
+        /// \return The memory usage. May be an estimate
+        ///
+        virtual MemoryUsage getMemoryUsage() const;
+
+        /// \brief Mark this resource as used on the current frame
+        ///
+        /// Resources that haven't been used recently are the first to be evicted
+        /// by the resource manager. If this resource has been evicted, a reload
+        /// is queued on the asynchronous loader.
+        ///
+        void markUsed() const;
+
+        /// \brief Check if this resource has been evicted
+        ///
+        /// \return True if evicted
+        ///
+        bool isEvicted() const;
+
+    protected:
+
+        /// \brief Release the memory held by this resource
+        ///
+        /// Called by the resource manager when evicting. The resource must stay valid
+        /// so that it can be reloaded with the same arguments load() was called with.
+        /// The default implementation does nothing.
+        ///
+        /// \return True if the memory was released
+        ///
+        virtual bool releaseMemory();
+
+        /// \brief Notify that the contents have changed
+        ///
+        /// Call this whenever the contents change, for example in load(). Unless the
+        /// resource manager is the one loading, the resource can no longer be reloaded
+        /// by replaying its first load, so it won't be evicted anymore.
+        ///
+        void contentsChanged();
+
     private:
 
-        const std::string m_name;       ///< Name of this resource
-        unsigned short m_persistence;   ///< Persistence level
+        static uint32 m_frame;                          ///< Current frame, advanced by the resource manager
+
+        const std::string m_name;                       ///< Name of this resource
+        unsigned short m_persistence;                   ///< Persistence level
+        std::function
+        <
+            std::function<bool(Resource&)>()
+        > m_reloader;                                   ///< Prepares a replay of the first load, empty if not reloadable
+        mutable uint32 m_lastUsed;                      ///< Frame this resource was last used on
+        mutable bool m_evicted;                         ///< Has the memory been released?
+        mutable bool m_reloadQueued;                    ///< Is a reload pending?
+    };
+
+    /// \brief Asynchronous load behavior of a resource type
+    ///
+    /// prepare() is called on a worker thread with the arguments passed to
+    /// ResourceManager::getAsync(). The returned function is called on the main
+    /// thread with the newly constructed resource. Returning an empty function
+    /// signals failure.
+    ///
+    /// By default the whole load() call is deferred to the main thread. Specialize
+    /// this to move decoding work off of it.
+    ///
+    template<typename T>
+    struct AsyncLoadTraits
+    {
+        template<typename ... Args>
+        static std::function<bool(T&)> prepare(Args... args)
+        {
+            return [args...](T& resource) mutable
+            {
+                return resource.load(args...);
+            };
+        }
     };
 }
 
@@ -120,5 +206,13 @@ namespace jop
 /// If at least one of these exists, the resource manager will use them to fetch
 /// a fallback resource if the load() method fails. Make sure that these functions
 /// always succeed, so that they don't cause an infinite recursive loop.
+///
+/// ## Eviction
+///
+/// To let the resource manager evict a resource when over its memory budget,
+/// override getMemoryUsage() and releaseMemory(), call markUsed() whenever the
+/// resource is used and contentsChanged() whenever its contents change. Only
+/// resources loaded through the manager with plain value arguments (numbers, enums
+/// and strings), and not changed since, can be reloaded, and so evicted.
 
 #endif
\ No newline at end of file
@@ -27,13 +27,18 @@
 #include <Jopnal/Core/Resource.hpp>
 #include <Jopnal/Core/Subsystem.hpp>
 #include <Jopnal/Core/DebugHandler.hpp>
+#include <Jopnal/Core/Profiler.hpp>
 #include <Jopnal/Utility/Clock.hpp>
+#include <Jopnal/Utility/JobSystem.hpp>
 #include <Jopnal/STL.hpp>
 #include <unordered_map>
 #include <unordered_set>
 #include <memory>
 #include <typeindex>
 #include <mutex>
+#include <atomic>
+#include <functional>
+#include <vector>
 
 //////////////////////////////////////////////
 
@@ -51,8 +56,99 @@ namespace jop
 {
     class Resource;
 
+    namespace detail
+    {
+        struct AsyncLoad
+        {
+            enum Status
+            {
+                Preparing,
+                Prepared,
+                Done,
+                Failed
+            };
+
+            AsyncLoad(const std::string& name, const std::type_index type, const bool isReload = false)
+                : key(name, type), reload(isReload), status(Preparing), finish(), upload(), reloader(), resource(), counter()
+            {}
+
+            std::pair<std::string, std::type_index> key;              ///< Resource key
+            const bool reload;                                        ///< Is this a reload of an evicted resource?
+            std::atomic<int> status;                                  ///< Status
+            std::function<std::unique_ptr<Resource>()> finish;        ///< Main thread step of a load. Written by the worker before status is set to Prepared
+            std::function<bool(Resource&)> upload;                    ///< Main thread step of a reload. Written by the worker before status is set to Prepared
+            std::function<std::function<bool(Resource&)>()> reloader; ///< Reloader given to the resource once loaded. Empty if the arguments aren't reloadable
+            WeakReference<Resource> resource;                         ///< The resource, once done. Set from the start when reloading
+            JobSystem::Counter counter;                               ///< Counter of the worker job
+        };
+    }
+
+    /// \brief Handle to an asynchronously loaded resource
+    ///
+    /// \see ResourceManager::getAsync()
+    ///
+    template<typename T>
+    class AsyncResource
+    {
+    private:
+
+        friend class ResourceManager;
+
+    public:
+
+        /// \brief Default constructor
+        ///
+        /// Creates a handle that's not bound to any load.
+        ///
+        AsyncResource() = default;
+
+        /// \brief Check if the load has finished, successfully or not
+        ///
+        /// \return True if finished
+        ///
+        bool isReady() const;
+
+        /// \brief Check if the resource was loaded successfully
+        ///
+        /// \return True if loaded and still alive
+        ///
+        bool isLoaded() const;
+
+        /// \brief Get the resource
+        ///
+        /// If the resource isn't loaded, the default or error resource is
+        /// returned instead.
+        ///
+        /// \return Reference to the resource
+        ///
+        T& get() const;
+
+    private:
+
+        std::shared_ptr<detail::AsyncLoad> m_state; ///< Shared load state
+    };
+
+    //////////////////////////////////////////////
+
     class JOP_API ResourceManager : public Subsystem
     {
+    private:
+
+        friend class Resource;
+
+    public:
+
+        /// Memory statistics
+        ///
+        struct MemoryStats
+        {
+            std::size_t cpu;    ///< Main memory in use, in bytes
+            std::size_t gpu;    ///< Video memory in use, in bytes
+            uint32 resources;   ///< Number of resources
+            uint32 evicted;     ///< Number of currently evicted resources
+            uint64 evictions;   ///< Total number of evictions
+        };
+
     public:
 
         /// \brief Default constructor
@@ -89,6 +185,56 @@ namespace jop
         template<typename T, typename ... Args>
         static T& getNamed(const std::string& name, Args&&... args);
 
+        /// \brief Load a resource asynchronously
+        ///
+        /// The first argument must be convertible into std::string, as it's used as
+        /// a hash map key. See getNamedAsync().
+        ///
+        /// \param args Arguments passed to AsyncLoadTraits<T>::prepare()
+        ///
+        /// \return Handle to the resource
+        ///
+        template<typename T, typename ... Args>
+        static AsyncResource<T> getAsync(Args&&... args);
+
+        /// \brief Load a named resource asynchronously
+        ///
+        /// AsyncLoadTraits<T>::prepare() is run on the \ref JobSystem "default job system",
+        /// and the rest of the load, including GPU uploads, is run on the main thread
+        /// during preUpdate(). Requests for a resource that's already being loaded
+        /// share the same load. If the resource exists already, the returned handle
+        /// is ready immediately.
+        ///
+        /// \param name Name for the resource
+        /// \param args Arguments passed to AsyncLoadTraits<T>::prepare(). String literals
+        ///             are stored as std::string
+        ///
+        /// \return Handle to the resource
+        ///
+        template<typename T, typename ... Args>
+        static AsyncResource<T> getNamedAsync(const std::string& name, Args&&... args);
+
+        /// \brief Finish all pending asynchronous loads
+        ///
+        /// Blocks until every load has finished. Must be called from the main thread.
+        ///
+        static void finishAsyncLoads();
+
+        /// \brief Get the number of unfinished asynchronous loads
+        ///
+        /// \return Number of unfinished loads
+        ///
+        static uint32 getPendingLoads();
+
+        /// \brief Get the progress of asynchronous loading
+        ///
+        /// The progress is counted from the first request made while nothing was
+        /// pending, and is useful for loading screens.
+        ///
+        /// \return Progress between 0 and 1. 1 when nothing is pending
+        ///
+        static float getLoadProgress();
+
         /// \brief Get an empty resource
         ///
         /// This function will not call the resource's load function.
@@ -212,8 +358,72 @@ namespace jop
         template<typename T>
         static bool isError(const T& resource);
 
+        /// \brief Set the total memory budget
+        ///
+        /// When over budget, the least recently used resources are evicted. Only resources
+        /// that have persistence above zero, can be reloaded and haven't been used during
+        /// the last "engine@Resources|uEvictionIdleFrames" frames are considered. The next
+        /// use of an evicted resource queues a reload on the asynchronous loader, and the
+        /// resource stays evicted until the reload has finished.
+        ///
+        /// The initial budgets are read from "engine@Resources|uCPUMemoryBudget" and
+        /// "engine@Resources|uGPUMemoryBudget", in megabytes.
+        ///
+        /// \param cpu Main memory budget in bytes. Zero means unlimited
+        /// \param gpu Video memory budget in bytes. Zero means unlimited
+        ///
+        /// \see Resource::markUsed()
+        ///
+        static void setMemoryBudget(const std::size_t cpu, const std::size_t gpu);
+
+        /// \brief Set the memory budget of a resource type
+        ///
+        /// Type budgets are enforced alongside the total budget.
+        ///
+        /// \param cpu Main memory budget in bytes. Zero means unlimited
+        /// \param gpu Video memory budget in bytes. Zero means unlimited
+        ///
+        template<typename T>
+        static void setMemoryBudget(const std::size_t cpu, const std::size_t gpu);
+
+        /// \brief Get the memory statistics of all resources
+        ///
+        /// \return The statistics
+        ///
+        static MemoryStats getMemoryStats();
+
+        /// \brief Get the memory statistics per resource type
+        ///
+        /// \return The statistics
+        ///
+        static std::unordered_map<std::type_index, MemoryStats> getMemoryStatsByType();
+
+        /// \brief Finish prepared asynchronous loads and enforce the memory budgets
+        ///
+        /// The main thread steps are run until the time budget, read from
+        /// "engine@Resources|fAsyncUploadBudget" (seconds), runs out. At least
+        /// one load is finished per call.
+        ///
+        /// \param deltaTime The delta time
+        ///
+        void preUpdate(const float deltaTime) override;
+
     private:
 
+        static void setTypeBudget(const std::type_index& type, const std::size_t cpu, const std::size_t gpu);
+
+        static void queueReload(Resource& resource);
+
+        void updateAsync();
+
+        void enforceBudgets();
+
+        void finishAsync(detail::AsyncLoad& load);
+
+        void finishReload(detail::AsyncLoad& load);
+
+        Resource& insert(const std::pair<std::string, std::type_index>& key, std::unique_ptr<Resource> resource);
+
         static ResourceManager* m_instance;         ///< Pointer to the single instance
 
         std::unordered_map
@@ -225,6 +435,28 @@ namespace jop
         <
             std::pair<std::string, std::type_index>
         > m_loadPhaseResources;                     ///< Resource keys loaded during a load phase
+        std::unordered_map
+        <
+            std::pair<std::string, std::type_index>,
+            std::shared_ptr<detail::AsyncLoad>
+        > m_asyncLoads;                             ///< Unfinished asynchronous loads
+        std::vector<std::shared_ptr<detail::AsyncLoad>> m_asyncQueue;   ///< Unfinished asynchronous loads in request order
+        std::vector<std::shared_ptr<detail::AsyncLoad>> m_reloadQueue;  ///< Unfinished reloads of evicted resources
+        uint32 m_asyncRequested;                    ///< Loads requested since nothing was pending
+        uint32 m_asyncFinished;                     ///< Loads finished since nothing was pending
+        float m_uploadBudget;                       ///< Main thread time budget for asynchronous loads per frame
+        Resource::MemoryUsage m_budget;             ///< Total memory budget
+        std::unordered_map
+        <
+            std::type_index,
+            Resource::MemoryUsage
+        > m_typeBudgets;                            ///< Memory budgets per type
+        std::unordered_map
+        <
+            std::type_index,
+            uint64
+        > m_evictions;                              ///< Evictions per type
+        uint32 m_evictionIdleFrames;                ///< Frames a resource must be unused for to be evicted
         std::atomic<bool> m_loadPhase;              ///< Is it load phase currently?
         std::recursive_mutex m_mutex;               ///< Mutex
     };
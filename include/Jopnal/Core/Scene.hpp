@@ -36,10 +36,6 @@
 
 namespace jop
 {
-    namespace detail
-    {
-        class CullingBroadphaseCallback;
-    }
     class Renderer;
     class World;
     class World2D;
@@ -256,8 +252,6 @@ namespace jop
         std::unique_ptr<Renderer> m_renderer;   ///< The renderer
         float m_deltaScale;                     ///< Delta time scalar
         std::tuple<World2D*, World*> m_worlds;  ///< 2D and 3D worlds
-        World m_cullingWorld;
-        std::unique_ptr<detail::CullingBroadphaseCallback> m_broadphaseCallback;
     };
 
     // Include the template implementation file
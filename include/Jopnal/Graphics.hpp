@@ -35,6 +35,8 @@
 #include <Jopnal/Graphics/EnvironmentRecorder.hpp>
 #include <Jopnal/Graphics/Drawable.hpp>
 #include <Jopnal/Graphics/OpenGL/GlState.hpp>
+#include <Jopnal/Graphics/LightClusters.hpp>
+#include <Jopnal/Graphics/LightIndex.hpp>
 #include <Jopnal/Graphics/LightSource.hpp>
 #include <Jopnal/Graphics/MainRenderTarget.hpp>
 #include <Jopnal/Graphics/Material.hpp>
@@ -43,17 +45,21 @@
 #include <Jopnal/Graphics/PostProcessor.hpp>
 #include <Jopnal/Graphics/Mesh/RectangleMesh.hpp>
 #include <Jopnal/Graphics/RenderTarget.hpp>
+#include <Jopnal/Graphics/RenderTargetPool.hpp>
 #include <Jopnal/Graphics/RenderTexture.hpp>
 #include <Jopnal/Graphics/Renderer.hpp>
 #include <Jopnal/Graphics/Shader.hpp>
 #include <Jopnal/Graphics/ShaderAssembler.hpp>
+#include <Jopnal/Graphics/ShadowAtlas.hpp>
 #include <Jopnal/Graphics/SkyBox.hpp>
 #include <Jopnal/Graphics/SkySphere.hpp>
 #include <Jopnal/Graphics/Sprite.hpp>
+#include <Jopnal/Graphics/SpriteBatch.hpp>
 #include <Jopnal/Graphics/Mesh/SphereMesh.hpp>
 #include <Jopnal/Graphics/Texture/Texture2D.hpp>
 #include <Jopnal/Graphics/Texture/TextureSampler.hpp>
 #include <Jopnal/Graphics/Transform.hpp>
+#include <Jopnal/Graphics/UniformBuffer.hpp>
 #include <Jopnal/Graphics/Vertex.hpp>
 #include <Jopnal/Graphics/VertexBuffer.hpp>
 #include <Jopnal/Graphics/ShaderProgram.hpp>
@@ -24,9 +24,7 @@
 
 // Headers
 #include <Jopnal/Header.hpp>
-#include <Jopnal/Graphics/Drawable.hpp>
-#include <Jopnal/Graphics/Material.hpp>
-#include <Jopnal/Graphics/Mesh/RectangleMesh.hpp>
+#include <Jopnal/Graphics/Sprite.hpp>
 
 //////////////////////////////////////////////
 
@@ -35,7 +33,7 @@ namespace jop
 {
     class AnimationAtlas;
 
-    class JOP_API AnimatedSprite : public Drawable
+    class JOP_API AnimatedSprite : public Sprite
     {
     public:
 
@@ -65,7 +63,8 @@ namespace jop
 
         /// \brief Update sprite animation
         ///
-        /// Cycles through animation range with given frame time.
+        /// Cycles through animation range with given frame time. Advancing
+        /// a frame only changes the texture coordinates.
         ///
         /// \param deltaTime The delta time
         ///
@@ -104,6 +103,8 @@ namespace jop
 
         /// \brief Set animation atlas
         ///
+        /// The texture is set to the atlas texture and the size to the frame size.
+        ///
         /// \param atlas Reference to the animation atlas holding the frames
         ///
         /// \return Reference to self
@@ -131,8 +132,6 @@ namespace jop
     private:
 
         WeakReference<const AnimationAtlas> m_atlas;    ///< Reference to the animation atlas
-        RectangleMesh m_mesh;                           ///< Mesh to be drawn on
-        Material m_material;                            ///< Material to be drawn with
         std::pair<uint32, uint32> m_animationRange;     ///< Animation range (Start - End)
         float m_frameTime;                              ///< Time taken for each frame
         float m_timer;                                  ///< Timer
@@ -85,6 +85,9 @@ namespace jop
 
         /// \brief Bind this buffer
         ///
+        /// Element array buffers are bound to the default vertex array, so
+        /// that the vertex arrays owned by meshes are never modified.
+        ///
         void bind() const;
 
         /// \brief Unbind a buffer
@@ -109,6 +112,12 @@ namespace jop
         ///
         std::size_t getAllocatedSize() const;
 
+        /// \brief Get the OpenGL handle for this buffer
+        ///
+        /// \return The OpenGL handle. Zero if the buffer hasn't been created yet
+        ///
+        unsigned int getHandle() const;
+
     protected:
   
         std::size_t m_bytesAllocated;   ///< Size of the allocated buffer
@@ -27,22 +27,16 @@
 #include <Jopnal/Core/Component.hpp>
 #include <Jopnal/Graphics/RenderTexture.hpp>
 #include <glm/vec3.hpp>
-#include <set>
+#include <vector>
 
 //////////////////////////////////////////////
 
 
 namespace jop
 {
-    namespace detail
-    {
-        class CullerComponent;
-    }
     class Renderer;
     class RenderTarget;
     class Drawable;
-    class LightSource;
-    class FrustumShape;
 
     class JOP_API Camera : public Component
     {
@@ -50,7 +44,7 @@ namespace jop
 
         JOP_GENERIC_COMPONENT_CLONE(Camera);
 
-        friend class detail::CullerComponent;
+        friend class Renderer;
 
     public:
 
@@ -97,8 +91,6 @@ namespace jop
         ~Camera() override;
 
 
-        void update(const float deltaTime) override;
-
         /// \brief Get the projection matrix
         ///
         /// \return The projection matrix
@@ -301,15 +293,9 @@ namespace jop
 
     private:
 
-        Camera& updateShape();
-
-
         mutable glm::mat4 m_projectionMatrix;               ///< The projection matrix
         RenderTexture m_renderTexture;                      ///< RenderTexture used for off-screen rendering
-        std::set<const Drawable*> m_drawables;              ///< Drawables currently in view
-        std::set<const LightSource*> m_lights;              ///< Lights currently in view
-        std::unique_ptr<FrustumShape> m_shape;              ///< CUlling shape
-        std::unique_ptr<detail::CullerComponent> m_culler;  ///< Culler
+        mutable std::vector<const Drawable*> m_visible;     ///< Drawables currently in view, sorted
         ViewPort m_viewPort;                                ///< Viewport in relative coordinates
         ProjectionData m_projData;                          ///< Union with data for orthographic and perspective projections
         ClippingPlanes m_clippingPlanes;                    ///< The clipping planes
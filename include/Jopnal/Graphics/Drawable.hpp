@@ -38,10 +38,6 @@
 
 namespace jop
 {
-    namespace detail
-    {
-        class CullerComponent;
-    }
     class ShaderProgram;
     class LightSource;
     class LightContainer;
@@ -66,7 +62,8 @@ namespace jop
             ReceiveLights   = 1,        ///< Receive lights?
             ReceiveShadows  = 1 << 1,   ///< Receive shadows?
             CastShadows     = 1 << 2,   ///< Cast shadows?
-            Reflected       = 1 << 3    ///< Reflect on dynamic environment maps?
+            Reflected       = 1 << 3,   ///< Reflect on dynamic environment maps?
+            StaticShadows   = 1 << 4    ///< Is this a static shadow caster? Lights cache static casters separately
         };
 
         /// Attribute flags
@@ -76,7 +73,9 @@ namespace jop
             enum : uint64
             {
                 __SkySphere = 1 << 10,
-                __SkyBox    = __SkySphere << 1
+                __SkyBox    = __SkySphere << 1,
+                __Instanced = __SkyBox << 1,
+                __Sprite    = __Instanced << 1  ///< The drawable is a Sprite and can be drawn through a SpriteBatch
             };
         };
 
@@ -123,8 +122,6 @@ namespace jop
         virtual ~Drawable() override;
 
 
-        void update(const float deltaTime) override;
-
         /// \brief Draw function
         /// 
         /// \param proj The projection info
@@ -298,12 +295,29 @@ namespace jop
         ///
         bool isCulled() const;
 
+        /// \brief Get the render state version
+        ///
+        /// The version changes whenever the mesh, material, shader or color
+        /// is changed. Render passes use it to know when a cached sort key
+        /// needs to be recomputed.
+        ///
+        /// \return The render state version
+        ///
+        uint32 getStateVersion() const;
+
     protected:
 
         /// \copydoc Component::receiveMessage()
         ///
         virtual Message::Result receiveMessage(const Message& message) override;
 
+        /// \brief Invalidate the render state
+        ///
+        /// Derived drawables should call this when they change something that
+        /// affects how they're sorted.
+        ///
+        void invalidateState();
+
     protected:
 
         uint64 m_attributes;                            ///< Attribute flags
@@ -317,11 +331,12 @@ namespace jop
         WeakReference<const Mesh> m_mesh;                   ///< The bound mesh
         WeakReference<const Material> m_material;           ///< The bound material
         mutable WeakReference<ShaderProgram> m_shader;      ///< The bound shader (override)
-        std::unique_ptr<detail::CullerComponent> m_culler;  ///< Culler
+        uint32 m_cullingProxy;                              ///< Proxy in the renderer's culling tree
         Renderer& m_rendererRef;                            ///< Reference to the renderer
         const RenderPass::Pass m_pass;                      ///< The render pass type
         const uint32 m_weight;                              ///< Render pass weight
         uint32 m_flags;                                     ///< Property flags
+        uint32 m_stateVersion;                              ///< Render state version
         uint8 m_renderGroup;                                ///< The render group
     };
 }
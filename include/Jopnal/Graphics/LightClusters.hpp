@@ -0,0 +1,209 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+#ifndef JOP_LIGHTCLUSTERS_HPP
+#define JOP_LIGHTCLUSTERS_HPP
+
+// Headers
+#include <Jopnal/Header.hpp>
+#include <Jopnal/Graphics/UniformBuffer.hpp>
+#include <Jopnal/Graphics/Texture/Texture2D.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+#include <vector>
+
+//////////////////////////////////////////////
+
+
+namespace jop
+{
+    class LightSource;
+    class Camera;
+    class RenderTarget;
+
+    class JOP_API ClusterGrid
+    {
+    private:
+
+        /// Range of clusters touched by a light
+        ///
+        struct Range
+        {
+            glm::ivec3 min;     ///< First cluster
+            glm::ivec3 max;     ///< Last cluster
+            uint32 light;       ///< Index of the light
+        };
+
+    public:
+
+        /// \brief Constructor
+        ///
+        /// \param dimensions The amount of tiles on the x and y axes and the amount of depth slices.
+        ///                   Zero values are replaced with one
+        ///
+        explicit ClusterGrid(const glm::uvec3& dimensions);
+
+
+        /// \brief Bin light volumes into the clusters
+        ///
+        /// \param spheres Light bounding spheres in view space. The w component is the radius
+        /// \param projectionMatrix The projection matrix
+        /// \param nearPlane Distance to the near clipping plane
+        /// \param farPlane Distance to the far clipping plane
+        ///
+        void bin(const std::vector<glm::vec4>& spheres, const glm::mat4& projectionMatrix, const float nearPlane, const float farPlane);
+
+        /// \brief Get the grid dimensions
+        ///
+        /// \return The amount of tiles on the x and y axes and the amount of depth slices
+        ///
+        const glm::uvec3& getDimensions() const;
+
+        /// \brief Get the index of a cluster
+        ///
+        /// \param cluster The cluster coordinates
+        ///
+        /// \return The index
+        ///
+        uint32 getClusterIndex(const glm::uvec3& cluster) const;
+
+        /// \brief Get the depth slice parameters of the last binning
+        ///
+        /// \return Slice scale, bias and whether the slices are logarithmic
+        ///
+        const glm::vec4& getDepthParameters() const;
+
+        /// \brief Get the cells of the last binning
+        ///
+        /// \return The offset into the index list and the amount of lights of each cluster
+        ///
+        const std::vector<glm::uvec2>& getCells() const;
+
+        /// \brief Get the light index list of the last binning
+        ///
+        /// \return The light indices
+        ///
+        const std::vector<uint32>& getIndices() const;
+
+    private:
+
+        /// \brief Get the depth slice of a view space depth
+        ///
+        /// \param depth The depth, positive
+        ///
+        /// \return The slice, clamped to the grid
+        ///
+        int getSlice(const float depth) const;
+
+
+        glm::uvec3 m_dimensions;            ///< Grid dimensions
+        glm::vec4 m_depthParams;            ///< Slice scale, bias and whether the slices are logarithmic
+        std::vector<Range> m_ranges;        ///< Clusters touched by each light
+        std::vector<glm::uvec2> m_cells;    ///< Index list offset and light count of each cluster
+        std::vector<uint32> m_indices;      ///< Light index lists
+    };
+
+    class JOP_API LightClusters
+    {
+    private:
+
+        JOP_DISALLOW_COPY_MOVE(LightClusters);
+
+    public:
+
+        /// \brief Constructor
+        ///
+        /// The grid dimensions are read from the settings
+        /// "engine@Graphics|Shading|Clusters|uTilesX", "uTilesY" and "uSlices".
+        ///
+        LightClusters();
+
+        /// \brief Destructor
+        ///
+        ~LightClusters();
+
+
+        /// \brief Build and upload the clusters for a camera
+        ///
+        /// Directional lights are ignored, they're still passed to the drawables
+        /// through LightContainer.
+        ///
+        /// \param lights The lights
+        /// \param camera The camera
+        /// \param mainTarget The main render target, used when the camera has no render texture
+        ///
+        void build(const std::vector<const LightSource*>& lights, const Camera& camera, const RenderTarget& mainTarget);
+
+        /// \brief Bind the cluster textures and the uniform block
+        ///
+        void bind() const;
+
+        /// \brief Get the cluster grid
+        ///
+        /// \return Reference to the grid
+        ///
+        const ClusterGrid& getGrid() const;
+
+        /// \brief Check if clustered lighting is in use
+        ///
+        /// Clustered lighting is enabled with "engine@Graphics|Shading|Clusters|bEnabled".
+        /// It needs uniform blocks and two texture units after the shadow atlas.
+        ///
+        /// \return True if clustered lighting is in use
+        ///
+        static bool isEnabled();
+
+        /// \brief Get the first texture unit used by the cluster textures
+        ///
+        /// \return The texture unit
+        ///
+        static unsigned int getTextureUnit();
+
+    private:
+
+        ClusterGrid m_grid;                 ///< The CPU side cluster grid
+        std::vector<glm::vec4> m_spheres;   ///< Light volumes in view space
+        std::vector<glm::vec4> m_lightData; ///< Staging memory for the light texture
+        std::vector<glm::vec4> m_data;      ///< Staging memory for the cluster data texture
+        Texture2D m_lightTexture;           ///< Light data
+        Texture2D m_dataTexture;            ///< Cluster cells followed by the index lists
+        UniformBuffer m_block;              ///< The cluster uniform block
+    };
+}
+
+/// \class jop::LightClusters
+/// \ingroup graphics
+///
+/// Clustered forward lighting. The view frustum is split into a grid of
+/// screen space tiles and logarithmic depth slices. Point and spot lights are
+/// binned into the clusters on the CPU and the phong shaders only loop over
+/// the lights of the fragment's cluster, so the amount of lights isn't limited
+/// by uMaxPointLights or uMaxSpotLights.
+///
+/// Clustered lights don't cast shadows.
+
+/// \class jop::ClusterGrid
+/// \ingroup graphics
+///
+/// The CPU side of LightClusters. Bins light volumes into the grid and
+/// builds the per cluster light lists. Doesn't touch OpenGL.
+
+#endif
@@ -0,0 +1,177 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+#ifndef JOP_LIGHTINDEX_HPP
+#define JOP_LIGHTINDEX_HPP
+
+// Headers
+#include <Jopnal/Header.hpp>
+#include <glm/vec3.hpp>
+#include <unordered_map>
+#include <memory>
+#include <map>
+#include <set>
+#include <vector>
+
+//////////////////////////////////////////////
+
+
+namespace jop
+{
+    class LightSource;
+    class LightContainer;
+    class Drawable;
+
+    class JOP_API LightIndex
+    {
+    private:
+
+        JOP_DISALLOW_COPY_MOVE(LightIndex);
+
+        /// Light entry
+        ///
+        struct Entry
+        {
+            const LightSource* light;   ///< The light
+            glm::vec3 position;         ///< Global position, zero for directional lights
+            float range;                ///< Range of the light
+        };
+
+        /// Cached selection of a drawable
+        ///
+        struct Selection
+        {
+            glm::vec3 min;                  ///< Bounds minimum at the time of the selection
+            glm::vec3 max;                  ///< Bounds maximum at the time of the selection
+            uint32 version;                 ///< Index version at the time of the selection
+            const LightContainer* lights;   ///< The selected lights
+        };
+
+        /// Shared light container
+        ///
+        struct Slot
+        {
+            std::vector<const LightSource*> key;    ///< Lights of each type, separated by null pointers
+            std::unique_ptr<LightContainer> lights; ///< The container
+        };
+
+    public:
+
+        /// \brief Constructor
+        ///
+        LightIndex();
+
+        /// \brief Destructor
+        ///
+        ~LightIndex();
+
+
+        /// \brief Update the index
+        ///
+        /// Rebuilds the grid if any light was added, removed, moved or had
+        /// its range changed since the last update. Otherwise the previous
+        /// selections stay valid.
+        ///
+        /// \param lights The lights to index
+        ///
+        void update(const std::set<const LightSource*>& lights);
+
+        /// \brief Get the lights affecting a drawable
+        ///
+        /// Point and spot lights whose range doesn't reach the drawable's
+        /// bounds are ignored. Of the rest, the ones nearest to the drawable
+        /// are selected, up to LightSource::getMaximumLights() of each type.
+        /// Directional lights always apply.
+        ///
+        /// The selection is cached until either the drawable or the lights
+        /// move. Drawables ending up with the same lights share the returned
+        /// container.
+        ///
+        /// \param drawable The drawable
+        ///
+        /// \return Reference to the light container
+        ///
+        const LightContainer& getLights(const Drawable& drawable);
+
+        /// \brief Remove a drawable's cached selection
+        ///
+        /// \param drawable The drawable
+        ///
+        void forget(const Drawable& drawable);
+
+        /// \brief Get the index version
+        ///
+        /// The version is incremented every time the grid is rebuilt.
+        ///
+        /// \return The version
+        ///
+        uint32 getVersion() const;
+
+    private:
+
+        /// \brief Rebuild the grid from the current entries
+        ///
+        void rebuild();
+
+        /// \brief Select the lights for the given bounds
+        ///
+        /// \param min Bounds minimum
+        /// \param max Bounds maximum
+        ///
+        /// \return The selected lights
+        ///
+        const LightContainer& select(const glm::vec3& min, const glm::vec3& max);
+
+        /// \brief Fill a slot's container from its key
+        ///
+        /// \param slot The slot
+        ///
+        static void fill(Slot& slot);
+
+
+        std::vector<Entry> m_entries;                                           ///< Indexed lights
+        std::vector<Entry> m_scratch;                                           ///< Scratch entries used to detect changes
+        std::vector<uint32> m_directional;                                      ///< Directional lights, these are never stored in the grid
+        std::vector<uint32> m_unbounded;                                        ///< Lights too large to be stored in the grid
+        std::unordered_map<uint64, std::vector<uint32>> m_cells;                ///< The grid cells
+        std::vector<uint32> m_stamps;                                           ///< Last query each entry was visited by
+        std::vector<std::pair<float, uint32>> m_candidates;                     ///< Scratch candidate list
+        std::unordered_map<const Drawable*, Selection> m_selections;            ///< Cached selections
+        std::vector<Slot> m_slots;                                              ///< Light container pool
+        std::map<std::vector<const LightSource*>, std::size_t> m_slotIndices;   ///< Slot indices by key
+        std::vector<const LightSource*> m_key;                                  ///< Scratch key
+        std::size_t m_usedSlots;                                                ///< Amount of slots in use
+        float m_cellSize;                                                       ///< Cell size the grid was built with
+        uint32 m_query;                                                         ///< Current query stamp
+        uint32 m_version;                                                       ///< Index version
+    };
+}
+
+/// \class jop::LightIndex
+/// \ingroup graphics
+///
+/// A per-frame uniform grid over the bounding spheres of point and spot lights,
+/// used by SortedRenderPass to give each drawable its nearest lights instead of
+/// the first ones bound to the renderer.
+///
+/// The cell size is set with "engine@Graphics|Shading|Light|fGridCellSize".
+
+#endif
@@ -28,8 +28,11 @@
 #include <Jopnal/Graphics/Color.hpp>
 #include <Jopnal/Graphics/RenderPass.hpp>
 #include <Jopnal/Graphics/RenderTexture.hpp>
+#include <Jopnal/Graphics/ShadowAtlas.hpp>
 #include <Jopnal/Graphics/Texture/Cubemap.hpp>
+#include <Jopnal/Graphics/UniformBuffer.hpp>
 #include <glm/vec2.hpp>
+#include <glm/mat4x4.hpp>
 #include <vector>
 #include <array>
 #include <set>
@@ -82,6 +85,13 @@ namespace jop
             Quadratic
         };
 
+        /// Maximum amount of directional shadow cascades
+        ///
+        enum : unsigned int
+        {
+            MaxShadowCascades = 4
+        };
+
     public:
 
         /// \brief Constructor
@@ -119,12 +129,20 @@ namespace jop
         ///
         /// This can be an expensive function, do not call frequently.
         ///
+        /// The shadows are drawn into the renderer's shared ShadowAtlas. Every frame
+        /// the light gets a square tile for each cube face or cascade, sized by how
+        /// much of the screen the light volume covers. A tile is only rendered again
+        /// when the light, the tile or the transforms or meshes of the casters inside
+        /// its volume change. Drawables with the flag Drawable::StaticShadows are
+        /// additionally cached in a separate layer, which the dynamic casters are
+        /// drawn on top of. Point light shadows aren't supported on GLES 2.0.
+        ///
         /// \param castShadows True to cast shadows
-        /// \param resolution The shadow map resolution, glm::uvec2(0) to use the default
+        /// \param resolution The maximum tile resolution, zero to use the default
         ///
         /// \return Reference to self
         ///
-        LightSource& setCastShadows(const bool castShadows, const glm::uvec2& resolution = glm::uvec2(0));
+        LightSource& setCastShadows(const bool castShadows, const unsigned int resolution = 0);
 
         /// \brief Check if this light casts shadows
         ///
@@ -146,10 +164,72 @@ namespace jop
 
         /// \brief Get the shadow map
         ///
-        /// \return Const reference to the shadow map. nullptr if no shadow map exists
+        /// This is the shadow atlas shared by all the lights of the renderer.
+        ///
+        /// \return Pointer to the shadow map. nullptr if no tiles were allocated for this light
         ///
         const Texture* getShadowMap() const;
 
+        /// \brief Check if the light has a shadow map
+        ///
+        /// Tiles may run out when there are many shadow casting lights,
+        /// the least important ones are left without.
+        ///
+        /// \return True if tiles were allocated for this light during the last frame
+        ///
+        bool hasShadowMap() const;
+
+        /// \brief Get a shadow tile
+        ///
+        /// \param index The cube face or cascade index
+        ///
+        /// \return Texture coordinates of the bottom left corner (x, y) and the size (z, w)
+        ///
+        glm::vec4 getShadowTile(const unsigned int index) const;
+
+        /// \brief Get a light space matrix for sampling the shadow map
+        ///
+        /// The returned matrix maps into the tile of the cube face or cascade.
+        ///
+        /// \param index The cube face or cascade index
+        ///
+        /// \return The matrix
+        ///
+        glm::mat4 getShadowMatrix(const unsigned int index) const;
+
+        /// \brief Set the amount of shadow cascades
+        ///
+        /// This only affects directional lights. With a single cascade, the shadow
+        /// frustum is built from the object's scale. With more, the view frustum of
+        /// the first active camera sharing the render mask is split by distance and
+        /// each split gets its own light space matrix and shadow tile, fitted around it.
+        ///
+        /// The shadow distance and the split distribution are controlled by the settings
+        /// "engine@Graphics|Shading|fShadowCascadeDistance" and "fShadowCascadeSplitLambda".
+        ///
+        /// \param cascades The amount of cascades. Will be clamped to [1, MaxShadowCascades]
+        ///
+        /// \return Reference to self
+        ///
+        /// \comm setShadowCascades
+        ///
+        LightSource& setShadowCascades(const unsigned int cascades);
+
+        /// \brief Get the amount of shadow cascades
+        ///
+        /// \return The amount of shadow cascades
+        ///
+        unsigned int getShadowCascades() const;
+
+        /// \brief Get the far distances of the cascades
+        ///
+        /// The distances are in view space, along the viewing direction of the
+        /// camera the cascades were fitted to. Unused cascades are left at zero.
+        ///
+        /// \return The split distances
+        ///
+        const glm::vec4& getCascadeSplits() const;
+
         /// \brief Set a specific intensity value
         ///
         /// \param intensity The intensity type
@@ -290,6 +370,19 @@ namespace jop
         /// \param viewMats Reference to a vector with the matrices. This must have a size of at least 6
         ///
         static void makeCubemapMatrices(const glm::mat4& projection, const glm::vec3& position, std::vector<glm::mat4>& viewMats);
+
+        /// \brief Calculate the far distances of shadow cascades
+        ///
+        /// The distances blend between a logarithmic and a uniform split of the range.
+        ///
+        /// \param clipNear The near clipping distance of the camera
+        /// \param distance The distance the last cascade ends at
+        /// \param lambda The blend factor. 1 is fully logarithmic, 0 fully uniform
+        /// \param cascades The number of cascades, up to MaxShadowCascades
+        ///
+        /// \return The split distances. Unused cascades are left at zero
+        ///
+        static glm::vec4 makeCascadeSplits(const float clipNear, const float distance, const float lambda, const unsigned int cascades);
         
     protected:
 
@@ -301,8 +394,11 @@ namespace jop
 
         bool drawShadowMap() const;
 
+        void fitCascades() const;
+
+        unsigned int getShadowTileSize() const;
+
 
-        mutable RenderTexture m_shadowMap;                      ///< The shadow map
         mutable std::vector<glm::mat4> m_lightSpaceMatrices;    ///< Light space matrices. Used when rendering the shadow map
         const Type m_type;                                      ///< The light type
         std::array<Color, 3> m_intensities;                     ///< The intensities
@@ -310,6 +406,14 @@ namespace jop
         glm::vec2 m_cutoff;                                     ///< Spot light cutoff
         Renderer& m_rendererRef;                                ///< Reference to the renderer
         uint32 m_renderMask;                                    ///< The render mask
+        mutable RenderTexture m_staticShadowMap;                ///< Cached depth of the static casters
+        mutable uint64 m_shadowVersion;                         ///< Version of the casters the shadow map was rendered with
+        mutable uint64 m_staticShadowVersion;                   ///< Version of the static casters in the static layer
+        mutable glm::vec4 m_cascadeSplits;                      ///< Far distances of the shadow cascades
+        unsigned int m_cascades;                                ///< Amount of shadow cascades
+        mutable std::vector<ShadowAtlas::Tile> m_shadowTiles;   ///< Tiles allocated during this frame
+        unsigned int m_shadowResolution;                        ///< Maximum tile resolution, zero for default
+        bool m_castShadows;                                     ///< Cast shadows?
     };
 
     /// \brief Container for lights
@@ -340,6 +444,10 @@ namespace jop
 
         /// \brief Send the contained lights to shader
         ///
+        /// When uniform blocks are available, the light data is uploaded into
+        /// a uniform block once per view matrix. Only the drawable specific
+        /// values and the shadow maps are sent to the shader.
+        ///
         /// \param shader The shader to send the lights to
         /// \param drawable The drawable
         /// \param viewMatrix The current view matrix
@@ -360,7 +468,18 @@ namespace jop
 
     private:
 
+        /// \brief Upload the contained lights into the uniform block
+        ///
+        /// \param viewMatrix The current view matrix
+        ///
+        void updateBlock(const glm::mat4& viewMatrix) const;
+
+
         std::array<ContainerType, 3> m_container;   ///< Containers for each type of light
+        mutable std::vector<uint8> m_blockData;     ///< Staging memory for the uniform block
+        mutable UniformBuffer m_block;              ///< Uniform block with the light data
+        mutable glm::mat4 m_blockView;              ///< View matrix the block was last updated with
+        mutable bool m_blockValid;                  ///< Is the uniform block up to date?
     };
 }
 
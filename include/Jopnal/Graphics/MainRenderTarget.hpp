@@ -53,13 +53,51 @@ namespace jop
         ///
         void preUpdate(const float deltaTime) override;
 
+        /// \brief Set the resolution scale
+        ///
+        /// The size of this target is the size of the window multiplied by the
+        /// scale. When dynamic resolution is enabled, this is the highest scale
+        /// used.
+        ///
+        /// \param scale The resolution scale
+        ///
+        /// \comm setResolutionScale
+        ///
+        void setResolutionScale(const float scale);
+
+        /// \brief Get the current resolution scale
+        ///
+        /// With dynamic resolution, this can be less than the scale set with setResolutionScale().
+        ///
+        /// \return The resolution scale
+        ///
+        float getResolutionScale() const;
+
+    protected:
+
+        /// \copydoc Subsystem::receiveMessage()
+        ///
+        Message::Result receiveMessage(const Message& message) override;
+
     private:
 
+        void resize(const float scale);
+
+
         const Window& m_windowRef;  ///< Main window reference
+        float m_maxScale;           ///< The resolution scale set by the user
+        float m_scale;              ///< The current resolution scale
+        float m_frameTime;          ///< Smoothed frame time, in seconds
+        unsigned int m_cooldown;    ///< Frames to wait until the scale may change again
     };
 }
 
 /// \class jop::MainRenderTarget
 /// \ingroup graphics
+///
+/// When "engine@Graphics|MainRenderTarget|bDynamicResolution" is enabled, the
+/// resolution is lowered in steps while the frame time exceeds
+/// "fTargetFrameTime", down to "fMinResolutionScale", and raised again once
+/// there's room. The post processor scales the image back to the window size.
 
 #endif
\ No newline at end of file
@@ -25,6 +25,7 @@
 // Headers
 #include <Jopnal/Header.hpp>
 #include <Jopnal/Graphics/Color.hpp>
+#include <Jopnal/Graphics/UniformBuffer.hpp>
 #include <Jopnal/Core/Resource.hpp>
 #include <memory>
 #include <array>
@@ -186,10 +187,22 @@ namespace jop
 
         /// \brief Send this material to a shader
         ///
+        /// When uniform blocks are available, the reflection values are
+        /// uploaded into a uniform block only after they've been changed.
+        ///
         /// \param shader Reference to the shader to send this material to
         ///
         void sendToShader(ShaderProgram& shader) const;
 
+        /// \brief Reset the uniform cache
+        ///
+        /// When the same material is sent to the same shader multiple times
+        /// in a row, only the maps are bound after the first time. This needs
+        /// to be called when the uniform values may have been changed by
+        /// other means. Renderer does this at the start of every pass.
+        ///
+        static void resetUniformCache();
+
         /// \brief Set the lighting model
         ///
         /// \param model The lighting model to set
@@ -310,6 +323,15 @@ namespace jop
         ///
         uint64 getAttributes() const;
 
+        /// \brief Get the version
+        ///
+        /// The version changes whenever the shader or the translucency of
+        /// this material may have changed.
+        ///
+        /// \return The version
+        ///
+        uint32 getVersion() const;
+
         /// \brief Get the default material
         ///
         /// The default material has no attributes, meaning only the
@@ -330,7 +352,10 @@ namespace jop
         uint64 m_attributes;                            ///< The attribute bit field
         float m_reflectivity;                           ///< The reflectivity value
         float m_shininess;                              ///< The shininess factor
+        mutable UniformBuffer m_block;                  ///< Uniform block with the reflection values
+        uint32 m_version;                               ///< Version, see getVersion()
         mutable bool m_updateShader;                    ///< Does the shader need updating?
+        mutable bool m_updateBlock;                     ///< Does the uniform block need updating?
     };
 }
 
@@ -28,6 +28,8 @@
 #include <Jopnal/Graphics/VertexBuffer.hpp>
 #include <Jopnal/Graphics/Vertex.hpp>
 #include <Jopnal/Physics/Shape/BoxShape.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
 #include <vector>
 
 //////////////////////////////////////////////
@@ -71,6 +73,14 @@ namespace jop
             };
         };
 
+        /// Per-instance data used in instanced drawing
+        ///
+        struct InstanceData
+        {
+            glm::mat4 modelMatrix;  ///< Model matrix. Bound to VertexIndex::ModelMatrix
+            glm::vec4 color;        ///< Color. Bound to VertexIndex::Color
+        };
+
     public:
 
         /// \brief Constructor
@@ -91,6 +101,10 @@ namespace jop
         ///
         Mesh(const Mesh& other, const std::string& newName);
 
+        /// \brief Destructor
+        ///
+        ~Mesh() override;
+
 
         /// \brief Load mesh from memory
         ///
@@ -124,9 +138,25 @@ namespace jop
         /// Using this function requires that the shader state has been properly configured.
         /// This function will set up the vertex attributes pointers, buffer bindings and call
         /// glDrawElements or glDrawArrays depending on whether there are indices or not.
+        /// On OpenGL 3 & OpenGL ES 3 the vertex layout is stored in a vertex array object
+        /// owned by the mesh, so drawing only needs to bind it.
         ///
         void draw() const;
 
+        /// \brief Draw multiple instances of this mesh
+        ///
+        /// Works like draw(), but the model matrix and color attributes are
+        /// read per instance from the given buffer, which must be filled with
+        /// InstanceData. The color attribute is overridden, so meshes with vertex
+        /// colors should not be drawn this way.
+        ///
+        /// This must only be called when instancingSupported() returns true.
+        ///
+        /// \param instances Buffer holding the instance data
+        /// \param amount Amount of instances to draw
+        ///
+        void drawInstanced(const VertexBuffer& instances, const uint32 amount) const;
+
         /// \brief Destroy this mesh
         ///
         /// After this call, this mesh won't be valid and cannot be used in drawing.
@@ -134,6 +164,12 @@ namespace jop
         ///
         void destroy();
 
+        /// \brief Get the memory usage
+        ///
+        /// \return The allocated vertex and index buffer sizes
+        ///
+        MemoryUsage getMemoryUsage() const override;
+
         /// \brief Get the bounds of this mesh
         ///
         /// \return Bounds of this mesh
@@ -234,10 +270,43 @@ namespace jop
         ///
         static Mesh& getDefault();
 
+        /// \brief Check if instanced drawing is supported
+        ///
+        /// Instancing requires OpenGL 3.3 or OpenGL ES 3.0.
+        ///
+        /// \return True if supported
+        ///
+        static bool instancingSupported();
+
+    protected:
+
+        /// \brief Release the vertex and index buffers
+        ///
+        /// \return True if released
+        ///
+        bool releaseMemory() override;
+
     private:
 
+        /// \brief Specify the vertex attribute pointers in the default vertex array
+        ///
+        /// \return True if there's something to draw
+        ///
         bool updateVertexAttributes() const;
 
+        /// \brief Bind the vertex array object of this mesh
+        ///
+        /// The vertex array is created on first use and recreated
+        /// after the vertex layout has changed.
+        ///
+        /// \return True if there's something to draw
+        ///
+        bool bindVertexArray() const;
+
+        /// \brief Destroy the vertex array object of this mesh
+        ///
+        void destroyVertexArray() const;
+
 
         VertexBuffer m_vertexbuffer;                ///< The vertex buffer
         VertexBuffer m_indexbuffer;                 ///< The index buffer
@@ -246,6 +315,7 @@ namespace jop
         uint32 m_vertexComponents;                  ///< Vertex components this mesh has
         uint16 m_elementSize;                       ///< Element size
         uint16 m_vertexSize;                        ///< Vertex size
+        mutable unsigned int m_vertexArray;         ///< Vertex array object
     };
 }
 
@@ -33,18 +33,36 @@ namespace jop
     namespace detail
     {
         class WindowImpl;
+        class BufferSwapper;
     }
+    class ShaderProgram;
+    class Mesh;
+    class SpriteBatch;
+    class Window;
 
     class JOP_API GlState
     {
     private:
 
         friend class detail::WindowImpl;
+        friend class detail::BufferSwapper;
+        friend class ShaderProgram;
+        friend class Mesh;
+        friend class SpriteBatch;
+        friend class Window;
 
         /// Reset the cached values to defaults
         ///
         static void reset();
 
+        /// Make the calling thread the owner of the OpenGL context
+        ///
+        static void setContextThread();
+
+        /// Delete the objects queued with deferDelete()
+        ///
+        static void deleteDeferred();
+
     public:
 
         /// Depth functions
@@ -99,6 +117,29 @@ namespace jop
             Point
         };
 
+        /// Per-frame draw statistics
+        ///
+        struct Statistics
+        {
+            uint32 programSwitches; ///< Shader program switches
+            uint32 textureBinds;    ///< Texture binds
+            uint32 drawCalls;       ///< Draw calls
+        };
+
+        /// OpenGL object types, see deferDelete()
+        ///
+        enum class ObjectType
+        {
+            Buffer,
+            Texture,
+            Sampler,
+            VertexArray,
+            Program,
+            Shader,
+            Framebuffer,
+            Renderbuffer
+        };
+
     public:
     
         /// \brief Set the depth test
@@ -168,6 +209,88 @@ namespace jop
         ///
         static void setVertexAttribute(const bool enable, const unsigned int index);
 
+        /// \brief Bind a vertex array object
+        ///
+        /// The attribute functions in this class always operate on the default
+        /// vertex array, which is bound automatically when they're called.
+        ///
+        /// \param vertexArray The vertex array handle. Zero binds the default vertex array
+        ///
+        static void bindVertexArray(const unsigned int vertexArray);
+
+        /// \brief Set and bind the default vertex array
+        ///
+        /// \param vertexArray The vertex array handle
+        ///
+        static void setDefaultVertexArray(const unsigned int vertexArray);
+
+        /// \brief Forget a vertex array that's about to be deleted
+        ///
+        /// \param vertexArray The vertex array handle
+        ///
+        static void releaseVertexArray(const unsigned int vertexArray);
+
+        /// \brief Set the source of the current vertex attribute pointers
+        ///
+        /// Used to skip specifying the vertex attribute pointers again when
+        /// the same mesh is drawn multiple times in a row. Call this with
+        /// nullptr after specifying attribute pointers by other means.
+        ///
+        /// \param source The new source
+        ///
+        /// \return True if the source changed and the pointers need to be specified
+        ///
+        static bool setVertexAttributeSource(const void* source);
+
+        /// \brief Bind a texture to a texture unit
+        ///
+        /// The unit will be made active. If the texture is already bound
+        /// to the unit, the bind is skipped.
+        ///
+        /// \param unit The texture unit
+        /// \param target The texture target (OpenGL enum)
+        /// \param texture The texture handle
+        ///
+        static void bindTexture(const unsigned int unit, const unsigned int target, const unsigned int texture);
+
+        /// \brief Forget a texture that's about to be deleted
+        ///
+        /// \param texture The texture handle
+        ///
+        static void releaseTexture(const unsigned int texture);
+
+        /// \brief Bind a uniform buffer to an indexed binding point
+        ///
+        /// If the buffer is already bound to the binding point, the bind is skipped.
+        ///
+        /// \param index The binding point index
+        /// \param buffer The buffer handle
+        ///
+        static void bindUniformBuffer(const unsigned int index, const unsigned int buffer);
+
+        /// \brief Forget a uniform buffer that's about to be deleted
+        ///
+        /// \param buffer The buffer handle
+        ///
+        static void releaseUniformBuffer(const unsigned int buffer);
+
+        /// \brief Check if the calling thread owns the OpenGL context
+        ///
+        /// \return True if OpenGL may be called. Also true before the context is created
+        ///
+        static bool isContextThread();
+
+        /// \brief Delete an OpenGL object on the context thread
+        ///
+        /// Resources may be destroyed on any thread, but only the context thread
+        /// may call OpenGL. Objects queued with this are deleted at the end of the
+        /// frame, or when the window is closed. Thread safe.
+        ///
+        /// \param type The object type
+        /// \param handle The object handle
+        ///
+        static void deferDelete(const ObjectType type, const unsigned int handle);
+
         /// \brief Enable/disable depth buffer writing
         ///
         /// \param enable Enable depth writes?
@@ -177,6 +300,22 @@ namespace jop
         /// \brief Call glFlush
         ///
         static void flush();
+
+        /// \brief Get the draw statistics
+        ///
+        /// \return Statistics of the last finished frame
+        ///
+        static const Statistics& getStatistics();
+
+    private:
+
+        /// Get the statistics of the frame currently being drawn
+        ///
+        static Statistics& getFrameStatistics();
+
+        /// Finish the current frame and reset the frame statistics
+        ///
+        static void endFrame();
     };
 }
 
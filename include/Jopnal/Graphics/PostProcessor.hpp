@@ -27,10 +27,14 @@
 #include <Jopnal/Core/SubSystem.hpp>
 #include <Jopnal/Core/SettingManager.hpp>
 #include <Jopnal/Graphics/RenderTexture.hpp>
+#include <Jopnal/Graphics/RenderTargetPool.hpp>
 #include <Jopnal/Graphics/Texture/Texture2D.hpp>
 #include <Jopnal/Graphics/Mesh/RectangleMesh.hpp>
 #include <array>
+#include <map>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 //////////////////////////////////////////////
 
@@ -40,6 +44,120 @@ namespace jop
     class ShaderProgram;
     class Renderer;
     class RenderTarget;
+    class PostProcessor;
+
+    class JOP_API PostProcessPass
+    {
+    private:
+
+        JOP_DISALLOW_COPY_MOVE(PostProcessPass);
+
+        friend class PostProcessor;
+
+    public:
+
+        /// \brief Constructor
+        ///
+        /// \param processor Reference to the post processor
+        /// \param weight The weight of this pass
+        /// \param name Name of this pass, used in the statistics and the profiler
+        ///
+        PostProcessPass(PostProcessor& processor, const uint32 weight, const std::string& name);
+
+        /// \brief Virtual destructor
+        ///
+        virtual ~PostProcessPass() = 0;
+
+
+        /// \brief Set this pass active/inactive
+        ///
+        /// \param active True to set active
+        ///
+        void setActive(const bool active);
+
+        /// \brief Check if this pass is active
+        ///
+        /// \return True if active
+        ///
+        bool isActive() const;
+
+        /// \brief Get the name
+        ///
+        /// \return Reference to the name
+        ///
+        const std::string& getName() const;
+
+        /// \brief Get the weight
+        ///
+        /// \return The weight
+        ///
+        uint32 getWeight() const;
+
+    protected:
+
+        /// \brief Process the image
+        ///
+        /// The result must be drawn into a target acquired with PostProcessor::acquireTarget().
+        /// The post processor releases it once the next pass is done with it. Any other
+        /// targets acquired here should be released before returning.
+        ///
+        /// \param input The output of the previous pass, or the main render target
+        ///
+        /// \return The target holding the result. nullptr to pass the input on unchanged
+        ///
+        virtual const RenderTexture* process(const RenderTexture& input) = 0;
+
+
+        PostProcessor& m_processorRef;  ///< Reference to the post processor
+
+    private:
+
+        const std::string m_name;       ///< Name
+        const char* m_profileName;      ///< Name with static storage duration, for the profiler
+        const uint32 m_weight;          ///< Weight value
+        double m_time;                  ///< Time spent during the last frame, in milliseconds
+        bool m_active;                  ///< Is this pass active?
+    };
+
+    /// \brief Full-screen shader pass
+    ///
+    /// Draws the input using a shader into a target of the same format as the
+    /// main render target. The input is bound to the sampler "u_Texture". The
+    /// shader should be linked with PostProcessor::getVertexSource().
+    ///
+    class JOP_API PostProcessShaderPass : public PostProcessPass
+    {
+    public:
+
+        /// \brief Constructor
+        ///
+        /// \param processor Reference to the post processor
+        /// \param weight The weight of this pass
+        /// \param name Name of this pass
+        /// \param shader The shader to draw with
+        /// \param scale Size of the output relative to the input
+        ///
+        PostProcessShaderPass(PostProcessor& processor, const uint32 weight, const std::string& name, ShaderProgram& shader, const float scale = 1.f);
+
+    protected:
+
+        /// \copydoc PostProcessPass::process()
+        ///
+        const RenderTexture* process(const RenderTexture& input) override;
+
+        /// \brief Set additional uniforms
+        ///
+        /// Called before drawing. Does nothing by default.
+        ///
+        /// \param shader The shader
+        ///
+        virtual void setUniforms(ShaderProgram& shader);
+
+    private:
+
+        WeakReference<ShaderProgram> m_shader;  ///< The shader
+        const float m_scale;                    ///< Output size relative to the input
+    };
 
     class JOP_API PostProcessor final : public Subsystem
     {
@@ -62,6 +180,25 @@ namespace jop
             };
         };
 
+        /// Statistics of a single pass
+        ///
+        struct PassStatistics
+        {
+            std::string name;   ///< Name of the pass
+            uint32 weight;      ///< Weight of the pass
+            double time;        ///< Time spent during the last frame, in milliseconds
+        };
+
+        /// Post processor statistics
+        ///
+        struct Statistics
+        {
+            std::vector<PassStatistics> passes; ///< The user passes, in order
+            std::size_t targets;                ///< Amount of pooled render targets
+            std::size_t memory;                 ///< Video memory used by the pooled targets, in bytes
+            unsigned int creations;             ///< Amount of pooled render targets created so far
+        };
+
     public:
 
         /// \brief Constructor
@@ -75,19 +212,105 @@ namespace jop
         ~PostProcessor();
 
 
+        /// \brief Create a new pass
+        ///
+        /// The passes are run in order of their weight, before bloom and the
+        /// rest of the built-in functions. If a pass with the same weight already
+        /// exists, it will be replaced.
+        ///
+        /// \param weight The weight. Lesser weight means the pass is run earlier
+        /// \param args The arguments to pass to the pass' constructor, after the weight
+        ///
+        /// \return Reference to the newly created pass
+        ///
+        template<typename T, typename ... Args>
+        T& createPass(const uint32 weight, Args&&... args);
+
+        /// \brief Get a pass
+        ///
+        /// \param weight The weight
+        ///
+        /// \return Pointer to the pass. nullptr if no pass exists with the given weight
+        ///
+        template<typename T>
+        T* getPass(const uint32 weight);
+
+        /// \brief Remove and delete a pass
+        ///
+        /// \param weight The weight of the pass to remove
+        ///
+        void removePass(const uint32 weight);
+
+        /// \brief Acquire a temporary render target
+        ///
+        /// The targets are pooled and shared between the passes, see RenderTargetPool.
+        ///
+        /// \param size The size in pixels
+        /// \param format The color format
+        ///
+        /// \return Reference to the render target
+        ///
+        RenderTexture& acquireTarget(const glm::uvec2& size, const Texture::Format format);
+
+        /// \brief Release a temporary render target
+        ///
+        /// \param target The render target, previously returned by acquireTarget()
+        ///
+        void releaseTarget(const RenderTexture& target);
+
+        /// \brief Get the color format of the main render target
+        ///
+        /// \return The format
+        ///
+        Texture::Format getBufferFormat() const;
+
+        /// \brief Get the vertex shader source used by the passes
+        ///
+        /// Outputs the texture coordinates of a full-screen quad in vf_TexCoords.
+        ///
+        /// \return Reference to the source
+        ///
+        const std::string& getVertexSource() const;
+
+        /// \brief Draw a full-screen quad
+        ///
+        /// The shader and the target must be bound beforehand.
+        ///
+        void drawQuad() const;
+
+        /// \brief Get the statistics
+        ///
+        /// \return The statistics of the last frame
+        ///
+        Statistics getStatistics() const;
+
+        /// \brief Print the statistics using DebugHandler
+        ///
+        /// \comm printPostProcess
+        ///
+        void printStatistics() const;
+
         /// \brief Draw
         ///
-        /// This will draw a full-screen quad using the post-process settings.
+        /// This will run the passes and draw a full-screen quad using the post-process settings.
         ///
         void draw() override;
 
+    protected:
+
+        /// \copydoc Subsystem::receiveMessage()
+        ///
+        Message::Result receiveMessage(const Message& message) override;
+
     private:
 
+        ShaderProgram& getShader(const uint32 funcs);
+
         void getPreprocessorStr(const uint32 funcs, std::string& str) const;
 
-        void makeBloom();
+        const RenderTexture* makeBloom(const RenderTexture& input);
 
-        void enableBloom();
+        void blur(RenderTexture& target, const Texture::Format format, const unsigned int iterations);
 
 
         static PostProcessor* m_instance;                                   ///< The single instance
@@ -103,12 +326,23 @@ namespace jop
         DynamicSetting<float> m_bloomThreshold;                             ///< Full bloom threshold
         DynamicSetting<float> m_subBloomThresholdExp;                       ///< Sub-threshold bloom exponent
         Texture2D m_ditherMatrix;                                           ///< Dithering matrix texture
-        std::array<std::array<RenderTexture, 2>, 5> m_bloomTextures;        ///< Bloom frame buffers
+        RenderTargetPool m_targetPool;                                      ///< Intermediate render targets
+        std::map<uint32, std::unique_ptr<PostProcessPass>> m_passes;        ///< User passes
         WeakReference<ShaderProgram> m_brightShader;                        ///< Bright filter shader
     };
+
+    // Include template implementation file
+    #include <Jopnal/Graphics/Inl/PostProcessor.inl>
 }
 
 /// \class jop::PostProcessor
 /// \ingroup graphics
+///
+/// The post processor runs the user passes in order of their weight, each
+/// reading the output of the previous one. Bloom is then extracted at half
+/// resolution and blurred at successively halved resolutions, and everything
+/// is composited to the window with tone mapping, dithering and gamma correction.
+/// The intermediate buffers are taken from a RenderTargetPool, so buffers no longer
+/// needed by a pass are reused by the following ones.
 
-#endif
\ No newline at end of file
+#endif
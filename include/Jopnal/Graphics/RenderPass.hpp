@@ -25,6 +25,12 @@
 // Headers
 #include <Jopnal/Header.hpp>
 #include <Jopnal/Core/SubSystem.hpp>
+#include <Jopnal/Graphics/LightIndex.hpp>
+#include <Jopnal/Graphics/UniformBuffer.hpp>
+#include <Jopnal/Graphics/VertexBuffer.hpp>
+#include <Jopnal/Graphics/Mesh/Mesh.hpp>
+#include <unordered_map>
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -36,6 +42,11 @@ namespace jop
     class Renderer;
     class Drawable;
     class RenderTarget;
+    class LightContainer;
+    class LightClusters;
+    class LightSource;
+    class Camera;
+    class Material;
 
     class JOP_API RenderPass
     {
@@ -145,32 +156,101 @@ namespace jop
         virtual void unbind(const Drawable* drawable) = 0;
 
 
-        Renderer& m_rendererRef;        ///< Reference to the renderer
-        const RenderTarget& m_target;   ///< Reference to the render target
-        const uint32 m_weight;          ///< Weight value
-        const Pass m_pass;              ///< Render pass type
-        bool m_active;                  ///< Is this render pass active?
+        Renderer& m_rendererRef;            ///< Reference to the renderer
+        const RenderTarget& m_target;       ///< Reference to the render target
+        const uint32 m_weight;              ///< Weight value
+        const Pass m_pass;                  ///< Render pass type
+        bool m_active;                      ///< Is this render pass active?
+        const char* const m_profileName;    ///< Name of the GPU timing of this pass
     };
 
-    /// \brief Distance-sorted render pass
-    ///
-    /// Sorts opaque drawables from nearest to farthest and translucent
-    /// drawables the other way around.
+    /// \brief Sorted render pass
     ///
     /// Draws its drawables in three different sets:
     /// 1. Opaque objects
     /// 2. Sky boxes/spheres
     /// 3. Translucent objects
     ///
+    /// The drawables are placed into a persistent render queue, where each entry
+    /// has a 64-bit sort key. Opaque drawables are ordered by shader, material,
+    /// mesh and finally from nearest to farthest, in order to minimize state
+    /// changes. Translucent drawables are ordered from farthest to nearest.
+    /// The queue is radix sorted and its memory is reused between frames.
+    /// The render state part of each key is cached per drawable and only
+    /// recomputed when the drawable's or its material's version changes, see
+    /// Drawable::getStateVersion() and Material::getVersion().
+    /// Redundant program, texture and vertex attribute binds between
+    /// consecutive drawables are skipped, see GlState::getStatistics().
+    ///
+    /// Runs of opaque drawables sharing the same mesh and material are drawn
+    /// with a single instanced draw call, when supported. The minimum length
+    /// of such a run is set with the "engine@Graphics|uMinInstances" setting,
+    /// zero disables instancing.
+    ///
     /// By default Renderer creates one of these as a BeforePost pass, using
     /// RenderPass::DefaultWeight.
     ///
+    /// Consecutive sprites are drawn through the renderer's SpriteBatch, unless
+    /// Sprite::isBatched() says otherwise. In the opaque bucket sprites are ordered by texture, so that sprites sharing
+    /// a texture or a TextureAtlas end up in the same draw call.
+    ///
+    /// Each drawable receives the lights nearest to it, found using a
+    /// LightIndex. Drawables with different lights are never instanced
+    /// together.
+    ///
+    /// When clustered lighting is enabled (see LightClusters), the point
+    /// and spot lights are binned once per camera and the phong shaders
+    /// read them from the clusters instead.
+    ///
     struct JOP_API SortedRenderPass : RenderPass
     {
+        /// Render queue entry
+        ///
+        struct QueueItem
+        {
+            uint64 key;                     ///< The sort key
+            const Drawable* drawable;       ///< The drawable
+            const LightContainer* lights;   ///< Lights affecting the drawable
+        };
+
+        /// Render queue bucket. Stored in the highest bits of the sort key
+        ///
+        enum class Bucket : uint64
+        {
+            Opaque,     ///< Opaque drawables
+            Sky,        ///< Sky boxes & spheres
+            Translucent ///< Translucent drawables
+        };
+
+    public:
+
         /// \copydoc RenderPass::RenderPass()
         ///
         SortedRenderPass(Renderer& renderer, const RenderTarget& target, const Pass pass, const uint32 weight);
 
+        /// \brief Destructor
+        ///
+        ~SortedRenderPass() override;
+
+
+        /// \brief Get the sort key bucket
+        ///
+        /// \param key The sort key
+        ///
+        /// \return The bucket
+        ///
+        static Bucket getBucket(const uint64 key);
+
+        /// \brief Sort a render queue by the entries' keys
+        ///
+        /// This is a stable LSD radix sort. Byte positions that are equal
+        /// for every key are skipped.
+        ///
+        /// \param queue The queue to sort
+        /// \param buffer Scratch buffer. Will be resized to match the queue
+        ///
+        static void sortQueue(std::vector<QueueItem>& queue, std::vector<QueueItem>& buffer);
+
     protected:
 
         /// \copydoc RenderPass::draw()
@@ -187,12 +267,80 @@ namespace jop
 
     private:
 
-        std::set<const Drawable*> m_drawables; ///< Drawable set
+        /// Cached sort key state of a bound drawable
+        ///
+        struct DrawableState
+        {
+            const Drawable* drawable;   ///< The drawable
+            const Material* material;   ///< The material the state was computed with
+            uint64 state;               ///< Program, material & mesh bits of the sort key
+            uint32 version;             ///< Drawable state version the state was computed with
+            uint32 materialVersion;     ///< Material version the state was computed with
+            Bucket bucket;              ///< The bucket
+        };
+
+        /// \brief Recompute the cached state of a drawable if it's out of date
+        ///
+        /// \param entry The cached state
+        ///
+        static void updateState(DrawableState& entry);
+
+        /// \brief Build the render queue for a camera
+        ///
+        /// \param camera The camera
+        ///
+        void buildQueue(const Camera& camera);
+
+        /// \brief Get the length of an instanceable run in the render queue
+        ///
+        /// \param first Index of the first item in the run
+        ///
+        /// \return Amount of items that can be drawn in a single instanced call
+        ///
+        std::size_t getInstanceRun(const std::size_t first) const;
+
+        /// \brief Get the length of a run of sprites in the render queue
+        ///
+        /// \param first Index of the first item in the run
+        ///
+        /// \return Amount of consecutive sprites in the same bucket
+        ///
+        std::size_t getSpriteRun(const std::size_t first) const;
+
+        /// \brief Draw a run of sprites through the renderer's sprite batch
+        ///
+        /// \param first Index of the first item in the run
+        /// \param amount Amount of items in the run
+        /// \param projView The projection matrix multiplied by the view matrix
+        ///
+        void drawSprites(const std::size_t first, const std::size_t amount, const glm::mat4& projView);
+
+        /// \brief Draw a run of drawables using instancing
+        ///
+        /// \param first Index of the first item in the run
+        /// \param amount Amount of items in the run
+        /// \param camera The camera
+        /// \param lights The light container
+        ///
+        void drawInstanced(const std::size_t first, const std::size_t amount, const Camera& camera, const LightContainer& lights);
+
+
+        std::vector<DrawableState> m_drawables;                         ///< Bound drawables with their cached states
+        std::unordered_map<const Drawable*, std::size_t> m_indices;     ///< Indices into the drawable vector
+        std::vector<QueueItem> m_queue;                                 ///< The render queue
+        std::vector<QueueItem> m_sortBuffer;                            ///< Scratch buffer used when sorting
+        LightIndex m_lightIndex;                                        ///< Selects the lights passed to the drawables
+        std::unique_ptr<LightClusters> m_clusters;                      ///< Light clusters, null unless clustered lighting is enabled
+        std::vector<const LightSource*> m_clusterLights;                ///< Lights binned into the clusters
+        std::vector<Mesh::InstanceData> m_instanceData;                 ///< Instance data of the current run
+        VertexBuffer m_instanceBuffer;                                  ///< Streamed instance buffer
+        UniformBuffer m_cameraBlock;                                    ///< Camera uniform block used by the instanced runs
     };
 
     /// \brief Orderer render pass
     ///
-    /// Maintains the order in which drawables are added.
+    /// Maintains the order in which drawables are added. Consecutive sprites
+    /// are drawn through the renderer's SpriteBatch, see Sprite::isBatched().
     ///
     /// \note This pass by default doesn't do depth testing or writing
     /// \note Lighting is disabled for all drawables bound to this kind of pass
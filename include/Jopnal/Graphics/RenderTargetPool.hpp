@@ -0,0 +1,137 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+#ifndef JOP_RENDERTARGETPOOL_HPP
+#define JOP_RENDERTARGETPOOL_HPP
+
+// Headers
+#include <Jopnal/Header.hpp>
+#include <Jopnal/Graphics/RenderTexture.hpp>
+#include <glm/vec2.hpp>
+#include <memory>
+#include <vector>
+
+//////////////////////////////////////////////
+
+
+namespace jop
+{
+    class JOP_API RenderTargetPool
+    {
+    private:
+
+        JOP_DISALLOW_COPY_MOVE(RenderTargetPool);
+
+    public:
+
+        /// \brief Constructor
+        ///
+        RenderTargetPool();
+
+        /// \brief Destructor
+        ///
+        ~RenderTargetPool();
+
+
+        /// \brief Acquire a render target
+        ///
+        /// A released target with the same size and format is reused if one
+        /// exists, otherwise a new one is created. The target has a single color
+        /// attachment, which is filtered bilinearly and clamped to the edges.
+        /// The contents are undefined.
+        ///
+        /// \param size The size in pixels
+        /// \param format The color format
+        ///
+        /// \return Reference to the render target
+        ///
+        RenderTexture& acquire(const glm::uvec2& size, const Texture::Format format);
+
+        /// \brief Release a render target
+        ///
+        /// After this the target may be handed out by acquire() again, so its
+        /// contents must not be relied on. Releasing targets as soon as they're
+        /// no longer read from lets the following passes share the memory.
+        ///
+        /// \param target The render target, previously returned by acquire()
+        ///
+        void release(const RenderTexture& target);
+
+        /// \brief Finish a frame
+        ///
+        /// Released targets that haven't been acquired during the given amount
+        /// of frames are destroyed.
+        ///
+        /// \param maxIdleFrames The amount of frames to keep unused targets for
+        ///
+        void endFrame(const unsigned int maxIdleFrames);
+
+        /// \brief Destroy all the render targets
+        ///
+        /// None of the targets may be in use.
+        ///
+        void clear();
+
+        /// \brief Get the amount of render targets
+        ///
+        /// \return The amount of render targets, including the ones not in use
+        ///
+        std::size_t getTargetCount() const;
+
+        /// \brief Get the video memory used by the render targets
+        ///
+        /// \return The estimated memory usage in bytes
+        ///
+        std::size_t getMemoryUsage() const;
+
+        /// \brief Get the amount of render targets created
+        ///
+        /// Acquiring a target that could be reused doesn't count as a creation.
+        ///
+        /// \return The amount of render targets created since construction
+        ///
+        unsigned int getCreationCount() const;
+
+    private:
+
+        /// Pooled render target
+        ///
+        struct Entry
+        {
+            std::unique_ptr<RenderTexture> target;  ///< The render target
+            Texture::Format format;                 ///< Color format
+            unsigned int idleFrames;                ///< Frames since last acquired
+            bool inUse;                             ///< Is the target in use?
+        };
+
+        std::vector<Entry> m_entries;   ///< The pooled targets
+        std::size_t m_memory;           ///< Memory usage in bytes
+        unsigned int m_creations;       ///< Amount of targets created
+    };
+}
+
+/// \class jop::RenderTargetPool
+/// \ingroup graphics
+///
+/// Pool of temporary color render targets, used to share the intermediate
+/// buffers of the post processor between passes and frames.
+
+#endif
@@ -26,10 +26,14 @@
 #include <Jopnal/Header.hpp>
 #include <Jopnal/Core/Object.hpp>
 #include <Jopnal/Graphics/RenderPass.hpp>
+#include <Jopnal/Graphics/ShadowAtlas.hpp>
+#include <Jopnal/Graphics/SpriteBatch.hpp>
 #include <Jopnal/Physics/World.hpp>
 #include <Jopnal/STL.hpp>
 #include <map>
+#include <set>
 #include <array>
+#include <vector>
 
 //////////////////////////////////////////////
 
@@ -42,6 +46,11 @@ namespace jop
     class LightContainer;
     class RenderTarget;
 
+    namespace detail
+    {
+        class CullingTree;
+    }
+
     class JOP_API Renderer final
     {
     private:
@@ -65,6 +74,10 @@ namespace jop
         ///
         Renderer(const RenderTarget& mainTarget, Scene& sceneRef);
 
+        /// \brief Destructor
+        ///
+        ~Renderer();
+
 
         /// \brief Get the bound render target
         ///
@@ -122,12 +135,48 @@ namespace jop
         ///
         void draw(const RenderPass::Pass pass);
 
-        /// \brief Get the culling world
+        /// \brief Find the drawables inside a frustum
+        ///
+        /// Uses the culling tree when culling is enabled. Otherwise every bound
+        /// drawable's global bounds are tested.
+        ///
+        /// \param pvMatrix The projection-view matrix defining the frustum
+        /// \param renderMask Render groups to include
+        /// \param drawables Vector to fill with the drawables. Cleared first
+        ///
+        void queryDrawables(const glm::mat4& pvMatrix, const uint32 renderMask, std::vector<const Drawable*>& drawables) const;
+
+        /// \brief Get the number of shadow maps rendered during the last frame
+        ///
+        /// Shadow maps whose casters haven't changed aren't rendered again.
+        ///
+        /// \return Number of shadow maps rendered
+        ///
+        uint32 getShadowMapUpdates() const;
+
+        /// \brief Get the shadow atlas
+        ///
+        /// The atlas is created when a light first casts shadows.
+        ///
+        /// \return Reference to the shadow atlas
+        ///
+        const ShadowAtlas& getShadowAtlas() const;
+
+        /// \brief Get the sprite batch
+        ///
+        /// Used by the render passes and sprites to draw. The batch is only a
+        /// drawing helper, so it's available through a const renderer as well.
+        ///
+        /// \return Reference to the sprite batch
         ///
-        World& getCullingWorld();
+        SpriteBatch& getSpriteBatch() const;
 
     private:
 
+        void allocateShadowTiles();
+
+        detail::CullingTree& getCullingTree();
+
         void bind(const LightSource* light);
 
         void bind(const Camera* camera);
@@ -150,6 +199,11 @@ namespace jop
         CameraSet m_cameras;                                    ///< The bound cameras
         PassContainer m_passes;                                 ///< Render passes
         std::set<const EnvironmentRecorder*> m_envRecorders;    ///< The bound environment recorders
+        std::multiset<const Drawable*> m_drawables;             ///< The bound drawables, once per render pass
+        uint32 m_shadowMapUpdates;                              ///< Shadow maps rendered during the last frame
+        ShadowAtlas m_shadowAtlas;                              ///< Shadow maps of all the lights
+        mutable SpriteBatch m_spriteBatch;                      ///< Sprite batch
+        std::unique_ptr<detail::CullingTree> m_cullingTree;     ///< Culling tree, only created if culling is enabled
         const RenderTarget& m_target;                           ///< Main render target reference
         Scene& m_sceneRef;
     };
@@ -109,6 +109,8 @@ namespace jop
 
         /// \brief Get the extension definition string
         ///
+        /// Also defines JOP_UNIFORM_BLOCKS when uniform blocks are in use.
+        ///
         /// \return The extension string
         ///
         static const std::string& getExtensionString();
@@ -29,6 +29,8 @@
 #include <glm/vec4.hpp>
 #include <glm/mat4x4.hpp>
 #include <unordered_map>
+#include <array>
+#include <vector>
 
 //////////////////////////////////////////////
 
@@ -43,6 +45,40 @@ namespace jop
 
         typedef std::unordered_map<std::string, int> LocationMap; ///< Map containing uniform locations
 
+    public:
+
+        /// Engine uniforms
+        ///
+        /// The handles of these uniforms are resolved when the program is linked.
+        ///
+        struct Uniform
+        {
+            enum : uint32
+            {
+                PVMMatrix,              ///< u_PVMMatrix
+                VMMatrix,               ///< u_VMMatrix
+                NMatrix,                ///< u_NMatrix
+                PVMatrix,               ///< u_PVMatrix
+                VMatrix,                ///< u_VMatrix
+                DiffuseMap,             ///< u_DiffuseMap
+                ReceiveLights,          ///< u_ReceiveLights
+                ReceiveShadows,         ///< u_ReceiveShadows
+                NumPointLights,         ///< u_NumPointLights
+                NumSpotLights,          ///< u_NumSpotLights
+                NumDirectionalLights,   ///< u_NumDirectionalLights
+                ShadowAtlas,            ///< u_ShadowAtlas
+
+                __Last                  ///< For internal functionality, do not use
+            };
+        };
+
+        /// A table of uniform names
+        ///
+        /// Tables are identified by their address, so they should have
+        /// static storage duration.
+        ///
+        typedef std::vector<std::string> UniformTable;
+
     public:
 
         /// \brief Constructor
@@ -116,6 +152,40 @@ namespace jop
         ///
         bool isValid() const;
 
+        /// \brief Get a uniform handle by name
+        ///
+        /// The handle is looked up only once, after which it's cached until
+        /// the program is linked again. Uniforms that don't exist will get
+        /// a handle of -1, which is silently ignored by setUniform().
+        ///
+        /// \param name The uniform name
+        ///
+        /// \return The uniform handle
+        ///
+        int getUniformHandle(const std::string& name);
+
+        /// \brief Get the handle of an engine uniform
+        ///
+        /// This is a simple array lookup.
+        ///
+        /// \param uniform The engine uniform. One of Uniform
+        ///
+        /// \return The uniform handle
+        ///
+        int getUniformHandle(const uint32 uniform) const;
+
+        /// \brief Get the handles of a uniform table
+        ///
+        /// The handles are resolved the first time the table is used with
+        /// this program. After that the table is found with a short linear
+        /// search, no strings are hashed or compared.
+        ///
+        /// \param table The uniform table
+        ///
+        /// \return Pointer to the handles, in the same order as the names in the table
+        ///
+        const int* getUniformHandles(const UniformTable& table);
+
         /// \brief Set a mat4 uniform
         ///
         /// \param name Uniform name
@@ -210,6 +280,88 @@ namespace jop
         ///
         bool setUniform(const std::string& name, const bool value);
 
+        /// \brief Set a mat4 uniform using a handle
+        ///
+        /// \param handle The uniform handle
+        /// \param matrix A 4x4 matrix
+        ///
+        /// \return True if set successfully
+        ///
+        bool setUniform(const int handle, const glm::mat4& matrix);
+
+        /// \brief Set a mat3 uniform using a handle
+        ///
+        /// \param handle The uniform handle
+        /// \param matrix A 3x3 matrix
+        ///
+        /// \return True if set successfully
+        ///
+        bool setUniform(const int handle, const glm::mat3& matrix);
+
+        /// \brief Set a vec2 uniform using a handle
+        ///
+        /// \param handle The uniform handle
+        /// \param vector A 2-dimensional vector
+        ///
+        /// \return True if set successfully
+        ///
+        bool setUniform(const int handle, const glm::vec2& vector);
+
+        /// \brief Set a vec3 uniform using a handle
+        ///
+        /// \param handle The uniform handle
+        /// \param vector A 3-dimensional vector
+        ///
+        /// \return True if set successfully
+        ///
+        bool setUniform(const int handle, const glm::vec3& vector);
+
+        /// \brief Set a vec4 uniform using a handle
+        ///
+        /// \param handle The uniform handle
+        /// \param vector A 4-dimensional vector
+        ///
+        /// \return True if set successfully
+        ///
+        bool setUniform(const int handle, const glm::vec4& vector);
+
+        /// \brief Set a texture uniform using a handle
+        ///
+        /// \param handle The uniform handle
+        /// \param texture A texture
+        /// \param unit The texture unit
+        ///
+        /// \return True if set successfully
+        ///
+        bool setUniform(const int handle, const Texture& texture, const unsigned int unit);
+
+        /// \brief Set a float uniform using a handle
+        ///
+        /// \param handle The uniform handle
+        /// \param value The float value
+        ///
+        /// \return True if set successfully
+        ///
+        bool setUniform(const int handle, const float value);
+
+        /// \brief Set an integer uniform using a handle
+        ///
+        /// \param handle The uniform handle
+        /// \param value The integer to set
+        ///
+        /// \return True if set successfully
+        ///
+        bool setUniform(const int handle, const int value);
+
+        /// \brief Set a boolean uniform using a handle
+        ///
+        /// \param handle The uniform handle
+        /// \param value The boolean to set
+        ///
+        /// \return True if set successfully
+        ///
+        bool setUniform(const int handle, const bool value);
+
         /// \brief Get the default shader program
         ///
         /// \return Reference to the default shader
@@ -237,8 +389,17 @@ namespace jop
         int getUniformLocation(const std::string& name);
 
 
+        /// \brief Resolve the engine uniform handles
+        ///
+        /// Also assigns the engine uniform blocks to their fixed binding points.
+        ///
+        void resolveEngineUniforms();
+
+
         std::unordered_map<unsigned int, WeakReference<const Shader>> m_shaders;    ///< Map with shaders
         LocationMap m_unifMap;                                                      ///< Map with uniform locations
+        std::array<int, Uniform::__Last> m_engineUnifs;                             ///< Engine uniform handles
+        std::vector<std::pair<const UniformTable*, std::vector<int>>> m_unifTables; ///< Resolved uniform tables
         unsigned int m_programID;                                                   ///< OpenGL program handle
     };
 
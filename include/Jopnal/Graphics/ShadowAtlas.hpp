@@ -0,0 +1,216 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+#ifndef JOP_SHADOWATLAS_HPP
+#define JOP_SHADOWATLAS_HPP
+
+// Headers
+#include <Jopnal/Header.hpp>
+#include <Jopnal/Graphics/RenderTexture.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+#include <vector>
+
+//////////////////////////////////////////////
+
+
+namespace jop
+{
+    class Texture;
+
+    class JOP_API ShadowAtlas
+    {
+    private:
+
+        JOP_DISALLOW_COPY_MOVE(ShadowAtlas);
+
+    public:
+
+        /// A square region of the atlas
+        ///
+        struct Tile
+        {
+            /// \brief Default constructor
+            ///
+            /// Constructs an invalid tile.
+            ///
+            Tile();
+
+            /// \brief Check if this tile was allocated
+            ///
+            /// \return True if valid
+            ///
+            bool isValid() const;
+
+            glm::uvec2 position;    ///< Position in pixels
+            unsigned int size;      ///< Width and height in pixels. Zero if invalid
+        };
+
+    public:
+
+        /// \brief Constructor
+        ///
+        /// Doesn't create the texture, see create().
+        ///
+        ShadowAtlas();
+
+
+        /// \brief Create the atlas texture
+        ///
+        /// The size is read from the setting "engine@Graphics|Shading|uShadowAtlasSize"
+        /// and rounded down to a power of two. When depth textures aren't available,
+        /// the depth is packed into a color texture. Does nothing if already created.
+        ///
+        /// \return True if successful
+        ///
+        bool create();
+
+        /// \brief Destroy the atlas texture
+        ///
+        void destroy();
+
+        /// \brief Check if the texture has been created
+        ///
+        /// \return True if created
+        ///
+        bool isValid() const;
+
+        /// \brief Free all tiles
+        ///
+        /// The contents of the texture are left as is.
+        ///
+        void reset();
+
+        /// \brief Free all tiles and set the size the tiles are allocated from
+        ///
+        /// create() calls this with the texture size and getMinimumTileSize(). The
+        /// texture isn't touched, so the tiles can be laid out without an OpenGL context.
+        ///
+        /// \param size The size in pixels, a power of two
+        /// \param minTileSize The smallest tile size in pixels, a power of two
+        ///
+        void reset(const unsigned int size, const unsigned int minTileSize);
+
+        /// \brief Allocate a tile
+        ///
+        /// The size is rounded up to a power of two and clamped between the
+        /// minimum tile size and the atlas size. Tiles are packed as a quad tree,
+        /// so allocating the largest tiles first leaves no gaps.
+        ///
+        /// \param size The wanted size in pixels
+        ///
+        /// \return The tile. Invalid if there was no space left
+        ///
+        Tile allocate(const unsigned int size);
+
+        /// \brief Free a tile
+        ///
+        /// Merges the tile back with its free siblings, so the space can be
+        /// allocated again as a bigger tile.
+        ///
+        /// \param tile The tile, allocated with allocate(). Does nothing if invalid
+        ///
+        void release(const Tile& tile);
+
+        /// \brief Get a tile as a normalized rectangle
+        ///
+        /// \param tile The tile
+        ///
+        /// \return Texture coordinates of the bottom left corner (x, y) and the size (z, w)
+        ///
+        glm::vec4 getRect(const Tile& tile) const;
+
+        /// \brief Bind the atlas for drawing
+        ///
+        /// \return True if successful
+        ///
+        bool bind() const;
+
+        /// \brief Restrict drawing to a tile
+        ///
+        /// The atlas must be bound. Sets the viewport and the scissor box.
+        ///
+        /// \param tile The tile
+        /// \param clear Clear the tile?
+        ///
+        void setTile(const Tile& tile, const bool clear) const;
+
+        /// \brief Get the atlas texture
+        ///
+        /// \return Pointer to the texture. nullptr if not created
+        ///
+        const Texture* getTexture() const;
+
+        /// \brief Get the render texture
+        ///
+        /// \return Reference to the render texture
+        ///
+        const RenderTexture& getRenderTexture() const;
+
+        /// \brief Get the size
+        ///
+        /// \return The width and height in pixels. Zero if neither created nor reset with a size
+        ///
+        unsigned int getSize() const;
+
+        /// \brief Check if the depth is packed into a color texture
+        ///
+        /// \return True if packed
+        ///
+        bool isPacked() const;
+
+        /// \brief Get the generation
+        ///
+        /// The generation changes every time the texture is created, which
+        /// invalidates the contents of all tiles.
+        ///
+        /// \return The generation
+        ///
+        uint32 getGeneration() const;
+
+        /// \brief Get the minimum tile size
+        ///
+        /// Read from the setting "engine@Graphics|Shading|uShadowAtlasMinTileSize".
+        ///
+        /// \return The minimum tile size in pixels
+        ///
+        static unsigned int getMinimumTileSize();
+
+    private:
+
+        RenderTexture m_target;                         ///< The atlas
+        std::vector<std::vector<glm::uvec2>> m_free;    ///< Free nodes of each quad tree level
+        unsigned int m_size;                            ///< Size of the quad tree
+        uint32 m_generation;                            ///< Texture generation
+        bool m_packed;                                  ///< Is depth packed into color?
+    };
+}
+
+/// \class jop::ShadowAtlas
+/// \ingroup graphics
+///
+/// A single depth texture shared by the shadow casting lights of a renderer.
+/// Each light gets square tiles sized by its importance on screen, one per
+/// cube face, cascade or spot light, and the whole atlas is drawn with a
+/// single framebuffer. The shaders sample it with the tile rectangles, so
+/// shadows only take one texture unit.
+
+#endif
@@ -26,7 +26,7 @@
 #include <Jopnal/Header.hpp>
 #include <Jopnal/Graphics/Drawable.hpp>
 #include <Jopnal/Graphics/Material.hpp>
-#include <Jopnal/Graphics/Mesh/RectangleMesh.hpp>
+#include <typeinfo>
 
 //////////////////////////////////////////////
 
@@ -34,6 +34,7 @@
 namespace jop
 {
     class Texture2D;
+    class TextureAtlas;
 
     class JOP_API Sprite : public Drawable
     {
@@ -54,6 +55,9 @@ namespace jop
 
         /// \copydoc Drawable::draw()
         ///
+        /// The render passes draw consecutive sprites through the renderer's
+        /// SpriteBatch instead of calling this, see isBatched().
+        ///
         virtual void draw(const ProjectionInfo& proj, const LightContainer& lights) const override;
 
         /// \brief Set the texture
@@ -65,6 +69,18 @@ namespace jop
         ///
         Sprite& setTexture(const Texture2D& texture, const bool updateSize);
 
+        /// \brief Set the texture from an atlas
+        ///
+        /// Sprites sharing the atlas texture can be drawn in a single batch.
+        ///
+        /// \param atlas The texture atlas
+        /// \param index Index of the texture in the atlas
+        /// \param updateSize Update the size from the texture region?
+        ///
+        /// \return Reference to self
+        ///
+        Sprite& setTexture(const TextureAtlas& atlas, const unsigned int index, const bool updateSize);
+
         /// \brief Get the texture
         ///
         /// \return Reference to the texture
@@ -100,15 +116,40 @@ namespace jop
         ///
         const std::pair<glm::vec2, glm::vec2>& getTextureCoordinates() const;
 
+        /// \brief Check if this sprite is drawn through a SpriteBatch
+        ///
+        /// The batch builds the quad without calling draw(), so a class deriving
+        /// from Sprite is only batched after calling enableBatching() for its own
+        /// type. Other sprites are drawn one by one with draw().
+        ///
+        /// \return True if batched
+        ///
+        bool isBatched() const;
+
+    protected:
+
+        /// \brief Allow batching a class deriving from Sprite
+        ///
+        /// Call this from the constructor of a class that doesn't override draw().
+        /// Classes deriving from it need to call this again with their own type.
+        ///
+        /// \param type The exact type of the class, as returned by typeid
+        ///
+        void enableBatching(const std::type_info& type);
+
     private:
 
         mutable WeakReference<const Texture2D> m_texture;   ///< Texture
-        RectangleMesh m_mesh;                               ///< Mesh
+        glm::vec2 m_size;                                   ///< Size
         std::pair<glm::vec2, glm::vec2> m_texCoords;        ///< Texture coordinates
+        const std::type_info* m_batchType;                  ///< Exact type allowed to be batched
     };
 }
 
 /// \class jop::Sprite
 /// \ingroup graphics
+///
+/// Sprites don't own a mesh. The quad is built from the size and the texture
+/// coordinates when drawn, see SpriteBatch.
 
 #endif
\ No newline at end of file
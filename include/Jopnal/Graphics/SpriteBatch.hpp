@@ -0,0 +1,131 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+#ifndef JOP_SPRITEBATCH_HPP
+#define JOP_SPRITEBATCH_HPP
+
+// Headers
+#include <Jopnal/Header.hpp>
+#include <Jopnal/Graphics/VertexBuffer.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <vector>
+
+//////////////////////////////////////////////
+
+
+namespace jop
+{
+    class Sprite;
+    class Texture2D;
+    class ShaderProgram;
+
+    class JOP_API SpriteBatch
+    {
+    private:
+
+        JOP_DISALLOW_COPY_MOVE(SpriteBatch);
+
+    public:
+
+        /// Batch vertex
+        ///
+        struct Vertex
+        {
+            glm::vec3 position;     ///< World space position
+            glm::vec2 texCoords;    ///< Texture coordinates
+            glm::vec4 color;        ///< Color
+        };
+
+    public:
+
+        /// \brief Constructor
+        ///
+        /// The buffers are created on first use.
+        ///
+        SpriteBatch();
+
+        /// \brief Destructor
+        ///
+        ~SpriteBatch();
+
+
+        /// \brief Begin a batch
+        ///
+        /// Sprites still pending from a previous batch are drawn first.
+        ///
+        /// \param projView The projection matrix multiplied by the view matrix
+        ///
+        void begin(const glm::mat4& projView);
+
+        /// \brief Add a sprite
+        ///
+        /// The corners are transformed into world space and written into the
+        /// batch. If the sprite uses a different texture or shader than the
+        /// pending ones, or the batch is full, the pending sprites are drawn first.
+        ///
+        /// \param sprite The sprite
+        ///
+        void add(const Sprite& sprite);
+
+        /// \brief Draw the pending sprites
+        ///
+        /// All the pending sprites are drawn with a single draw call.
+        ///
+        void flush();
+
+        /// \brief Get the amount of sprites pending
+        ///
+        /// \return The amount of sprites added since the last flush
+        ///
+        unsigned int getPendingSprites() const;
+
+        /// \brief Get the maximum amount of sprites drawn in a single call
+        ///
+        /// Limited by the 16-bit indices.
+        ///
+        /// \return The maximum amount of sprites
+        ///
+        static unsigned int getMaxSprites();
+
+    private:
+
+        std::vector<Vertex> m_vertices;     ///< Vertices of the pending sprites
+        VertexBuffer m_vertexBuffer;        ///< Streamed vertex buffer
+        VertexBuffer m_indexBuffer;         ///< Index buffer, shared by all batches
+        glm::mat4 m_projView;               ///< Projection-view matrix
+        const Texture2D* m_texture;         ///< Texture of the pending sprites
+        ShaderProgram* m_shader;            ///< Shader of the pending sprites
+        unsigned int m_indexCapacity;       ///< Amount of sprites the index buffer can hold
+    };
+}
+
+/// \class jop::SpriteBatch
+/// \ingroup graphics
+///
+/// Sprites are drawn through a batch by the render passes. Consecutive sprites
+/// in a pass that share a texture, such as the texture of a TextureAtlas, end up
+/// in a single draw call. Only the vertices are streamed each frame; the index
+/// buffer is only grown when needed.
+
+#endif
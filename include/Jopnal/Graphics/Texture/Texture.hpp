@@ -76,6 +76,14 @@ namespace jop
             ///
             RGBA_F_16,
 
+            /// 128 bit floating point RGBA texture
+            ///
+            /// Meant for data textures, these can't be filtered on GLES.
+            ///
+            /// \warning Not supported on GLES 2.0
+            ///
+            RGBA_F_32,
+
             /// 16 bit depth texture
             ///
             /// \warning On GLES 2.0, supported only with the extension OES_depth_texture
@@ -207,6 +215,15 @@ namespace jop
         ///
         virtual unsigned int getPixelDepth() const = 0;
 
+        /// \brief Get the memory usage
+        ///
+        /// The video memory is estimated from the size and the pixel depth.
+        /// Mipmaps and compression are not accounted for.
+        ///
+        /// \return The memory usage
+        ///
+        MemoryUsage getMemoryUsage() const override;
+
         /// \copydoc TextureSampler::setFilterMode()
         ///
         Texture& setFilterMode(const TextureSampler::Filter mode, const float param = 1.f);
@@ -296,6 +313,14 @@ namespace jop
         ///
         void setAlphaSwizzle(const Format format);
 
+    protected:
+
+        /// \brief Release the video memory
+        ///
+        /// \return True if released
+        ///
+        bool releaseMemory() override;
+
     private:
 
         void updateSampling() const;
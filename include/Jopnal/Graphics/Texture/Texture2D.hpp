@@ -143,6 +143,14 @@ namespace jop
 
         glm::uvec2 m_size; ///< Size
     };
+
+    /// Decodes the image on a worker thread and uploads it on the main thread
+    ///
+    template<>
+    struct JOP_API AsyncLoadTraits<Texture2D>
+    {
+        static std::function<bool(Texture2D&)> prepare(const std::string& path, const uint32 flags = 0);
+    };
 }
 
 /// \class jop::Texture2D
@@ -0,0 +1,112 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+#ifndef JOP_UNIFORMBUFFER_HPP
+#define JOP_UNIFORMBUFFER_HPP
+
+// Headers
+#include <Jopnal/Header.hpp>
+#include <Jopnal/Graphics/Buffer.hpp>
+
+//////////////////////////////////////////////
+
+
+namespace jop
+{
+    class JOP_API UniformBuffer : public Buffer
+    {
+    private:
+
+        JOP_DISALLOW_COPY(UniformBuffer);
+
+    public:
+
+        /// Fixed binding points of the engine's uniform blocks
+        ///
+        struct Binding
+        {
+            enum : uint32
+            {
+                Camera,     ///< Per-camera matrices (jop_CameraBlock)
+                Lights,     ///< Per-frame light data (jop_LightBlock)
+                Material,   ///< Per-material reflection values (jop_MaterialBlock)
+                Clusters,   ///< Per-camera light cluster grid (jop_ClusterBlock)
+
+                __Last
+            };
+        };
+
+    public:
+
+        /// \brief Constructor 
+        ///
+        /// \param usage Usage type
+        ///
+        UniformBuffer(const Usage usage = Buffer::DynamicDraw);
+
+        /// \brief Move constructor
+        ///
+        UniformBuffer(UniformBuffer&& other);
+
+        /// \brief Move assignment operator
+        ///
+        UniformBuffer& operator =(UniformBuffer&& other);
+
+
+        /// \brief Set the buffer data
+        ///
+        /// \param data Pointer to the data
+        /// \param size Size of the buffer data in bytes
+        ///
+        void setData(const void* data, const std::size_t size);
+
+        /// \brief Set buffer sub data
+        ///
+        /// \param data Pointer to the data
+        /// \param offset The start position in the buffer
+        /// \param size Size of the sub data in bytes
+        ///
+        void setSubData(const void* data, const std::size_t offset, const std::size_t size);
+
+        /// \brief Bind this buffer to an indexed binding point
+        ///
+        /// \param index The binding point, usually one of Binding
+        ///
+        void bindBase(const uint32 index) const;
+
+        /// \brief Check if uniform blocks are in use
+        ///
+        /// Uniform blocks need GLSL 3.30 or GLSL ES 3.00. They can be turned
+        /// off with the setting "engine@Graphics|Shading|bUniformBlocks", in
+        /// which case every value is sent as an individual uniform.
+        ///
+        /// \return True if uniform blocks are in use
+        ///
+        static bool isAvailable();
+    };
+}
+
+/// \class jop::UniformBuffer
+/// \ingroup graphics
+///
+/// The data layout must follow the std140 rules of the block it backs.
+
+#endif
@@ -27,6 +27,7 @@
 #include <Jopnal/Utility/CommandHandler.hpp>
 #include <Jopnal/Utility/DateTime.hpp>
 #include <Jopnal/Utility/DirectoryWatcher.hpp>
+#include <Jopnal/Utility/JobSystem.hpp>
 #include <Jopnal/Utility/Json.hpp>
 #include <Jopnal/Utility/Randomizer.hpp>
 #include <Jopnal/Utility/SafeReferenceable.hpp>
@@ -25,11 +25,11 @@
 // Headers
 #include <Jopnal/Header.hpp>
 #include <Jopnal/Utility/Message.hpp>
-#include <unordered_map>
 #include <algorithm>
 #include <functional>
 #include <string>
 #include <tuple>
+#include <vector>
 
 //////////////////////////////////////////////
 
@@ -48,6 +48,23 @@ namespace jop
     {
     public:
 
+        /// \brief Default constructor
+        ///
+        /// The handler is assumed to belong to every kind of receiver, until
+        /// setReceivers() says otherwise.
+        ///
+        CommandHandler();
+
+        /// \brief Set the kind of receivers that execute this handler
+        ///
+        /// This needs to be called before binding any commands. It allows broadcasts
+        /// of commands bound only by components to skip the scene traversal.
+        ///
+        /// \param receivers Message filter bits of the receivers
+        ///
+        void setReceivers(const unsigned short receivers);
+
+
         /// \brief Bind a new free function using a custom parser
         ///
         /// \param command The command name
@@ -117,7 +134,19 @@ namespace jop
 
         /// \brief Execute a command
         ///
-        /// \param command The command name
+        /// The command is looked up with its interned identifier, and the arguments
+        /// are converted only once per message and argument types.
+        ///
+        /// \param message The message containing the command and arguments
+        /// \param instance The class instance to call the command on. Can be nullptr to only consider free functions
+        ///
+        /// \return The message result
+        ///
+        Message::Result execute(const Message& message, void* instance);
+
+        /// \brief Execute a command
+        ///
+        /// \param command The command name and arguments in text form
         /// \param instance The class instance to call the command on. Can be nullptr to only consider free functions
         ///
         /// \return The message result
@@ -126,9 +155,27 @@ namespace jop
 
     private:
 
-        std::unordered_map<std::string, std::pair<std::function<void(const std::string&, void*)>, Message::Result>> m_memberParsers;    ///< Parsers for member functions
-        std::unordered_map<std::string, std::pair<std::function<void(const std::string&)>, Message::Result>> m_funcParsers;             ///< Parsers for free functions
+        /// A bound command
+        ///
+        struct Entry
+        {
+            std::function<void(const Message&)> func;           ///< Parser for the free function
+            std::function<void(const Message&, void*)> member;  ///< Parser for the member function
+            Message::Result funcResult;                         ///< Result of the free function
+            Message::Result memberResult;                       ///< Result of the member function
+        };
+
+        /// \brief Get the entry of a command, creating it if necessary
+        ///
+        /// \param command The command name
+        ///
+        /// \return Reference to the entry
+        ///
+        Entry& getEntry(const std::string& command);
+
 
+        std::vector<Entry> m_commands;  ///< Bound commands, indexed by the interned command identifier
+        unsigned short m_receivers;     ///< Message filter bits of the receivers that execute this handler
     };
 
     // Include the template implementation file
@@ -148,6 +195,12 @@ namespace jop
 ///
 #define JOP_END_COMMAND_HANDLER(handlerName) }}; static ns_##handlerName##_registrar ns_##handlerName##_reg;
 
+/// \brief Set the kind of receivers that execute the command handler
+///
+/// This must come before any of the bindings.
+///
+#define JOP_COMMAND_RECEIVERS(receivers) handler.setReceivers(receivers)
+
 /// \brief Bind a member command
 ///
 #define JOP_BIND_MEMBER_COMMAND(function, funcName) handler.bindMember(funcName, function, ::jop::Message::Result::Continue)
@@ -167,9 +220,10 @@ namespace jop
 /// \brief Execute a command
 ///
 /// This will search for both free and member functions. This will need to be placed in the
-/// same namespace as the command handler.
+/// same namespace as the command handler. Pass the message itself rather than its string,
+/// so that the command and arguments are only parsed once.
 ///
-#define JOP_EXECUTE_COMMAND(handlerName, command, instance) ns_##handlerName##_commandHandler.execute(command, instance)
+#define JOP_EXECUTE_COMMAND(handlerName, message, instance) ns_##handlerName##_commandHandler.execute(message, instance)
 
 /// \class jop::CommandHandler
 /// \ingroup utility
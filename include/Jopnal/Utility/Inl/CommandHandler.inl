@@ -24,7 +24,10 @@ template<typename Func, typename Parser>
 void CommandHandler::bind(const std::string& command, const Func& func, const Parser& parser, const Message::Result result)
 {
     JOP_ASSERT(!command.empty(), "Tried to register an empty command!");
-    m_funcParsers[command] = std::make_pair(std::bind(parser, func, std::placeholders::_1), result);
+
+    auto& entry = getEntry(command);
+    entry.func = [func, parser](const Message& message){ parser(func, message.getArguments()); };
+    entry.funcResult = result;
 }
 
 //////////////////////////////////////////////
@@ -32,7 +35,11 @@ void CommandHandler::bind(const std::string& command, const Func& func, const Pa
 template<typename Ret, typename ... FuncArgs>
 void CommandHandler::bind(const std::string& command, const std::function<Ret(FuncArgs...)>& func, const Message::Result result)
 {
-    bind(command, func, &detail::DefaultParser::parse<Ret, FuncArgs...>, result);
+    JOP_ASSERT(!command.empty(), "Tried to register an empty command!");
+
+    auto& entry = getEntry(command);
+    entry.func = [func](const Message& message){ detail::DefaultParser::parse<Ret, FuncArgs...>(func, message); };
+    entry.funcResult = result;
 }
 
 //////////////////////////////////////////////
@@ -40,7 +47,7 @@ void CommandHandler::bind(const std::string& command, const std::function<Ret(Fu
 template<typename Ret, typename ... FuncArgs>
 void CommandHandler::bind(const std::string& command, Ret(*func)(FuncArgs...), const Message::Result result)
 {
-    bind(command, func, &detail::DefaultParser::parse<Ret, FuncArgs...>, result);
+    bind(command, std::function<Ret(FuncArgs...)>(func), result);
 }
 
 //////////////////////////////////////////////
@@ -49,7 +56,10 @@ template<typename Func, typename Parser>
 void CommandHandler::bindMember(const std::string& command, const Func& func, const Parser& parser, const Message::Result result)
 {
     JOP_ASSERT(!command.empty(), "Tried to register an empty member command!");
-    m_memberParsers[command] = std::make_pair(std::bind(parser, func, std::placeholders::_1, std::placeholders::_2), result);
+
+    auto& entry = getEntry(command);
+    entry.member = [func, parser](const Message& message, void* instance){ parser(func, message.getArguments(), instance); };
+    entry.memberResult = result;
 }
 
 //////////////////////////////////////////////
@@ -57,7 +67,11 @@ void CommandHandler::bindMember(const std::string& command, const Func& func, co
 template<typename Ret, typename Class, typename ... FuncArgs>
 void CommandHandler::bindMember(const std::string& command, const std::function<Ret(Class&, FuncArgs...)>& func, const Message::Result result)
 {
-    bindMember(command, func, &detail::DefaultParser::parseMember<Ret, Class, FuncArgs...>, result);
+    JOP_ASSERT(!command.empty(), "Tried to register an empty member command!");
+
+    auto& entry = getEntry(command);
+    entry.member = [func](const Message& message, void* instance){ detail::DefaultParser::parseMember<Ret, Class, FuncArgs...>(func, message, instance); };
+    entry.memberResult = result;
 }
 
 //////////////////////////////////////////////
@@ -66,11 +80,11 @@ template<typename Ret, typename Class, typename ... FuncArgs>
 void CommandHandler::bindMember(const std::string& command, Ret(Class::*func)(FuncArgs...), const Message::Result result)
 {
     // Have to use mem_fn due to a bug in VS
-    bindMember(command, std::mem_fn(func), &detail::DefaultParser::parseMember<Ret, Class, FuncArgs...>, result);
+    bindMember(command, std::function<Ret(Class&, FuncArgs...)>(std::mem_fn(func)), result);
 }
 
 template<typename Ret, typename Class, typename ... FuncArgs>
 void CommandHandler::bindMember(const std::string& command, Ret(Class::*func)(FuncArgs...) const, const Message::Result result)
 {
-    bindMember(command, std::mem_fn(func), &detail::DefaultParser::parseMember<Ret, const Class, FuncArgs...>, result);
+    bindMember(command, std::function<Ret(const Class&, FuncArgs...)>(std::mem_fn(func)), result);
 }
\ No newline at end of file
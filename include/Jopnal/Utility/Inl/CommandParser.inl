@@ -291,6 +291,10 @@ namespace DefaultParser
         {
             ArgumentApplier::apply<decltype(func), typename RealType<Args>::type...>(func, Splitter<typename RealType<Args>::type...>::split(args));
         }
+        static void parse(const std::function<Ret(Args...)>& func, const Message& message)
+        {
+            ArgumentApplier::apply<decltype(func), typename RealType<Args>::type...>(func, message.getParsedArguments(&Splitter<typename RealType<Args>::type...>::split));
+        }
     };
     template<typename Ret>
     struct Helper<Ret>
@@ -299,6 +303,10 @@ namespace DefaultParser
         {
             func();
         }
+        static void parse(const std::function<Ret()>& func, const Message&)
+        {
+            func();
+        }
     };
 
     template<typename Ret, typename ... Args>
@@ -307,6 +315,12 @@ namespace DefaultParser
         Helper<Ret, Args...>::parse(func, args);
     }
 
+    template<typename Ret, typename ... Args>
+    void parse(const std::function<Ret(Args...)>& func, const Message& message)
+    {
+        Helper<Ret, Args...>::parse(func, message);
+    }
+
     //////////////////////////////////////////////
 
     template<typename Ret, typename T, typename ... Args>
@@ -316,6 +330,10 @@ namespace DefaultParser
         {
             ArgumentApplier::applyMember<decltype(func), T, typename RealType<Args>::type...>(func, instance, Splitter<typename RealType<Args>::type...>::split(args));
         }
+        static void parse(const std::function<Ret(T&, Args...)>& func, const Message& message, T& instance)
+        {
+            ArgumentApplier::applyMember<decltype(func), T, typename RealType<Args>::type...>(func, instance, message.getParsedArguments(&Splitter<typename RealType<Args>::type...>::split));
+        }
     };
     template<typename Ret, typename T>
     struct MemberHelper<Ret, T>
@@ -324,6 +342,10 @@ namespace DefaultParser
         {
             func(instance);
         }
+        static void parse(const std::function<Ret(T&)>& func, const Message&, T& instance)
+        {
+            func(instance);
+        }
     };
 
     template<typename Ret, typename T, typename ... Args>
@@ -334,4 +356,13 @@ namespace DefaultParser
             MemberHelper<Ret, T, Args...>::parse(func, args, *static_cast<T*>(instance));
         }
     }
+
+    template<typename Ret, typename T, typename ... Args>
+    void parseMember(const std::function<Ret(T&, Args...)>& func, const Message& message, void* instance)
+    {
+        if (instance)
+        {
+            MemberHelper<Ret, T, Args...>::parse(func, message, *static_cast<T*>(instance));
+        }
+    }
 }
\ No newline at end of file
@@ -34,4 +34,18 @@ Message& Message::pushReference(const T& ref)
 {
     m_command << ' ' << std::hex << reinterpret_cast<const void*>(&ref);
     return *this;
+}
+
+//////////////////////////////////////////////
+
+template<typename Tuple>
+const Tuple& Message::getParsedArguments(Tuple (*parse)(const std::string&)) const
+{
+    if (!m_parsedType || *m_parsedType != typeid(Tuple))
+    {
+        m_parsedArguments = std::make_shared<Tuple>(parse(getArguments()));
+        m_parsedType = &typeid(Tuple);
+    }
+
+    return *static_cast<const Tuple*>(m_parsedArguments.get());
 }
\ No newline at end of file
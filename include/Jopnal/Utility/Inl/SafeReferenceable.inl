@@ -30,7 +30,7 @@ inline WeakReference<To> static_ref_cast(const WeakReference<From>& from)
 template<typename To, typename From>
 inline WeakReference<To> dynamic_ref_cast(const WeakReference<From>& from)
 {
-    if (!from.expired() && dynamic_cast<To*>(*from.m_ref.lock()))
+    if (!from.expired() && dynamic_cast<const To*>(from.get()))
         return static_ref_cast<To>(from);
 
     return WeakReference<To>();
@@ -40,33 +40,40 @@ inline WeakReference<To> dynamic_ref_cast(const WeakReference<From>& from)
 
 template<typename T>
 SafeReferenceable<T>::SafeReferenceable(T* ref)
-    : m_ref(std::make_shared<T*>(nullptr))
-{
-    *m_ref = ref;
-}
+    : m_slot(detail::ReferenceTable::allocate(ref))
+{}
 
 template<typename T>
 SafeReferenceable<T>::SafeReferenceable(SafeReferenceable<T>&& other)
-    : m_ref(std::move(other.m_ref))
+    : m_slot(other.m_slot)
 {
-    if (m_ref)
-        *m_ref = static_cast<T*>(this);
+    other.m_slot = detail::ReferenceTable::NullSlot;
+
+    if (m_slot != detail::ReferenceTable::NullSlot)
+        detail::ReferenceTable::getSlot(m_slot).object = static_cast<T*>(this);
 }
 
 template<typename T>
 SafeReferenceable<T>& SafeReferenceable<T>::operator =(SafeReferenceable<T>&& other)
 {
-    m_ref = std::move(other.m_ref);
+    if (m_slot != detail::ReferenceTable::NullSlot)
+        detail::ReferenceTable::release(m_slot);
 
-    if (m_ref)
-        *m_ref = static_cast<T*>(this);
+    m_slot = other.m_slot;
+    other.m_slot = detail::ReferenceTable::NullSlot;
+
+    if (m_slot != detail::ReferenceTable::NullSlot)
+        detail::ReferenceTable::getSlot(m_slot).object = static_cast<T*>(this);
 
     return *this;
 }
 
 template<typename T>
 SafeReferenceable<T>::~SafeReferenceable()
-{}
+{
+    if (m_slot != detail::ReferenceTable::NullSlot)
+        detail::ReferenceTable::release(m_slot);
+}
 
 //////////////////////////////////////////////
 
@@ -80,9 +87,18 @@ inline WeakReference<T> SafeReferenceable<T>::getReference() const
 //////////////////////////////////////////////
 
 
+template<typename T>
+inline WeakReference<T>::WeakReference()
+    : m_slot        (detail::ReferenceTable::NullSlot),
+      m_generation  (0)
+{}
+
+//////////////////////////////////////////////
+
 template<typename T>
 inline WeakReference<T>::WeakReference(const SafeReferenceable<T>& ref)
-    : m_ref(ref.m_ref)
+    : m_slot        (ref.m_slot),
+      m_generation  (ref.m_slot != detail::ReferenceTable::NullSlot ? detail::ReferenceTable::getSlot(ref.m_slot).generation : 0)
 {}
 
 //////////////////////////////////////////////
@@ -90,7 +106,7 @@ inline WeakReference<T>::WeakReference(const SafeReferenceable<T>& ref)
 template<typename T>
 inline bool WeakReference<T>::expired() const
 {
-    return m_ref.expired();
+    return m_slot == detail::ReferenceTable::NullSlot || detail::ReferenceTable::getSlot(m_slot).generation != m_generation;
 }
 
 //////////////////////////////////////////////
@@ -98,7 +114,7 @@ inline bool WeakReference<T>::expired() const
 template<typename T>
 inline void WeakReference<T>::reset()
 {
-    m_ref.reset();
+    m_slot = detail::ReferenceTable::NullSlot;
 }
 
 //////////////////////////////////////////////
@@ -106,7 +122,7 @@ inline void WeakReference<T>::reset()
 template<typename T>
 inline T* WeakReference<T>::get()
 {
-    return m_ref.expired() ? nullptr : *m_ref.lock();
+    return expired() ? nullptr : static_cast<T*>(detail::ReferenceTable::getSlot(m_slot).object);
 }
 
 //////////////////////////////////////////////
@@ -114,7 +130,7 @@ inline T* WeakReference<T>::get()
 template<typename T>
 inline const T* WeakReference<T>::get() const
 {
-    return m_ref.expired() ? nullptr : *m_ref.lock();
+    return expired() ? nullptr : static_cast<const T*>(detail::ReferenceTable::getSlot(m_slot).object);
 }
 
 //////////////////////////////////////////////
@@ -122,7 +138,7 @@ inline const T* WeakReference<T>::get() const
 template<typename T>
 inline T& WeakReference<T>::operator *()
 {
-    return **m_ref.lock();
+    return *get();
 }
 
 //////////////////////////////////////////////
@@ -130,7 +146,7 @@ inline T& WeakReference<T>::operator *()
 template<typename T>
 inline const T& WeakReference<T>::operator *() const
 {
-    return **m_ref.lock();
+    return *get();
 }
 
 //////////////////////////////////////////////
@@ -178,6 +194,5 @@ inline WeakReference<T>::operator bool() const
 template<typename T>
 inline WeakReference<T>& WeakReference<T>::operator =(const SafeReferenceable<T>& other)
 {
-    m_ref = other.m_ref;
-    return *this;
-}    
\ No newline at end of file
+    return *this = WeakReference<T>(other);
+}
\ No newline at end of file
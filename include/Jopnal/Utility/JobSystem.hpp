@@ -0,0 +1,180 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+#ifndef JOP_JOBSYSTEM_HPP
+#define JOP_JOBSYSTEM_HPP
+
+// Headers
+#include <Jopnal/Header.hpp>
+#include <Jopnal/Utility/Thread.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//////////////////////////////////////////////
+
+
+namespace jop
+{
+    class JOP_API JobSystem
+    {
+    private:
+
+        JOP_DISALLOW_COPY_MOVE(JobSystem);
+
+    public:
+
+        typedef std::function<void()> Job;
+        typedef std::function<void(const uint32, const uint32)> RangeJob;
+
+        /// Counter of unfinished jobs
+        ///
+        class Counter
+        {
+        private:
+
+            JOP_DISALLOW_COPY_MOVE(Counter);
+
+            friend class JobSystem;
+
+        public:
+
+            /// \brief Constructor
+            ///
+            Counter();
+
+            /// \brief Check if all the jobs have finished
+            ///
+            /// \return True if finished
+            ///
+            bool isDone() const;
+
+        private:
+
+            std::atomic<uint32> m_pending;  ///< Number of unfinished jobs
+        };
+
+    private:
+
+        struct Task
+        {
+            Job job;            ///< The job
+            Counter* counter;   ///< Counter to decrement once done
+        };
+
+        struct Queue
+        {
+            std::mutex mutex;           ///< Mutex
+            std::deque<Task> tasks;     ///< The tasks
+        };
+
+    public:
+
+        /// \brief Constructor
+        ///
+        /// \param workers Number of worker threads. With zero workers, jobs
+        ///                are run by the thread that waits for them
+        ///
+        explicit JobSystem(const uint32 workers);
+
+        /// \brief Destructor
+        ///
+        /// Waits for the worker threads to finish the jobs they're executing.
+        /// Jobs that haven't been started are discarded.
+        ///
+        ~JobSystem();
+
+
+        /// \brief Run a job
+        ///
+        /// \param job The job
+        /// \param counter Counter to associate the job with
+        ///
+        void run(Job job, Counter& counter);
+
+        /// \brief Wait until all the jobs associated with a counter have finished
+        ///
+        /// The calling thread executes pending jobs while waiting.
+        ///
+        /// \param counter The counter
+        ///
+        void wait(const Counter& counter);
+
+        /// \brief Split a range into batches and run them in parallel
+        ///
+        /// Returns once every batch has finished.
+        ///
+        /// \param count Size of the range
+        /// \param batchSize Maximum number of elements in a single batch
+        /// \param job Function called with the beginning and end of each batch
+        ///
+        void parallelFor(const uint32 count, const uint32 batchSize, const RangeJob& job);
+
+        /// \brief Get the number of worker threads
+        ///
+        /// \return Number of worker threads
+        ///
+        uint32 getWorkerCount() const;
+
+        /// \brief Get the engine job system
+        ///
+        /// The number of workers is read from the setting "engine@Threading|uWorkerThreads".
+        /// Zero means one less than the number of hardware threads.
+        ///
+        /// \return Reference to the job system
+        ///
+        static JobSystem& getDefault();
+
+    private:
+
+        void push(Task task);
+
+        bool runOne(const uint32 index);
+
+        void workerLoop(const uint32 index);
+
+        uint32 getQueueIndex() const;
+
+
+        std::vector<std::unique_ptr<Queue>> m_queues;   ///< Queues. The first one is used by non-worker threads
+        std::vector<Thread> m_threads;                  ///< Worker threads
+        std::mutex m_sleepMutex;                        ///< Mutex for sleeping workers
+        std::condition_variable m_sleepCondition;       ///< Condition for waking up workers
+        std::atomic<uint32> m_queued;                   ///< Number of queued tasks
+        std::atomic<bool> m_exit;                       ///< Exit flag
+    };
+}
+
+/// \class jop::JobSystem
+/// \ingroup utility
+///
+/// Work stealing job scheduler.
+///
+/// Each worker pushes and pops jobs at the back of its own queue and steals from
+/// the front of the others' queues when it runs out. Jobs submitted from
+/// threads outside the system go to a shared queue, which workers steal from
+/// the same way.
+
+#endif
\ No newline at end of file
@@ -25,6 +25,7 @@
 // Headers
 #include <Jopnal/Header.hpp>
 #include <Jopnal/Utility/Assert.hpp>
+#include <memory>
 #include <string>
 #include <typeinfo>
 #include <sstream>
@@ -124,6 +125,33 @@ namespace jop
         ///
         const std::string& getString() const;
 
+        /// \brief Get the interned identifier of the command
+        ///
+        /// The command is split from the arguments only once, no matter
+        /// how many receivers the message is passed to.
+        ///
+        /// \return The command identifier. 0 if there's no command or it has never been registered
+        ///
+        uint32 getCommandID() const;
+
+        /// \brief Get the arguments without the command
+        ///
+        /// \return Reference to the internal argument string
+        ///
+        const std::string& getArguments() const;
+
+        /// \brief Get the arguments converted into a typed tuple
+        ///
+        /// The converted arguments are cached, so that receivers binding the
+        /// command with the same argument types don't have to parse them again.
+        ///
+        /// \param parse Function to convert the argument string with, if there's no cached value
+        ///
+        /// \return Reference to the converted arguments
+        ///
+        template<typename Tuple>
+        const Tuple& getParsedArguments(Tuple (*parse)(const std::string&)) const;
+
         /// \brief Check if the given bit field should pass the filter
         ///
         /// \param filter The bits to check. Only one match is required for a pass
@@ -162,10 +190,58 @@ namespace jop
         ///
         operator bool() const;
 
+
+        /// \brief Intern a command name
+        ///
+        /// The same name always maps to the same identifier.
+        ///
+        /// \param command The command name
+        ///
+        /// \return The command identifier. 0 for an empty name
+        ///
+        static uint32 internCommand(const std::string& command);
+
+        /// \brief Find the identifier of a command name
+        ///
+        /// Unlike internCommand(), this never adds the name.
+        ///
+        /// \param command The command name
+        ///
+        /// \return The command identifier. 0 if the name hasn't been interned
+        ///
+        static uint32 findCommand(const std::string& command);
+
+        /// \brief Record the receivers that have bound a command
+        ///
+        /// \param id The command identifier
+        /// \param receivers Filter bits of the receivers, added to the previously recorded ones
+        ///
+        static void addCommandReceivers(const uint32 id, const unsigned short receivers);
+
+        /// \brief Get the receivers that have bound a command
+        ///
+        /// Engine::sendMessage() uses this to decide whether a broadcast can skip
+        /// the scene traversal.
+        ///
+        /// \param id The command identifier
+        ///
+        /// \return Filter bits of the receivers. 0 if nothing has bound the command
+        ///
+        static unsigned short getCommandReceivers(const uint32 id);
+
     private:
 
+        /// \brief Split the command from the arguments
+        ///
+        void parseCommand() const;
+
         mutable std::ostringstream m_command;                                       ///< Buffer containing the command and arguments in string form
         mutable std::string m_commandStr;                                           ///< String with the command & arguments
+        mutable std::string m_arguments;                                            ///< The arguments without the command
+        mutable uint32 m_commandID;                                                 ///< Interned command identifier
+        mutable bool m_commandParsed;                                               ///< Has the command been split from the arguments?
+        mutable const std::type_info* m_parsedType;                                 ///< Type of the cached converted arguments
+        mutable std::shared_ptr<void> m_parsedArguments;                            ///< Cached converted arguments
         std::string m_idPattern;                                                    ///< The id filter to compare any passed ids against
         std::unordered_set<std::string> m_tags;                                     ///< Tags to compare against
         unsigned short m_filterBits;                                                ///< Bit field with the system filter bits
@@ -25,7 +25,6 @@
 // Headers
 #include <Jopnal/Header.hpp>
 #include <Jopnal/Utility/Assert.hpp>
-#include <memory>
 
 //////////////////////////////////////////////
 
@@ -59,6 +58,64 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    namespace detail
+    {
+        class JOP_API ReferenceTable
+        {
+        public:
+
+            /// A referenceable object's slot
+            ///
+            struct Slot
+            {
+                void* object;       ///< The bound object. nullptr when the slot is free
+                uint32 generation;  ///< Incremented when the slot is released, which expires the references
+                uint32 nextFree;    ///< Next free slot
+            };
+
+            static const uint32 NullSlot = ~0u;         ///< Slot of an unbound reference
+            static const uint32 PageBits = 12;          ///< The table grows a page of 2^PageBits slots at a time
+            static const uint32 MaxPages = 1 << 12;     ///< Maximum amount of pages
+
+        public:
+
+            /// \brief Allocate a slot
+            ///
+            /// \param object The object to bind
+            ///
+            /// \return The slot index
+            ///
+            static uint32 allocate(void* object);
+
+            /// \brief Release a slot
+            ///
+            /// All references to the slot expire.
+            ///
+            /// \param slot The slot index
+            ///
+            static void release(const uint32 slot);
+
+            /// \brief Get a slot
+            ///
+            /// The pages are never moved or freed, so this needs no locking.
+            ///
+            /// \param slot The slot index
+            ///
+            /// \return Reference to the slot
+            ///
+            static Slot& getSlot(const uint32 slot)
+            {
+                return m_pages[slot >> PageBits][slot & ((1 << PageBits) - 1)];
+            }
+
+        private:
+
+            static Slot* m_pages[MaxPages]; ///< The slot pages
+        };
+    }
+
+    //////////////////////////////////////////////
+
     template<typename T>
     class SafeReferenceable
     {
@@ -102,7 +159,7 @@ namespace jop
 
     private:
 
-        std::shared_ptr<T*> m_ref;  ///< The bound reference
+        uint32 m_slot;  ///< Slot in the reference table
     };
 
     //////////////////////////////////////////////
@@ -124,7 +181,7 @@ namespace jop
         ///
         /// Initializes the internal reference to be empty
         ///
-        WeakReference() = default;
+        WeakReference();
 
         /// \brief Constructor for initializing from a SafeReferenceable object
         ///
@@ -202,7 +259,8 @@ namespace jop
 
     private:
 
-        std::weak_ptr<T*> m_ref;    ///< The bound reference
+        uint32 m_slot;          ///< Slot in the reference table
+        uint32 m_generation;    ///< Generation of the slot when this reference was bound
     };
 
     // Include the template implementation file
@@ -211,5 +269,10 @@ namespace jop
 
 /// \class jop::SafeReferenceable
 /// \ingroup utility
+///
+/// Each referenceable object owns a slot in a central table. A weak reference
+/// stores the slot and its generation, and it's valid as long as the generation
+/// hasn't changed. Checking a reference is a plain comparison, and no memory is
+/// allocated per object.
 
 #endif
\ No newline at end of file
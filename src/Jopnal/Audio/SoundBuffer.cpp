@@ -117,6 +117,17 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    Resource::MemoryUsage SoundBuffer::getMemoryUsage() const
+    {
+        MemoryUsage usage;
+        usage.cpu = m_samples.size();
+        usage.gpu = 0;
+
+        return usage;
+    }
+
+    //////////////////////////////////////////////
+
     SoundBuffer& SoundBuffer::getDefault()
     {
         static WeakReference<SoundBuffer> defBuf;
@@ -41,6 +41,8 @@ namespace jop
 {
     JOP_REGISTER_COMMAND_HANDLER(SoundEffect)
 
+        JOP_COMMAND_RECEIVERS(Message::Component);
+
         JOP_BIND_MEMBER_COMMAND(&SoundEffect::play, "playEffect");
         JOP_BIND_MEMBER_COMMAND(&SoundEffect::pause, "pauseEffect");
         JOP_BIND_MEMBER_COMMAND(&SoundEffect::stop, "stopEffect");
@@ -48,6 +48,8 @@ namespace jop
 {
     JOP_REGISTER_COMMAND_HANDLER(SoundSource)
 
+        JOP_COMMAND_RECEIVERS(Message::Component);
+
     JOP_BIND_MEMBER_COMMAND(&SoundSource::setVolume, "setVolume");
     JOP_BIND_MEMBER_COMMAND(&SoundSource::setPitch, "setPitch");
     JOP_BIND_MEMBER_COMMAND(&SoundSource::setMinDistance, "setMinDistance");
@@ -45,6 +45,8 @@ namespace jop
 {
     JOP_REGISTER_COMMAND_HANDLER(SoundStream)
 
+        JOP_COMMAND_RECEIVERS(Message::Component);
+
         JOP_BIND_MEMBER_COMMAND((SoundStream& (SoundStream::*)(const bool reset))&SoundStream::play, "playStream");
         JOP_BIND_MEMBER_COMMAND(&SoundStream::pause, "pauseStream");
         JOP_BIND_MEMBER_COMMAND(&SoundStream::stop, "stopStream");
@@ -27,18 +27,45 @@
     #include <Jopnal/Core/Component.hpp>
 
     #include <Jopnal/Utility/CommandHandler.hpp>
+    #include <Jopnal/Core/Engine.hpp>
+    #include <Jopnal/Core/Object.hpp>
+    #include <Jopnal/Core/Scene.hpp>
     #include <Jopnal/Core/Serializer.hpp>
     #include <Jopnal/Core/DebugHandler.hpp>
+    #include <algorithm>
+    #include <array>
+    #include <mutex>
 
 #endif
 
 //////////////////////////////////////////////
 
 
+namespace
+{
+    // Subscribed components, indexed by the command identifier
+    std::vector<std::vector<jop::Component*>> ns_subscribers;
+
+    // Component pools. Sizes are rounded up to the granularity, larger components use the global heap
+    const std::size_t ns_poolGranularity = 16;
+    const std::size_t ns_maxPooledSize = 1024;
+    const std::size_t ns_chunkSlots = 64;
+
+    struct FreeSlot
+    {
+        FreeSlot* next;
+    };
+
+    std::mutex ns_poolMutex;
+    std::array<FreeSlot*, ns_maxPooledSize / ns_poolGranularity> ns_freeSlots;
+}
+
 namespace jop
 {
     JOP_REGISTER_COMMAND_HANDLER(Component)
 
+        JOP_COMMAND_RECEIVERS(Message::Component);
+
         JOP_BIND_MEMBER_COMMAND(&Component::setID, "setID");
 
     JOP_END_COMMAND_HANDLER(Component)
@@ -72,17 +99,87 @@ namespace jop
     //////////////////////////////////////////////
 
     Component::Component(Object& object, const uint32 ID)
-        : m_objectRef   (object),
-          m_ID          (ID)
+        : m_ID              (ID),
+          m_typeID          (0),
+          m_objectRef       (object),
+          m_subscriptions   ()
     {}
 
     Component::Component(const Component& other, Object& newObj)
-        : m_objectRef   (newObj),
-          m_ID          (other.m_ID)
-    {}
+        : m_ID              (other.m_ID),
+          m_typeID          (0),
+          m_objectRef       (newObj),
+          m_subscriptions   (other.m_subscriptions)
+    {
+        for (auto id : m_subscriptions)
+            ns_subscribers[id].push_back(this);
+    }
+
+    //////////////////////////////////////////////
+
+    void* Component::operator new(std::size_t size)
+    {
+        if (size > ns_maxPooledSize)
+            return ::operator new(size);
+
+        const std::size_t sizeClass = (size + ns_poolGranularity - 1) / ns_poolGranularity - 1;
+
+        std::lock_guard<std::mutex> lock(ns_poolMutex);
+
+        auto& head = ns_freeSlots[sizeClass];
+
+        if (!head)
+        {
+            // The chunks are kept for reuse, they're never released
+            const std::size_t slotSize = (sizeClass + 1) * ns_poolGranularity;
+            auto chunk = static_cast<char*>(::operator new(slotSize * ns_chunkSlots));
+
+            for (std::size_t i = ns_chunkSlots; i-- > 0;)
+            {
+                auto slot = reinterpret_cast<FreeSlot*>(chunk + i * slotSize);
+                slot->next = head;
+                head = slot;
+            }
+        }
+
+        FreeSlot* slot = head;
+        head = slot->next;
+
+        return slot;
+    }
+
+    //////////////////////////////////////////////
+
+    void Component::operator delete(void* ptr, std::size_t size)
+    {
+        if (!ptr)
+            return;
+
+        if (size > ns_maxPooledSize)
+        {
+            ::operator delete(ptr);
+            return;
+        }
+
+        const std::size_t sizeClass = (size + ns_poolGranularity - 1) / ns_poolGranularity - 1;
+
+        std::lock_guard<std::mutex> lock(ns_poolMutex);
+
+        auto slot = static_cast<FreeSlot*>(ptr);
+        slot->next = ns_freeSlots[sizeClass];
+        ns_freeSlots[sizeClass] = slot;
+    }
+
+    //////////////////////////////////////////////
 
     Component::~Component()
-    {}
+    {
+        for (auto id : m_subscriptions)
+        {
+            auto& subs = ns_subscribers[id];
+            subs.erase(std::find(subs.begin(), subs.end(), this));
+        }
+    }
 
     //////////////////////////////////////////////
 
@@ -101,6 +198,11 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    void Component::parallelUpdate(const float)
+    {}
+
+    //////////////////////////////////////////////
+
     uint32 Component::getID() const
     {
         return m_ID;
@@ -153,6 +255,87 @@ namespace jop
 
     Message::Result Component::receiveMessage(const Message& message)
     {
-        return JOP_EXECUTE_COMMAND(Component, message.getString(), this);
+        return JOP_EXECUTE_COMMAND(Component, message, this);
+    }
+
+    //////////////////////////////////////////////
+
+    void Component::subscribe(const std::string& command)
+    {
+        const uint32 id = Message::internCommand(command);
+
+        if (id == 0 || std::find(m_subscriptions.begin(), m_subscriptions.end(), id) != m_subscriptions.end())
+            return;
+
+        if (id >= ns_subscribers.size())
+            ns_subscribers.resize(id + 1);
+
+        ns_subscribers[id].push_back(this);
+        m_subscriptions.push_back(id);
+    }
+
+    //////////////////////////////////////////////
+
+    void Component::unsubscribe(const std::string& command)
+    {
+        const uint32 id = Message::findCommand(command);
+        auto itr = std::find(m_subscriptions.begin(), m_subscriptions.end(), id);
+
+        if (itr == m_subscriptions.end())
+            return;
+
+        auto& subs = ns_subscribers[id];
+        subs.erase(std::find(subs.begin(), subs.end(), this));
+        m_subscriptions.erase(itr);
+    }
+
+    //////////////////////////////////////////////
+
+    bool Component::sendToSubscribers(const Message& message, Message::Result& result)
+    {
+        const uint32 id = message.getCommandID();
+
+        if (id >= ns_subscribers.size() || ns_subscribers[id].empty())
+            return false;
+
+        if (!message.passFilter(Message::Component))
+            return false;
+
+        // The traversal is still needed if a scene or an object has bound the command
+        const unsigned short otherField = Message::SharedScene | Message::Scene | Message::Object;
+
+        if (message.passFilter(Message::getCommandReceivers(id) & otherField))
+            return false;
+
+        result = Message::Result::Continue;
+
+        const Scene* shared = Engine::hasSharedScene() ? &Engine::getSharedScene() : nullptr;
+        const Scene* current = Engine::hasCurrentScene() ? &Engine::getCurrentScene() : nullptr;
+
+        // The traversal only descends into the child objects when the object
+        // filter is set, otherwise just the components of the scenes are reached
+        const bool descend = message.passFilter(Message::Object);
+
+        // Indexed, since the receivers may subscribe or unsubscribe
+        for (std::size_t i = 0; i < ns_subscribers[id].size(); ++i)
+        {
+            Component& comp = *ns_subscribers[id][i];
+            const Object* obj = comp.getObject().get();
+            const Scene& scene = obj->getScene();
+
+            if (&scene != current && &scene != shared)
+                continue;
+
+            if (!descend && obj != &scene.getAsObject())
+                continue;
+
+            if (comp.receiveMessage(message) == Message::Result::Escape)
+            {
+                result = Message::Result::Escape;
+                break;
+            }
+        }
+
+        return true;
     }
 }
\ No newline at end of file
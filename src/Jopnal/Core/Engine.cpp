@@ -29,6 +29,8 @@
     #include <Jopnal/Audio/AudioDevice.hpp>
     #include <Jopnal/Core/Scene.hpp>
     #include <Jopnal/Core/FileLoader.hpp>
+    #include <Jopnal/Core/Profiler.hpp>
+    #include <Jopnal/Core/Hierarchy/TransformStore.hpp>
     #include <Jopnal/Core/SettingManager.hpp>
     #include <Jopnal/Core/ResourceManager.hpp>
     #include <Jopnal/Graphics/MainRenderTarget.hpp>
@@ -231,6 +233,13 @@ namespace jop
         // Buffer swapper
         createSubsystem<detail::BufferSwapper>(*m_mainWindow);
 
+    #ifdef JOP_ENABLE_PROFILING
+
+        // Profiler, needs to be the last subsystem so that it can collect the whole frame
+        createSubsystem<Profiler>();
+
+    #endif
+
         // Set process priority
         if (SettingManager::get<bool>("engine@bForceProcessHighPriority", true))
 
@@ -258,6 +267,8 @@ namespace jop
 
         while (!eng.m_exit)
         {
+            JOP_PROFILE("Engine::frame");
+
             if (eng.m_newScene.load() && eng.m_newSceneSignal.load())
             {
                 eng.m_currentScene.reset(eng.m_newScene.load());
@@ -274,10 +285,15 @@ namespace jop
 
             // Update
             {
+                JOP_PROFILE("Engine::update");
+
                 for (auto& i : eng.m_subsystems)
                 {
                     if (i->isActive())
+                    {
+                        JOP_PROFILE(typeid(*i).name());
                         i->preUpdate(frameTime);
+                    }
                 }
 
                 if (hasCurrentScene())
@@ -289,15 +305,28 @@ namespace jop
                 for (auto& i : eng.m_subsystems)
                 {
                     if (i->isActive())
+                    {
+                        JOP_PROFILE(typeid(*i).name());
                         i->postUpdate(frameTime);
+                    }
                 }
             }
 
+            // Resolve the transformations changed during the update in one pass
+            detail::TransformStore::getInstance().update();
+
             // Draw
-            for (auto& i : eng.m_subsystems)
             {
-                if (i->isActive())
-                    i->draw();
+                JOP_PROFILE("Engine::draw");
+
+                for (auto& i : eng.m_subsystems)
+                {
+                    if (i->isActive())
+                    {
+                        JOP_PROFILE(typeid(*i).name());
+                        i->draw();
+                    }
+                }
             }
 
             eng.m_advanceFrame.store(false);
@@ -395,15 +424,26 @@ namespace jop
         {
             const unsigned short sceneField = Message::SharedScene | Message::Scene | Message::Object | Message::Component;
 
-            if (hasSharedScene() && message.passFilter(sceneField) && m_engineObject->m_sharedScene->sendMessage(message) == Message::Result::Escape)
-                return Message::Result::Escape;
+            // Commands with subscribers skip the scene traversal
+            Message::Result result;
 
-            if (hasCurrentScene())
+            if (Component::sendToSubscribers(message, result))
             {
-                auto& s = m_engineObject->m_currentScene;
-
-                if (s && message.passFilter(sceneField) && s->sendMessage(message) == Message::Result::Escape)
+                if (result == Message::Result::Escape)
+                    return result;
+            }
+            else
+            {
+                if (hasSharedScene() && message.passFilter(sceneField) && m_engineObject->m_sharedScene->sendMessage(message) == Message::Result::Escape)
                     return Message::Result::Escape;
+
+                if (hasCurrentScene())
+                {
+                    auto& s = m_engineObject->m_currentScene;
+
+                    if (s && message.passFilter(sceneField) && s->sendMessage(message) == Message::Result::Escape)
+                        return Message::Result::Escape;
+                }
             }
 
             if (message.passFilter(Message::Subsystem))
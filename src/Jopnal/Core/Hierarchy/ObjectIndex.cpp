@@ -0,0 +1,122 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+// Headers
+#include JOP_PRECOMPILED_HEADER_FILE
+
+#ifndef JOP_PRECOMPILED_HEADER
+
+    #include <Jopnal/Core/Hierarchy/ObjectIndex.hpp>
+
+#endif
+
+//////////////////////////////////////////////
+
+
+namespace jop { namespace detail
+{
+    ObjectIndex::ObjectIndex()
+        : m_ids     (),
+          m_tags    ()
+    {}
+
+    //////////////////////////////////////////////
+
+    ObjectIndex& ObjectIndex::getInstance()
+    {
+        static ObjectIndex index;
+        return index;
+    }
+
+    //////////////////////////////////////////////
+
+    void ObjectIndex::addID(const std::string& ID, const Object& obj)
+    {
+        add(m_ids, ID, obj);
+    }
+
+    //////////////////////////////////////////////
+
+    void ObjectIndex::removeID(const std::string& ID, const Object& obj)
+    {
+        remove(m_ids, ID, obj);
+    }
+
+    //////////////////////////////////////////////
+
+    void ObjectIndex::addTag(const std::string& tag, const Object& obj)
+    {
+        add(m_tags, tag, obj);
+    }
+
+    //////////////////////////////////////////////
+
+    void ObjectIndex::removeTag(const std::string& tag, const Object& obj)
+    {
+        remove(m_tags, tag, obj);
+    }
+
+    //////////////////////////////////////////////
+
+    const ObjectIndex::Bucket* ObjectIndex::findID(const std::string& ID) const
+    {
+        return find(m_ids, ID);
+    }
+
+    //////////////////////////////////////////////
+
+    const ObjectIndex::Bucket* ObjectIndex::findTag(const std::string& tag) const
+    {
+        return find(m_tags, tag);
+    }
+
+    //////////////////////////////////////////////
+
+    void ObjectIndex::add(Map& map, const std::string& key, const Object& obj)
+    {
+        map[key].insert(&obj);
+    }
+
+    //////////////////////////////////////////////
+
+    void ObjectIndex::remove(Map& map, const std::string& key, const Object& obj)
+    {
+        auto itr = map.find(key);
+
+        if (itr != map.end())
+        {
+            itr->second.erase(&obj);
+
+            // Don't let the tables grow with every name ever used
+            if (itr->second.empty())
+                map.erase(itr);
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    const ObjectIndex::Bucket* ObjectIndex::find(const Map& map, const std::string& key)
+    {
+        auto itr = map.find(key);
+
+        return itr == map.end() ? nullptr : &itr->second;
+    }
+}}
\ No newline at end of file
@@ -0,0 +1,94 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+#ifndef JOP_OBJECTINDEX_HPP
+#define JOP_OBJECTINDEX_HPP
+
+// Headers
+#include <Jopnal/Header.hpp>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+//////////////////////////////////////////////
+
+
+namespace jop
+{
+    class Object;
+
+    namespace detail
+    {
+        class ObjectIndex
+        {
+        private:
+
+            JOP_DISALLOW_COPY_MOVE(ObjectIndex);
+
+            ObjectIndex();
+
+        public:
+
+            typedef std::unordered_set<const Object*> Bucket;
+
+
+            static ObjectIndex& getInstance();
+
+
+            void addID(const std::string& ID, const Object& obj);
+
+            void removeID(const std::string& ID, const Object& obj);
+
+            void addTag(const std::string& tag, const Object& obj);
+
+            void removeTag(const std::string& tag, const Object& obj);
+
+            const Bucket* findID(const std::string& ID) const;
+
+            const Bucket* findTag(const std::string& tag) const;
+
+        private:
+
+            typedef std::unordered_map<std::string, Bucket> Map;
+
+            static void add(Map& map, const std::string& key, const Object& obj);
+
+            static void remove(Map& map, const std::string& key, const Object& obj);
+
+            static const Bucket* find(const Map& map, const std::string& key);
+
+
+            Map m_ids;  ///< Objects by identifier
+            Map m_tags; ///< Objects by tag
+        };
+    }
+}
+
+/// \class jop::ObjectIndex
+/// \ingroup core
+///
+/// Lookup tables from object identifiers and tags to the live objects.
+///
+/// Object keeps the tables up to date whenever it's created, moved, destroyed,
+/// renamed or tagged. The object searches use them to find the candidates
+/// directly, and only need to check that a candidate is in the searched subtree.
+
+#endif
\ No newline at end of file
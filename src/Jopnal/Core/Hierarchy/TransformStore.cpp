@@ -0,0 +1,340 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+// Headers
+#include JOP_PRECOMPILED_HEADER_FILE
+
+#ifndef JOP_PRECOMPILED_HEADER
+
+    #include <Jopnal/Core/Hierarchy/TransformStore.hpp>
+
+    #include <Jopnal/Core/Object.hpp>
+    #include <Jopnal/Core/Profiler.hpp>
+
+#endif
+
+//////////////////////////////////////////////
+
+
+namespace
+{
+    const jop::uint32 ns_unknownDepth = ~0u;
+}
+
+namespace jop { namespace detail
+{
+    const uint32 TransformStore::NullHandle = ~0u;
+
+    //////////////////////////////////////////////
+
+    TransformStore::TransformStore()
+        : m_locals          (),
+          m_world           (),
+          m_parents         (),
+          m_restrictions    (),
+          m_versions        (),
+          m_parentVersions  (),
+          m_dirty           (),
+          m_alive           (),
+          m_order           (),
+          m_depths          (),
+          m_freeList        (),
+          m_orderDirty      (false),
+          m_modified        (false)
+    {}
+
+    //////////////////////////////////////////////
+
+    TransformStore& TransformStore::getInstance()
+    {
+        static TransformStore store;
+        return store;
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 TransformStore::create()
+    {
+        uint32 handle;
+
+        if (m_freeList.empty())
+        {
+            handle = static_cast<uint32>(m_alive.size());
+
+            m_locals.emplace_back();
+            m_world.emplace_back(1.f);
+            m_parents.push_back(NullHandle);
+            m_restrictions.push_back(0);
+            m_versions.push_back(0);
+            m_parentVersions.push_back(0);
+            m_dirty.push_back(1);
+            m_alive.push_back(1);
+        }
+        else
+        {
+            handle = m_freeList.back();
+            m_freeList.pop_back();
+
+            m_parents[handle] = NullHandle;
+            m_restrictions[handle] = 0;
+            m_dirty[handle] = 1;
+            m_alive[handle] = 1;
+        }
+
+        auto& locals = m_locals[handle];
+        locals.position = glm::vec3(0.f);
+        locals.scale = glm::vec3(1.f);
+        locals.rotation = glm::quat(1.f, 0.f, 0.f, 0.f);
+
+        // Versions keep counting across reuse, so a stale version
+        // held by a previous owner can't match
+        ++m_versions[handle];
+
+        m_orderDirty = true;
+        m_modified = true;
+
+        return handle;
+    }
+
+    //////////////////////////////////////////////
+
+    void TransformStore::destroy(const uint32 handle)
+    {
+        JOP_ASSERT(m_alive[handle], "Tried to destroy a transform that doesn't exist!");
+
+        m_alive[handle] = 0;
+        m_parents[handle] = NullHandle;
+        m_freeList.push_back(handle);
+
+        m_orderDirty = true;
+    }
+
+    //////////////////////////////////////////////
+
+    void TransformStore::setParent(const uint32 handle, const uint32 parent)
+    {
+        if (m_parents[handle] != parent)
+        {
+            m_parents[handle] = parent;
+            m_dirty[handle] = 1;
+
+            m_orderDirty = true;
+            m_modified = true;
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    void TransformStore::setLocals(const uint32 handle, const Transform::Variables& locals)
+    {
+        m_locals[handle] = locals;
+        m_dirty[handle] = 1;
+        m_modified = true;
+    }
+
+    //////////////////////////////////////////////
+
+    void TransformStore::setRestrictions(const uint32 handle, const uint32 restrictions)
+    {
+        m_restrictions[handle] = restrictions;
+        m_dirty[handle] = 1;
+        m_modified = true;
+    }
+
+    //////////////////////////////////////////////
+
+    const glm::mat4& TransformStore::getWorld(const uint32 handle)
+    {
+        if (m_modified)
+            refresh(handle);
+
+        return m_world[handle];
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 TransformStore::getVersion(const uint32 handle) const
+    {
+        return m_versions[handle];
+    }
+
+    //////////////////////////////////////////////
+
+    void TransformStore::update()
+    {
+        if (!m_modified)
+            return;
+
+        JOP_PROFILE("TransformStore::update");
+
+        if (m_orderDirty)
+            rebuildOrder();
+
+        // Parents come before their children, so a single pass is enough
+        for (auto i : m_order)
+        {
+            const uint32 parent = m_parents[i];
+
+            if (m_dirty[i] || (parent != NullHandle && m_parentVersions[i] != m_versions[parent]))
+                compute(i);
+        }
+
+        m_modified = false;
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 TransformStore::size() const
+    {
+        return static_cast<uint32>(m_alive.size() - m_freeList.size());
+    }
+
+    //////////////////////////////////////////////
+
+    void TransformStore::refresh(const uint32 handle)
+    {
+        const uint32 parent = m_parents[handle];
+
+        if (parent != NullHandle)
+            refresh(parent);
+
+        if (m_dirty[handle] || (parent != NullHandle && m_parentVersions[handle] != m_versions[parent]))
+            compute(handle);
+    }
+
+    //////////////////////////////////////////////
+
+    void TransformStore::compute(const uint32 handle)
+    {
+        const auto& locals = m_locals[handle];
+        const uint32 restrictions = m_restrictions[handle];
+        const uint32 parent = m_parents[handle];
+
+        Transform transform;
+        transform.translate(locals.position);
+        transform.rotate(locals.rotation);
+        transform.scale(locals.scale);
+
+        if (parent != NullHandle && (restrictions & Object::IgnoreParent) != Object::IgnoreParent)
+        {
+            Transform globalTrans(m_world[parent]);
+            glm::mat4& globalMat = globalTrans.getMatrix();
+
+            if (restrictions & Object::ScaleX) globalMat[0] = glm::normalize(globalMat[0]);
+            if (restrictions & Object::ScaleY) globalMat[1] = glm::normalize(globalMat[1]);
+            if (restrictions & Object::ScaleZ) globalMat[2] = glm::normalize(globalMat[2]);
+
+            if (restrictions & Object::Rotation)
+            {
+                const glm::vec3 scl
+                (
+                    glm::length(globalMat[0]),
+                    glm::length(globalMat[1]),
+                    glm::length(globalMat[2])
+                );
+
+                transform.getMatrix()[3] = glm::quat(globalMat) * transform.getMatrix()[3];
+
+                globalMat[0] = glm::mat4::col_type(scl.x, 0.f, 0.f, 0.f);
+                globalMat[1] = glm::mat4::col_type(0.f, scl.y, 0.f, 0.f);
+                globalMat[2] = glm::mat4::col_type(0.f, 0.f, scl.z, 0.f);
+            }
+
+            if (restrictions & Object::Translation)
+            {
+                glm::mat4& localMat = transform.getMatrix();
+
+                for (int i = 0; i < 3; ++i)
+                {
+                    if (restrictions & (Object::TranslationX << i))
+                    {
+                        globalMat[3][i] = 0.f;
+                        localMat[3][i] = locals.position[i];
+                    }
+                }
+            }
+
+            transform = globalTrans * transform;
+        }
+
+        if (parent != NullHandle)
+            m_parentVersions[handle] = m_versions[parent];
+
+        m_world[handle] = transform.getMatrix();
+        m_dirty[handle] = 0;
+        ++m_versions[handle];
+    }
+
+    //////////////////////////////////////////////
+
+    void TransformStore::rebuildOrder()
+    {
+        const uint32 count = static_cast<uint32>(m_alive.size());
+
+        m_depths.assign(count, ns_unknownDepth);
+
+        // Resolve depths, memoizing every node on the way up
+        uint32 maxDepth = 0;
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            if (!m_alive[i] || m_depths[i] != ns_unknownDepth)
+                continue;
+
+            uint32 top = i;
+            uint32 steps = 0;
+
+            while (m_parents[top] != NullHandle && m_depths[m_parents[top]] == ns_unknownDepth)
+            {
+                top = m_parents[top];
+                ++steps;
+            }
+
+            uint32 depth = (m_parents[top] == NullHandle ? 0 : m_depths[m_parents[top]] + 1) + steps;
+            maxDepth = std::max(maxDepth, depth);
+
+            for (uint32 node = i; node != m_parents[top]; node = m_parents[node], --depth)
+                m_depths[node] = depth;
+        }
+
+        // Counting sort by depth
+        std::vector<uint32> offsets(maxDepth + 2, 0);
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            if (m_alive[i])
+                ++offsets[m_depths[i] + 1];
+        }
+
+        for (uint32 i = 1; i < offsets.size(); ++i)
+            offsets[i] += offsets[i - 1];
+
+        m_order.resize(offsets.back());
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            if (m_alive[i])
+                m_order[offsets[m_depths[i]]++] = i;
+        }
+
+        m_orderDirty = false;
+    }
+}}
@@ -0,0 +1,108 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+#ifndef JOP_TRANSFORMSTORE_HPP
+#define JOP_TRANSFORMSTORE_HPP
+
+// Headers
+#include <Jopnal/Header.hpp>
+#include <Jopnal/Graphics/Transform.hpp>
+#include <vector>
+
+//////////////////////////////////////////////
+
+
+namespace jop { namespace detail
+{
+    class JOP_API TransformStore
+    {
+    private:
+
+        JOP_DISALLOW_COPY_MOVE(TransformStore);
+
+        TransformStore();
+
+    public:
+
+        static const uint32 NullHandle;
+
+
+        static TransformStore& getInstance();
+
+
+        uint32 create();
+
+        void destroy(const uint32 handle);
+
+        void setParent(const uint32 handle, const uint32 parent);
+
+        void setLocals(const uint32 handle, const Transform::Variables& locals);
+
+        void setRestrictions(const uint32 handle, const uint32 restrictions);
+
+        const glm::mat4& getWorld(const uint32 handle);
+
+        uint32 getVersion(const uint32 handle) const;
+
+        void update();
+
+        uint32 size() const;
+
+    private:
+
+        void refresh(const uint32 handle);
+
+        void compute(const uint32 handle);
+
+        void rebuildOrder();
+
+
+        // Per-node data, indexed by handle
+        std::vector<Transform::Variables> m_locals; ///< Local transformation variables
+        std::vector<glm::mat4> m_world;             ///< Global matrices
+        std::vector<uint32> m_parents;              ///< Parent handles
+        std::vector<uint32> m_restrictions;         ///< Transform restriction flags
+        std::vector<uint32> m_versions;             ///< Incremented every time the global matrix changes
+        std::vector<uint32> m_parentVersions;       ///< Parent version the global matrix was computed with
+        std::vector<uint8> m_dirty;                 ///< Local transformation changed
+        std::vector<uint8> m_alive;                 ///< Is the handle in use
+
+        std::vector<uint32> m_order;                ///< Live handles, parents before children
+        std::vector<uint32> m_depths;               ///< Depth buffer used when sorting
+        std::vector<uint32> m_freeList;             ///< Free handles
+        bool m_orderDirty;                          ///< Hierarchy changed since the order was built
+        bool m_modified;                            ///< Anything changed since the last update
+    };
+}}
+
+/// \class jop::TransformStore
+/// \ingroup core
+///
+/// Flat storage for the transformations of all objects.
+///
+/// Object keeps its transformation API and holds a handle into this store.
+/// Changing a local transformation only marks that node dirty. Children notice
+/// the change by comparing the parent's version, so nothing is propagated
+/// through the object tree. update() resolves every node in a single linear pass.
+/// Reads in between are still exact, since getWorld() resolves the parent chain
+/// on demand.
+
+#endif
\ No newline at end of file
@@ -28,7 +28,11 @@
 
     #include <Jopnal/Core/DebugHandler.hpp>
     #include <Jopnal/Core/Scene.hpp>
+    #include <Jopnal/Core/Hierarchy/ObjectIndex.hpp>
+    #include <Jopnal/Core/Hierarchy/TransformStore.hpp>
     #include <Jopnal/Utility/CommandHandler.hpp>
+    #include <algorithm>
+    #include <atomic>
 
 #endif
 
@@ -39,6 +43,8 @@ namespace jop
 {
     JOP_REGISTER_COMMAND_HANDLER(Object)
 
+        JOP_COMMAND_RECEIVERS(Message::Object);
+
         // Transform
         JOP_BIND_MEMBER_COMMAND((Object& (Object::*)(const float, const float, const float))&Object::setRotation, "setRotation");
         JOP_BIND_MEMBER_COMMAND((Object& (Object::*)(const float, const float, const float))&Object::setScale, "setScale");
@@ -82,18 +88,29 @@ namespace jop
 
 namespace jop
 {
+    uint32 detail::nextComponentTypeID()
+    {
+        // 0 is reserved for components of unknown type
+        static std::atomic<uint32> counter(0);
+        return ++counter;
+    }
+
+    //////////////////////////////////////////////
+
     Object::Object(const std::string& ID)
         : SafeReferenceable<Object> (this),
           m_transform               (),
           m_inverseTransform        (),
           m_locals                  (),
           m_globals                 (),
+          m_transformHandle         (detail::TransformStore::getInstance().create()),
+          m_transformVersion        (0),
           m_children                (),
           m_components              (),
           m_tags                    (),
           m_ID                      (),
           m_parent                  (),
-          m_flags                   (ActiveFlag | MatrixDirty | InverseMatrixDirty | GlobalPositionDirty | GlobalRotationDirty | GlobalScaleDirty)
+          m_flags                   (ActiveFlag | TransformDirty)
     {
         setID(ID);
 
@@ -108,15 +125,27 @@ namespace jop
           m_inverseTransform        (),
           m_locals                  (newTransform),
           m_globals                 (),
+          m_transformHandle         (detail::TransformStore::getInstance().create()),
+          m_transformVersion        (0),
           m_children                (),
           m_components              (),
           m_tags                    (other.m_tags),
           m_ID                      (),
           m_parent                  (other.m_parent),
-          m_flags                   (other.m_flags | MatrixDirty | InverseMatrixDirty | GlobalPositionDirty | GlobalRotationDirty | GlobalScaleDirty)
+          m_flags                   (other.m_flags | TransformDirty)
     {
         setID(newID);
 
+        for (auto& i : m_tags)
+            detail::ObjectIndex::getInstance().addTag(i, *this);
+
+        auto& store = detail::TransformStore::getInstance();
+        store.setLocals(m_transformHandle, m_locals);
+        store.setRestrictions(m_transformHandle, m_flags & IgnoreParent);
+
+        if (!m_parent.expired())
+            store.setParent(m_transformHandle, m_parent->m_transformHandle);
+
         m_components.reserve(other.m_components.size());
         for (auto& i : other.m_components)
         {
@@ -130,7 +159,7 @@ namespace jop
         for (auto& i : other.m_children)
         {
             m_children.emplace_back(i, i.getID(), i.m_locals);
-            m_children.back().m_parent = *this;
+            m_children.back().attachTo(*this);
         }
     }
 
@@ -140,17 +169,39 @@ namespace jop
           m_inverseTransform        (),
           m_locals                  (other.m_locals),
           m_globals                 (),
+          m_transformHandle         (other.m_transformHandle),
+          m_transformVersion        (0),
           m_children                (std::move(other.m_children)),
           m_components              (std::move(other.m_components)),
           m_tags                    (std::move(other.m_tags)),
           m_ID                      (std::move(other.m_ID)),
           m_parent                  (other.m_parent),
-          m_flags                   (other.m_flags | MatrixDirty | InverseMatrixDirty | GlobalPositionDirty | GlobalRotationDirty | GlobalScaleDirty)
-    {}
+          m_flags                   (other.m_flags | TransformDirty)
+    {
+        other.m_transformHandle = detail::TransformStore::NullHandle;
+
+        // Point the index to the new address
+        auto& index = detail::ObjectIndex::getInstance();
+
+        index.removeID(m_ID, other);
+        index.addID(m_ID, *this);
+
+        for (auto& i : m_tags)
+        {
+            index.removeTag(i, other);
+            index.addTag(i, *this);
+        }
+
+        other.m_ID.clear();
+        other.m_tags.clear();
+    }
 
     Object& Object::operator=(Object&& other)
     {
         SafeReferenceable<Object>::operator =(std::move(other));
+
+        unindexSelf();
+        other.unindexSelf();
         
         m_locals        = other.m_locals;
         m_children      = std::move(other.m_children);
@@ -158,7 +209,18 @@ namespace jop
         m_tags          = std::move(other.m_tags);
         m_ID            = std::move(other.m_ID);
         m_parent        = other.m_parent;
-        m_flags         = other.m_flags | MatrixDirty | InverseMatrixDirty | GlobalPositionDirty | GlobalRotationDirty | GlobalScaleDirty;
+        m_flags         = other.m_flags | TransformDirty;
+
+        if (m_transformHandle != detail::TransformStore::NullHandle)
+            detail::TransformStore::getInstance().destroy(m_transformHandle);
+
+        m_transformHandle = other.m_transformHandle;
+        m_transformVersion = 0;
+        other.m_transformHandle = detail::TransformStore::NullHandle;
+
+        other.m_ID.clear();
+        other.m_tags.clear();
+        indexSelf();
 
         return *this;
     }
@@ -168,6 +230,12 @@ namespace jop
         // These need to be cleared before anything else
         m_children.clear();
         m_components.clear();
+
+        unindexSelf();
+
+        // Children release their transforms first, so that no live node is left pointing to this one
+        if (m_transformHandle != detail::TransformStore::NullHandle)
+            detail::TransformStore::getInstance().destroy(m_transformHandle);
     }
 
     //////////////////////////////////////////////
@@ -217,7 +285,7 @@ namespace jop
     WeakReference<Object> Object::createChild(const std::string& ID)
     {
         m_children.emplace_back(ID);
-        m_children.back().m_parent = *this;
+        m_children.back().attachTo(*this);
 
         return m_children.back().getReference();
     }
@@ -235,8 +303,7 @@ namespace jop
             m_children.reserve(m_children.size() + 1);
 
         m_children.emplace_back(std::move(child));
-        m_children.back().m_parent = *this;
-        m_children.back().propagateFlags(TransformDirty);
+        m_children.back().attachTo(*this);
 
         child.removeSelf();
 
@@ -440,7 +507,7 @@ namespace jop
     {
         if (message.passFilter(Message::Object) && message.passFilter(getID()) && message.passFilter(m_tags))
         {
-            if (JOP_EXECUTE_COMMAND(Object, message.getString(), this) == Message::Result::Escape)
+            if (JOP_EXECUTE_COMMAND(Object, message, this) == Message::Result::Escape)
                 return Message::Result::Escape;
         }
 
@@ -478,10 +545,83 @@ namespace jop
         {
             return findID.empty() || childID.find(findID) != std::string::npos;
         }
+
+        // Sorts the objects into the order the depth-first tree walk finds them in,
+        // since the index buckets are unordered
+        void sortByTreeOrder(std::vector<const Object*>& objects)
+        {
+            if (objects.size() < 2)
+                return;
+
+            // Positions as child indices from the root, compared lexicographically.
+            // They're stored back to back, so that there's no allocation per object
+            struct Position
+            {
+                std::size_t begin;
+                std::size_t end;
+                const Object* object;
+            };
+
+            std::vector<std::size_t> indices;
+            std::vector<Position> positions;
+            positions.reserve(objects.size());
+
+            for (auto i : objects)
+            {
+                const std::size_t begin = indices.size();
+
+                for (const Object* obj = i; !obj->getParent().expired();)
+                {
+                    const Object& parent = *obj->getParent();
+
+                    indices.push_back(static_cast<std::size_t>(obj - parent.getChildren().data()));
+                    obj = &parent;
+                }
+
+                std::reverse(indices.begin() + begin, indices.end());
+                positions.push_back(Position{begin, indices.size(), i});
+            }
+
+            std::sort(positions.begin(), positions.end(), [&indices](const Position& left, const Position& right)
+            {
+                return std::lexicographical_compare(indices.begin() + left.begin, indices.begin() + left.end,
+                                                    indices.begin() + right.begin, indices.begin() + right.end);
+            });
+
+            for (std::size_t i = 0; i < objects.size(); ++i)
+                objects[i] = positions[i].object;
+        }
     }
 
     WeakReference<Object> Object::findChild(const std::string& ID, const bool recursive, const bool strict) const
     {
+        if (strict)
+        {
+            auto bucket = detail::ObjectIndex::getInstance().findID(ID);
+
+            if (!bucket)
+                return WeakReference<Object>();
+
+            // Going through the direct children is cheaper if there are fewer of them
+            if (recursive || bucket->size() < m_children.size())
+            {
+                std::vector<const Object*> found;
+
+                for (auto i : *bucket)
+                {
+                    if (recursive ? i->hasAncestor(*this) : i->m_parent.get() == this)
+                        found.push_back(i);
+                }
+
+                if (found.empty())
+                    return WeakReference<Object>();
+
+                detail::sortByTreeOrder(found);
+
+                return found.front()->getReference();
+            }
+        }
+
         auto method = strict ? &detail::findChildStrict : &detail::findChildLoose;
 
         for (auto& i : m_children)
@@ -509,6 +649,32 @@ namespace jop
 
         std::vector<WeakReference<Object>> vec;
 
+        if (strict)
+        {
+            auto bucket = detail::ObjectIndex::getInstance().findID(ID);
+
+            if (!bucket)
+                return vec;
+
+            if (recursive || bucket->size() < m_children.size())
+            {
+                std::vector<const Object*> found;
+
+                for (auto i : *bucket)
+                {
+                    if (recursive ? i->hasAncestor(*this) : i->m_parent.get() == this)
+                        found.push_back(i);
+                }
+
+                detail::sortByTreeOrder(found);
+
+                for (auto i : found)
+                    vec.push_back(i->getReference());
+
+                return vec;
+            }
+        }
+
         for (auto& i : m_children)
         {
             if (method(i.getID(), ID))
@@ -530,18 +696,35 @@ namespace jop
     {
         std::vector<WeakReference<Object>> vec;
 
-        for (auto& i : m_children)
-        {
-            if (i.hasTag(tag))
-                vec.push_back(i.getReference());
+        auto bucket = detail::ObjectIndex::getInstance().findTag(tag);
 
-            if (recursive)
+        if (!bucket)
+            return vec;
+
+        if (!recursive && bucket->size() >= m_children.size())
+        {
+            for (auto& i : m_children)
             {
-                auto ref = i.findChildrenWithTag(tag, true);
-                vec.insert(vec.end(), ref.begin(), ref.end());
+                if (i.hasTag(tag))
+                    vec.push_back(i.getReference());
             }
+
+            return vec;
+        }
+
+        std::vector<const Object*> found;
+
+        for (auto i : *bucket)
+        {
+            if (recursive ? i->hasAncestor(*this) : i->m_parent.get() == this)
+                found.push_back(i);
         }
 
+        detail::sortByTreeOrder(found);
+
+        for (auto i : found)
+            vec.push_back(i->getReference());
+
         return vec;
     }
 
@@ -625,6 +808,21 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    void Object::parallelUpdate(const float deltaTime)
+    {
+        // Removed objects are only swept in update(), they must be skipped here
+        if (isActive() && !isRemoved())
+        {
+            for (auto& i : m_components)
+                i->parallelUpdate(deltaTime);
+
+            for (auto& i : m_children)
+                i.parallelUpdate(deltaTime);
+        }
+    }
+
+    //////////////////////////////////////////////
+
     void Object::printDebugTree() const
     {
         printDebugTreeImpl(std::vector<uint32>(), false);
@@ -710,7 +908,11 @@ namespace jop
 
     Object& Object::setID(const std::string& ID)
     {
+        auto& index = detail::ObjectIndex::getInstance();
+
+        index.removeID(m_ID, *this);
         m_ID = ID;
+        index.addID(m_ID, *this);
 
     #ifdef JOP_DEBUG_MODE   
     
@@ -726,7 +928,9 @@ namespace jop
 
     Object& Object::addTag(const std::string& tag)
     {
-        m_tags.insert(tag);
+        if (m_tags.insert(tag).second)
+            detail::ObjectIndex::getInstance().addTag(tag, *this);
+
         return *this;
     }
 
@@ -734,7 +938,9 @@ namespace jop
 
     Object& Object::removeTag(const std::string& tag)
     {
-        m_tags.erase(tag);
+        if (m_tags.erase(tag) > 0)
+            detail::ObjectIndex::getInstance().removeTag(tag, *this);
+
         return *this;
     }
 
@@ -742,6 +948,9 @@ namespace jop
 
     Object& Object::clearTags()
     {
+        for (auto& i : m_tags)
+            detail::ObjectIndex::getInstance().removeTag(i, *this);
+
         m_tags.clear();
         return *this;
     }
@@ -780,72 +989,22 @@ namespace jop
 
     const Transform& Object::getTransform() const
     {
-        if (flagSet(MatrixDirty))
-        {
-            m_transform.getMatrix() = Transform::IdentityMatrix;
-            m_transform.translate(getLocalPosition());
-            m_transform.rotate(getLocalRotation());
-            m_transform.scale(getLocalScale());
-
-            if (!m_parent.expired() && !ignoresParent())
-            {
-                Transform globalTrans = m_parent->getTransform();
-                glm::mat4& globalMat = globalTrans.getMatrix();
-
-                if (flagSet(ScaleX)) globalMat[0] = glm::normalize(globalMat[0]);
-                if (flagSet(ScaleY)) globalMat[1] = glm::normalize(globalMat[1]);
-                if (flagSet(ScaleZ)) globalMat[2] = glm::normalize(globalMat[2]);
-                
-                if (flagSet(Rotation))
-                {
-                    const glm::vec3 scl
-                    (
-                        glm::length(globalMat[0]),
-                        glm::length(globalMat[1]),
-                        glm::length(globalMat[2])
-                    );
-
-                    m_transform.getMatrix()[3] = glm::quat(globalMat) * m_transform.getMatrix()[3];
-
-                    globalMat[0] = glm::mat4::col_type(scl.x, 0.f, 0.f, 0.f);
-                    globalMat[1] = glm::mat4::col_type(0.f, scl.y, 0.f, 0.f);
-                    globalMat[2] = glm::mat4::col_type(0.f, 0.f, scl.z, 0.f);
-                }
-
-                if (flagSet(Translation))
-                {
-                    glm::mat4& localMat = m_transform.getMatrix();
-
-                    if (flagSet(TranslationX))
-                    {
-                        globalMat[3][0] = 0.f;
-                        localMat[3][0] = getLocalPosition().x;
-                    }
-
-                    if (flagSet(TranslationY))
-                    {
-                        globalMat[3][1] = 0.f;
-                        localMat[3][1] = getLocalPosition().y;
-                    }
-
-                    if (flagSet(TranslationZ))
-                    {
-                        globalMat[3][2] = 0.f;
-                        localMat[3][2] = getLocalPosition().z;
-                    }
-                }
-
-                m_transform = globalTrans * m_transform;
-            }
-
-            clearFlags(MatrixDirty);
-        }
-
+        syncTransform();
         return m_transform;
     }
 
+    uint32 Object::getTransformVersion() const
+    {
+        syncTransform();
+        return m_transformVersion;
+    }
+
+    //////////////////////////////////////////////
+
     const Transform& Object::getInverseTransform() const
     {
+        syncTransform();
+
         if (flagSet(InverseMatrixDirty))
         {
             m_inverseTransform.getMatrix() = glm::inverse(getTransform().getMatrix());
@@ -892,7 +1051,7 @@ namespace jop
     Object& Object::setRotation(const glm::quat& rotation)
     {
         m_locals.rotation = rotation;
-        propagateFlags(MatrixDirty | InverseMatrixDirty | GlobalRotationDirty | GlobalPositionDirty);
+        updateLocals();
 
         return *this;
     }
@@ -915,6 +1074,8 @@ namespace jop
 
     const glm::quat& Object::getGlobalRotation() const
     {
+        syncTransform();
+
         if (flagSet(GlobalRotationDirty))
         {
             if (m_parent.expired() || ignoresTransform(Rotation))
@@ -982,7 +1143,7 @@ namespace jop
     Object& Object::setScale(const glm::vec3& scale)
     {
         m_locals.scale = scale;
-        propagateFlags(MatrixDirty | InverseMatrixDirty | GlobalScaleDirty | GlobalPositionDirty);
+        updateLocals();
 
         return *this;
     }
@@ -1005,6 +1166,8 @@ namespace jop
 
     const glm::vec3& Object::getGlobalScale() const
     {
+        syncTransform();
+
         if (flagSet(GlobalScaleDirty))
         {
             const auto& mat = getTransform().getMatrix();
@@ -1034,7 +1197,7 @@ namespace jop
     Object& Object::setPosition(const glm::vec3& position)
     {
         m_locals.position = position;
-        propagateFlags(MatrixDirty | InverseMatrixDirty | GlobalPositionDirty);
+        updateLocals();
 
         return *this;
     }
@@ -1050,6 +1213,8 @@ namespace jop
 
     const glm::vec3& Object::getGlobalPosition() const
     {
+        syncTransform();
+
         if (flagSet(GlobalPositionDirty))
         {
             const auto& mat = getTransform().getMatrix();
@@ -1161,6 +1326,10 @@ namespace jop
     Object& Object::setIgnoreParent(const bool ignore)
     {
         ignore ? setFlags(IgnoreParent) : clearFlags(IgnoreParent);
+
+        if (m_transformHandle != detail::TransformStore::NullHandle)
+            detail::TransformStore::getInstance().setRestrictions(m_transformHandle, m_flags & IgnoreParent);
+
         return *this;
     }
 
@@ -1175,7 +1344,11 @@ namespace jop
 
     Object& Object::setIgnoreTransform(const uint32 flags)
     {
-        setFlags((flags & IgnoreParent) | TransformDirty);
+        setFlags(flags & IgnoreParent);
+
+        if (m_transformHandle != detail::TransformStore::NullHandle)
+            detail::TransformStore::getInstance().setRestrictions(m_transformHandle, m_flags & IgnoreParent);
+
         return *this;
     }
 
@@ -1208,11 +1381,72 @@ namespace jop
         (m_flags &= ~flags) |= (flags * cond);
     }
 
-    void Object::propagateFlags(const uint32 flags)
+    void Object::attachTo(Object& parent)
     {
-        setFlags(flags);
+        m_parent = parent;
 
-        for (auto& i : m_children)
-            i.propagateFlags(flags);
+        if (m_transformHandle != detail::TransformStore::NullHandle)
+            detail::TransformStore::getInstance().setParent(m_transformHandle, parent.m_transformHandle);
+    }
+
+    void Object::updateLocals()
+    {
+        if (m_transformHandle != detail::TransformStore::NullHandle)
+            detail::TransformStore::getInstance().setLocals(m_transformHandle, m_locals);
+    }
+
+    void Object::syncTransform() const
+    {
+        if (m_transformHandle == detail::TransformStore::NullHandle)
+            return;
+
+        auto& store = detail::TransformStore::getInstance();
+        const glm::mat4& world = store.getWorld(m_transformHandle);
+
+        // The version changes whenever this node or any of its parents was modified
+        if (store.getVersion(m_transformHandle) != m_transformVersion)
+        {
+            m_transform.getMatrix() = world;
+            m_transformVersion = store.getVersion(m_transformHandle);
+
+            setFlags(TransformDirty);
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    void Object::indexSelf() const
+    {
+        auto& index = detail::ObjectIndex::getInstance();
+
+        index.addID(m_ID, *this);
+
+        for (auto& i : m_tags)
+            index.addTag(i, *this);
+    }
+
+    //////////////////////////////////////////////
+
+    void Object::unindexSelf() const
+    {
+        auto& index = detail::ObjectIndex::getInstance();
+
+        index.removeID(m_ID, *this);
+
+        for (auto& i : m_tags)
+            index.removeTag(i, *this);
+    }
+
+    //////////////////////////////////////////////
+
+    bool Object::hasAncestor(const Object& ancestor) const
+    {
+        for (auto obj = m_parent.get(); obj; obj = obj->m_parent.get())
+        {
+            if (obj == &ancestor)
+                return true;
+        }
+
+        return false;
     }
 }
\ No newline at end of file
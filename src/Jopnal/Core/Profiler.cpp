@@ -0,0 +1,457 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+// Headers
+#include JOP_PRECOMPILED_HEADER_FILE
+
+#ifndef JOP_PRECOMPILED_HEADER
+
+    #include <Jopnal/Core/Profiler.hpp>
+
+    #include <Jopnal/Core/DebugHandler.hpp>
+    #include <Jopnal/Core/FileLoader.hpp>
+    #include <Jopnal/Core/SettingManager.hpp>
+    #include <Jopnal/Utility/CommandHandler.hpp>
+    #include <algorithm>
+    #include <array>
+    #include <atomic>
+    #include <chrono>
+    #include <deque>
+    #include <iomanip>
+    #include <mutex>
+    #include <sstream>
+    #include <unordered_map>
+
+#endif
+
+//////////////////////////////////////////////
+
+
+namespace
+{
+    struct Event
+    {
+        jop::uint32 node;
+        jop::uint64 start;
+        jop::uint64 end;
+    };
+
+    // Single producer, single consumer ring. The owning thread pushes,
+    // the main thread collects at the end of the frame
+    struct Ring
+    {
+        static const jop::uint32 Capacity = 1 << 12;
+
+        std::array<Event, Capacity> events;
+        std::atomic<jop::uint32> head;
+        std::atomic<jop::uint32> tail;
+        std::atomic<jop::uint32> dropped;
+        jop::uint32 thread;
+        bool gpu;
+
+        Ring(const jop::uint32 threadIndex, const bool gpuTrack)
+            : events(), head(0), tail(0), dropped(0), thread(threadIndex), gpu(gpuTrack)
+        {}
+
+        void push(const jop::uint32 node, const jop::uint64 start, const jop::uint64 end)
+        {
+            const jop::uint32 h = head.load(std::memory_order_relaxed);
+
+            if (h - tail.load(std::memory_order_acquire) >= Capacity)
+            {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            auto& event = events[h & (Capacity - 1)];
+            event.node = node;
+            event.start = start;
+            event.end = end;
+
+            head.store(h + 1, std::memory_order_release);
+        }
+    };
+
+    struct ScopeRecord
+    {
+        jop::uint64 calls;
+        jop::uint64 frameTime;
+        double average;
+        double last;
+        double max;
+    };
+
+    struct TraceEvent
+    {
+        Event event;
+        jop::uint32 thread;
+    };
+
+    // Node in the scope tree. The same name in a different parent is a different node
+    struct Node
+    {
+        jop::uint32 label;
+        jop::uint32 parent;
+        jop::uint32 depth;
+    };
+
+    // Parents of the top level CPU scopes and GPU events
+    const jop::uint32 ns_rootNode = ~0u;
+    const jop::uint32 ns_gpuRootNode = ~0u - 1;
+
+    const auto ns_epoch = std::chrono::steady_clock::now();
+
+    std::mutex ns_ringMutex;
+    std::vector<std::unique_ptr<Ring>> ns_rings;
+    thread_local Ring* ns_ring = nullptr;
+    Ring* ns_gpuRing = nullptr;
+
+    // Scope names are interned by content, so the same name coming from
+    // different translation units ends up in the same node
+    std::mutex ns_tableMutex;
+    std::unordered_map<std::string, jop::uint32> ns_labelIds;
+    std::deque<std::string> ns_labels;
+    std::unordered_map<jop::uint64, jop::uint32> ns_nodeIds;
+    std::vector<Node> ns_nodes;
+
+    // Per thread caches, the tables are only locked the first time a thread enters a scope
+    thread_local std::unordered_map<const char*, jop::uint32> ns_labelCache;
+    thread_local std::unordered_map<jop::uint64, jop::uint32> ns_nodeCache;
+    thread_local jop::uint32 ns_currentNode = ns_rootNode;
+
+    // Only touched by the main thread. Indexed by node
+    std::vector<ScopeRecord> ns_records;
+    std::deque<TraceEvent> ns_trace;
+
+    Ring& createRing(const bool gpu)
+    {
+        std::lock_guard<std::mutex> lock(ns_ringMutex);
+
+        ns_rings.emplace_back(std::make_unique<Ring>(static_cast<jop::uint32>(ns_rings.size()), gpu));
+        return *ns_rings.back();
+    }
+
+    Ring& getRing()
+    {
+        if (!ns_ring)
+            ns_ring = &createRing(false);
+
+        return *ns_ring;
+    }
+
+    jop::uint32 getLabel(const char* name)
+    {
+        auto itr = ns_labelCache.find(name);
+
+        if (itr != ns_labelCache.end())
+            return itr->second;
+
+        std::lock_guard<std::mutex> lock(ns_tableMutex);
+
+        auto result = ns_labelIds.emplace(name, static_cast<jop::uint32>(ns_labels.size()));
+
+        if (result.second)
+            ns_labels.emplace_back(name);
+
+        return ns_labelCache[name] = result.first->second;
+    }
+
+    jop::uint32 getNode(const jop::uint32 parent, const jop::uint32 label)
+    {
+        const jop::uint64 key = (static_cast<jop::uint64>(parent) << 32) | label;
+
+        auto itr = ns_nodeCache.find(key);
+
+        if (itr != ns_nodeCache.end())
+            return itr->second;
+
+        std::lock_guard<std::mutex> lock(ns_tableMutex);
+
+        auto result = ns_nodeIds.emplace(key, static_cast<jop::uint32>(ns_nodes.size()));
+
+        if (result.second)
+        {
+            const bool root = parent == ns_rootNode || parent == ns_gpuRootNode;
+            ns_nodes.push_back({label, parent, root ? 0 : ns_nodes[parent].depth + 1});
+        }
+
+        return ns_nodeCache[key] = result.first->second;
+    }
+}
+
+namespace jop
+{
+    JOP_REGISTER_COMMAND_HANDLER(Profiler)
+
+        JOP_COMMAND_RECEIVERS(Message::Subsystem);
+
+        JOP_BIND_MEMBER_COMMAND(&Profiler::printStatistics, "printProfile");
+        JOP_BIND_MEMBER_COMMAND(&Profiler::exportTrace, "exportProfile");
+
+    JOP_END_COMMAND_HANDLER(Profiler)
+}
+
+namespace jop
+{
+    Profiler::Scope::Scope(const char* name)
+        : m_node    (getNode(ns_currentNode, getLabel(name))),
+          m_parent  (ns_currentNode),
+          m_start   (now())
+    {
+        ns_currentNode = m_node;
+    }
+
+    Profiler::Scope::~Scope()
+    {
+        getRing().push(m_node, m_start, now());
+        ns_currentNode = m_parent;
+    }
+
+    //////////////////////////////////////////////
+
+    Profiler::Profiler()
+        : Subsystem(0)
+    {}
+
+    Profiler::~Profiler()
+    {}
+
+    //////////////////////////////////////////////
+
+    void Profiler::draw()
+    {
+        static const uint32 maxTraceEvents = SettingManager::get<unsigned int>("engine@Profiler|uTraceEvents", 100000);
+        static const double smoothing = 0.05;
+
+        {
+            std::lock_guard<std::mutex> lock(ns_ringMutex);
+
+            for (auto& ring : ns_rings)
+            {
+                const uint32 tail = ring->tail.load(std::memory_order_relaxed);
+                const uint32 head = ring->head.load(std::memory_order_acquire);
+
+                for (uint32 i = tail; i != head; ++i)
+                {
+                    const Event& event = ring->events[i & (Ring::Capacity - 1)];
+
+                    if (event.node >= ns_records.size())
+                        ns_records.resize(event.node + 1, ScopeRecord());
+
+                    auto& record = ns_records[event.node];
+                    ++record.calls;
+                    record.frameTime += event.end - event.start;
+
+                    if (maxTraceEvents > 0)
+                    {
+                        if (ns_trace.size() >= maxTraceEvents)
+                            ns_trace.pop_front();
+
+                        ns_trace.push_back({event, ring->thread});
+                    }
+                }
+
+                ring->tail.store(head, std::memory_order_release);
+
+                const uint32 dropped = ring->dropped.exchange(0, std::memory_order_relaxed);
+
+                if (dropped > 0)
+                    JOP_DEBUG_WARNING("Profiler ring buffer of thread " << ring->thread << " overflowed, " << dropped << " scopes were dropped");
+            }
+        }
+
+        for (auto& record : ns_records)
+        {
+            record.last = record.frameTime / 1000000.0;
+            record.average += (record.last - record.average) * smoothing;
+            record.max = std::max(record.max, record.last);
+            record.frameTime = 0;
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    std::vector<Profiler::Statistics> Profiler::getStatistics() const
+    {
+        std::lock_guard<std::mutex> lock(ns_tableMutex);
+
+        // Nodes recorded during this frame haven't been collected yet
+        const uint32 numNodes = static_cast<uint32>(std::min(ns_nodes.size(), ns_records.size()));
+
+        std::vector<std::vector<uint32>> children(numNodes);
+        std::vector<uint32> roots;
+
+        for (uint32 i = 0; i < numNodes; ++i)
+        {
+            const uint32 parent = ns_nodes[i].parent;
+
+            if (parent == ns_rootNode || parent == ns_gpuRootNode)
+                roots.push_back(i);
+            else
+                children[parent].push_back(i);
+        }
+
+        auto sortNodes = [](std::vector<uint32>& nodes)
+        {
+            std::sort(nodes.begin(), nodes.end(), [](const uint32 a, const uint32 b)
+            {
+                const bool gpuA = ns_nodes[a].parent == ns_gpuRootNode;
+                const bool gpuB = ns_nodes[b].parent == ns_gpuRootNode;
+
+                return gpuA != gpuB ? gpuB : ns_records[a].average > ns_records[b].average;
+            });
+        };
+
+        std::vector<Statistics> stats;
+        stats.reserve(numNodes);
+
+        // Depth first, parents are always created before their children
+        std::vector<uint32> stack(roots);
+        sortNodes(stack);
+        std::reverse(stack.begin(), stack.end());
+
+        while (!stack.empty())
+        {
+            const uint32 node = stack.back();
+            stack.pop_back();
+
+            auto& record = ns_records[node];
+            auto& info = ns_nodes[node];
+
+            uint32 root = node;
+            while (ns_nodes[root].depth > 0)
+                root = ns_nodes[root].parent;
+
+            stats.push_back({ns_labels[info.label], info.depth, ns_nodes[root].parent == ns_gpuRootNode, record.calls, record.average, record.last, record.max});
+
+            auto& nested = children[node];
+            sortNodes(nested);
+            stack.insert(stack.end(), nested.rbegin(), nested.rend());
+        }
+
+        return stats;
+    }
+
+    //////////////////////////////////////////////
+
+    void Profiler::printStatistics() const
+    {
+        std::ostringstream stream;
+        stream << std::fixed << std::setprecision(3) << "Profiler statistics (ms):";
+
+        bool gpu = false;
+
+        for (auto& i : getStatistics())
+        {
+            if (i.gpu && !gpu)
+            {
+                stream << "\n    GPU:";
+                gpu = true;
+            }
+
+            // Nested scopes are indented under their parents
+            stream << "\n    " << std::left << std::setw(48) << (std::string(i.depth * 2, ' ') + i.name)
+                   << " avg " << i.average << "  last " << i.last << "  max " << i.max << "  calls " << i.calls;
+        }
+
+        DebugHandler::getInstance() << DebugHandler::Severity::__Always << stream.str() << std::endl;
+    }
+
+    //////////////////////////////////////////////
+
+    bool Profiler::exportTrace(const std::string& path) const
+    {
+        std::ostringstream stream;
+        stream << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+
+        // Name the tracks
+        {
+            std::lock_guard<std::mutex> lock(ns_ringMutex);
+
+            for (auto& ring : ns_rings)
+            {
+                stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << ring->thread << ",\"args\":{\"name\":\"";
+
+                if (ring->gpu)
+                    stream << "GPU";
+                else
+                    stream << "Thread " << ring->thread;
+
+                stream << "\"}},";
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(ns_tableMutex);
+
+        for (auto& i : ns_trace)
+        {
+            // Trace event timestamps are in microseconds
+            stream << "{\"name\":\"" << ns_labels[ns_nodes[i.event.node].label]
+                   << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << i.thread
+                   << ",\"ts\":" << i.event.start / 1000.0
+                   << ",\"dur\":" << (i.event.end - i.event.start) / 1000.0 << "},";
+        }
+
+        // Drop the trailing comma
+        std::string trace = stream.str();
+
+        if (trace.back() == ',')
+            trace.pop_back();
+
+        trace += "],\"displayTimeUnit\":\"ms\"}";
+
+        if (!FileLoader::writeTextfile(FileLoader::Directory::User, path, trace))
+        {
+            JOP_DEBUG_ERROR("Failed to export profiler trace to \"" << path << "\"");
+            return false;
+        }
+
+        JOP_DEBUG_INFO("Profiler trace with " << ns_trace.size() << " events exported to \"" << path << "\"");
+        return true;
+    }
+
+    //////////////////////////////////////////////
+
+    uint64 Profiler::now()
+    {
+        return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - ns_epoch).count());
+    }
+
+    //////////////////////////////////////////////
+
+    void Profiler::recordGpu(const char* name, const uint64 start, const uint64 end)
+    {
+        if (!ns_gpuRing)
+            ns_gpuRing = &createRing(true);
+
+        ns_gpuRing->push(getNode(ns_gpuRootNode, getLabel(name)), start, end);
+    }
+
+    //////////////////////////////////////////////
+
+    Message::Result Profiler::receiveMessage(const Message& message)
+    {
+        if (JOP_EXECUTE_COMMAND(Profiler, message, this) == Message::Result::Escape)
+            return Message::Result::Escape;
+
+        return Subsystem::receiveMessage(message);
+    }
+}
\ No newline at end of file
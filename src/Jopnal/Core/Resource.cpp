@@ -26,6 +26,8 @@
 
     #include <Jopnal/Core/Resource.hpp>
 
+    #include <Jopnal/Core/ResourceManager.hpp>
+
 #endif
 
 //////////////////////////////////////////////
@@ -36,13 +38,21 @@ namespace jop
     Resource::Resource(const std::string& name)
         : SafeReferenceable<Resource>   (this),
           m_name                        (name),
-          m_persistence                 (USHRT_MAX)
+          m_persistence                 (USHRT_MAX),
+          m_reloader                    (),
+          m_lastUsed                    (m_frame),
+          m_evicted                     (false),
+          m_reloadQueued                (false)
     {}
 
     Resource::Resource(const Resource& other, const std::string& newName)
         : SafeReferenceable<Resource>   (this),
           m_name                        (newName),
-          m_persistence                 (other.m_persistence)
+          m_persistence                 (other.m_persistence),
+          m_reloader                    (),
+          m_lastUsed                    (m_frame),
+          m_evicted                     (false),
+          m_reloadQueued                (false)
     {}
 
     Resource::~Resource()
@@ -68,4 +78,52 @@ namespace jop
     {
         return m_persistence;
     }
+
+    //////////////////////////////////////////////
+
+    Resource::MemoryUsage Resource::getMemoryUsage() const
+    {
+        MemoryUsage usage;
+        usage.cpu = 0;
+        usage.gpu = 0;
+
+        return usage;
+    }
+
+    //////////////////////////////////////////////
+
+    void Resource::markUsed() const
+    {
+        m_lastUsed = m_frame;
+
+        if (m_evicted && !m_reloadQueued)
+            ResourceManager::queueReload(const_cast<Resource&>(*this));
+    }
+
+    //////////////////////////////////////////////
+
+    bool Resource::isEvicted() const
+    {
+        return m_evicted;
+    }
+
+    //////////////////////////////////////////////
+
+    bool Resource::releaseMemory()
+    {
+        return false;
+    }
+
+    //////////////////////////////////////////////
+
+    void Resource::contentsChanged()
+    {
+        // Replaying the first load would lose the new contents
+        m_reloader = nullptr;
+        m_evicted = false;
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 Resource::m_frame = 0;
 }
\ No newline at end of file
@@ -26,6 +26,9 @@
 
     #include <Jopnal/Core/ResourceManager.hpp>
 
+    #include <Jopnal/Core/SettingManager.hpp>
+    #include <algorithm>
+
 #endif
 
 //////////////////////////////////////////////
@@ -48,21 +51,462 @@ namespace jop
         : Subsystem             (0),
           m_resources           (),
           m_loadPhaseResources  (),
+          m_asyncLoads          (),
+          m_asyncQueue          (),
+          m_reloadQueue         (),
+          m_asyncRequested      (0),
+          m_asyncFinished       (0),
+          m_uploadBudget        (SettingManager::get<float>("engine@Resources|fAsyncUploadBudget", 0.004f)),
+          m_budget              (),
+          m_typeBudgets         (),
+          m_evictions           (),
+          m_evictionIdleFrames  (SettingManager::get<unsigned int>("engine@Resources|uEvictionIdleFrames", 60)),
           m_loadPhase           (false),
           m_mutex               ()
     {
         JOP_ASSERT(m_instance == nullptr, "Only one jop::ResourceManager object must exist at a time!");
     
         m_instance = this;
+
+        m_budget.cpu = static_cast<std::size_t>(SettingManager::get<unsigned int>("engine@Resources|uCPUMemoryBudget", 0)) << 20;
+        m_budget.gpu = static_cast<std::size_t>(SettingManager::get<unsigned int>("engine@Resources|uGPUMemoryBudget", 0)) << 20;
     }
     
     ResourceManager::~ResourceManager()
     {
+        // Workers may still be preparing, they only touch the shared load states
         m_instance = nullptr;
     }
 
     //////////////////////////////////////////////
 
+    void ResourceManager::finishAsyncLoads()
+    {
+        if (!m_instance)
+            return;
+
+        auto& inst = *m_instance;
+
+        std::vector<std::shared_ptr<detail::AsyncLoad>> loads;
+        {
+            std::lock_guard<std::recursive_mutex> lock(inst.m_mutex);
+
+            loads = inst.m_asyncQueue;
+            loads.insert(loads.end(), inst.m_reloadQueue.begin(), inst.m_reloadQueue.end());
+        }
+
+        for (auto& i : loads)
+        {
+            JobSystem::getDefault().wait(i->counter);
+            inst.finishAsync(*i);
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 ResourceManager::getPendingLoads()
+    {
+        if (!m_instance)
+            return 0;
+
+        std::lock_guard<std::recursive_mutex> lock(m_instance->m_mutex);
+
+        return static_cast<uint32>(m_instance->m_asyncQueue.size());
+    }
+
+    //////////////////////////////////////////////
+
+    float ResourceManager::getLoadProgress()
+    {
+        if (!m_instance)
+            return 1.f;
+
+        std::lock_guard<std::recursive_mutex> lock(m_instance->m_mutex);
+
+        if (m_instance->m_asyncQueue.empty())
+            return 1.f;
+
+        return static_cast<float>(m_instance->m_asyncFinished) / m_instance->m_asyncRequested;
+    }
+
+    //////////////////////////////////////////////
+
+    void ResourceManager::setMemoryBudget(const std::size_t cpu, const std::size_t gpu)
+    {
+        if (m_instance)
+        {
+            std::lock_guard<std::recursive_mutex> lock(m_instance->m_mutex);
+
+            m_instance->m_budget.cpu = cpu;
+            m_instance->m_budget.gpu = gpu;
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    ResourceManager::MemoryStats ResourceManager::getMemoryStats()
+    {
+        MemoryStats total = {0, 0, 0, 0, 0};
+
+        for (auto& i : getMemoryStatsByType())
+        {
+            total.cpu += i.second.cpu;
+            total.gpu += i.second.gpu;
+            total.resources += i.second.resources;
+            total.evicted += i.second.evicted;
+            total.evictions += i.second.evictions;
+        }
+
+        return total;
+    }
+
+    //////////////////////////////////////////////
+
+    std::unordered_map<std::type_index, ResourceManager::MemoryStats> ResourceManager::getMemoryStatsByType()
+    {
+        std::unordered_map<std::type_index, MemoryStats> stats;
+
+        if (m_instance)
+        {
+            std::lock_guard<std::recursive_mutex> lock(m_instance->m_mutex);
+
+            for (auto& i : m_instance->m_resources)
+            {
+                auto itr = stats.find(i.first.second);
+
+                if (itr == stats.end())
+                {
+                    MemoryStats empty = {0, 0, 0, 0, 0};
+                    itr = stats.emplace(i.first.second, empty).first;
+                }
+
+                const auto usage = i.second->getMemoryUsage();
+
+                itr->second.cpu += usage.cpu;
+                itr->second.gpu += usage.gpu;
+                ++itr->second.resources;
+                itr->second.evicted += i.second->isEvicted();
+            }
+
+            for (auto& i : m_instance->m_evictions)
+            {
+                auto itr = stats.find(i.first);
+
+                if (itr != stats.end())
+                    itr->second.evictions = i.second;
+            }
+        }
+
+        return stats;
+    }
+
+    //////////////////////////////////////////////
+
+    void ResourceManager::setTypeBudget(const std::type_index& type, const std::size_t cpu, const std::size_t gpu)
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_instance->m_mutex);
+
+        if (cpu || gpu)
+        {
+            auto& budget = m_instance->m_typeBudgets[type];
+            budget.cpu = cpu;
+            budget.gpu = gpu;
+        }
+        else
+            m_instance->m_typeBudgets.erase(type);
+    }
+
+    //////////////////////////////////////////////
+
+    void ResourceManager::queueReload(Resource& resource)
+    {
+        if (!m_instance || !resource.m_reloader)
+            return;
+
+        auto state = std::make_shared<detail::AsyncLoad>(resource.getName(), std::type_index(typeid(resource)), true);
+        state->resource = resource.getReference();
+
+        resource.m_reloadQueued = true;
+        {
+            std::lock_guard<std::recursive_mutex> lock(m_instance->m_mutex);
+            m_instance->m_reloadQueue.push_back(state);
+        }
+
+        // Copied, since the resource may change before the worker gets to it
+        auto prepare = resource.m_reloader;
+
+        JobSystem::getDefault().run([state, prepare]()
+        {
+            JOP_PROFILE("ResourceManager::prepareReload");
+
+            state->upload = prepare();
+            state->status.store(detail::AsyncLoad::Prepared);
+
+        }, state->counter);
+    }
+
+    //////////////////////////////////////////////
+
+    void ResourceManager::preUpdate(const float)
+    {
+        ++Resource::m_frame;
+
+        updateAsync();
+        enforceBudgets();
+    }
+
+    //////////////////////////////////////////////
+
+    void ResourceManager::updateAsync()
+    {
+        std::vector<std::shared_ptr<detail::AsyncLoad>> loads;
+        {
+            std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+            if (m_asyncQueue.empty() && m_reloadQueue.empty())
+                return;
+
+            // Reloads share the upload budget, after the requested loads
+            loads = m_asyncQueue;
+            loads.insert(loads.end(), m_reloadQueue.begin(), m_reloadQueue.end());
+        }
+
+        JOP_PROFILE("ResourceManager::finishAsync");
+
+        // Without workers nothing gets prepared unless the jobs are waited for
+        const bool runJobs = JobSystem::getDefault().getWorkerCount() == 0;
+
+        Clock clk;
+
+        for (auto& i : loads)
+        {
+            if (runJobs)
+                JobSystem::getDefault().wait(i->counter);
+
+            else if (i->status.load() != detail::AsyncLoad::Prepared)
+                continue;
+
+            finishAsync(*i);
+
+            if (clk.getElapsedTime().asSeconds() >= m_uploadBudget)
+                break;
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    void ResourceManager::enforceBudgets()
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+        if (!m_budget.cpu && !m_budget.gpu && m_typeBudgets.empty())
+            return;
+
+        JOP_PROFILE("ResourceManager::enforceBudgets");
+
+        struct Candidate
+        {
+            uint32 lastUsed;
+            const std::type_index* type;
+            Resource* resource;
+        };
+
+        Resource::MemoryUsage total = {0, 0};
+        std::unordered_map<std::type_index, Resource::MemoryUsage> usage;
+        std::vector<Candidate> candidates;
+
+        for (auto& i : m_resources)
+        {
+            auto& res = *i.second;
+
+            if (res.m_evicted)
+                continue;
+
+            const auto mem = res.getMemoryUsage();
+
+            auto& typeUsage = usage[i.first.second];
+            typeUsage.cpu += mem.cpu;
+            typeUsage.gpu += mem.gpu;
+            total.cpu += mem.cpu;
+            total.gpu += mem.gpu;
+
+            if (res.m_reloader && res.getPersistence() != 0 && Resource::m_frame - res.m_lastUsed >= m_evictionIdleFrames)
+            {
+                Candidate c = {res.m_lastUsed, &i.first.second, &res};
+                candidates.push_back(c);
+            }
+        }
+
+        auto overBudget = [](const Resource::MemoryUsage& used, const Resource::MemoryUsage& budget)
+        {
+            return (budget.cpu && used.cpu > budget.cpu) || (budget.gpu && used.gpu > budget.gpu);
+        };
+
+        bool over = overBudget(total, m_budget);
+        for (auto& i : m_typeBudgets)
+        {
+            auto itr = usage.find(i.first);
+            over = over || (itr != usage.end() && overBudget(itr->second, i.second));
+        }
+
+        if (!over)
+            return;
+
+        // Least recently used first
+        std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b)
+        {
+            return a.lastUsed < b.lastUsed;
+        });
+
+        for (auto& i : candidates)
+        {
+            auto& typeUsage = usage[*i.type];
+            auto budgetItr = m_typeBudgets.find(*i.type);
+
+            if (!overBudget(total, m_budget) && (budgetItr == m_typeBudgets.end() || !overBudget(typeUsage, budgetItr->second)))
+                continue;
+
+            const auto mem = i.resource->getMemoryUsage();
+
+            if (i.resource->releaseMemory())
+            {
+                i.resource->m_evicted = true;
+
+                typeUsage.cpu -= mem.cpu;
+                typeUsage.gpu -= mem.gpu;
+                total.cpu -= mem.cpu;
+                total.gpu -= mem.gpu;
+
+                ++m_evictions[*i.type];
+
+                JOP_DEBUG_DIAG("\"" << i.resource->getName() << "\" (" << i.type->name() << ") evicted, freed " << mem.cpu << " CPU and " << mem.gpu << " GPU bytes");
+            }
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    void ResourceManager::finishAsync(detail::AsyncLoad& load)
+    {
+        if (load.status.load() != detail::AsyncLoad::Prepared)
+            return;
+
+        if (load.reload)
+        {
+            finishReload(load);
+            return;
+        }
+
+    #if JOP_CONSOLE_VERBOSITY >= 3
+        Clock clk;
+    #endif
+
+        auto res = load.finish ? load.finish() : nullptr;
+        load.finish = nullptr;
+
+        if (res)
+        {
+            // Allows the resource to be evicted, like the ones loaded synchronously
+            res->m_reloader = std::move(load.reloader);
+
+            load.resource = insert(load.key, std::move(res)).getReference();
+            load.status.store(detail::AsyncLoad::Done);
+
+            JOP_DEBUG_DIAG("\"" << load.key.first << "\" (" << load.key.second.name() << ") loaded asynchronously, main thread step took " << clk.getElapsedTime().asSeconds() << "s");
+        }
+        else
+        {
+            load.status.store(detail::AsyncLoad::Failed);
+
+            JOP_DEBUG_WARNING("Couldn't load resource \"" << load.key.first << "\" (" << load.key.second.name() << ") asynchronously");
+        }
+
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+        m_asyncLoads.erase(load.key);
+
+        for (auto itr = m_asyncQueue.begin(); itr != m_asyncQueue.end(); ++itr)
+        {
+            if (itr->get() == &load)
+            {
+                m_asyncQueue.erase(itr);
+                break;
+            }
+        }
+
+        ++m_asyncFinished;
+    }
+
+    //////////////////////////////////////////////
+
+    void ResourceManager::finishReload(detail::AsyncLoad& load)
+    {
+        auto upload = std::move(load.upload);
+        load.upload = nullptr;
+
+        // The resource may have been unloaded, or loaded with new contents, in the meantime
+        if (!load.resource.expired() && load.resource->m_evicted && load.resource->m_reloader)
+        {
+            auto& res = *load.resource;
+
+            // contentsChanged() would drop the reloader during the replay
+            auto reloader = std::move(res.m_reloader);
+            const bool success = upload && upload(res);
+            res.m_reloader = std::move(reloader);
+
+            if (success)
+            {
+                res.m_evicted = false;
+                load.status.store(detail::AsyncLoad::Done);
+
+                JOP_DEBUG_DIAG("\"" << load.key.first << "\" (" << load.key.second.name() << ") reloaded after eviction");
+            }
+            else
+            {
+                // Stays evicted, the next use tries again
+                load.status.store(detail::AsyncLoad::Failed);
+
+                JOP_DEBUG_ERROR("Failed to reload evicted resource \"" << load.key.first << "\" (" << load.key.second.name() << ")");
+            }
+        }
+        else
+            load.status.store(detail::AsyncLoad::Failed);
+
+        if (!load.resource.expired())
+            load.resource->m_reloadQueued = false;
+
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+        for (auto itr = m_reloadQueue.begin(); itr != m_reloadQueue.end(); ++itr)
+        {
+            if (itr->get() == &load)
+            {
+                m_reloadQueue.erase(itr);
+                break;
+            }
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    Resource& ResourceManager::insert(const std::pair<std::string, std::type_index>& key, std::unique_ptr<Resource> resource)
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+        if (m_loadPhase.load())
+            m_loadPhaseResources.insert(key);
+
+        // Keep the first one if the same resource was loaded twice simultaneously
+        auto& slot = m_resources[key];
+
+        if (!slot)
+            slot = std::move(resource);
+
+        return *slot;
+    }
+
+    //////////////////////////////////////////////
+
     void ResourceManager::unload(const std::string& name)
     {
         if (m_instance)
@@ -27,11 +27,12 @@
     #include <Jopnal/Core/Scene.hpp>
 
     #include <Jopnal/Core/Engine.hpp>
+    #include <Jopnal/Core/Profiler.hpp>
+    #include <Jopnal/Core/Hierarchy/TransformStore.hpp>
     #include <Jopnal/Graphics/Renderer.hpp>
     #include <Jopnal/Physics/World.hpp>
     #include <Jopnal/Utility/CommandHandler.hpp>
-    #include <Jopnal/Graphics/Culling/CullerComponent.hpp>
-    #include <Jopnal/Physics/Collider.hpp>
+    #include <Jopnal/Utility/JobSystem.hpp>
 
 #endif
 
@@ -42,6 +43,8 @@ namespace jop
 {
     JOP_REGISTER_COMMAND_HANDLER(Scene)
 
+        JOP_COMMAND_RECEIVERS(Message::SharedScene | Message::Scene);
+
         JOP_BIND_MEMBER_COMMAND(&Scene::setDeltaScale, "setDeltaScale");
 
     JOP_END_COMMAND_HANDLER(Scene)
@@ -49,43 +52,16 @@ namespace jop
 
 namespace jop
 {
-    namespace detail
-    {
-        class CullingBroadphaseCallback : public World::BroadphaseCallback
-        {
-        public:
-
-            CullingBroadphaseCallback(World& worldRef)
-                : World::BroadphaseCallback(worldRef)
-            {}
-
-            bool collide(const Collider& c0, const Collider& c1) const override
-            {
-                auto& st = static_cast<const CullerComponent&>(c0);
-                auto& nd = static_cast<const CullerComponent&>(c1);
-
-                return st.shouldCollide(nd) || nd.shouldCollide(st);
-            }
-        };
-    }
-
-    //////////////////////////////////////////////
-
     Scene::Scene(const std::string& ID)
         : Object                (ID),
           m_renderer            (std::make_unique<Renderer>(Engine::getMainRenderTarget(), *this)),
           m_worlds              (nullptr, nullptr),
-          m_deltaScale          (1.f),
-          m_cullingWorld        (*this, *m_renderer),
-          m_broadphaseCallback  (std::make_unique<detail::CullingBroadphaseCallback>(m_cullingWorld))
-    {
-        m_cullingWorld.setBroadphaseBallback(*m_broadphaseCallback);
-        m_cullingWorld.setDebugMode(true);
-    }
+          m_deltaScale          (1.f)
+    {}
 
     Scene::~Scene()
     {
-        // Child objects need to be deinitialized before the renderer & culling world
+        // Child objects need to be deinitialized before the renderer
         Object::clearChildren();
         Object::clearComponents();
     }
@@ -138,6 +114,8 @@ namespace jop
     {
         if (isActive())
         {
+            JOP_PROFILE("Scene::updateBase");
+
             const float dt = deltaTime * m_deltaScale;
 
             // Have to check every step since engine state
@@ -146,12 +124,33 @@ namespace jop
             if (Engine::getState() == Engine::State::Running)
                 preUpdate(dt);
 
+            if (Engine::getState() == Engine::State::Running)
+            {
+                JOP_PROFILE("Scene::parallelUpdate");
+
+                // Resolve the transformations up front, so that reading
+                // them from the worker threads doesn't write to the store
+                detail::TransformStore::getInstance().update();
+
+                for (auto& i : getComponents())
+                    i->parallelUpdate(dt);
+
+                // Sibling subtrees are independent of each other
+                auto& children = getChildren();
+                auto& jobs = JobSystem::getDefault();
+
+                const uint32 batch = static_cast<uint32>(children.size()) / ((jobs.getWorkerCount() + 1) * 4) + 1;
+
+                jobs.parallelFor(static_cast<uint32>(children.size()), batch, [&children, dt](const uint32 begin, const uint32 end)
+                {
+                    for (uint32 i = begin; i < end; ++i)
+                        children[i].parallelUpdate(dt);
+                });
+            }
+
             if (Engine::getState() == Engine::State::Running)
                 Object::update(dt);
 
-            
-            if (detail::CullerComponent::cullingEnabled() && Engine::getState() < Engine::State::Frozen)
-                m_cullingWorld.update(1.f / 60.f);
 
             if (Engine::getState() == Engine::State::Running)
                 postUpdate(dt);
@@ -186,6 +185,6 @@ namespace jop
 
     Message::Result Scene::receiveMessage(const Message& message)
     {
-        return JOP_EXECUTE_COMMAND(Scene, message.getString(), this);
+        return JOP_EXECUTE_COMMAND(Scene, message, this);
     }
 }
\ No newline at end of file
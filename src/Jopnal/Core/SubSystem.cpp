@@ -37,6 +37,8 @@ namespace jop
 {
     JOP_REGISTER_COMMAND_HANDLER(Subsystem)
 
+        JOP_COMMAND_RECEIVERS(Message::Subsystem);
+
         JOP_BIND_MEMBER_COMMAND(&Subsystem::setActive, "setActive");
 
     JOP_END_COMMAND_HANDLER(Subsystem)
@@ -104,6 +106,6 @@ namespace jop
 
     Message::Result Subsystem::receiveMessage(const Message& message)
     {
-        return JOP_EXECUTE_COMMAND(Subsystem, message.getString(), this);
+        return JOP_EXECUTE_COMMAND(Subsystem, message, this);
     }
 }
\ No newline at end of file
@@ -27,7 +27,6 @@
     #include <Jopnal/Graphics/AnimatedSprite.hpp>
 
     #include <Jopnal/Graphics/AnimationAtlas.hpp>
-    #include <Jopnal/Graphics/Mesh/RectangleMesh.hpp>
 
 #endif
 
@@ -41,10 +40,8 @@ namespace jop
     {}
 
     AnimatedSprite::AnimatedSprite(Object& object, Renderer& renderer, const RenderPass::Pass pass, const uint32 weight, const bool cull)
-        : Drawable          (object, renderer, pass, weight, cull),
+        : Sprite            (object, renderer, pass, weight, cull),
           m_atlas           (),
-          m_mesh            (""),
-          m_material        (""),
           m_animationRange  (),
           m_frameTime       (0.f),
           m_timer           (0.f),
@@ -52,7 +49,7 @@ namespace jop
           m_currentFrame    (0),
           m_repeats         (0)
     {
-        setModel(m_mesh, m_material);
+        enableBatching(typeid(AnimatedSprite));
     }
 
     AnimatedSprite::~AnimatedSprite()
@@ -64,7 +61,7 @@ namespace jop
     {
         m_timer += deltaTime * (m_status == Status::Playing) * (m_repeats != 0);
 
-        if (m_timer >= m_frameTime)
+        if (m_timer >= m_frameTime && !m_atlas.expired())
         {  
             if (++m_currentFrame > m_animationRange.second)
             {
@@ -73,7 +70,7 @@ namespace jop
             }
 
             const auto coords = m_atlas->getCoordinates(m_currentFrame);
-            m_mesh.load(m_atlas->getFrameSize().x, coords.first, coords.second);
+            setTextureCoordinates(coords.first, coords.second);
 
             m_timer -= m_frameTime;
         } 
@@ -125,10 +122,9 @@ namespace jop
     AnimatedSprite& AnimatedSprite::setAtlas(const AnimationAtlas& atlas)
     {
         m_atlas = static_ref_cast<const AnimationAtlas>(atlas.getReference());
-        m_material.setMap(Material::Map::Diffuse0, atlas.getTexture());
 
-        const auto coords = m_atlas->getCoordinates(0);
-        m_mesh.load(m_atlas->getFrameSize().x, coords.first, coords.second);
+        setTexture(atlas, 0, false);
+        setSize(atlas.getFrameSize());
 
         m_currentFrame = 0;
 
@@ -28,6 +28,7 @@
 
     #include <Jopnal/Graphics/OpenGL/OpenGL.hpp>
     #include <Jopnal/Graphics/OpenGL/GlCheck.hpp>
+    #include <Jopnal/Graphics/OpenGL/GlState.hpp>
     #include <Jopnal/Utility/Assert.hpp>
 
 #endif
@@ -53,6 +54,13 @@ namespace
         GL_DYNAMIC_DRAW,
         GL_STREAM_DRAW
     };
+
+    // The element array buffer binding is part of the vertex array state
+    void useDefaultVertexArray(const int bufferType)
+    {
+        if (bufferType == GL_ELEMENT_ARRAY_BUFFER)
+            jop::GlState::bindVertexArray(0);
+    }
 }
 
 namespace jop
@@ -116,6 +124,8 @@ namespace jop
             glCheck(glGenBuffers(1, &m_buffer));
         }
 
+        useDefaultVertexArray(m_bufferType);
+
         glCheck(glBindBuffer(m_bufferType, m_buffer));
     }
 
@@ -146,8 +156,23 @@ namespace jop
     {
         if (m_buffer)
         {
-            glCheck(glBindBuffer(m_bufferType, m_buffer));
-            glCheck(glDeleteBuffers(1, &m_buffer));
+            if (!GlState::isContextThread())
+                GlState::deferDelete(GlState::ObjectType::Buffer, m_buffer);
+            else
+            {
+            #if !defined(JOP_OPENGL_ES) || defined(JOP_OPENGL_ES3)
+
+                if (m_bufferType == GL_UNIFORM_BUFFER)
+                    GlState::releaseUniformBuffer(m_buffer);
+
+            #endif
+
+                useDefaultVertexArray(m_bufferType);
+
+                glCheck(glBindBuffer(m_bufferType, m_buffer));
+                glCheck(glDeleteBuffers(1, &m_buffer));
+            }
+
             m_bytesAllocated = 0;
             m_buffer = 0;
         }
@@ -159,4 +184,11 @@ namespace jop
     {
         return m_bytesAllocated;
     }
+
+    //////////////////////////////////////////////
+
+    unsigned int Buffer::getHandle() const
+    {
+        return m_buffer;
+    }
 }
\ No newline at end of file
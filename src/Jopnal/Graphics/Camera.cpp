@@ -33,8 +33,7 @@
     #include <Jopnal/Graphics/Renderer.hpp>
     #include <Jopnal/Utility/CommandHandler.hpp>
     #include <Jopnal/Graphics/OpenGL/GlCheck.hpp>
-    #include <Jopnal/Graphics/Culling/CullerComponent.hpp>
-    #include <Jopnal/Physics/Shape/FrustumShape.hpp>
+    #include <Jopnal/Graphics/Culling/CullingTree.hpp>
     #include <glm/gtc/matrix_transform.hpp>
 
 #endif
@@ -46,6 +45,8 @@ namespace jop
 {
     JOP_REGISTER_COMMAND_HANDLER(Camera)
 
+        JOP_COMMAND_RECEIVERS(Message::Component);
+
         JOP_BIND_MEMBER_COMMAND(&Camera::setProjectionMode, "setProjectionMode");
         JOP_BIND_MEMBER_COMMAND(&Camera::setClippingPlanes, "setClippingPlanes");
         JOP_BIND_MEMBER_COMMAND((Camera& (Camera::*)(const float, const float))&Camera::setSize, "setSize");
@@ -62,9 +63,7 @@ namespace jop
         : Component                 (object, 0),
           m_projectionMatrix        (),
           m_renderTexture           (),
-          m_drawables               (),
-          m_lights                  (),
-          m_culler                  (),
+          m_visible                 (),
           m_viewPort                (glm::vec2(0.f), glm::vec2(1.f)),
           m_projData                ({{0.f, 0.f}}),
           m_clippingPlanes          (0.f, 0.f),
@@ -89,13 +88,6 @@ namespace jop
             setSize(Engine::getMainRenderTarget().getSize());
         }
 
-        if (detail::CullerComponent::cullingEnabled())
-        {
-            m_culler = std::make_unique<detail::CullerComponent>(object, renderer.getCullingWorld(), detail::CullerComponent::Type::Camera, this);
-            m_shape = std::make_unique<FrustumShape>("");
-            updateShape();
-        }
-
         renderer.bind(this);
     }
 
@@ -103,9 +95,7 @@ namespace jop
         : Component                 (other, newObj),
           m_projectionMatrix        (other.m_projectionMatrix),
           m_renderTexture           (),
-          m_drawables               (),
-          m_lights                  (),
-          m_culler                  (),
+          m_visible                 (),
           m_viewPort                (other.m_viewPort),
           m_projData                (other.m_projData),
           m_clippingPlanes          (other.m_clippingPlanes),
@@ -114,13 +104,6 @@ namespace jop
           m_mode                    (other.m_mode),
           m_projectionNeedUpdate    (other.m_projectionNeedUpdate)
     {
-        if (other.m_culler)
-        {
-            m_culler = std::make_unique<detail::CullerComponent>(*other.m_culler, newObj, this);
-            m_shape = std::make_unique<FrustumShape>("");
-            updateShape();
-        }
-
         m_rendererRef.bind(this);
     }
     
@@ -131,14 +114,6 @@ namespace jop
 
     //////////////////////////////////////////////
 
-    void Camera::update(const float deltaTime)
-    {
-        if (m_culler)
-            m_culler->update(deltaTime);
-    }
-
-    //////////////////////////////////////////////
-
     const glm::mat4& Camera::getProjectionMatrix() const
     {
         if (m_projectionNeedUpdate)
@@ -189,7 +164,7 @@ namespace jop
         m_mode = mode;
         m_projectionNeedUpdate = true;
 
-        return updateShape();
+        return *this;
     }
 
     //////////////////////////////////////////////
@@ -206,7 +181,7 @@ namespace jop
         m_clippingPlanes = ClippingPlanes(clipNear, clipFar);
         m_projectionNeedUpdate = true;
 
-        return updateShape();
+        return *this;
     }
 
     //////////////////////////////////////////////
@@ -236,7 +211,7 @@ namespace jop
         else
             setAspectRatio(x / y);
 
-        return updateShape();
+        return *this;
     }
 
     //////////////////////////////////////////////
@@ -253,7 +228,7 @@ namespace jop
         m_projData.perspective.aspectRatio = ratio;
         m_projectionNeedUpdate = true;
 
-        return updateShape();
+        return *this;
     }
 
     //////////////////////////////////////////////
@@ -270,7 +245,7 @@ namespace jop
         m_projData.perspective.fov = fovY;
         m_projectionNeedUpdate = true;
 
-        return updateShape();
+        return *this;
     }
 
     //////////////////////////////////////////////
@@ -339,33 +314,16 @@ namespace jop
 
     bool Camera::inView(const Drawable& drawable) const
     {
-        return !detail::CullerComponent::cullingEnabled() || m_drawables.find(&drawable) != m_drawables.end();
+        return !detail::CullingTree::cullingEnabled() || std::binary_search(m_visible.begin(), m_visible.end(), &drawable);
     }
 
     //////////////////////////////////////////////
 
     Message::Result Camera::receiveMessage(const Message& message)
     {
-        if (JOP_EXECUTE_COMMAND(Camera, message.getString(), this) == Message::Result::Escape)
+        if (JOP_EXECUTE_COMMAND(Camera, message, this) == Message::Result::Escape)
             return Message::Result::Escape;
 
         return Component::receiveMessage(message); 
     }
-
-    //////////////////////////////////////////////
-
-    Camera& Camera::updateShape()
-    {
-        if (m_culler)
-        {
-            if (getProjectionMode() == Projection::Perspective)
-                m_shape->load(getClippingPlanes(), getFieldOfView(), getAspectRatio(), glm::quat());
-            else
-                m_shape->load(getClippingPlanes(), getSize(), glm::quat());
-
-            m_culler->updateWorldBounds();
-        }
-
-        return *this;
-    }
 }
\ No newline at end of file
@@ -0,0 +1,467 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+// Headers
+#include JOP_PRECOMPILED_HEADER_FILE
+
+#ifndef JOP_PRECOMPILED_HEADER
+
+    #include <Jopnal/Graphics/Culling/CullingTree.hpp>
+
+    #include <Jopnal/Core/Object.hpp>
+    #include <Jopnal/Core/SettingManager.hpp>
+    #include <Jopnal/Graphics/Drawable.hpp>
+    #include <algorithm>
+    #include <cmath>
+
+#endif
+
+//////////////////////////////////////////////
+
+
+namespace
+{
+    // Leaf bounds are enlarged by this fraction of their size in every
+    // direction, so that small movements don't require reinsertion
+    const float ns_boundsMargin = 0.1f;
+
+    // Margin used for drawables with empty bounds
+    const float ns_minMargin = 0.01f;
+
+    float getArea(const glm::vec3& min, const glm::vec3& max)
+    {
+        const glm::vec3 size = max - min;
+        return 2.f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    std::pair<glm::vec3, glm::vec3> getBounds(const jop::Drawable& drawable)
+    {
+        if (drawable.getMesh())
+            return drawable.getGlobalBounds();
+
+        const glm::vec3& pos = drawable.getObject()->getGlobalPosition();
+        return std::make_pair(pos, pos);
+    }
+}
+
+namespace jop { namespace detail
+{
+    const uint32 CullingTree::NullNode = ~0u;
+
+    //////////////////////////////////////////////
+
+    bool CullingTree::Node::isLeaf() const
+    {
+        return children[0] == NullNode;
+    }
+
+    //////////////////////////////////////////////
+
+    CullingTree::CullingTree()
+        : m_nodes       (),
+          m_stack       (),
+          m_root        (NullNode),
+          m_freeList    (NullNode)
+    {}
+
+    //////////////////////////////////////////////
+
+    uint32 CullingTree::createProxy(const Drawable& drawable)
+    {
+        const uint32 leaf = allocateNode();
+
+        m_nodes[leaf].drawable = &drawable;
+        m_nodes[leaf].height = 0;
+
+        setLeafBounds(leaf);
+        insertLeaf(leaf);
+
+        return leaf;
+    }
+
+    //////////////////////////////////////////////
+
+    void CullingTree::destroyProxy(const uint32 proxy)
+    {
+        removeLeaf(proxy);
+        freeNode(proxy);
+    }
+
+    //////////////////////////////////////////////
+
+    void CullingTree::update()
+    {
+        for (uint32 i = 0; i < m_nodes.size(); ++i)
+        {
+            auto& node = m_nodes[i];
+
+            if (node.height != 0)
+                continue;
+
+            auto& drawable = *node.drawable;
+
+            // Only leaves whose object moved or whose mesh changed need their bounds checked
+            if (node.transformVersion == drawable.getObject()->getTransformVersion() && node.stateVersion == drawable.getStateVersion())
+                continue;
+
+            node.transformVersion = drawable.getObject()->getTransformVersion();
+            node.stateVersion = drawable.getStateVersion();
+
+            const auto bounds = getBounds(*node.drawable);
+
+            // Still inside the enlarged bounds, nothing to do
+            if (glm::all(glm::greaterThanEqual(bounds.first, node.min)) && glm::all(glm::lessThanEqual(bounds.second, node.max)))
+                continue;
+
+            removeLeaf(i);
+            setLeafBounds(i);
+            insertLeaf(i);
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    void CullingTree::query(const glm::mat4& pvMatrix, const uint32 renderMask, std::vector<const Drawable*>& visible) const
+    {
+        visible.clear();
+
+        if (m_root == NullNode)
+            return;
+
+        // Extract the frustum planes, stored as a structure of arrays so that
+        // the plane tests can be vectorized. The planes don't need to be normalized,
+        // since only the signs of the distances are compared
+        float px[6], py[6], pz[6], pw[6];
+
+        for (int i = 0; i < 6; ++i)
+        {
+            const int row = i / 2;
+            const float sign = (i % 2) == 0 ? 1.f : -1.f;
+
+            px[i] = pvMatrix[0][3] + sign * pvMatrix[0][row];
+            py[i] = pvMatrix[1][3] + sign * pvMatrix[1][row];
+            pz[i] = pvMatrix[2][3] + sign * pvMatrix[2][row];
+            pw[i] = pvMatrix[3][3] + sign * pvMatrix[3][row];
+        }
+
+        static const uint32 allPlanes = (1 << 6) - 1;
+
+        m_stack.clear();
+        m_stack.emplace_back(m_root, allPlanes);
+
+        while (!m_stack.empty())
+        {
+            const uint32 index = m_stack.back().first;
+            uint32 mask = m_stack.back().second;
+            m_stack.pop_back();
+
+            auto& node = m_nodes[index];
+
+            // Planes the parent was found to be fully inside of are skipped
+            if (mask)
+            {
+                const glm::vec3 center = (node.min + node.max) * 0.5f;
+                const glm::vec3 extent = (node.max - node.min) * 0.5f;
+
+                uint32 outside = 0;
+                uint32 inside = 0;
+
+                for (int i = 0; i < 6; ++i)
+                {
+                    const float dist = px[i] * center.x + py[i] * center.y + pz[i] * center.z + pw[i];
+                    const float radius = std::abs(px[i]) * extent.x + std::abs(py[i]) * extent.y + std::abs(pz[i]) * extent.z;
+
+                    outside |= static_cast<uint32>(dist + radius < 0.f) << i;
+                    inside |= static_cast<uint32>(dist - radius >= 0.f) << i;
+                }
+
+                if ((outside & mask) != 0)
+                    continue;
+
+                mask &= ~inside;
+            }
+
+            if (node.isLeaf())
+            {
+                if ((renderMask & (1 << node.drawable->getRenderGroup())) != 0)
+                    visible.push_back(node.drawable);
+            }
+            else
+            {
+                m_stack.emplace_back(node.children[0], mask);
+                m_stack.emplace_back(node.children[1], mask);
+            }
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    bool CullingTree::cullingEnabled()
+    {
+        static const bool culling = SettingManager::get<bool>("engine@Graphics|bCulling", false);
+        return culling;
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 CullingTree::allocateNode()
+    {
+        uint32 index = m_freeList;
+
+        if (index == NullNode)
+        {
+            index = static_cast<uint32>(m_nodes.size());
+            m_nodes.emplace_back();
+        }
+        else
+            m_freeList = m_nodes[index].parent;
+
+        auto& node = m_nodes[index];
+        node.drawable = nullptr;
+        node.parent = NullNode;
+        node.children[0] = node.children[1] = NullNode;
+        node.height = 0;
+
+        return index;
+    }
+
+    //////////////////////////////////////////////
+
+    void CullingTree::freeNode(const uint32 node)
+    {
+        m_nodes[node].parent = m_freeList;
+        m_nodes[node].drawable = nullptr;
+        m_nodes[node].height = -1;
+        m_freeList = node;
+    }
+
+    //////////////////////////////////////////////
+
+    void CullingTree::insertLeaf(const uint32 leaf)
+    {
+        if (m_root == NullNode)
+        {
+            m_root = leaf;
+            m_nodes[leaf].parent = NullNode;
+            return;
+        }
+
+        const glm::vec3 leafMin = m_nodes[leaf].min;
+        const glm::vec3 leafMax = m_nodes[leaf].max;
+
+        // Find the best sibling, using the surface area as the cost
+        uint32 index = m_root;
+
+        while (!m_nodes[index].isLeaf())
+        {
+            auto& node = m_nodes[index];
+
+            const float area = getArea(node.min, node.max);
+            const float combinedArea = getArea(glm::min(node.min, leafMin), glm::max(node.max, leafMax));
+
+            // Cost of creating a new parent for this node and the leaf
+            const float cost = 2.f * combinedArea;
+
+            // Minimum cost of pushing the leaf further down the tree
+            const float inheritanceCost = 2.f * (combinedArea - area);
+
+            float childCosts[2];
+
+            for (int i = 0; i < 2; ++i)
+            {
+                auto& child = m_nodes[node.children[i]];
+                const float newArea = getArea(glm::min(child.min, leafMin), glm::max(child.max, leafMax));
+
+                childCosts[i] = (child.isLeaf() ? newArea : newArea - getArea(child.min, child.max)) + inheritanceCost;
+            }
+
+            if (cost < childCosts[0] && cost < childCosts[1])
+                break;
+
+            index = node.children[childCosts[0] < childCosts[1] ? 0 : 1];
+        }
+
+        const uint32 sibling = index;
+
+        // Create a new parent. The node vector may be reallocated here
+        const uint32 oldParent = m_nodes[sibling].parent;
+        const uint32 newParent = allocateNode();
+
+        auto& parent = m_nodes[newParent];
+        parent.parent = oldParent;
+        parent.min = glm::min(leafMin, m_nodes[sibling].min);
+        parent.max = glm::max(leafMax, m_nodes[sibling].max);
+        parent.height = m_nodes[sibling].height + 1;
+        parent.children[0] = sibling;
+        parent.children[1] = leaf;
+
+        if (oldParent != NullNode)
+        {
+            auto& op = m_nodes[oldParent];
+            op.children[op.children[0] == sibling ? 0 : 1] = newParent;
+        }
+        else
+            m_root = newParent;
+
+        m_nodes[sibling].parent = newParent;
+        m_nodes[leaf].parent = newParent;
+
+        refit(newParent);
+    }
+
+    //////////////////////////////////////////////
+
+    void CullingTree::removeLeaf(const uint32 leaf)
+    {
+        if (leaf == m_root)
+        {
+            m_root = NullNode;
+            return;
+        }
+
+        const uint32 parent = m_nodes[leaf].parent;
+        const uint32 grandParent = m_nodes[parent].parent;
+        const uint32 sibling = m_nodes[parent].children[m_nodes[parent].children[0] == leaf ? 1 : 0];
+
+        if (grandParent != NullNode)
+        {
+            // Replace the parent with the sibling
+            auto& gp = m_nodes[grandParent];
+            gp.children[gp.children[0] == parent ? 0 : 1] = sibling;
+            m_nodes[sibling].parent = grandParent;
+
+            freeNode(parent);
+            refit(grandParent);
+        }
+        else
+        {
+            m_root = sibling;
+            m_nodes[sibling].parent = NullNode;
+
+            freeNode(parent);
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    void CullingTree::refit(uint32 index)
+    {
+        while (index != NullNode)
+        {
+            index = balance(index);
+
+            auto& node = m_nodes[index];
+            auto& left = m_nodes[node.children[0]];
+            auto& right = m_nodes[node.children[1]];
+
+            node.height = 1 + std::max(left.height, right.height);
+            node.min = glm::min(left.min, right.min);
+            node.max = glm::max(left.max, right.max);
+
+            index = node.parent;
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 CullingTree::balance(const uint32 iA)
+    {
+        auto& a = m_nodes[iA];
+
+        if (a.isLeaf() || a.height < 2)
+            return iA;
+
+        const uint32 iB = a.children[0];
+        const uint32 iC = a.children[1];
+        auto& b = m_nodes[iB];
+        auto& c = m_nodes[iC];
+
+        const int32 diff = c.height - b.height;
+
+        // Either child is rotated up, depending on which one is deeper.
+        // The rotated child's deeper child is kept, the other one is given to A
+        if (diff > 1 || diff < -1)
+        {
+            const int up = diff > 1 ? 1 : 0;
+
+            const uint32 iU = a.children[up];
+            const uint32 iS = a.children[1 - up];
+            auto& u = m_nodes[iU];
+            auto& s = m_nodes[iS];
+
+            const uint32 iF = u.children[0];
+            const uint32 iG = u.children[1];
+            auto& f = m_nodes[iF];
+            auto& g = m_nodes[iG];
+
+            // U takes A's place
+            u.children[0] = iA;
+            u.parent = a.parent;
+            a.parent = iU;
+
+            if (u.parent != NullNode)
+            {
+                auto& p = m_nodes[u.parent];
+                p.children[p.children[0] == iA ? 0 : 1] = iU;
+            }
+            else
+                m_root = iU;
+
+            const bool keepF = f.height > g.height;
+            const uint32 iKeep = keepF ? iF : iG;
+            const uint32 iGive = keepF ? iG : iF;
+            auto& keep = m_nodes[iKeep];
+            auto& give = m_nodes[iGive];
+
+            u.children[1] = iKeep;
+            a.children[up] = iGive;
+            give.parent = iA;
+
+            a.min = glm::min(s.min, give.min);
+            a.max = glm::max(s.max, give.max);
+            a.height = 1 + std::max(s.height, give.height);
+
+            u.min = glm::min(a.min, keep.min);
+            u.max = glm::max(a.max, keep.max);
+            u.height = 1 + std::max(a.height, keep.height);
+
+            return iU;
+        }
+
+        return iA;
+    }
+
+    //////////////////////////////////////////////
+
+    void CullingTree::setLeafBounds(const uint32 leaf)
+    {
+        auto& node = m_nodes[leaf];
+        const auto bounds = getBounds(*node.drawable);
+
+        node.transformVersion = node.drawable->getObject()->getTransformVersion();
+        node.stateVersion = node.drawable->getStateVersion();
+
+        const glm::vec3 margin = glm::max((bounds.second - bounds.first) * ns_boundsMargin, glm::vec3(ns_minMargin));
+
+        node.min = bounds.first - margin;
+        node.max = bounds.second + margin;
+    }
+}}
@@ -0,0 +1,111 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+#ifndef JOP_CULLINGTREE_HPP
+#define JOP_CULLINGTREE_HPP
+
+// Headers
+#include <Jopnal/Header.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <vector>
+
+//////////////////////////////////////////////
+
+
+namespace jop
+{
+    class Drawable;
+
+    namespace detail
+    {
+        class CullingTree
+        {
+        private:
+
+            JOP_DISALLOW_COPY_MOVE(CullingTree);
+
+            struct Node
+            {
+                glm::vec3 min;              ///< Enlarged bounds minimum
+                glm::vec3 max;              ///< Enlarged bounds maximum
+                const Drawable* drawable;   ///< The drawable, only set for leaves
+                uint32 transformVersion;    ///< Transform version of the drawable's object when the bounds were set
+                uint32 stateVersion;        ///< State version of the drawable when the bounds were set
+                uint32 parent;              ///< Parent node, or the next free node
+                uint32 children[2];         ///< Child nodes
+                int32 height;               ///< Height of the subtree, -1 for free nodes
+
+                bool isLeaf() const;
+            };
+
+        public:
+
+            static const uint32 NullNode;
+
+
+            CullingTree();
+
+
+            uint32 createProxy(const Drawable& drawable);
+
+            void destroyProxy(const uint32 proxy);
+
+            void update();
+
+            void query(const glm::mat4& pvMatrix, const uint32 renderMask, std::vector<const Drawable*>& visible) const;
+
+            static bool cullingEnabled();
+
+        private:
+
+            uint32 allocateNode();
+
+            void freeNode(const uint32 node);
+
+            void insertLeaf(const uint32 leaf);
+
+            void removeLeaf(const uint32 leaf);
+
+            void refit(uint32 node);
+
+            uint32 balance(const uint32 node);
+
+            void setLeafBounds(const uint32 leaf);
+
+
+            std::vector<Node> m_nodes;
+            mutable std::vector<std::pair<uint32, uint32>> m_stack;
+            uint32 m_root;
+            uint32 m_freeList;
+        };
+    }
+}
+
+/// \class jop::CullingTree
+/// \ingroup graphics
+///
+/// Dynamic AABB tree of the drawables' bounds, used for view frustum culling.
+///
+/// Leaves store enlarged bounds, so a drawable only has to be reinserted once
+/// it moves outside of them. Inserting balances the tree using rotations.
+
+#endif
\ No newline at end of file
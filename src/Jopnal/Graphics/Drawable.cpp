@@ -36,7 +36,7 @@
     #include <Jopnal/Graphics/ShaderAssembler.hpp>
     #include <Jopnal/Graphics/OpenGL/OpenGL.hpp>
     #include <Jopnal/Graphics/OpenGL/GlCheck.hpp>
-    #include <Jopnal/Graphics/Culling/CullerComponent.hpp>
+    #include <Jopnal/Graphics/Culling/CullingTree.hpp>
     #include <Jopnal/Utility/CommandHandler.hpp>
     #include <glm/gtc/type_ptr.hpp>
 
@@ -49,6 +49,8 @@ namespace jop
 {
     JOP_REGISTER_COMMAND_HANDLER(Drawable)
 
+        JOP_COMMAND_RECEIVERS(Message::Component);
+
         JOP_BIND_MEMBER_COMMAND(&Drawable::setModel, "setModel");
         JOP_BIND_MEMBER_COMMAND(&Drawable::setRenderGroup, "setRenderGroup");
 
@@ -75,19 +77,20 @@ namespace jop
           m_mesh            (),
           m_material        (),
           m_shader          (),
-          m_culler          (),
+          m_cullingProxy    (detail::CullingTree::NullNode),
           m_attributes      (0),
           m_rendererRef     (renderer),
           m_pass            (pass),
           m_weight          (weight),
           m_flags           (ReceiveLights | ReceiveShadows | CastShadows | Reflected),
+          m_stateVersion    (0),
           m_renderGroup     (0)
     {
         setModel(Mesh::getDefault(), Material::getDefault());
         renderer.bind(this, pass, weight);
 
-        if (cull && detail::CullerComponent::cullingEnabled())
-            m_culler = std::make_unique<detail::CullerComponent>(object, renderer.getCullingWorld(), detail::CullerComponent::Type::Drawable, this);
+        if (cull && detail::CullingTree::cullingEnabled())
+            m_cullingProxy = renderer.getCullingTree().createProxy(*this);
     }
 
     Drawable::Drawable(const Drawable& other, Object& newObj)
@@ -96,30 +99,26 @@ namespace jop
           m_mesh            (other.m_mesh),
           m_material        (other.m_material),
           m_shader          (other.m_shader),
-          m_culler          (),
+          m_cullingProxy    (detail::CullingTree::NullNode),
           m_rendererRef     (other.m_rendererRef),
           m_pass            (other.m_pass),
           m_weight          (other.m_weight),
           m_renderGroup     (other.m_renderGroup),
-          m_flags           (other.m_flags)
+          m_flags           (other.m_flags),
+          m_stateVersion    (0)
     {
         m_rendererRef.bind(this, m_pass, m_weight);
 
-        if (other.isCulled() && detail::CullerComponent::cullingEnabled())
-            m_culler = std::make_unique<detail::CullerComponent>(*other.m_culler, newObj, this);
+        if (other.isCulled())
+            m_cullingProxy = m_rendererRef.getCullingTree().createProxy(*this);
     }
 
     Drawable::~Drawable()
     {
-        m_rendererRef.unbind(this, m_pass, m_weight);
-    }
+        if (isCulled())
+            m_rendererRef.getCullingTree().destroyProxy(m_cullingProxy);
 
-    //////////////////////////////////////////////
-
-    void Drawable::update(const float deltaTime)
-    {
-        if (m_culler)
-            m_culler->update(deltaTime);
+        m_rendererRef.unbind(this, m_pass, m_weight);
     }
 
     //////////////////////////////////////////////
@@ -132,11 +131,13 @@ namespace jop
         auto& mesh = *getMesh();
 
         {
+            typedef ShaderProgram::Uniform SU;
+
             auto& shdr = getShader();
             auto& modelMat = getObject()->getTransform().getMatrix();
             const auto VMMatrix = proj.viewMatrix * modelMat;
 
-            shdr.setUniform("u_PVMMatrix", proj.projectionMatrix * VMMatrix);
+            shdr.setUniform(shdr.getUniformHandle(SU::PVMMatrix), proj.projectionMatrix * VMMatrix);
 
             if (!mesh.hasVertexComponent(Mesh::Color))
             {
@@ -150,8 +151,8 @@ namespace jop
                 auto& mat = *getMaterial();
                 if (mat.getAttributes() & Material::LightingAttribs)
                 {
-                    shdr.setUniform("u_VMMatrix", VMMatrix);
-                    shdr.setUniform("u_NMatrix", glm::transpose(glm::inverse(glm::mat3(VMMatrix))));
+                    shdr.setUniform(shdr.getUniformHandle(SU::VMMatrix), VMMatrix);
+                    shdr.setUniform(shdr.getUniformHandle(SU::NMatrix), glm::transpose(glm::inverse(glm::mat3(VMMatrix))));
                     lights.sendToShader(shdr, *this, proj.viewMatrix);
                 }
 
@@ -207,12 +208,7 @@ namespace jop
     Drawable& Drawable::setMesh(const Mesh& mesh)
     {
         m_mesh = static_ref_cast<const Mesh>(mesh.getReference());
-
-        if (m_culler)
-        {
-            m_culler->setCollisionShape(mesh.getCullingShape());
-            m_culler->updateWorldBounds();
-        }
+        invalidateState();
 
         return *this;
     }
@@ -222,6 +218,8 @@ namespace jop
     Drawable& Drawable::setMaterial(const Material& material)
     {
         m_material = static_ref_cast<const Material>(material.getReference());
+        invalidateState();
+
         return *this;
     }
 
@@ -243,6 +241,10 @@ namespace jop
 
     Drawable& Drawable::setColor(const Color& color)
     {
+        // Alpha decides whether this drawable is sorted as translucent
+        if ((color.alpha < 1.f) != (m_color.alpha < 1.f))
+            invalidateState();
+
         m_color = color;
         return *this;
     }
@@ -314,14 +316,28 @@ namespace jop
 
     bool Drawable::isCulled() const
     {
-        return m_culler.operator bool();
+        return m_cullingProxy != detail::CullingTree::NullNode;
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 Drawable::getStateVersion() const
+    {
+        return m_stateVersion;
+    }
+
+    //////////////////////////////////////////////
+
+    void Drawable::invalidateState()
+    {
+        ++m_stateVersion;
     }
 
     //////////////////////////////////////////////
 
     Message::Result Drawable::receiveMessage(const Message& message)
     {
-        if (JOP_EXECUTE_COMMAND(Drawable, message.getString(), this) == Message::Result::Escape)
+        if (JOP_EXECUTE_COMMAND(Drawable, message, this) == Message::Result::Escape)
             return Message::Result::Escape;
 
         return Component::receiveMessage(message);
@@ -339,6 +355,7 @@ namespace jop
     void Drawable::setOverrideShader(ShaderProgram& shader)
     {
         m_shader = static_ref_cast<ShaderProgram>(shader.getReference());
+        invalidateState();
     }
 
     //////////////////////////////////////////////
@@ -346,6 +363,7 @@ namespace jop
     void Drawable::removeOverrideShader()
     {
         m_shader.reset();
+        invalidateState();
     }
 
     //////////////////////////////////////////////
@@ -367,6 +385,9 @@ namespace jop
         if (attributes & Attribute::__SkySphere)
             str += "#define JDRW_SKYSPHERE\n";
 
+        if (attributes & Attribute::__Instanced)
+            str += "#define JDRW_INSTANCED\n";
+
         return str;
     }
 }
\ No newline at end of file
@@ -0,0 +1,384 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+// Headers
+#include JOP_PRECOMPILED_HEADER_FILE
+
+#ifndef JOP_PRECOMPILED_HEADER
+
+    #include <Jopnal/Graphics/LightClusters.hpp>
+
+    #include <Jopnal/Core/Object.hpp>
+    #include <Jopnal/Core/SettingManager.hpp>
+    #include <Jopnal/Graphics/Camera.hpp>
+    #include <Jopnal/Graphics/LightSource.hpp>
+    #include <Jopnal/Graphics/Material.hpp>
+    #include <Jopnal/Graphics/RenderTarget.hpp>
+    #include <Jopnal/Graphics/OpenGL/OpenGL.hpp>
+    #include <algorithm>
+    #include <cmath>
+
+#endif
+
+//////////////////////////////////////////////
+
+
+namespace
+{
+    // Texels per light in the light texture:
+    //
+    // 0: position (view space), type (0 = point, 1 = spot)
+    // 1: ambient, cos(inner cutoff)
+    // 2: diffuse, cos(outer cutoff)
+    // 3: specular, range
+    // 4: attenuation
+    // 5: direction (view space)
+    //
+    const unsigned int ns_lightTexels = 6;
+
+    // Width of the cluster data texture. Must match the shaders
+    const unsigned int ns_dataWidth = 1024;
+
+    // Layout of jop_ClusterBlock
+    struct ClusterBlock
+    {
+        glm::ivec4 grid;        ///< Tiles on x & y, slices, first index texel
+        glm::vec4 viewport;     ///< Viewport position in pixels, tiles per pixel
+        glm::vec4 depth;        ///< Slice scale, bias, logarithmic
+    };
+
+    static_assert(sizeof(ClusterBlock) == 48, "Cluster block doesn't match the std140 layout");
+
+    int toTile(const float ndc, const unsigned int tiles)
+    {
+        return glm::clamp(static_cast<int>(std::floor((ndc * 0.5f + 0.5f) * tiles)), 0, static_cast<int>(tiles) - 1);
+    }
+
+    void upload(jop::Texture2D& texture, const std::vector<glm::vec4>& data, const glm::uvec2& size)
+    {
+        using namespace jop;
+
+        // Grow in powers of two to avoid reallocating every frame
+        if (!texture.isValid() || texture.getSize().x < size.x || texture.getSize().y < size.y)
+        {
+            glm::uvec2 allocated(size.x, 1);
+
+            while (allocated.y < size.y)
+                allocated.y <<= 1;
+
+            texture.load(allocated, Texture::Format::RGBA_F_32, Texture::Flag::DisallowSRGB | Texture::Flag::DisallowMipmapGeneration);
+            texture.setFilterMode(TextureSampler::Filter::None).setRepeatMode(TextureSampler::Repeat::ClampEdge);
+        }
+
+        if (!data.empty())
+            texture.setPixels(glm::uvec2(0), size, data.data());
+    }
+}
+
+namespace jop
+{
+    ClusterGrid::ClusterGrid(const glm::uvec3& dimensions)
+        : m_dimensions  (glm::max(dimensions, glm::uvec3(1))),
+          m_depthParams (),
+          m_ranges      (),
+          m_cells       (),
+          m_indices     ()
+    {}
+
+    //////////////////////////////////////////////
+
+    void ClusterGrid::bin(const std::vector<glm::vec4>& spheres, const glm::mat4& projectionMatrix, const float nearPlane, const float farPlane)
+    {
+        const int slices = static_cast<int>(m_dimensions.z);
+
+        // Perspective projections have -1 here, orthographic ones 0
+        const bool perspective = projectionMatrix[2][3] != 0.f;
+
+        if (perspective && nearPlane > 0.f && farPlane > nearPlane)
+        {
+            const float scale = slices / std::log(farPlane / nearPlane);
+            m_depthParams = glm::vec4(scale, -std::log(nearPlane) * scale, 1.f, 0.f);
+        }
+        else
+        {
+            const float scale = farPlane > nearPlane ? slices / (farPlane - nearPlane) : 0.f;
+            m_depthParams = glm::vec4(scale, -nearPlane * scale, 0.f, 0.f);
+        }
+
+        m_ranges.clear();
+        m_cells.assign(m_dimensions.x * m_dimensions.y * m_dimensions.z, glm::uvec2(0));
+
+        for (uint32 i = 0; i < spheres.size(); ++i)
+        {
+            const glm::vec3 center(spheres[i]);
+            const float radius = spheres[i].w;
+
+            const float minDepth = -center.z - radius;
+            const float maxDepth = -center.z + radius;
+
+            if (maxDepth < nearPlane || minDepth > farPlane)
+                continue;
+
+            Range range;
+            range.light = i;
+            range.min.z = getSlice(std::max(minDepth, nearPlane));
+            range.max.z = getSlice(std::min(maxDepth, farPlane));
+
+            // A sphere crossing the near plane can't be projected, it covers the whole screen
+            if (perspective && minDepth <= nearPlane)
+            {
+                range.min.x = range.min.y = 0;
+                range.max.x = m_dimensions.x - 1;
+                range.max.y = m_dimensions.y - 1;
+            }
+            else
+            {
+                glm::vec2 minNDC(FLT_MAX);
+                glm::vec2 maxNDC(-FLT_MAX);
+
+                for (int c = 0; c < 8; ++c)
+                {
+                    const glm::vec3 corner(c & 1 ? radius : -radius, c & 2 ? radius : -radius, c & 4 ? radius : -radius);
+                    const glm::vec4 clip = projectionMatrix * glm::vec4(center + corner, 1.f);
+                    const glm::vec2 ndc = glm::vec2(clip) / clip.w;
+
+                    minNDC = glm::min(minNDC, ndc);
+                    maxNDC = glm::max(maxNDC, ndc);
+                }
+
+                if (maxNDC.x < -1.f || maxNDC.y < -1.f || minNDC.x > 1.f || minNDC.y > 1.f)
+                    continue;
+
+                range.min.x = toTile(minNDC.x, m_dimensions.x);
+                range.min.y = toTile(minNDC.y, m_dimensions.y);
+                range.max.x = toTile(maxNDC.x, m_dimensions.x);
+                range.max.y = toTile(maxNDC.y, m_dimensions.y);
+            }
+
+            m_ranges.push_back(range);
+
+            for (int z = range.min.z; z <= range.max.z; ++z)
+            {
+                for (int y = range.min.y; y <= range.max.y; ++y)
+                {
+                    for (int x = range.min.x; x <= range.max.x; ++x)
+                        ++m_cells[getClusterIndex(glm::uvec3(x, y, z))].y;
+                }
+            }
+        }
+
+        // Turn the counts into offsets, then fill the index lists
+        uint32 offset = 0;
+
+        for (auto& c : m_cells)
+        {
+            c.x = offset;
+            offset += c.y;
+            c.y = 0;
+        }
+
+        m_indices.resize(offset);
+
+        for (auto& r : m_ranges)
+        {
+            for (int z = r.min.z; z <= r.max.z; ++z)
+            {
+                for (int y = r.min.y; y <= r.max.y; ++y)
+                {
+                    for (int x = r.min.x; x <= r.max.x; ++x)
+                    {
+                        auto& cell = m_cells[getClusterIndex(glm::uvec3(x, y, z))];
+                        m_indices[cell.x + cell.y++] = r.light;
+                    }
+                }
+            }
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    const glm::uvec3& ClusterGrid::getDimensions() const
+    {
+        return m_dimensions;
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 ClusterGrid::getClusterIndex(const glm::uvec3& cluster) const
+    {
+        return cluster.x + m_dimensions.x * (cluster.y + m_dimensions.y * cluster.z);
+    }
+
+    //////////////////////////////////////////////
+
+    const glm::vec4& ClusterGrid::getDepthParameters() const
+    {
+        return m_depthParams;
+    }
+
+    //////////////////////////////////////////////
+
+    const std::vector<glm::uvec2>& ClusterGrid::getCells() const
+    {
+        return m_cells;
+    }
+
+    //////////////////////////////////////////////
+
+    const std::vector<uint32>& ClusterGrid::getIndices() const
+    {
+        return m_indices;
+    }
+
+    //////////////////////////////////////////////
+
+    int ClusterGrid::getSlice(const float depth) const
+    {
+        const float scaled = (m_depthParams.z > 0.f ? std::log(std::max(depth, 0.0001f)) : depth) * m_depthParams.x + m_depthParams.y;
+
+        return glm::clamp(static_cast<int>(std::floor(scaled)), 0, static_cast<int>(m_dimensions.z) - 1);
+    }
+
+    //////////////////////////////////////////////
+
+
+    LightClusters::LightClusters()
+        : m_grid        (glm::uvec3(SettingManager::get<unsigned int>("engine@Graphics|Shading|Clusters|uTilesX", 16),
+                                    SettingManager::get<unsigned int>("engine@Graphics|Shading|Clusters|uTilesY", 8),
+                                    SettingManager::get<unsigned int>("engine@Graphics|Shading|Clusters|uSlices", 24))),
+          m_spheres     (),
+          m_lightData   (),
+          m_data        (),
+          m_lightTexture("jop_cluster_lights"),
+          m_dataTexture ("jop_cluster_data"),
+          m_block       (Buffer::StreamDraw)
+    {}
+
+    LightClusters::~LightClusters()
+    {}
+
+    //////////////////////////////////////////////
+
+    void LightClusters::build(const std::vector<const LightSource*>& lights, const Camera& camera, const RenderTarget& mainTarget)
+    {
+        typedef LightSource LS;
+
+        const glm::mat4& view = camera.getViewMatrix();
+
+        m_spheres.clear();
+        m_lightData.clear();
+
+        for (auto l : lights)
+        {
+            if (!l->isActive() || l->getType() == LS::Type::Directional)
+                continue;
+
+            const glm::vec3 pos(view * glm::vec4(l->getObject()->getGlobalPosition(), 1.f));
+            const glm::vec3 dir(glm::normalize(glm::mat3(view) * l->getObject()->getGlobalFront()));
+            const bool spot = l->getType() == LS::Type::Spot;
+            const glm::vec2 cutoff = spot ? glm::vec2(std::cos(l->getCutoff().x), std::cos(l->getCutoff().y)) : glm::vec2();
+            const float range = l->getRange();
+
+            m_spheres.emplace_back(pos, range);
+
+            m_lightData.emplace_back(pos, spot ? 1.f : 0.f);
+            m_lightData.emplace_back(l->getIntensity(LS::Intensity::Ambient).colors, cutoff.x);
+            m_lightData.emplace_back(l->getIntensity(LS::Intensity::Diffuse).colors, cutoff.y);
+            m_lightData.emplace_back(l->getIntensity(LS::Intensity::Specular).colors, range);
+            m_lightData.emplace_back(l->getAttenuation(), 0.f);
+            m_lightData.emplace_back(dir, 0.f);
+        }
+
+        const auto& planes = camera.getClippingPlanes();
+        m_grid.bin(m_spheres, camera.getProjectionMatrix(), planes.first, planes.second);
+
+        const auto& cells = m_grid.getCells();
+        const auto& indices = m_grid.getIndices();
+
+        // Cells first, then the index lists packed four to a texel
+        const std::size_t numCells = cells.size();
+        const std::size_t numTexels = numCells + (indices.size() + 3) / 4;
+        const std::size_t rows = (numTexels + ns_dataWidth - 1) / ns_dataWidth;
+
+        m_data.assign(rows * ns_dataWidth, glm::vec4(0.f));
+
+        for (std::size_t i = 0; i < numCells; ++i)
+            m_data[i] = glm::vec4(cells[i], 0.f, 0.f);
+
+        for (std::size_t i = 0; i < indices.size(); ++i)
+            m_data[numCells + i / 4][i % 4] = static_cast<float>(indices[i]);
+
+        upload(m_lightTexture, m_lightData, glm::uvec2(ns_lightTexels, m_spheres.size()));
+        upload(m_dataTexture, m_data, glm::uvec2(ns_dataWidth, rows));
+
+        // Same as Camera::applyViewport()
+        auto& viewport = camera.getViewport();
+        const glm::uvec2 mainSize = camera.getRenderTexture().isValid() ? camera.getRenderTexture().getSize() : mainTarget.getSize();
+        const auto p = glm::ivec2(viewport.first * glm::vec2(mainSize));
+        const auto s = glm::ivec2(viewport.second * glm::vec2(mainSize)) - p;
+
+        const auto& dimensions = m_grid.getDimensions();
+
+        ClusterBlock block;
+        block.grid = glm::ivec4(dimensions, numCells);
+        block.viewport = glm::vec4(p, glm::vec2(dimensions) / glm::max(glm::vec2(s), glm::vec2(1.f)));
+        block.depth = m_grid.getDepthParameters();
+
+        m_block.setData(&block, sizeof(ClusterBlock));
+    }
+
+    //////////////////////////////////////////////
+
+    void LightClusters::bind() const
+    {
+        const unsigned int unit = getTextureUnit();
+
+        m_lightTexture.bind(unit);
+        m_dataTexture.bind(unit + 1);
+        m_block.bindBase(UniformBuffer::Binding::Clusters);
+    }
+
+    //////////////////////////////////////////////
+
+    const ClusterGrid& LightClusters::getGrid() const
+    {
+        return m_grid;
+    }
+
+    //////////////////////////////////////////////
+
+    bool LightClusters::isEnabled()
+    {
+        static const bool enabled = SettingManager::get<bool>("engine@Graphics|Shading|Clusters|bEnabled", false)
+                                 && UniformBuffer::isAvailable()
+                                 && getTextureUnit() + 2 <= Texture::getMaxTextureUnits();
+
+        return enabled;
+    }
+
+    //////////////////////////////////////////////
+
+    unsigned int LightClusters::getTextureUnit()
+    {
+        // Right after the shadow atlas, see LightContainer::sendToShader()
+        return static_cast<unsigned int>(Material::Map::__Last) + 1;
+    }
+}
\ No newline at end of file
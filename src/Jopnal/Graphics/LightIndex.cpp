@@ -0,0 +1,355 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+// Headers
+#include JOP_PRECOMPILED_HEADER_FILE
+
+#ifndef JOP_PRECOMPILED_HEADER
+
+    #include <Jopnal/Graphics/LightIndex.hpp>
+
+    #include <Jopnal/Core/Object.hpp>
+    #include <Jopnal/Core/SettingManager.hpp>
+    #include <Jopnal/Graphics/Drawable.hpp>
+    #include <Jopnal/Graphics/LightSource.hpp>
+    #include <glm/gtx/norm.hpp>
+    #include <algorithm>
+
+#endif
+
+//////////////////////////////////////////////
+
+
+namespace
+{
+    // Lights and queries spanning more cells than this bypass the grid
+    const jop::uint64 ns_maxCells = 64;
+
+    // Cell coordinates are packed into 21 bits each
+    const float ns_maxCoord = static_cast<float>((1 << 20) - 1);
+
+    glm::ivec3 getCell(const glm::vec3& point, const float invCellSize)
+    {
+        return glm::ivec3(glm::floor(glm::clamp(point * invCellSize, glm::vec3(-ns_maxCoord), glm::vec3(ns_maxCoord))));
+    }
+
+    jop::uint64 getCellKey(const int x, const int y, const int z)
+    {
+        const jop::uint64 mask = (1ull << 21) - 1;
+
+        return ((static_cast<jop::uint64>(x) & mask) << 42)
+             | ((static_cast<jop::uint64>(y) & mask) << 21)
+             |  (static_cast<jop::uint64>(z) & mask);
+    }
+
+    jop::uint64 getCellCount(const glm::ivec3& min, const glm::ivec3& max)
+    {
+        const glm::ivec3 size = max - min + 1;
+
+        return static_cast<jop::uint64>(size.x) * size.y * size.z;
+    }
+
+    float distanceSquared(const glm::vec3& point, const glm::vec3& min, const glm::vec3& max)
+    {
+        return glm::length2(point - glm::clamp(point, min, max));
+    }
+}
+
+namespace jop
+{
+    LightIndex::LightIndex()
+        : m_entries     (),
+          m_scratch     (),
+          m_directional (),
+          m_unbounded   (),
+          m_cells       (),
+          m_stamps      (),
+          m_candidates  (),
+          m_selections  (),
+          m_slots       (),
+          m_slotIndices (),
+          m_key         (),
+          m_usedSlots   (0),
+          m_cellSize    (0.f),
+          m_query       (0),
+          m_version     (0)
+    {}
+
+    LightIndex::~LightIndex()
+    {}
+
+    //////////////////////////////////////////////
+
+    void LightIndex::update(const std::set<const LightSource*>& lights)
+    {
+        static const DynamicSetting<float> cellSize("engine@Graphics|Shading|Light|fGridCellSize", 10.f);
+
+        m_scratch.clear();
+
+        for (auto l : lights)
+        {
+            if (!l->isActive())
+                continue;
+
+            const bool directional = l->getType() == LightSource::Type::Directional;
+
+            m_scratch.push_back({l, directional ? glm::vec3() : l->getObject()->getGlobalPosition(), l->getRange()});
+        }
+
+        bool changed = m_scratch.size() != m_entries.size() || cellSize.value != m_cellSize;
+
+        for (std::size_t i = 0; !changed && i < m_scratch.size(); ++i)
+        {
+            auto& last = m_entries[i];
+            auto& current = m_scratch[i];
+
+            changed = last.light != current.light || last.position != current.position || last.range != current.range;
+        }
+
+        m_entries.swap(m_scratch);
+
+        if (changed)
+        {
+            m_cellSize = cellSize.value;
+            rebuild();
+        }
+        else
+        {
+            // The light properties may still have changed, refill the containers
+            // so that their uniform blocks get updated
+            for (std::size_t i = 0; i < m_usedSlots; ++i)
+                fill(m_slots[i]);
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    const LightContainer& LightIndex::getLights(const Drawable& drawable)
+    {
+        auto bounds = drawable.getMesh() ? drawable.getGlobalBounds() : std::make_pair(drawable.getObject()->getGlobalPosition(), drawable.getObject()->getGlobalPosition());
+
+        auto& sel = m_selections[&drawable];
+
+        if (!sel.lights || sel.version != m_version || sel.min != bounds.first || sel.max != bounds.second)
+        {
+            sel.min = bounds.first;
+            sel.max = bounds.second;
+            sel.version = m_version;
+            sel.lights = &select(bounds.first, bounds.second);
+        }
+
+        return *sel.lights;
+    }
+
+    //////////////////////////////////////////////
+
+    void LightIndex::forget(const Drawable& drawable)
+    {
+        m_selections.erase(&drawable);
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 LightIndex::getVersion() const
+    {
+        return m_version;
+    }
+
+    //////////////////////////////////////////////
+
+    void LightIndex::rebuild()
+    {
+        ++m_version;
+
+        m_directional.clear();
+        m_unbounded.clear();
+        m_cells.clear();
+        m_stamps.assign(m_entries.size(), 0);
+        m_query = 0;
+
+        m_slotIndices.clear();
+        m_usedSlots = 0;
+
+        const float invCellSize = m_cellSize > 0.f ? 1.f / m_cellSize : 0.f;
+
+        for (uint32 i = 0; i < m_entries.size(); ++i)
+        {
+            auto& entry = m_entries[i];
+
+            if (entry.light->getType() == LightSource::Type::Directional)
+            {
+                m_directional.push_back(i);
+                continue;
+            }
+
+            const glm::ivec3 min = getCell(entry.position - entry.range, invCellSize);
+            const glm::ivec3 max = getCell(entry.position + entry.range, invCellSize);
+
+            if (invCellSize <= 0.f || getCellCount(min, max) > ns_maxCells)
+            {
+                m_unbounded.push_back(i);
+                continue;
+            }
+
+            for (int x = min.x; x <= max.x; ++x)
+            {
+                for (int y = min.y; y <= max.y; ++y)
+                {
+                    for (int z = min.z; z <= max.z; ++z)
+                        m_cells[getCellKey(x, y, z)].push_back(i);
+                }
+            }
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    const LightContainer& LightIndex::select(const glm::vec3& min, const glm::vec3& max)
+    {
+        if (++m_query == 0)
+        {
+            std::fill(m_stamps.begin(), m_stamps.end(), 0);
+            m_query = 1;
+        }
+
+        m_candidates.clear();
+
+        const glm::vec3 center = (min + max) * 0.5f;
+
+        auto consider = [this, &min, &max, &center](const uint32 index)
+        {
+            if (m_stamps[index] == m_query)
+                return;
+
+            m_stamps[index] = m_query;
+
+            auto& entry = m_entries[index];
+
+            if (entry.light->getType() == LightSource::Type::Directional)
+                m_candidates.emplace_back(0.f, index);
+
+            else if (distanceSquared(entry.position, min, max) <= entry.range * entry.range)
+                m_candidates.emplace_back(glm::length2(entry.position - center), index);
+        };
+
+        for (auto i : m_directional)
+            consider(i);
+
+        for (auto i : m_unbounded)
+            consider(i);
+
+        const float invCellSize = m_cellSize > 0.f ? 1.f / m_cellSize : 0.f;
+        const glm::ivec3 minCell = getCell(min, invCellSize);
+        const glm::ivec3 maxCell = getCell(max, invCellSize);
+
+        if (invCellSize > 0.f && getCellCount(minCell, maxCell) <= ns_maxCells)
+        {
+            for (int x = minCell.x; x <= maxCell.x; ++x)
+            {
+                for (int y = minCell.y; y <= maxCell.y; ++y)
+                {
+                    for (int z = minCell.z; z <= maxCell.z; ++z)
+                    {
+                        auto itr = m_cells.find(getCellKey(x, y, z));
+
+                        if (itr == m_cells.end())
+                            continue;
+
+                        for (auto i : itr->second)
+                            consider(i);
+                    }
+                }
+            }
+        }
+        else
+        {
+            // Large drawables are tested against every light
+            for (uint32 i = 0; i < m_entries.size(); ++i)
+                consider(i);
+        }
+
+        std::sort(m_candidates.begin(), m_candidates.end());
+
+        // The key holds the nearest lights of each type, ordered by address so that
+        // drawables with the same lights end up sharing a container
+        m_key.clear();
+
+        static const LightSource::Type types[] =
+        {
+            LightSource::Type::Point,
+            LightSource::Type::Spot,
+            LightSource::Type::Directional
+        };
+
+        for (auto type : types)
+        {
+            const std::size_t first = m_key.size();
+            const std::size_t maxLights = LightSource::getMaximumLights(type);
+
+            for (auto& c : m_candidates)
+            {
+                if (m_key.size() - first >= maxLights)
+                    break;
+
+                if (m_entries[c.second].light->getType() == type)
+                    m_key.push_back(m_entries[c.second].light);
+            }
+
+            std::sort(m_key.begin() + first, m_key.end());
+            m_key.push_back(nullptr);
+        }
+
+        auto itr = m_slotIndices.find(m_key);
+
+        if (itr != m_slotIndices.end())
+            return *m_slots[itr->second].lights;
+
+        if (m_usedSlots == m_slots.size())
+            m_slots.push_back({std::vector<const LightSource*>(), std::make_unique<LightContainer>()});
+
+        auto& slot = m_slots[m_usedSlots];
+        slot.key = m_key;
+        fill(slot);
+
+        m_slotIndices.emplace(m_key, m_usedSlots++);
+
+        return *slot.lights;
+    }
+
+    //////////////////////////////////////////////
+
+    void LightIndex::fill(Slot& slot)
+    {
+        auto& lights = *slot.lights;
+        lights.clear();
+
+        // Types are stored in the order of LightSource::Type
+        int type = 0;
+
+        for (auto l : slot.key)
+        {
+            if (!l)
+                ++type;
+            else
+                lights[static_cast<LightSource::Type>(type)].push_back(l);
+        }
+    }
+}
@@ -31,9 +31,12 @@
     #include <Jopnal/Core/SettingManager.hpp>
     #include <Jopnal/Graphics/OpenGL/OpenGL.hpp>
     #include <Jopnal/Graphics/OpenGL/GlCheck.hpp>
+    #include <Jopnal/Graphics/OpenGL/GpuTimer.hpp>
+    #include <Jopnal/Graphics/OpenGL/GlState.hpp>
     #include <Jopnal/Graphics/Drawable.hpp>
     #include <Jopnal/Graphics/Texture/Texture.hpp>
     #include <Jopnal/Graphics/Mesh/Mesh.hpp>
+    #include <Jopnal/Graphics/Camera.hpp>
     #include <Jopnal/Graphics/Renderer.hpp>
     #include <Jopnal/Graphics/ShaderAssembler.hpp>
     #include <Jopnal/Graphics/ShaderProgram.hpp>
@@ -52,13 +55,80 @@
 ///////////////////////////////////////////
 
 
+namespace
+{
+    // std140 layouts of the light structures in jop_LightBlock
+
+    struct PointLightBlock
+    {
+        glm::vec3 position;
+        jop::uint32 castShadow;
+        glm::vec3 ambient;
+        float padding0;
+        glm::vec3 diffuse;
+        float padding1;
+        glm::vec3 specular;
+        float padding2;
+        glm::vec3 attenuation;
+        float farPlane;
+        glm::vec4 shadowTiles[6];
+    };
+
+    struct SpotLightBlock
+    {
+        glm::vec3 position;
+        jop::uint32 castShadow;
+        glm::vec3 direction;
+        float padding0;
+        glm::vec3 ambient;
+        float padding1;
+        glm::vec3 diffuse;
+        float padding2;
+        glm::vec3 specular;
+        float padding3;
+        glm::vec3 attenuation;
+        float padding4;
+        glm::vec2 cutoff;
+        float padding5[2];
+        glm::mat4 lsMatrix;
+        glm::vec4 shadowTile;
+    };
+
+    struct DirectionalLightBlock
+    {
+        glm::vec3 direction;
+        jop::uint32 castShadow;
+        glm::vec3 ambient;
+        float padding0;
+        glm::vec3 diffuse;
+        float padding1;
+        glm::vec3 specular;
+        float padding2;
+        glm::vec4 cascadeSplits;
+        jop::int32 numCascades;
+        jop::int32 padding3[3];
+        glm::mat4 lsMatrices[jop::LightSource::MaxShadowCascades];
+        glm::vec4 shadowTiles[jop::LightSource::MaxShadowCascades];
+    };
+
+    static_assert(sizeof(PointLightBlock) == 176, "Point light block doesn't match the std140 layout");
+    static_assert(sizeof(SpotLightBlock) == 192, "Spot light block doesn't match the std140 layout");
+    static_assert(sizeof(DirectionalLightBlock) == 416, "Directional light block doesn't match the std140 layout");
+
+    // The light counts are padded to 16 bytes
+    const std::size_t ns_lightArrayOffset = 16;
+}
+
 namespace jop
 {
     JOP_REGISTER_COMMAND_HANDLER(LightSource)
 
+        JOP_COMMAND_RECEIVERS(Message::Component);
+
         JOP_BIND_MEMBER_COMMAND((LightSource& (LightSource::*)(const LightSource::Intensity, const Color&))&LightSource::setIntensity, "setIntensity");
         JOP_BIND_MEMBER_COMMAND((LightSource& (LightSource::*)(const float, const float, const float))&LightSource::setAttenuation, "setAttenuation");
         JOP_BIND_MEMBER_COMMAND(&LightSource::setCutoff, "setCutoff");
+        JOP_BIND_MEMBER_COMMAND(&LightSource::setShadowCascades, "setShadowCascades");
 
     JOP_END_COMMAND_HANDLER(LightSource)
 }
@@ -76,6 +146,103 @@ namespace
 
         return intensities;
     }
+
+    jop::uint64 hashBytes(const void* data, const std::size_t size, jop::uint64 hash = 14695981039346656037ull)
+    {
+        auto bytes = static_cast<const unsigned char*>(data);
+
+        for (std::size_t i = 0; i < size; ++i)
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+
+        return hash;
+    }
+
+    // Independent of the order the casters were returned in
+    jop::uint64 hashCasters(const std::vector<const jop::Drawable*>& casters)
+    {
+        jop::uint64 hash = 0;
+
+        for (auto d : casters)
+        {
+            const jop::Mesh* mesh = d->getMesh();
+
+            jop::uint64 h = hashBytes(&d, sizeof(d));
+            h = hashBytes(&mesh, sizeof(mesh), h);
+            h = hashBytes(glm::value_ptr(d->getObject()->getTransform().getMatrix()), sizeof(glm::mat4), h);
+
+            hash += h;
+        }
+
+        return hash;
+    }
+
+    jop::ShaderProgram& getRecordShader(const bool linear)
+    {
+        static std::array<jop::WeakReference<jop::ShaderProgram>, 2> shaders;
+        auto& shader = shaders[linear];
+
+        if (shader.expired())
+        {
+            using namespace jop;
+
+            shader = static_ref_cast<ShaderProgram>(ResourceManager::getEmpty<ShaderProgram>(linear ? "jop_depth_record_shader_linear" : "jop_depth_record_shader").getReference());
+            shader->setPersistence(0);
+
+            const bool depthTextureSupport =
+            #if defined(JOP_OPENGL_ES) && JOP_MIN_OPENGL_ES_VERSION < 300
+                gl::getVersionMajor() >= 3 || JOP_CHECK_GL_EXTENSION(OES_depth_texture);
+            #else
+                true;
+            #endif
+
+            std::string pp(depthTextureSupport ? "" : "#define JOP_PACK_DEPTH\n");
+
+            if (linear)
+                pp += "#define JOP_LINEAR_DEPTH\n";
+
+            JOP_ASSERT_EVAL(shader->load(pp,
+                Shader::Type::Vertex, std::string(reinterpret_cast<const char*>(jopr::depthRecordShaderVert), sizeof(jopr::depthRecordShaderVert)),
+                Shader::Type::Fragment, std::string(reinterpret_cast<const char*>(jopr::depthRecordShaderFrag), sizeof(jopr::depthRecordShaderFrag))),
+                "Failed to compile depth record shader!");
+        }
+
+        return *shader;
+    }
+
+    // Caching static casters needs a depth blit, which GLES 2.0 doesn't have
+    bool staticLayerSupported()
+    {
+    #ifdef JOP_OPENGL_ES
+        return false;
+    #else
+        static const bool enabled = jop::SettingManager::get<bool>("engine@Graphics|Shading|bStaticShadowLayer", true);
+        return enabled;
+    #endif
+    }
+
+    // The camera shadows are fitted for
+    const jop::Camera* findCamera(const jop::Renderer& renderer, const jop::uint32 renderMask)
+    {
+        for (auto cam : renderer.getCameras())
+        {
+            if (cam->isActive() && (cam->getRenderMask() & renderMask) != 0)
+                return cam;
+        }
+
+        return nullptr;
+    }
+
+    void drawCasters(jop::ShaderProgram& shader, const std::vector<const jop::Drawable*>& casters)
+    {
+        // The handle overload also binds the program
+        const int modelMatrix = shader.getUniformHandle("a_MMatrix");
+
+        for (auto d : casters)
+        {
+            shader.setUniform(modelMatrix, d->getObject()->getTransform().getMatrix());
+            d->getMesh()->draw();
+        }
+    }
 }
 
 namespace jop
@@ -89,7 +256,14 @@ namespace jop
           m_cutoff              (0.17f, 0.17f), // ~10 degrees
           m_rendererRef         (renderer),
           m_renderMask          (1),
-          m_shadowMap           ()
+          m_staticShadowMap     (),
+          m_shadowVersion       (0),
+          m_staticShadowVersion (0),
+          m_cascadeSplits       (0.f),
+          m_cascades            (1),
+          m_shadowTiles         (),
+          m_shadowResolution    (0),
+          m_castShadows         (false)
     {
         renderer.bind(this);
     }
@@ -103,9 +277,16 @@ namespace jop
           m_cutoff              (other.m_cutoff),
           m_rendererRef         (other.m_rendererRef),
           m_renderMask          (other.m_renderMask),
-          m_shadowMap           ()
+          m_staticShadowMap     (),
+          m_shadowVersion       (0),
+          m_staticShadowVersion (0),
+          m_cascadeSplits       (0.f),
+          m_cascades            (other.m_cascades),
+          m_shadowTiles         (),
+          m_shadowResolution    (0),
+          m_castShadows         (false)
     {
-        setCastShadows(other.castsShadows());
+        setCastShadows(other.castsShadows(), other.m_shadowResolution);
         m_rendererRef.bind(this);
     }
 
@@ -137,45 +318,40 @@ namespace jop
 
     //////////////////////////////////////////////
 
-    LightSource& LightSource::setCastShadows(const bool castShadows, const glm::uvec2& /*resolution*/)
+    LightSource& LightSource::setCastShadows(const bool castShadows, const unsigned int resolution)
     {
+        m_shadowResolution = resolution;
+
         if (castsShadows() != castShadows)
-        {/*
+        {
+            m_shadowVersion = 0;
+            m_staticShadowVersion = 0;
+
             if (castShadows)
             {
-                static const unsigned int defMapSize = SettingManager::get<unsigned int>("engine@Graphics|Shading|uDefaultShadowMapResolution", 512);
-                const glm::uvec2 realSize = glm::min(glm::uvec2(m_type == Type::Point ? Cubemap::getMaximumSize() : Texture2D::getMaximumSize()),
-                                                    (resolution == glm::uvec2(0) ? glm::uvec2(defMapSize) : resolution));
-
-                m_shadowMap.setSize(realSize);
-                bool packed = false;
-
-                using Slot = RenderTexture::Slot;
+            #if defined(JOP_OPENGL_ES) && JOP_MIN_OPENGL_ES_VERSION < 300
 
-                if (m_type == Type::Point)
+                // Point light shadow maps are recorded using gl_FragDepth
+                if (m_type == Type::Point && gl::getVersionMajor() < 3)
                 {
-                    if (!m_shadowMap.addCubemapAttachment(Slot::Depth, Texture::Format::Depth_US_16))
-                        m_shadowMap.addCubemapAttachment(Slot::Color0, Texture::Format::RGBA_UB_8);
-                }
-                else
-                {
-                    if (!m_shadowMap.addTextureAttachment(Slot::Depth, Texture::Format::Depth_US_16))
-                        m_shadowMap.addTextureAttachment(Slot::Color0, Texture::Format::RGBA_UB_8);
+                    JOP_DEBUG_WARNING("Point light shadows are not supported on GLES 2.0");
+                    return *this;
                 }
 
-                m_shadowMap.getTextureAttachment(packed ? Slot::Color0 : Slot::Depth)
-                    ->setFilterMode(TextureSampler::Filter::Bilinear)
-                     .setRepeatMode(TextureSampler::Repeat::ClampBorder)
-                     .setBorderColor(Color::White);
-                
-                m_lightSpaceMatrices.resize(1 + (m_type == Type::Point) * 5);
+            #endif
+
+                // One tile per cube face or cascade
+                m_lightSpaceMatrices.resize(m_type == Type::Point ? 6 : (m_type == Type::Directional ? m_cascades : 1));
             }
             else
             {
-                m_shadowMap.destroy(true, true);
+                m_staticShadowMap.destroy(true, true);
+                m_shadowTiles.clear();
                 m_lightSpaceMatrices.clear();
                 m_lightSpaceMatrices.shrink_to_fit();
-            }*/
+            }
+
+            m_castShadows = castShadows;
         }
 
         return *this;
@@ -185,7 +361,7 @@ namespace jop
 
     bool LightSource::castsShadows() const
     {
-        return m_shadowMap.isValid();
+        return m_castShadows;
     }
 
     //////////////////////////////////////////////
@@ -203,58 +379,105 @@ namespace jop
 
     //////////////////////////////////////////////
 
-    bool LightSource::drawShadowMap() const
+    LightSource& LightSource::setShadowCascades(const unsigned int cascades)
     {
-        if (!castsShadows() || !isActive() || !getRenderMask())
-            return false;
-
-        static WeakReference<ShaderProgram> recordShader;
+        m_cascades = glm::clamp(cascades, 1u, static_cast<unsigned int>(MaxShadowCascades));
 
-        // Shadow map recorder shader
-        if (recordShader.expired())
+        if (m_type == Type::Directional && castsShadows() && m_lightSpaceMatrices.size() != m_cascades)
         {
-            recordShader = static_ref_cast<ShaderProgram>(ResourceManager::getEmpty<ShaderProgram>("jop_depth_record_shader").getReference());
-            recordShader->setPersistence(0);
+            // Tiles are allocated by the renderer every frame
+            m_lightSpaceMatrices.resize(m_cascades);
+            m_shadowVersion = 0;
+        }
 
-            const bool depthTextureSupport =
-            #if defined(JOP_OPENGL_ES) && JOP_MIN_OPENGL_ES_VERSION < 300
-                gl::getVersionMajor() >= 3 || JOP_CHECK_GL_EXTENSION(OES_depth_texture);
-            #else
-                true;
-            #endif
+        return *this;
+    }
 
-            JOP_ASSERT_EVAL(recordShader->load(depthTextureSupport ? "" : "#define JOP_PACK_DEPTH\n",
-                Shader::Type::Vertex, std::string(reinterpret_cast<const char*>(jopr::depthRecordShaderVert), sizeof(jopr::depthRecordShaderVert)),
-                Shader::Type::Fragment, std::string(reinterpret_cast<const char*>(jopr::depthRecordShaderFrag), sizeof(jopr::depthRecordShaderFrag))),
-                "Failed to compile depth record shader!");
-        }
+    //////////////////////////////////////////////
 
-        if (!m_shadowMap.bind() || !recordShader->bind())
-            return false;
+    unsigned int LightSource::getShadowCascades() const
+    {
+        return m_cascades;
+    }
+
+    //////////////////////////////////////////////
+
+    glm::mat4 LightSource::getShadowMatrix(const unsigned int index) const
+    {
+        if (index >= m_shadowTiles.size())
+            return glm::mat4();
+
+        const glm::vec4 rect = getShadowTile(index);
+
+        // Map the normalized device coordinates into the tile
+        glm::mat4 region(1.f);
+        region[0][0] = rect.z;
+        region[1][1] = rect.w;
+        region[3][0] = 2.f * rect.x + rect.z - 1.f;
+        region[3][1] = 2.f * rect.y + rect.w - 1.f;
+
+        return region * m_lightSpaceMatrices[index];
+    }
+
+    //////////////////////////////////////////////
+
+    glm::vec4 LightSource::getShadowTile(const unsigned int index) const
+    {
+        if (index >= m_shadowTiles.size())
+            return glm::vec4(0.f);
+
+        return m_rendererRef.getShadowAtlas().getRect(m_shadowTiles[index]);
+    }
+
+    //////////////////////////////////////////////
+
+    bool LightSource::hasShadowMap() const
+    {
+        return castsShadows() && !m_shadowTiles.empty();
+    }
+
+    //////////////////////////////////////////////
 
-        m_shadowMap.clear(RenderTarget::DepthBit);
-        /*
-        if (getType() == Type::Point)
+    const glm::vec4& LightSource::getCascadeSplits() const
+    {
+        return m_cascadeSplits;
+    }
+
+    //////////////////////////////////////////////
+
+    bool LightSource::drawShadowMap() const
+    {
+        // Tiles are only allocated for active lights. The atlas contents are lost
+        // once the tiles are gone, so the map needs to be drawn again when they return
+        if (!hasShadowMap())
         {
-            auto pos = getObject()->getGlobalPosition();
+            m_shadowVersion = 0;
+            return false;
+        }
 
-            const float range = getRange() * 10.f;
+        JOP_PROFILE("LightSource::drawShadowMap");
 
-            const glm::mat4 proj = glm::perspective(glm::half_pi<float>(), 1.f, 0.1f, range);
+        auto& atlas = m_rendererRef.getShadowAtlas();
 
-            makeCubemapMatrices(proj, pos, m_lightSpaceMatrices);
+        const bool point = getType() == Type::Point;
+        auto& obj = *getObject();
 
-            recordShader->setUniform("u_PVMatrices", glm::value_ptr(m_lightSpaceMatrices[0]), 6);
-            recordShader->setUniform("u_FarClippingPlane", range);
-            recordShader->setUniform("u_LightPosition", pos);
+        // Light space matrices
+        if (point)
+        {
+            const float range = getRange() * 10.f;
+
+            makeCubemapMatrices(glm::perspective(glm::half_pi<float>(), 1.f, 0.1f, range), obj.getGlobalPosition(), m_lightSpaceMatrices);
         }
+        else if (getType() == Type::Directional && m_cascades > 1)
+            fitCascades();
         else
         {
             // Use the object's scale to construct the frustum
-            auto scl = getObject()->getLocalScale();
+            auto scl = obj.getLocalScale();
 
             // We need scale at 1 to avoid messing up the view transform
-            glm::mat4 trans(getObject()->getInverseTransform().getMatrix());
+            glm::mat4 trans(obj.getInverseTransform().getMatrix());
             trans[0] = glm::normalize(trans[0]);
             trans[1] = glm::normalize(trans[1]);
             trans[2] = glm::normalize(trans[2]);
@@ -262,51 +485,277 @@ namespace jop
             if (getType() == Type::Directional)
             {
                 m_lightSpaceMatrices[0] = glm::ortho(scl.x * -0.5f, scl.x * 0.5f, scl.y * -0.5f, scl.y * 0.5f, 0.f, scl.z) * trans;
-                recordShader->setUniform("u_PVMatrix", m_lightSpaceMatrices[0]);
+                m_cascadeSplits = glm::vec4(0.f);
             }
             else
+                m_lightSpaceMatrices[0] = glm::perspective(getCutoff().y * 2.f, 1.f, 0.5f, getRange()) * trans;
+        }
+
+        // Gather the casters inside the light volume, per face
+        static std::array<std::vector<const Drawable*>, 6> faceCasters;
+        static std::vector<const Drawable*> staticCasters, dynamicCasters;
+
+        const std::size_t faces = m_lightSpaceMatrices.size();
+
+        for (std::size_t i = 0; i < faces; ++i)
+        {
+            auto& casters = faceCasters[i];
+            m_rendererRef.queryDrawables(m_lightSpaceMatrices[i], getRenderMask(), casters);
+
+            casters.erase(std::remove_if(casters.begin(), casters.end(), [](const Drawable* d)
             {
-                auto s = glm::vec2(m_shadowMap.getSize());
-                m_lightSpaceMatrices[0] = glm::perspective(getCutoff().y * 2.f, s.x / s.y, 0.5f, getRange()) * trans;
+                return !d->isActive() || !d->hasFlag(Drawable::CastShadows) || !d->getMesh();
+
+            }), casters.end());
+        }
+
+        // Static casters are cached separately. This requires blitting depth,
+        // so it's only done for single 2D shadow maps
+        bool useStaticLayer = false;
+
+        staticCasters.clear();
+        dynamicCasters.clear();
+
+        if (!point && faces == 1 && staticLayerSupported())
+        {
+            for (auto d : faceCasters[0])
+                (d->hasFlag(Drawable::StaticShadows) ? staticCasters : dynamicCasters).push_back(d);
+
+            useStaticLayer = !staticCasters.empty();
+        }
+
+        if (!useStaticLayer && m_staticShadowMap.isValid())
+        {
+            m_staticShadowMap.destroy(true, true);
+            m_staticShadowVersion = 0;
+        }
+
+        // Only render again if the light, its tiles or the casters have changed
+        const uint64 lightVersion = hashBytes(m_lightSpaceMatrices.data(), m_lightSpaceMatrices.size() * sizeof(glm::mat4));
+        const uint64 staticVersion = lightVersion + hashCasters(staticCasters);
+
+        const uint32 generation = atlas.getGeneration();
+        uint64 version = hashBytes(m_shadowTiles.data(), m_shadowTiles.size() * sizeof(ShadowAtlas::Tile), staticVersion);
+        version = hashBytes(&generation, sizeof(generation), version);
+
+        if (useStaticLayer)
+            version = hashBytes(&version, sizeof(version), hashCasters(dynamicCasters));
+        else
+        {
+            for (std::size_t i = 0; i < faces; ++i)
+                version = hashBytes(&version, sizeof(version), hashCasters(faceCasters[i]));
+        }
+
+        if (version == m_shadowVersion)
+            return false;
+
+        JOP_PROFILE_GPU("GPU LightSource::drawShadowMap");
+
+        auto& shader = getRecordShader(point);
+
+        if (!shader.bind())
+            return false;
+
+        GlState::setDepthTest(true);
+        GlState::setDepthWrite(true);
+
+        if (point)
+        {
+            shader.setUniform("u_LightPosition", obj.getGlobalPosition());
+            shader.setUniform("u_FarClippingPlane", getRange() * 10.f);
+        }
+
+    #ifndef JOP_OPENGL_ES
 
-                recordShader->setUniform("u_PVMatrix", m_lightSpaceMatrices[0]);
+        if (useStaticLayer)
+        {
+            const auto& tile = m_shadowTiles[0];
+
+            // The static layer matches the tile size so that it can be blitted as is
+            if (m_staticShadowMap.getSize() != glm::uvec2(tile.size))
+            {
+                m_staticShadowMap.destroy(true, true);
+                m_staticShadowVersion = 0;
             }
-        }*/
 
-        bool drawn = false;
+            if (!m_staticShadowMap.isValid())
+            {
+                m_staticShadowMap.setSize(glm::uvec2(tile.size));
+                useStaticLayer = m_staticShadowMap.addTextureAttachment(RenderTexture::Slot::Depth, Texture::Format::Depth_US_16);
+            }
+        }
 
-        /*for (auto d : drawables)
+        if (useStaticLayer)
         {
-            if (!d->isActive() || !d->castShadows() || (getRenderMask() & (1 << d->getRenderGroup())) == 0 || !d->lightTouches(*this))
-                continue;
+            const auto& tile = m_shadowTiles[0];
+            shader.setUniform("u_PVMatrix", m_lightSpaceMatrices[0]);
+
+            if (staticVersion != m_staticShadowVersion)
+            {
+                m_staticShadowMap.clear(RenderTarget::DepthBit);
+                drawCasters(shader, staticCasters);
+
+                m_staticShadowVersion = staticVersion;
+            }
+
+            // Rebinds the atlas for the following lights. bindDraw() binds the read
+            // framebuffer as well, so the static layer has to be bound after it
+            if (!atlas.getRenderTexture().bindDraw() || !m_staticShadowMap.bindRead())
+                return false;
 
-            drawn = true;
+            // The tile sets the scissor box, which also clips the blit
+            atlas.setTile(tile, false);
 
-            auto& mesh = *d->getModel().getMesh();
-            mesh.getVertexBuffer().bind();
+            const GLint x = static_cast<GLint>(tile.position.x), y = static_cast<GLint>(tile.position.y), size = static_cast<GLint>(tile.size);
+            glCheck(glBlitFramebuffer(0, 0, size, size, x, y, x + size, y + size, GL_DEPTH_BUFFER_BIT, GL_NEAREST));
+
+            drawCasters(shader, dynamicCasters);
+        }
+        else
 
-            shdr.setAttribute("a_Position", 0, GL_FLOAT, 3, mesh.getVertexSize(), mesh.getVertexOffset(Mesh::Position));
-            shdr.setUniform("u_MMatrix", d->getObject()->getTransform().getMatrix());
+    #endif
 
-            if (mesh.getElementAmount())
+        {
+            for (std::size_t i = 0; i < faces; ++i)
             {
-                mesh.getIndexBuffer().bind();
-                glCheck(glDrawElements(GL_TRIANGLES, mesh.getElementAmount(), mesh.getElementEnum(), (void*)0));
+                atlas.setTile(m_shadowTiles[i], true);
+
+                shader.setUniform("u_PVMatrix", m_lightSpaceMatrices[i]);
+                drawCasters(shader, faceCasters[i]);
             }
-            else
+        }
+
+        m_shadowVersion = version;
+
+        return true;
+    }
+
+    //////////////////////////////////////////////
+
+    void LightSource::fitCascades() const
+    {
+        const Camera* camera = findCamera(m_rendererRef, getRenderMask());
+
+        auto& obj = *getObject();
+        const glm::vec3 dir = glm::normalize(obj.getGlobalFront());
+
+        // Light rotation, the cascades are centered separately
+        const glm::mat4 lightView = glm::lookAt(glm::vec3(0.f), dir, std::abs(dir.y) > 0.99f ? glm::vec3(0.f, 0.f, 1.f) : glm::vec3(0.f, 1.f, 0.f));
+
+        // How far behind the cascade casters are included, as with the object's scale in the single cascade case
+        const float casterDistance = obj.getLocalScale().z;
+
+        if (!camera)
+        {
+            for (auto& mat : m_lightSpaceMatrices)
+                mat = glm::ortho(-0.5f, 0.5f, -0.5f, 0.5f, -casterDistance, casterDistance) * lightView;
+
+            m_cascadeSplits = glm::vec4(0.f);
+            return;
+        }
+
+        static const float shadowDistance = SettingManager::get<float>("engine@Graphics|Shading|fShadowCascadeDistance", 100.f);
+        static const float splitLambda = glm::clamp(SettingManager::get<float>("engine@Graphics|Shading|fShadowCascadeSplitLambda", 0.75f), 0.f, 1.f);
+
+        // Camera frustum corners in world space
+        const glm::mat4 invPV = glm::inverse(camera->getProjectionMatrix() * camera->getViewMatrix());
+        glm::vec3 nearCorners[4], farCorners[4];
+
+        for (int i = 0; i < 4; ++i)
+        {
+            const glm::vec2 ndc(i & 1 ? 1.f : -1.f, i & 2 ? 1.f : -1.f);
+
+            const glm::vec4 n = invPV * glm::vec4(ndc, -1.f, 1.f);
+            const glm::vec4 f = invPV * glm::vec4(ndc, 1.f, 1.f);
+
+            nearCorners[i] = glm::vec3(n) / n.w;
+            farCorners[i] = glm::vec3(f) / f.w;
+        }
+
+        const float clipNear = std::max(camera->getClippingPlanes().first, 0.001f);
+        const float clipFar = std::max(camera->getClippingPlanes().second, clipNear + 0.001f);
+        const float distance = std::min(clipFar, std::max(shadowDistance, clipNear + 0.001f));
+
+        const std::size_t cascades = m_lightSpaceMatrices.size();
+
+        m_cascadeSplits = makeCascadeSplits(clipNear, distance, splitLambda, static_cast<unsigned int>(cascades));
+        float splitNear = clipNear;
+
+        for (std::size_t i = 0; i < cascades; ++i)
+        {
+            const float splitFar = m_cascadeSplits[static_cast<int>(i)];
+
+            // Bounding sphere of the frustum slice keeps the projection
+            // size constant when the camera rotates
+            glm::vec3 corners[8];
+            glm::vec3 center(0.f);
+
+            for (int j = 0; j < 4; ++j)
             {
-                glCheck(glDrawArrays(GL_TRIANGLES, 0, mesh.getVertexAmount()));
+                const glm::vec3 edge = farCorners[j] - nearCorners[j];
+
+                corners[j]     = nearCorners[j] + edge * ((splitNear - clipNear) / (clipFar - clipNear));
+                corners[j + 4] = nearCorners[j] + edge * ((splitFar - clipNear) / (clipFar - clipNear));
+
+                center += corners[j] + corners[j + 4];
             }
-        }*/
 
-        return drawn;
+            center /= 8.f;
+
+            float radius = 0.f;
+
+            for (auto& c : corners)
+                radius = std::max(radius, glm::length(c - center));
+
+            radius = std::ceil(radius * 16.f) / 16.f;
+
+            // Snap to texel increments to avoid shimmering when the camera moves
+            glm::vec3 lsCenter(lightView * glm::vec4(center, 1.f));
+            const float texelSize = (radius * 2.f) / static_cast<float>(m_shadowTiles[i].size);
+
+            lsCenter.x = std::floor(lsCenter.x / texelSize) * texelSize;
+            lsCenter.y = std::floor(lsCenter.y / texelSize) * texelSize;
+
+            m_lightSpaceMatrices[i] = glm::ortho(lsCenter.x - radius, lsCenter.x + radius,
+                                                 lsCenter.y - radius, lsCenter.y + radius,
+                                                 -lsCenter.z - radius - casterDistance, -lsCenter.z + radius) * lightView;
+
+            splitNear = splitFar;
+        }
     }
 
     //////////////////////////////////////////////
 
     const Texture* LightSource::getShadowMap() const
     {
-        return m_shadowMap.getTextureAttachment(RenderTexture::Slot::Depth);
+        return hasShadowMap() ? m_rendererRef.getShadowAtlas().getTexture() : nullptr;
+    }
+
+    //////////////////////////////////////////////
+
+    unsigned int LightSource::getShadowTileSize() const
+    {
+        static const unsigned int defMapSize = SettingManager::get<unsigned int>("engine@Graphics|Shading|uDefaultShadowMapResolution", 512);
+        const unsigned int maxSize = m_shadowResolution ? m_shadowResolution : defMapSize;
+
+        const Camera* camera = findCamera(m_rendererRef, getRenderMask());
+
+        if (m_type == Type::Directional || !camera)
+            return maxSize;
+
+        // Approximate the share of the screen height covered by the light volume
+        const float range = getRange();
+        const glm::vec3 viewPos(camera->getViewMatrix() * glm::vec4(getObject()->getGlobalPosition(), 1.f));
+        const float distance = glm::length(viewPos);
+
+        if (distance <= range)
+            return maxSize;
+
+        const float coverage = camera->getProjectionMode() == Camera::Projection::Perspective
+                             ? range / (distance * std::tan(camera->getFieldOfView() * 0.5f))
+                             : (range * 2.f) / camera->getSize().y;
+
+        return std::max(static_cast<unsigned int>(maxSize * glm::clamp(coverage, 0.f, 1.f)), ShadowAtlas::getMinimumTileSize());
     }
 
     ///////////////////////////////////////////
@@ -424,9 +873,10 @@ namespace jop
     {
         static const unsigned int defLimits[] =
         {
-            gl::getGLSLVersion() >= 300 ? 8u : 1u,
-            gl::getGLSLVersion() >= 300 ? 2u : 1u,
+            // Shadows are in a single atlas, so these aren't limited by texture units
+            gl::getGLSLVersion() >= 300 ? 16u : 1u,
             gl::getGLSLVersion() >= 300 ? 2u : 1u,
+            gl::getGLSLVersion() >= 300 ? 8u : 1u,
         };
 
         static const unsigned int maxLights[] =
@@ -453,9 +903,27 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    glm::vec4 LightSource::makeCascadeSplits(const float clipNear, const float distance, const float lambda, const unsigned int cascades)
+    {
+        glm::vec4 splits(0.f);
+        const unsigned int count = std::min(cascades, static_cast<unsigned int>(MaxShadowCascades));
+
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            // Blend between logarithmic and uniform split distances
+            const float p = static_cast<float>(i + 1) / count;
+
+            splits[static_cast<int>(i)] = lambda * clipNear * std::pow(distance / clipNear, p) + (1.f - lambda) * (clipNear + (distance - clipNear) * p);
+        }
+
+        return splits;
+    }
+
+    //////////////////////////////////////////////
+
     Message::Result LightSource::receiveMessage(const Message& message)
     {
-        if (JOP_EXECUTE_COMMAND(LightSource, message.getString(), this) == Message::Result::Escape)
+        if (JOP_EXECUTE_COMMAND(LightSource, message, this) == Message::Result::Escape)
             return Message::Result::Escape;
 
         return Component::receiveMessage(message);
@@ -466,7 +934,11 @@ namespace jop
 
 
     LightContainer::LightContainer()
-        : m_container()
+        : m_container   (),
+          m_blockData   (),
+          m_block       (Buffer::StreamDraw),
+          m_blockView   (),
+          m_blockValid  (false)
     {}
 
     //////////////////////////////////////////////
@@ -488,6 +960,8 @@ namespace jop
     {
         for (auto& i : m_container)
             i.clear();
+
+        m_blockValid = false;
     }
 
     //////////////////////////////////////////////
@@ -497,7 +971,7 @@ namespace jop
         const bool receiveLights = drawable.hasFlag(Drawable::ReceiveLights);
         const bool receiveShadows = drawable.hasFlag(Drawable::ReceiveShadows);
 
-        shader.setUniform("u_ReceiveLights", receiveLights);
+        shader.setUniform(shader.getUniformHandle(ShaderProgram::Uniform::ReceiveLights), receiveLights);
 
     #if defined(JOP_OPENGL_ES) && JOP_MIN_OPENGL_ES_VERSION < 300
         if (gl::getGLSLVersion() >= 300)
@@ -509,31 +983,29 @@ namespace jop
         }
 
         const bool shadows = (drawable.getMaterial()->getAttributes() & Material::FragLightingAttribs) != 0;
-        
+
         if (shadows)
-            shader.setUniform("u_ReceiveShadows", receiveShadows);
+            shader.setUniform(shader.getUniformHandle(ShaderProgram::Uniform::ReceiveShadows), receiveShadows);
 
         typedef LightSource LS;
 
-        static const unsigned int pointShadowStartUnit = static_cast<unsigned int>(Material::Map::__Last);
-        unsigned int currentPointShadowUnit = pointShadowStartUnit;
+        // The shadow atlas goes right after the material maps
+        static const unsigned int shadowAtlasUnit = static_cast<unsigned int>(Material::Map::__Last);
+
+        // Each table holds the uniform names of every light of the given type, flattened
+        // as [light index * field count + field]
+        static const std::size_t numPointFields = 13, numSpotFields = 10, numDirFields = 15;
 
-        static const unsigned int dirSpotShadowStartUnit = pointShadowStartUnit + LS::getMaximumLights(LS::Type::Point);
-        unsigned int currentDirSpotShadowUnit = dirSpotShadowStartUnit;
-        
-        static std::array<std::vector<std::vector<std::string>>, 3> strCache;
+        static std::array<ShaderProgram::UniformTable, 3> strCache;
         static bool cacheInit = false;
 
         if (!cacheInit)
         {
-            strCache[0].resize(LS::getMaximumLights(LS::Type::Point));
-            strCache[1].resize(LS::getMaximumLights(LS::Type::Spot));
-            strCache[2].resize(LS::getMaximumLights(LS::Type::Directional));
 
             for (std::size_t i = 0; i < LS::getMaximumLights(LS::Type::Point); ++i)
             {
-                auto& cache = strCache[static_cast<int>(LS::Type::Point)][i];
-                cache.reserve(8);
+                auto& cache = strCache[static_cast<int>(LS::Type::Point)];
+                cache.reserve(LS::getMaximumLights(LS::Type::Point) * numPointFields);
                 const std::string indexed = "u_PointLights[" + std::to_string(i) + "].";
 
                 /* 0 */ cache.emplace_back(indexed + "position");
@@ -545,14 +1017,17 @@ namespace jop
                 /* 4 */ cache.emplace_back(indexed + "attenuation");
 
                 /* 5 */ cache.emplace_back(indexed + "castShadow");
-                /* 6 */ cache.emplace_back("u_PointLightShadowMaps[" + std::to_string(i) + "]");
-                /* 7 */ cache.emplace_back(indexed + "farPlane");
+                /* 6 */ cache.emplace_back(indexed + "farPlane");
+
+                /* 7 - 12 */
+                for (std::size_t j = 0; j < 6; ++j)
+                    cache.emplace_back(indexed + "shadowTiles[" + std::to_string(j) + "]");
             }
 
             for (std::size_t i = 0; i < LS::getMaximumLights(LS::Type::Spot); ++i)
             {
-                auto& cache = strCache[static_cast<int>(LS::Type::Spot)][i];
-                cache.reserve(10);
+                auto& cache = strCache[static_cast<int>(LS::Type::Spot)];
+                cache.reserve(LS::getMaximumLights(LS::Type::Spot) * numSpotFields);
                 const std::string indexed = "u_SpotLights[" + std::to_string(i) + "].";
 
                 /* 0 */ cache.emplace_back(indexed + "position");
@@ -569,13 +1044,13 @@ namespace jop
 
                 /* 7 */ cache.emplace_back(indexed + "castShadow");
                 /* 8 */ cache.emplace_back(indexed + "lsMatrix");
-                /* 9 */ cache.emplace_back("u_SpotLightShadowMaps[" + std::to_string(i) + "]");
+                /* 9 */ cache.emplace_back(indexed + "shadowTile");
             }
 
             for (std::size_t i = 0; i < LS::getMaximumLights(LS::Type::Directional); ++i)
             {
-                auto& cache = strCache[static_cast<int>(LS::Type::Directional)][i];
-                cache.reserve(7);
+                auto& cache = strCache[static_cast<int>(LS::Type::Directional)];
+                cache.reserve(LS::getMaximumLights(LS::Type::Directional) * numDirFields);
                 const std::string indexed = "u_DirectionalLights[" + std::to_string(i) + "].";
 
                 /* 0 */ cache.emplace_back(indexed + "direction");
@@ -585,23 +1060,69 @@ namespace jop
                 /* 3 */ cache.emplace_back(indexed + "specular");
 
                 /* 4 */ cache.emplace_back(indexed + "castShadow");
-                /* 5 */ cache.emplace_back(indexed + "lsMatrix");
-                /* 6 */ cache.emplace_back("u_DirectionalLightShadowMaps[" + std::to_string(i) + "]");
+                /* 5 */ cache.emplace_back(indexed + "cascadeSplits");
+                /* 6 */ cache.emplace_back(indexed + "numCascades");
+
+                /* 7 - 10 */
+                for (std::size_t j = 0; j < LS::MaxShadowCascades; ++j)
+                    cache.emplace_back(indexed + "lsMatrices[" + std::to_string(j) + "]");
+
+                /* 11 - 14 */
+                for (std::size_t j = 0; j < LS::MaxShadowCascades; ++j)
+                    cache.emplace_back(indexed + "shadowTiles[" + std::to_string(j) + "]");
             }
 
             cacheInit = true;
         }
 
+        // Every light of the renderer shares the same atlas
+        if (receiveShadows && shadows)
+        {
+            const Texture* atlas = nullptr;
+
+            for (auto& lights : m_container)
+            {
+                for (auto li : lights)
+                {
+                    if (li->hasShadowMap())
+                    {
+                        atlas = li->getShadowMap();
+                        break;
+                    }
+                }
+
+                if (atlas)
+                {
+                    shader.setUniform(shader.getUniformHandle(ShaderProgram::Uniform::ShadowAtlas), *atlas, shadowAtlasUnit);
+                    break;
+                }
+            }
+        }
+
+        if (UniformBuffer::isAvailable())
+        {
+            if (!m_blockValid || m_blockView != viewMatrix)
+                updateBlock(viewMatrix);
+
+            m_block.bindBase(UniformBuffer::Binding::Lights);
+
+            return;
+        }
+
+        // Shadow matrices are applied to view space positions
+        const glm::mat4 invView = glm::inverse(viewMatrix);
+
         // Point lights
         {
             auto& points = (*this)[LS::Type::Point];
+            const int* handles = shader.getUniformHandles(strCache[static_cast<int>(LS::Type::Point)]);
 
         #if defined(JOP_OPENGL_ES) && JOP_MIN_OPENGL_ES_VERSION < 300
             if (gl::getGLSLVersion() >= 300)
         #endif
             if (!points.empty())
             {
-                shader.setUniform("u_NumPointLights", static_cast<int>(points.size()));
+                shader.setUniform(shader.getUniformHandle(ShaderProgram::Uniform::NumPointLights), static_cast<int>(points.size()));
             }
 
             for (std::size_t i = 0; i < points.size(); ++i)
@@ -618,7 +1139,7 @@ namespace jop
             #endif
 
                 auto& li = *points[i];
-                auto& cache = strCache[static_cast<int>(LS::Type::Point)][i];
+                const int* cache = handles + i * numPointFields;
 
                 // Position
                 shader.setUniform(cache[0], glm::vec3(viewMatrix * glm::vec4(li.getObject()->getGlobalPosition(), 1.f)));
@@ -634,12 +1155,14 @@ namespace jop
                 // Shadow map
                 if (receiveShadows && shadows)
                 {
-                    shader.setUniform(cache[5], li.castsShadows());
+                    shader.setUniform(cache[5], li.hasShadowMap());
 
-                    if (li.castsShadows())
+                    if (li.hasShadowMap())
                     {
-                        shader.setUniform(cache[6], *li.getShadowMap(), currentPointShadowUnit++);
-                        shader.setUniform(cache[7], li.getRange() * 10.f);
+                        shader.setUniform(cache[6], li.getRange() * 10.f);
+
+                        for (unsigned int j = 0; j < 6; ++j)
+                            shader.setUniform(cache[7 + j], li.getShadowTile(j));
                     }
                 }
             }
@@ -648,13 +1171,14 @@ namespace jop
         // Spot lights
         {
             auto& spots = (*this)[LS::Type::Spot];
+            const int* handles = shader.getUniformHandles(strCache[static_cast<int>(LS::Type::Spot)]);
 
         #if defined(JOP_OPENGL_ES) && JOP_MIN_OPENGL_ES_VERSION < 300
             if (gl::getGLSLVersion() >= 300)
         #endif
             if (!spots.empty())
             {
-                shader.setUniform("u_NumSpotLights", static_cast<int>(spots.size()));
+                shader.setUniform(shader.getUniformHandle(ShaderProgram::Uniform::NumSpotLights), static_cast<int>(spots.size()));
             }
 
             for (std::size_t i = 0; i < spots.size(); ++i)
@@ -671,7 +1195,7 @@ namespace jop
             #endif
 
                 auto& li = *spots[i];
-                auto& cache = strCache[static_cast<int>(LS::Type::Spot)][i];
+                const int* cache = handles + i * numSpotFields;
 
                 // Position
                 shader.setUniform(cache[0], glm::vec3(viewMatrix * glm::vec4(li.getObject()->getGlobalPosition(), 1.f)));
@@ -693,12 +1217,12 @@ namespace jop
                 // Shadow map
                 if (receiveShadows && shadows)
                 {
-                    shader.setUniform(cache[7], li.castsShadows());
+                    shader.setUniform(cache[7], li.hasShadowMap());
 
-                    if (li.castsShadows())
+                    if (li.hasShadowMap())
                     {
-                        shader.setUniform(cache[8], li.getLightspaceMatrix());
-                        shader.setUniform(cache[9], *li.getShadowMap(), currentDirSpotShadowUnit++);
+                        shader.setUniform(cache[8], li.getShadowMatrix(0) * invView);
+                        shader.setUniform(cache[9], li.getShadowTile(0));
                     }
                 }
             }
@@ -707,13 +1231,14 @@ namespace jop
         // Directional lights
         {
             auto& dirs = (*this)[LS::Type::Directional];
+            const int* handles = shader.getUniformHandles(strCache[static_cast<int>(LS::Type::Directional)]);
 
         #if defined(JOP_OPENGL_ES) && JOP_MIN_OPENGL_ES_VERSION < 300
             if (gl::getGLSLVersion() >= 300)
         #endif
             if (!dirs.empty())
             {
-                shader.setUniform("u_NumDirectionalLights", static_cast<int>(dirs.size()));
+                shader.setUniform(shader.getUniformHandle(ShaderProgram::Uniform::NumDirectionalLights), static_cast<int>(dirs.size()));
             }
 
             for (std::size_t i = 0; i < dirs.size(); ++i)
@@ -730,11 +1255,11 @@ namespace jop
             #endif
 
                 auto& li = *dirs[i];
-                auto& cache = strCache[static_cast<int>(LS::Type::Directional)][i];
+                const int* cache = handles + i * numDirFields;
 
                 // Direction
                 shader.setUniform(cache[0], glm::normalize(li.getObject()->getGlobalFront()));
-                
+
                 // Intensity
                 shader.setUniform(cache[1], li.getIntensity(LS::Intensity::Ambient).colors);
                 shader.setUniform(cache[2], li.getIntensity(LS::Intensity::Diffuse).colors);
@@ -743,12 +1268,18 @@ namespace jop
                 // Shadow map
                 if (receiveShadows && shadows)
                 {
-                    shader.setUniform(cache[4], li.castsShadows());
+                    shader.setUniform(cache[4], li.hasShadowMap());
 
-                    if (li.castsShadows())
+                    if (li.hasShadowMap())
                     {
-                        shader.setUniform(cache[5], li.getLightspaceMatrix());
-                        shader.setUniform(cache[6], *li.getShadowMap(), currentDirSpotShadowUnit++);
+                        shader.setUniform(cache[5], li.getCascadeSplits());
+                        shader.setUniform(cache[6], static_cast<int>(li.getShadowCascades()));
+
+                        for (unsigned int j = 0; j < li.getShadowCascades(); ++j)
+                        {
+                            shader.setUniform(cache[7 + j], li.getShadowMatrix(j) * invView);
+                            shader.setUniform(cache[11 + j], li.getShadowTile(j));
+                        }
                     }
                 }
             }
@@ -757,6 +1288,100 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    void LightContainer::updateBlock(const glm::mat4& viewMatrix) const
+    {
+        typedef LightSource LS;
+
+        auto& points = (*this)[LS::Type::Point];
+        auto& spots = (*this)[LS::Type::Spot];
+        auto& dirs = (*this)[LS::Type::Directional];
+
+        // The arrays are sized by the maximum amount of lights, same as in the shaders
+        static const std::size_t spotOffset = ns_lightArrayOffset + LS::getMaximumLights(LS::Type::Point) * sizeof(PointLightBlock);
+        static const std::size_t dirOffset = spotOffset + LS::getMaximumLights(LS::Type::Spot) * sizeof(SpotLightBlock);
+        static const std::size_t blockSize = dirOffset + LS::getMaximumLights(LS::Type::Directional) * sizeof(DirectionalLightBlock);
+
+        m_blockData.resize(blockSize);
+
+        auto counts = reinterpret_cast<int32*>(m_blockData.data());
+        counts[0] = static_cast<int32>(points.size());
+        counts[1] = static_cast<int32>(spots.size());
+        counts[2] = static_cast<int32>(dirs.size());
+
+        // Point lights
+        auto pointBlocks = reinterpret_cast<PointLightBlock*>(&m_blockData[ns_lightArrayOffset]);
+
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            auto& li = *points[i];
+            auto& block = pointBlocks[i];
+
+            block.position      = glm::vec3(viewMatrix * glm::vec4(li.getObject()->getGlobalPosition(), 1.f));
+            block.castShadow    = li.hasShadowMap();
+            block.ambient       = li.getIntensity(LS::Intensity::Ambient).colors;
+            block.diffuse       = li.getIntensity(LS::Intensity::Diffuse).colors;
+            block.specular      = li.getIntensity(LS::Intensity::Specular).colors;
+            block.attenuation   = li.getAttenuation();
+            block.farPlane      = li.getRange() * 10.f;
+
+            for (unsigned int j = 0; j < 6; ++j)
+                block.shadowTiles[j] = li.getShadowTile(j);
+        }
+
+        // Shadow matrices are applied to view space positions
+        const glm::mat4 invView = glm::inverse(viewMatrix);
+
+        // Spot lights
+        auto spotBlocks = reinterpret_cast<SpotLightBlock*>(&m_blockData[spotOffset]);
+
+        for (std::size_t i = 0; i < spots.size(); ++i)
+        {
+            auto& li = *spots[i];
+            auto& block = spotBlocks[i];
+
+            block.position      = glm::vec3(viewMatrix * glm::vec4(li.getObject()->getGlobalPosition(), 1.f));
+            block.castShadow    = li.hasShadowMap();
+            block.direction     = glm::normalize(li.getObject()->getGlobalFront());
+            block.ambient       = li.getIntensity(LS::Intensity::Ambient).colors;
+            block.diffuse       = li.getIntensity(LS::Intensity::Diffuse).colors;
+            block.specular      = li.getIntensity(LS::Intensity::Specular).colors;
+            block.attenuation   = li.getAttenuation();
+            block.cutoff        = glm::vec2(std::cos(li.getCutoff().x), std::cos(li.getCutoff().y));
+            block.lsMatrix      = li.getShadowMatrix(0) * invView;
+            block.shadowTile    = li.getShadowTile(0);
+        }
+
+        // Directional lights
+        auto dirBlocks = reinterpret_cast<DirectionalLightBlock*>(&m_blockData[dirOffset]);
+
+        for (std::size_t i = 0; i < dirs.size(); ++i)
+        {
+            auto& li = *dirs[i];
+            auto& block = dirBlocks[i];
+
+            block.direction     = glm::normalize(li.getObject()->getGlobalFront());
+            block.castShadow    = li.hasShadowMap();
+            block.ambient       = li.getIntensity(LS::Intensity::Ambient).colors;
+            block.diffuse       = li.getIntensity(LS::Intensity::Diffuse).colors;
+            block.specular      = li.getIntensity(LS::Intensity::Specular).colors;
+            block.cascadeSplits = li.getCascadeSplits();
+            block.numCascades   = static_cast<int32>(li.getShadowCascades());
+
+            for (unsigned int j = 0; j < li.getShadowCascades(); ++j)
+            {
+                block.lsMatrices[j] = li.getShadowMatrix(j) * invView;
+                block.shadowTiles[j] = li.getShadowTile(j);
+            }
+        }
+
+        m_block.setData(m_blockData.data(), m_blockData.size());
+
+        m_blockView = viewMatrix;
+        m_blockValid = true;
+    }
+
+    //////////////////////////////////////////////
+
     LightContainer::ContainerType& LightContainer::operator[](const LightSource::Type type)
     {
         return m_container[static_cast<int>(type)];
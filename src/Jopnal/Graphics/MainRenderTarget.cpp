@@ -28,26 +28,137 @@
 
     #include <Jopnal/Core/SettingManager.hpp>
     #include <Jopnal/Graphics/OpenGL/OpenGL.hpp>
+    #include <Jopnal/Utility/CommandHandler.hpp>
     #include <Jopnal/Window/Window.hpp>
+    #include <glm/common.hpp>
+    #include <cmath>
 
 #endif
 
 //////////////////////////////////////////////
 
 
+namespace
+{
+    // Scales are quantized so that the post processor can reuse its targets
+    const float ns_scaleStep = 1.f / 16.f;
+
+    const unsigned int ns_scaleCooldown = 30;
+}
+
+namespace jop
+{
+    JOP_REGISTER_COMMAND_HANDLER(MainRenderTarget)
+
+        JOP_COMMAND_RECEIVERS(Message::Subsystem);
+
+        JOP_BIND_MEMBER_COMMAND(&MainRenderTarget::setResolutionScale, "setResolutionScale");
+
+    JOP_END_COMMAND_HANDLER(MainRenderTarget)
+}
+
 namespace jop
 {
     MainRenderTarget::MainRenderTarget(const Window& window)
         : RenderTexture (),
           Subsystem     (0),
-          m_windowRef   (window)
+          m_windowRef   (window),
+          m_maxScale    (SettingManager::get<float>("engine@Graphics|MainRenderTarget|fResolutionScale", 1.f)),
+          m_scale       (m_maxScale),
+          m_frameTime   (0.f),
+          m_cooldown    (0)
+    {
+        resize(m_scale);
+
+        setClearColor(Color(SettingManager::get<std::string>("engine@Graphics|MainRenderTarget|sClearColor", "000000FF")));
+    }
+
+    //////////////////////////////////////////////
+
+    void MainRenderTarget::preUpdate(const float deltaTime)
     {
-        const glm::uvec2 scaledRes(SettingManager::get<float>("engine@Graphics|MainRenderTarget|fResolutionScale", 1.f) * glm::vec2(window.getSize()));
+        static const DynamicSetting<bool> dynamic("engine@Graphics|MainRenderTarget|bDynamicResolution", false);
+
+        if (dynamic.value && deltaTime > 0.f)
+        {
+            static const DynamicSetting<float> targetTime("engine@Graphics|MainRenderTarget|fTargetFrameTime", 1.f / 60.f);
+            static const DynamicSetting<float> minScale("engine@Graphics|MainRenderTarget|fMinResolutionScale", 0.5f);
+
+            // Smooth the frame time so that single spikes don't cause a resize
+            m_frameTime = m_frameTime > 0.f ? glm::mix(m_frameTime, deltaTime, 0.1f) : deltaTime;
+
+            if (m_cooldown > 0)
+                --m_cooldown;
+
+            else
+            {
+                float scale = m_scale;
+
+                if (m_frameTime > targetTime.value * 1.05f)
+                    scale -= ns_scaleStep;
+
+                else if (m_frameTime < targetTime.value * 0.85f)
+                    scale += ns_scaleStep;
+
+                scale = glm::clamp(scale, std::min(minScale.value, m_maxScale), m_maxScale);
 
-        const bool hdr = SettingManager::get<bool>("engine@Graphics|MainRenderTarget|bHDR", !gl::es || JOP_CHECK_EGL_EXTENSION(GL_EXT_color_buffer_half_float));
+                if (scale != m_scale)
+                {
+                    resize(scale);
+                    m_cooldown = ns_scaleCooldown;
+                }
+            }
+        }
+        else if (m_scale != m_maxScale)
+            resize(m_maxScale);
+
+        clear(AllBit);
+    }
+
+    //////////////////////////////////////////////
+
+    void MainRenderTarget::setResolutionScale(const float scale)
+    {
+        m_maxScale = std::max(scale, ns_scaleStep);
+
+        if (m_maxScale != m_scale)
+            resize(m_maxScale);
+    }
+
+    //////////////////////////////////////////////
+
+    float MainRenderTarget::getResolutionScale() const
+    {
+        return m_scale;
+    }
+
+    //////////////////////////////////////////////
+
+    Message::Result MainRenderTarget::receiveMessage(const Message& message)
+    {
+        if (JOP_EXECUTE_COMMAND(MainRenderTarget, message, this) == Message::Result::Escape)
+            return Message::Result::Escape;
+
+        return Subsystem::receiveMessage(message);
+    }
+
+    //////////////////////////////////////////////
+
+    void MainRenderTarget::resize(const float scale)
+    {
+        const glm::uvec2 scaledRes(glm::max(glm::vec2(m_windowRef.getSize()) * scale, glm::vec2(1.f)));
+
+        m_scale = scale;
+
+        if (isValid() && getSize() == scaledRes)
+            return;
+
+        static const bool hdr = SettingManager::get<bool>("engine@Graphics|MainRenderTarget|bHDR", !gl::es || JOP_CHECK_EGL_EXTENSION(GL_EXT_color_buffer_half_float));
 
         using CA = Texture::Format;
 
+        destroy(true, true);
+
         setSize(scaledRes);
         addTextureAttachment(Slot::Color0, hdr ? CA::RGBA_F_16 : CA::RGBA_UB_8);
         
@@ -55,14 +166,5 @@ namespace jop
             addRenderbufferAttachment(Slot::Depth, CA::Depth_US_16);
 
         getTextureAttachment(Slot::Color0)->setFilterMode(TextureSampler::Filter::Bilinear).setRepeatMode(TextureSampler::Repeat::ClampEdge);
-
-        setClearColor(Color(SettingManager::get<std::string>("engine@Graphics|MainRenderTarget|sClearColor", "000000FF")));
-    }
-
-    //////////////////////////////////////////////
-
-    void MainRenderTarget::preUpdate(const float)
-    {
-        clear(AllBit);
     }
 }
\ No newline at end of file
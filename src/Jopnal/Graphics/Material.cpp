@@ -68,6 +68,21 @@ namespace
 
         return colors;
     }
+
+    // std140 layout of jop_MaterialBlock
+    struct MaterialBlock
+    {
+        glm::vec4 reflection[4];
+        float shininess;
+        float reflectivity;
+        float padding[2];
+    };
+
+    static_assert(sizeof(MaterialBlock) == 80, "Material block doesn't match the std140 layout");
+
+    // The last material to be sent to a shader. Consecutive uploads
+    // of the same material into the same shader are redundant
+    std::pair<const jop::ShaderProgram*, const jop::Material*> ns_lastUpload;
 }
 
 namespace jop
@@ -88,7 +103,10 @@ namespace jop
           m_shininess       (1.f),
           m_maps            (),
           m_shader          (),
-          m_updateShader    (true)
+          m_block           (),
+          m_version         (0),
+          m_updateShader    (true),
+          m_updateBlock     (true)
     {}
 
     Material::Material(const Material& other, const std::string& newName)
@@ -99,7 +117,10 @@ namespace jop
           m_shininess       (other.m_shininess),
           m_maps            (other.m_maps),
           m_shader          (other.m_shader),
-          m_updateShader    (other.m_updateShader)
+          m_block           (),
+          m_version         (0),
+          m_updateShader    (other.m_updateShader),
+          m_updateBlock     (true)
     {}
 
     //////////////////////////////////////////////
@@ -108,7 +129,7 @@ namespace jop
     {
         if (shader.bind())
         {
-            static const std::string strCache[] =
+            static const ShaderProgram::UniformTable strCache =
             {
                 /* 0 */  "u_CameraPosition",
                 /* 1 */  "u_Material.ambient",
@@ -126,41 +147,78 @@ namespace jop
                 /* 13 */ "u_ReflectionMap"
             };
 
-            if (m_attributes & LightingAttribs)
-            {
-                shader.setUniform(strCache[1], m_reflection[castEnum(Reflection::Ambient)].asRGBAVector());
-                shader.setUniform(strCache[2], m_reflection[castEnum(Reflection::Diffuse)].asRGBAVector());
-                shader.setUniform(strCache[3], m_reflection[castEnum(Reflection::Specular)].asRGBAVector());
-                shader.setUniform(strCache[4], m_reflection[castEnum(Reflection::Emission)].asRGBAVector());
-                shader.setUniform(strCache[5], m_shininess);
+            // The uniforms can be skipped if they're already in place. The maps still
+            // need to be bound, other drawables may have used the same texture units
+            const bool uploaded = ns_lastUpload.first == &shader && ns_lastUpload.second == this;
+            ns_lastUpload = std::make_pair(&shader, this);
 
-                if (checkMap(m_attributes, Map::Environment))
-                    shader.setUniform(strCache[6], m_reflectivity);
+            const int* handles = shader.getUniformHandles(strCache);
 
-                if (checkMap(m_attributes, Map::Gloss) && getMap(Map::Gloss))
-                    shader.setUniform(strCache[11], *getMap(Map::Gloss), castEnum<Map, unsigned int>(Map::Gloss));
+            auto sendMap = [&shader, handles, uploaded, this](const int index, const Map map)
+            {
+                if (checkMap(m_attributes, map) && getMap(map))
+                {
+                    if (uploaded)
+                        getMap(map)->bind(castEnum<Map, unsigned int>(map));
+                    else
+                        shader.setUniform(handles[index], *getMap(map), castEnum<Map, unsigned int>(map));
+
+                    return true;
+                }
 
-                if (checkMap(m_attributes, Map::Specular) && getMap(Map::Specular))
-                    shader.setUniform(strCache[8], *getMap(Map::Specular), castEnum<Map, unsigned int>(Map::Specular));
+                return false;
+            };
 
-                if (checkMap(m_attributes, Map::Emission) && getMap(Map::Emission))
-                    shader.setUniform(strCache[9], *getMap(Map::Emission), castEnum<Map, unsigned int>(Map::Emission));
+            if (m_attributes & LightingAttribs)
+            {
+                if (UniformBuffer::isAvailable())
+                {
+                    if (m_updateBlock)
+                    {
+                        MaterialBlock block;
+
+                        for (std::size_t i = 0; i < m_reflection.size(); ++i)
+                            block.reflection[i] = m_reflection[i].asRGBAVector();
+
+                        block.shininess = m_shininess;
+                        block.reflectivity = m_reflectivity;
+
+                        m_block.setData(&block, sizeof(block));
+                        m_updateBlock = false;
+                    }
+
+                    m_block.bindBase(UniformBuffer::Binding::Material);
+                }
+                else if (!uploaded)
+                {
+                    shader.setUniform(handles[1], m_reflection[castEnum(Reflection::Ambient)].asRGBAVector());
+                    shader.setUniform(handles[2], m_reflection[castEnum(Reflection::Diffuse)].asRGBAVector());
+                    shader.setUniform(handles[3], m_reflection[castEnum(Reflection::Specular)].asRGBAVector());
+                    shader.setUniform(handles[4], m_reflection[castEnum(Reflection::Emission)].asRGBAVector());
+                    shader.setUniform(handles[5], m_shininess);
+
+                    if (checkMap(m_attributes, Map::Environment))
+                        shader.setUniform(handles[6], m_reflectivity);
+                }
+
+                sendMap(11, Map::Gloss);
+                sendMap(8, Map::Specular);
+                sendMap(9, Map::Emission);
             }
 
-            if (checkMap(m_attributes, Map::Diffuse0) && getMap(Map::Diffuse0))
-                shader.setUniform(strCache[7], *getMap(Material::Map::Diffuse0), castEnum<Map, unsigned int>(Map::Diffuse0));
+            sendMap(7, Map::Diffuse0);
+            sendMap(10, Map::Opacity);
 
-            if (checkMap(m_attributes, Map::Opacity) && getMap(Map::Opacity))
-                shader.setUniform(strCache[10], *getMap(Map::Opacity), castEnum<Map, unsigned int>(Map::Opacity));
+            if (sendMap(12, Map::Environment))
+                sendMap(13, Map::Reflection);
+        }
+    }
 
-            if (checkMap(m_attributes, Map::Environment) && getMap(Map::Environment))
-            {
-                shader.setUniform(strCache[12], *getMap(Map::Environment), castEnum<Map, unsigned int>(Map::Environment));
+    //////////////////////////////////////////////
 
-                if (checkMap(m_attributes, Map::Reflection) && getMap(Map::Reflection))
-                    shader.setUniform(strCache[13], *getMap(Map::Reflection), castEnum<Map, unsigned int>(Map::Reflection));
-            }
-        }
+    void Material::resetUniformCache()
+    {
+        ns_lastUpload = std::make_pair(nullptr, nullptr);
     }
 
     //////////////////////////////////////////////
@@ -171,6 +229,7 @@ namespace jop
         {
             (m_attributes &= ~(LightingAttribs)) |= castEnum(model);
             m_updateShader = true;
+            ++m_version;
         }
 
         return *this;
@@ -188,6 +247,9 @@ namespace jop
     Material& Material::setReflection(const Reflection reflection, const Color& color)
     {
         m_reflection[static_cast<int>(reflection)] = color;
+        m_updateBlock = true;
+        ++m_version;
+
         return *this;
     }
 
@@ -199,6 +261,8 @@ namespace jop
         m_reflection[1] = diffuse;
         m_reflection[2] = specular;
         m_reflection[3] = emission;
+        m_updateBlock = true;
+        ++m_version;
 
         return *this;
     }
@@ -215,6 +279,8 @@ namespace jop
     Material& Material::setShininess(const float value)
     {
         m_shininess = std::max(1.f, value);
+        m_updateBlock = true;
+
         return *this;
     }
 
@@ -230,6 +296,8 @@ namespace jop
     Material& Material::setReflectivity(const float reflectivity)
     {
         m_reflectivity = reflectivity;
+        m_updateBlock = true;
+
         return *this;
     }
 
@@ -246,6 +314,7 @@ namespace jop
     {
         m_maps[static_cast<int>(map)] = static_ref_cast<const Texture>(tex.getReference());
         m_attributes |= (1ull << castEnum(map));
+        ++m_version;
 
         return *this;
     }
@@ -256,6 +325,7 @@ namespace jop
     {
         m_maps[static_cast<int>(map)].reset();
         m_attributes &= ~(1 << castEnum(map));
+        ++m_version;
 
         return *this;
     }
@@ -315,6 +385,13 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    uint32 Material::getVersion() const
+    {
+        return m_version;
+    }
+
+    //////////////////////////////////////////////
+
     std::string Material::getShaderPreprocessorDef(const uint64 attributes)
     {
         std::string str;
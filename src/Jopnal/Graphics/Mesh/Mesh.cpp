@@ -39,6 +39,23 @@
 //////////////////////////////////////////////
 
 
+namespace
+{
+    bool vertexArraysSupported()
+    {
+    #if !defined(JOP_OPENGL_ES) || defined(JOP_OPENGL_ES3)
+
+        static const bool supported = jop::gl::getVersionMajor() >= 3;
+        return supported;
+
+    #else
+
+        return false;
+
+    #endif
+    }
+}
+
 namespace jop
 {
     Mesh::Mesh(const std::string& name)
@@ -49,7 +66,8 @@ namespace jop
           m_bounds              (),
           m_vertexComponents    (0),
           m_elementSize         (0),
-          m_vertexSize          (0)
+          m_vertexSize          (0),
+          m_vertexArray         (0)
     {
         m_shape.load(glm::vec3(1.f));
     }
@@ -62,13 +80,25 @@ namespace jop
           m_bounds              (other.m_bounds),
           m_vertexComponents    (other.m_vertexComponents),
           m_elementSize         (other.m_elementSize),
-          m_vertexSize          (other.m_vertexSize)
+          m_vertexSize          (other.m_vertexSize),
+          m_vertexArray         (0)
     {}
 
+    Mesh::~Mesh()
+    {
+        destroyVertexArray();
+    }
+
     //////////////////////////////////////////////
 
     bool Mesh::load(const void* vertexData, const unsigned int vertexBytes, const uint32 vertexComponents, const void* indexData, const unsigned short indexSize, const unsigned int indexAmount, const bool calculateBounds)
     {
+        contentsChanged();
+
+        // The attribute pointers of this mesh, if current, will be invalidated
+        GlState::setVertexAttributeSource(nullptr);
+        destroyVertexArray();
+
         m_vertexbuffer.destroy();
         m_indexbuffer.destroy();
 
@@ -107,24 +137,95 @@ namespace jop
 
     void Mesh::draw() const
     {
-        if (updateVertexAttributes())
+        markUsed();
+
+        const bool vertexArray = vertexArraysSupported();
+
+        if (vertexArray ? bindVertexArray() : updateVertexAttributes())
         {
             if (getElementAmount())
             {
-                getIndexBuffer().bind();
+                // The vertex array stores the index buffer binding
+                if (!vertexArray)
+                    getIndexBuffer().bind();
+
                 glCheck(glDrawElements(GL_TRIANGLES, getElementAmount(), getElementEnum(), 0));
             }
             else
             {
                 glCheck(glDrawArrays(GL_TRIANGLES, 0, getVertexAmount()));
             }
+
+            ++GlState::getFrameStatistics().drawCalls;
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    void Mesh::drawInstanced(const VertexBuffer& instances, const uint32 amount) const
+    {
+    #if !defined(JOP_OPENGL_ES) || defined(JOP_OPENGL_ES3)
+
+        JOP_ASSERT(instancingSupported(), "Tried to draw instanced when instancing is not supported!");
+
+        markUsed();
+
+        if (!amount || !updateVertexAttributes())
+            return;
+
+        instances.bind();
+
+        const auto instSize = sizeof(InstanceData);
+
+        // A matrix occupies four consecutive attribute locations, one column each
+        for (unsigned int i = 0; i < 4; ++i)
+        {
+            GlState::setVertexAttribute(true, VertexIndex::ModelMatrix + i);
+            glCheck(glVertexAttribPointer(VertexIndex::ModelMatrix + i, 4, GL_FLOAT, GL_FALSE, instSize, reinterpret_cast<void*>(sizeof(glm::vec4) * i)));
+            glCheck(glVertexAttribDivisor(VertexIndex::ModelMatrix + i, 1));
+        }
+
+        GlState::setVertexAttribute(true, VertexIndex::Color);
+        glCheck(glVertexAttribPointer(VertexIndex::Color, 4, GL_FLOAT, GL_FALSE, instSize, reinterpret_cast<void*>(sizeof(glm::mat4))));
+        glCheck(glVertexAttribDivisor(VertexIndex::Color, 1));
+
+        if (getElementAmount())
+        {
+            getIndexBuffer().bind();
+            glCheck(glDrawElementsInstanced(GL_TRIANGLES, getElementAmount(), getElementEnum(), 0, amount));
+        }
+        else
+        {
+            glCheck(glDrawArraysInstanced(GL_TRIANGLES, 0, getVertexAmount(), amount));
+        }
+
+        ++GlState::getFrameStatistics().drawCalls;
+
+        // Restore the per-vertex state so that regular draws aren't affected
+        for (unsigned int i = 0; i < 4; ++i)
+        {
+            glCheck(glVertexAttribDivisor(VertexIndex::ModelMatrix + i, 0));
+            GlState::setVertexAttribute(false, VertexIndex::ModelMatrix + i);
         }
+
+        glCheck(glVertexAttribDivisor(VertexIndex::Color, 0));
+        GlState::setVertexAttribute(false, VertexIndex::Color);
+        GlState::setVertexAttributeSource(nullptr);
+
+    #else
+
+        instances; amount;
+
+    #endif
     }
 
     //////////////////////////////////////////////
 
     void Mesh::destroy()
     {
+        GlState::setVertexAttributeSource(nullptr);
+        destroyVertexArray();
+
         m_vertexbuffer.destroy();
         m_indexbuffer.destroy();
 
@@ -135,6 +236,25 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    Resource::MemoryUsage Mesh::getMemoryUsage() const
+    {
+        MemoryUsage usage;
+        usage.cpu = 0;
+        usage.gpu = m_vertexbuffer.getAllocatedSize() + m_indexbuffer.getAllocatedSize();
+
+        return usage;
+    }
+
+    //////////////////////////////////////////////
+
+    bool Mesh::releaseMemory()
+    {
+        destroy();
+        return true;
+    }
+
+    //////////////////////////////////////////////
+
     const std::pair<glm::vec3, glm::vec3>& Mesh::getBounds() const
     {
         return m_bounds;
@@ -271,11 +391,31 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    bool Mesh::instancingSupported()
+    {
+    #if !defined(JOP_OPENGL_ES) || defined(JOP_OPENGL_ES3)
+
+        static const bool supported = gl::getVersionMajor() > 3 || (gl::getVersionMajor() == 3 && (gl::es || gl::getVersionMinor() >= 3));
+        return supported;
+
+    #else
+
+        return false;
+
+    #endif
+    }
+
+    //////////////////////////////////////////////
+
     bool Mesh::updateVertexAttributes() const
     {
         if (!getVertexAmount())
             return false;
 
+        // Drawn the same mesh last time, the pointers are still valid
+        if (!GlState::setVertexAttributeSource(this))
+            return true;
+
         m_vertexbuffer.bind();
 
         const auto vertSize = getVertexSize();
@@ -313,4 +453,89 @@ namespace jop
 
         return true;
     }
+
+    //////////////////////////////////////////////
+
+    bool Mesh::bindVertexArray() const
+    {
+    #if !defined(JOP_OPENGL_ES) || defined(JOP_OPENGL_ES3)
+
+        if (!getVertexAmount())
+            return false;
+
+        if (m_vertexArray)
+        {
+            GlState::bindVertexArray(m_vertexArray);
+            return true;
+        }
+
+        glCheck(glGenVertexArrays(1, &m_vertexArray));
+        GlState::bindVertexArray(m_vertexArray);
+
+        // The attribute state of the new vertex array is set directly, since
+        // GlState only tracks the default vertex array
+        glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_vertexbuffer.getHandle()));
+
+        const auto vertSize = getVertexSize();
+
+        // Positions (should always be present)
+        glCheck(glEnableVertexAttribArray(VertexIndex::Position));
+        glCheck(glVertexAttribPointer(VertexIndex::Position, 3, GL_FLOAT, GL_FALSE, vertSize, getVertexOffset(Position)));
+
+        // Texture coordinates
+        if (m_vertexComponents & TexCoords)
+        {
+            glCheck(glEnableVertexAttribArray(VertexIndex::TexCoords));
+            glCheck(glVertexAttribPointer(VertexIndex::TexCoords, 2, GL_FLOAT, GL_FALSE, vertSize, getVertexOffset(TexCoords)));
+        }
+
+        // Normals
+        if (m_vertexComponents & Normal)
+        {
+            glCheck(glEnableVertexAttribArray(VertexIndex::Normal));
+            glCheck(glVertexAttribPointer(VertexIndex::Normal, 3, GL_FLOAT, GL_FALSE, vertSize, getVertexOffset(Normal)));
+        }
+
+        // Colors
+        if (m_vertexComponents & Color)
+        {
+            glCheck(glEnableVertexAttribArray(VertexIndex::Color));
+            glCheck(glVertexAttribPointer(VertexIndex::Color, 4, GL_FLOAT, GL_FALSE, vertSize, getVertexOffset(Color)));
+        }
+
+        if (getElementAmount())
+        {
+            glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexbuffer.getHandle()));
+        }
+
+        return true;
+
+    #else
+
+        return updateVertexAttributes();
+
+    #endif
+    }
+
+    //////////////////////////////////////////////
+
+    void Mesh::destroyVertexArray() const
+    {
+    #if !defined(JOP_OPENGL_ES) || defined(JOP_OPENGL_ES3)
+
+        if (m_vertexArray)
+        {
+            if (!GlState::isContextThread())
+                GlState::deferDelete(GlState::ObjectType::VertexArray, m_vertexArray);
+            else
+            {
+                GlState::releaseVertexArray(m_vertexArray);
+                glCheck(glDeleteVertexArrays(1, &m_vertexArray));
+            }
+
+            m_vertexArray = 0;
+        }
+
+    #endif
+    }
 }
\ No newline at end of file
@@ -29,6 +29,9 @@
     #include <Jopnal/Core/DebugHandler.hpp>
     #include <Jopnal/Graphics/OpenGL/OpenGL.hpp>
     #include <Jopnal/Graphics/OpenGL/GlCheck.hpp>
+    #include <Jopnal/Graphics/OpenGL/GpuTimer.hpp>
+    #include <mutex>
+    #include <thread>
     #include <tuple>
     #include <vector>
 
@@ -60,7 +63,18 @@ namespace
     std::pair<bool, float> ns_line;
     jop::GlState::PolygonMode ns_polygonMode;
     std::vector<bool> ns_vertexAttribs;
+    const void* ns_vertexAttribSource;
+    unsigned int ns_defaultVertexArray;
+    unsigned int ns_vertexArray;
     bool ns_depthMask;
+    unsigned int ns_activeTexture;
+    std::vector<std::pair<unsigned int, unsigned int>> ns_textures;
+    std::vector<unsigned int> ns_uniformBuffers;
+    jop::GlState::Statistics ns_frameStats;
+    jop::GlState::Statistics ns_stats;
+    std::thread::id ns_contextThread;
+    std::mutex ns_deferredMutex;
+    std::vector<std::pair<jop::GlState::ObjectType, unsigned int>> ns_deferred;
 
     void enableDisable(const bool enable, GLenum enum_)
     {
@@ -105,10 +119,16 @@ namespace jop
 
         // All vertex attributes are disabled by default
         ns_vertexAttribs.clear();
+        ns_vertexAttribSource = nullptr;
 
         // Depth mask is enabled by default
         ns_depthMask = true;
 
+        // No textures are bound by default and the first unit is active
+        ns_activeTexture = 0;
+        ns_textures.clear();
+        ns_uniformBuffers.clear();
+
         JOP_DEBUG_INFO("OpenGL state reset");
     }
 
@@ -292,6 +312,9 @@ namespace jop
 
     void GlState::setVertexAttribute(const bool enable, const unsigned int index)
     {
+        // The cached attribute state belongs to the default vertex array
+        bindVertexArray(0);
+
         static int attribLocs = 0;
 
         if (ns_vertexAttribs.empty())
@@ -318,6 +341,154 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    bool GlState::setVertexAttributeSource(const void* source)
+    {
+        bindVertexArray(0);
+
+        const bool changed = source == nullptr || source != ns_vertexAttribSource;
+        ns_vertexAttribSource = source;
+
+        return changed;
+    }
+
+    //////////////////////////////////////////////
+
+    void GlState::bindVertexArray(const unsigned int vertexArray)
+    {
+    #if !defined(JOP_OPENGL_ES) || defined(JOP_OPENGL_ES3)
+
+        const unsigned int array = vertexArray ? vertexArray : ns_defaultVertexArray;
+
+        if (ns_vertexArray != array)
+        {
+            glCheck(glBindVertexArray(array));
+            ns_vertexArray = array;
+        }
+
+    #else
+
+        vertexArray;
+
+    #endif
+    }
+
+    //////////////////////////////////////////////
+
+    void GlState::setDefaultVertexArray(const unsigned int vertexArray)
+    {
+    #if !defined(JOP_OPENGL_ES) || defined(JOP_OPENGL_ES3)
+
+        glCheck(glBindVertexArray(vertexArray));
+
+    #endif
+
+        ns_defaultVertexArray = vertexArray;
+        ns_vertexArray = vertexArray;
+    }
+
+    //////////////////////////////////////////////
+
+    void GlState::releaseVertexArray(const unsigned int vertexArray)
+    {
+        // Never leave a deleted vertex array bound
+        if (ns_vertexArray == vertexArray)
+            bindVertexArray(0);
+    }
+
+    //////////////////////////////////////////////
+
+    void GlState::bindTexture(const unsigned int unit, const unsigned int target, const unsigned int texture)
+    {
+        if (ns_activeTexture != unit)
+        {
+            glCheck(glActiveTexture(GL_TEXTURE0 + unit));
+            ns_activeTexture = unit;
+        }
+
+        if (unit >= ns_textures.size())
+            ns_textures.resize(unit + 1, std::make_pair(0u, 0u));
+
+        // A unit may have textures bound to multiple targets. Only the last
+        // binding is remembered, which may cause a redundant bind but never
+        // a missing one
+        auto& bound = ns_textures[unit];
+
+        if (bound.first != target || bound.second != texture || !texture)
+        {
+            glCheck(glBindTexture(target, texture));
+            bound = std::make_pair(target, texture);
+
+            if (texture)
+                ++ns_frameStats.textureBinds;
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    void GlState::releaseTexture(const unsigned int texture)
+    {
+        // Deleting a texture resets its bindings to zero
+        for (auto& i : ns_textures)
+        {
+            if (i.second == texture)
+                i = std::make_pair(0u, 0u);
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    void GlState::bindUniformBuffer(const unsigned int index, const unsigned int buffer)
+    {
+    #if !defined(JOP_OPENGL_ES) || defined(JOP_OPENGL_ES3)
+
+        if (index >= ns_uniformBuffers.size())
+            ns_uniformBuffers.resize(index + 1, 0u);
+
+        if (ns_uniformBuffers[index] != buffer || !buffer)
+        {
+            glCheck(glBindBufferBase(GL_UNIFORM_BUFFER, index, buffer));
+            ns_uniformBuffers[index] = buffer;
+        }
+
+    #else
+
+        index; buffer;
+
+    #endif
+    }
+
+    //////////////////////////////////////////////
+
+    void GlState::releaseUniformBuffer(const unsigned int buffer)
+    {
+        for (auto& i : ns_uniformBuffers)
+        {
+            if (i == buffer)
+                i = 0u;
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    bool GlState::isContextThread()
+    {
+        return ns_contextThread == std::thread::id() || ns_contextThread == std::this_thread::get_id();
+    }
+
+    //////////////////////////////////////////////
+
+    void GlState::deferDelete(const ObjectType type, const unsigned int handle)
+    {
+        if (!handle)
+            return;
+
+        std::lock_guard<std::mutex> lock(ns_deferredMutex);
+
+        ns_deferred.emplace_back(type, handle);
+    }
+
+    //////////////////////////////////////////////
+
     void GlState::setDepthWrite(const bool enable)
     {
         if (ns_depthMask != enable)
@@ -334,4 +505,106 @@ namespace jop
     {
         glCheck(glFlush());
     }
+
+    //////////////////////////////////////////////
+
+    const GlState::Statistics& GlState::getStatistics()
+    {
+        return ns_stats;
+    }
+
+    //////////////////////////////////////////////
+
+    GlState::Statistics& GlState::getFrameStatistics()
+    {
+        return ns_frameStats;
+    }
+
+    //////////////////////////////////////////////
+
+    void GlState::endFrame()
+    {
+    #ifdef JOP_ENABLE_PROFILING
+        detail::GpuTimer::endFrame();
+    #endif
+
+        deleteDeferred();
+
+        ns_stats = ns_frameStats;
+        ns_frameStats = Statistics();
+    }
+
+    //////////////////////////////////////////////
+
+    void GlState::setContextThread()
+    {
+        ns_contextThread = std::this_thread::get_id();
+    }
+
+    //////////////////////////////////////////////
+
+    void GlState::deleteDeferred()
+    {
+        JOP_ASSERT(isContextThread(), "Deferred OpenGL objects must be deleted on the context thread!");
+
+        static std::vector<std::pair<ObjectType, unsigned int>> objects;
+
+        {
+            std::lock_guard<std::mutex> lock(ns_deferredMutex);
+            objects.swap(ns_deferred);
+        }
+
+        // The cached bindings are released here, they may only be touched on this thread
+        for (auto& i : objects)
+        {
+            const GLuint handle = i.second;
+
+            switch (i.first)
+            {
+                case ObjectType::Buffer:
+                    releaseUniformBuffer(handle);
+                    glCheck(glDeleteBuffers(1, &handle));
+                    break;
+
+                case ObjectType::Texture:
+                    releaseTexture(handle);
+                    glCheck(glDeleteTextures(1, &handle));
+                    break;
+
+            #if !defined(JOP_OPENGL_ES) || defined(GL_ES_VERSION_3_0)
+                case ObjectType::Sampler:
+                    glCheck(glDeleteSamplers(1, &handle));
+                    break;
+            #endif
+
+            #if !defined(JOP_OPENGL_ES) || defined(JOP_OPENGL_ES3)
+                case ObjectType::VertexArray:
+                    releaseVertexArray(handle);
+                    glCheck(glDeleteVertexArrays(1, &handle));
+                    break;
+            #endif
+
+                case ObjectType::Program:
+                    glCheck(glDeleteProgram(handle));
+                    break;
+
+                case ObjectType::Shader:
+                    glCheck(glDeleteShader(handle));
+                    break;
+
+                case ObjectType::Framebuffer:
+                    glCheck(glDeleteFramebuffers(1, &handle));
+                    break;
+
+                case ObjectType::Renderbuffer:
+                    glCheck(glDeleteRenderbuffers(1, &handle));
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        objects.clear();
+    }
 }
\ No newline at end of file
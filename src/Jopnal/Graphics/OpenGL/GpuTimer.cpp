@@ -0,0 +1,221 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+// Headers
+#include JOP_PRECOMPILED_HEADER_FILE
+
+#ifndef JOP_PRECOMPILED_HEADER
+
+    #include <Jopnal/Graphics/OpenGL/GpuTimer.hpp>
+
+    #include <Jopnal/Core/DebugHandler.hpp>
+    #include <Jopnal/Graphics/OpenGL/OpenGL.hpp>
+    #include <Jopnal/Graphics/OpenGL/GlCheck.hpp>
+    #include <array>
+    #include <vector>
+
+#endif
+
+//////////////////////////////////////////////
+
+
+namespace
+{
+#ifndef JOP_OPENGL_ES
+
+    struct Timing
+    {
+        const char* name;
+        GLuint queries[2];
+    };
+
+    struct Frame
+    {
+        std::vector<Timing> timings;
+        jop::uint32 used;
+        jop::int64 offset;
+    };
+
+    // Results are read back after this many frames
+    const jop::uint32 ns_frameLatency = 3;
+
+    std::array<Frame, ns_frameLatency> ns_frames;
+    jop::uint32 ns_current = 0;
+    bool ns_warned = false;
+
+#endif
+}
+
+namespace jop { namespace detail
+{
+    GpuTimer::Scope::Scope(const char* name)
+        : m_index(GpuTimer::begin(name))
+    {}
+
+    GpuTimer::Scope::~Scope()
+    {
+        GpuTimer::end(m_index);
+    }
+
+    //////////////////////////////////////////////
+
+    bool GpuTimer::isSupported()
+    {
+    #ifdef JOP_OPENGL_ES
+
+        // The ES headers don't provide the EXT_disjoint_timer_query entry points
+        return false;
+
+    #else
+
+        static const bool supported = gl::getVersionMajor() > 3 || (gl::getVersionMajor() == 3 && gl::getVersionMinor() >= 3);
+
+        return supported;
+
+    #endif
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 GpuTimer::begin(const char* name)
+    {
+    #ifndef JOP_OPENGL_ES
+
+        if (!isSupported())
+            return ~0u;
+
+        auto& frame = ns_frames[ns_current];
+
+        if (frame.used == 0)
+        {
+            // Map the GPU clock to the profiler's time base
+            GLint64 gpuTime = 0;
+            glCheck(glGetInteger64v(GL_TIMESTAMP, &gpuTime));
+
+            frame.offset = static_cast<int64>(Profiler::now()) - gpuTime;
+        }
+
+        if (frame.used == frame.timings.size())
+        {
+            frame.timings.emplace_back();
+            glCheck(glGenQueries(2, frame.timings.back().queries));
+        }
+
+        auto& timing = frame.timings[frame.used];
+        timing.name = name;
+
+        glCheck(glQueryCounter(timing.queries[0], GL_TIMESTAMP));
+
+        return frame.used++;
+
+    #else
+
+        static_cast<void>(name);
+        return ~0u;
+
+    #endif
+    }
+
+    //////////////////////////////////////////////
+
+    void GpuTimer::end(const uint32 index)
+    {
+    #ifndef JOP_OPENGL_ES
+
+        if (index != ~0u)
+            glCheck(glQueryCounter(ns_frames[ns_current].timings[index].queries[1], GL_TIMESTAMP));
+
+    #else
+
+        static_cast<void>(index);
+
+    #endif
+    }
+
+    //////////////////////////////////////////////
+
+    void GpuTimer::endFrame()
+    {
+    #ifndef JOP_OPENGL_ES
+
+        if (!isSupported())
+            return;
+
+        ns_current = (ns_current + 1) % ns_frameLatency;
+
+        // This is the oldest frame, its queries are about to be reused
+        auto& frame = ns_frames[ns_current];
+
+        if (frame.used == 0)
+            return;
+
+        bool available = true;
+
+        for (uint32 i = 0; i < frame.used && available; ++i)
+        {
+            GLuint result = GL_FALSE;
+            glCheck(glGetQueryObjectuiv(frame.timings[i].queries[1], GL_QUERY_RESULT_AVAILABLE, &result));
+
+            available = result != GL_FALSE;
+        }
+
+        if (available)
+        {
+            for (uint32 i = 0; i < frame.used; ++i)
+            {
+                auto& timing = frame.timings[i];
+
+                GLuint64 start = 0, end = 0;
+                glCheck(glGetQueryObjectui64v(timing.queries[0], GL_QUERY_RESULT, &start));
+                glCheck(glGetQueryObjectui64v(timing.queries[1], GL_QUERY_RESULT, &end));
+
+                Profiler::recordGpu(timing.name, static_cast<uint64>(static_cast<int64>(start) + frame.offset), static_cast<uint64>(static_cast<int64>(end) + frame.offset));
+            }
+        }
+        else if (!ns_warned)
+        {
+            JOP_DEBUG_WARNING("GPU timings weren't available after " << ns_frameLatency << " frames, skipping. This warning is only shown once");
+            ns_warned = true;
+        }
+
+        frame.used = 0;
+
+    #endif
+    }
+
+    //////////////////////////////////////////////
+
+    void GpuTimer::destroy()
+    {
+    #ifndef JOP_OPENGL_ES
+
+        for (auto& frame : ns_frames)
+        {
+            for (auto& timing : frame.timings)
+                glCheck(glDeleteQueries(2, timing.queries));
+
+            frame.timings.clear();
+            frame.used = 0;
+        }
+
+    #endif
+    }
+}}
\ No newline at end of file
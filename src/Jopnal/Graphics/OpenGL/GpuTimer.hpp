@@ -0,0 +1,115 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+#ifndef JOP_GPUTIMER_HPP
+#define JOP_GPUTIMER_HPP
+
+// Headers
+#include <Jopnal/Header.hpp>
+#include <Jopnal/Core/Profiler.hpp>
+
+//////////////////////////////////////////////
+
+
+#ifdef JOP_ENABLE_PROFILING
+
+    #define JOP_PROFILE_GPU(name) ::jop::detail::GpuTimer::Scope __JOP_PROFILE_CAT(__jop_profile_gpu_, __LINE__)(name)
+
+#else
+
+    #define JOP_PROFILE_GPU(name) {}
+
+#endif
+
+namespace jop { namespace detail
+{
+    class GpuTimer
+    {
+    private:
+
+        JOP_DISALLOW_COPY_MOVE(GpuTimer);
+
+    public:
+
+        /// Scope timer, use the JOP_PROFILE_GPU macro instead of this directly
+        ///
+        class Scope
+        {
+        private:
+
+            JOP_DISALLOW_COPY_MOVE(Scope);
+
+        public:
+
+            explicit Scope(const char* name);
+
+            ~Scope();
+
+        private:
+
+            uint32 m_index; ///< Index of the timing in the current frame
+        };
+
+    public:
+
+        /// \brief Check if GPU timing is supported
+        ///
+        /// Requires GL_TIMESTAMP queries, which are core in OpenGL 3.3.
+        ///
+        static bool isSupported();
+
+        /// \brief Start a timing
+        ///
+        /// \param name Name of the timing. Must outlive the profiler
+        ///
+        /// \return Index to be passed to end()
+        ///
+        static uint32 begin(const char* name);
+
+        /// \brief End a timing
+        ///
+        /// \param index Index returned by begin()
+        ///
+        static void end(const uint32 index);
+
+        /// \brief Finish the current frame
+        ///
+        /// The results of the oldest buffered frame are passed on
+        /// to the profiler, if they are available.
+        ///
+        static void endFrame();
+
+        /// \brief Delete the query objects
+        ///
+        /// Must be called while the context is still current.
+        ///
+        static void destroy();
+    };
+}}
+
+/// \class jop::detail::GpuTimer
+/// \ingroup graphics
+///
+/// Timestamp queries are used instead of GL_TIME_ELAPSED, since only one
+/// elapsed time query can be active at a time and the scopes are nested.
+/// The queries are triple buffered so that reading the results never stalls.
+
+#endif
\ No newline at end of file
@@ -26,13 +26,21 @@
 
     #include <Jopnal/Graphics/PostProcessor.hpp>
 
+    #include <Jopnal/Core/DebugHandler.hpp>
+    #include <Jopnal/Core/Profiler.hpp>
     #include <Jopnal/Graphics/Mesh/RectangleMesh.hpp>
     #include <Jopnal/Graphics/Shader.hpp>
     #include <Jopnal/Graphics/ShaderProgram.hpp>
     #include <Jopnal/Core/ResourceManager.hpp>
     #include <Jopnal/Graphics/OpenGL/OpenGL.hpp>
     #include <Jopnal/Graphics/OpenGL/GlCheck.hpp>
+    #include <Jopnal/Graphics/OpenGL/GlState.hpp>
+    #include <Jopnal/Graphics/OpenGL/GpuTimer.hpp>
+    #include <Jopnal/Utility/CommandHandler.hpp>
     #include <Jopnal/STL.hpp>
+    #include <iomanip>
+    #include <sstream>
+    #include <unordered_set>
 
 #endif
 
@@ -86,11 +94,133 @@ namespace
     #endif
     }
 
+    const char* internName(const std::string& name)
+    {
+        // Set elements never move, so the names stay valid for the profiler
+        static std::unordered_set<std::string> names;
+
+        return names.insert(name).first->c_str();
+    }
+
     const float ns_defBloomThreshold = 2.f - jop::gl::es;
+
+    const unsigned int ns_maxBloomLevels = 6;
+    const unsigned int ns_minBloomSize = 8;
+
+    const jop::ShaderProgram::UniformTable ns_compositeUniforms =
+    {
+        "u_Scene",
+        "u_Exposure",
+        "u_Bloom",
+        "u_DitherMatrix",
+        "u_Gamma"
+    };
+
+    const jop::ShaderProgram::UniformTable ns_brightUniforms =
+    {
+        "u_Texture",
+        "u_Threshold",
+        "u_SubExponent"
+    };
+
+    const jop::ShaderProgram::UniformTable ns_blurUniforms =
+    {
+        "u_Buffer",
+        "u_Horizontal"
+    };
 }
 
 namespace jop
 {
+    JOP_REGISTER_COMMAND_HANDLER(PostProcessor)
+
+        JOP_COMMAND_RECEIVERS(Message::Subsystem);
+
+        JOP_BIND_MEMBER_COMMAND(&PostProcessor::printStatistics, "printPostProcess");
+
+    JOP_END_COMMAND_HANDLER(PostProcessor)
+}
+
+namespace jop
+{
+    PostProcessPass::PostProcessPass(PostProcessor& processor, const uint32 weight, const std::string& name)
+        : m_processorRef(processor),
+          m_name        (name),
+          m_profileName (internName(name)),
+          m_weight      (weight),
+          m_time        (0.0),
+          m_active      (true)
+    {}
+
+    PostProcessPass::~PostProcessPass()
+    {}
+
+    //////////////////////////////////////////////
+
+    void PostProcessPass::setActive(const bool active)
+    {
+        m_active = active;
+    }
+
+    //////////////////////////////////////////////
+
+    bool PostProcessPass::isActive() const
+    {
+        return m_active;
+    }
+
+    //////////////////////////////////////////////
+
+    const std::string& PostProcessPass::getName() const
+    {
+        return m_name;
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 PostProcessPass::getWeight() const
+    {
+        return m_weight;
+    }
+
+    //////////////////////////////////////////////
+    //////////////////////////////////////////////
+
+    PostProcessShaderPass::PostProcessShaderPass(PostProcessor& processor, const uint32 weight, const std::string& name, ShaderProgram& shader, const float scale)
+        : PostProcessPass   (processor, weight, name),
+          m_shader          (static_ref_cast<ShaderProgram>(shader.getReference())),
+          m_scale           (scale)
+    {}
+
+    //////////////////////////////////////////////
+
+    const RenderTexture* PostProcessShaderPass::process(const RenderTexture& input)
+    {
+        if (m_shader.expired())
+            return nullptr;
+
+        const glm::uvec2 size(glm::max(glm::vec2(input.getSize()) * m_scale, glm::vec2(1.f)));
+
+        auto& output = m_processorRef.acquireTarget(size, m_processorRef.getBufferFormat());
+        output.bind();
+
+        auto& shader = *m_shader;
+        shader.setUniform(shader.getUniformHandle("u_Texture"), *input.getTextureAttachment(RenderTexture::Slot::Color0), 1);
+        setUniforms(shader);
+
+        m_processorRef.drawQuad();
+
+        return &output;
+    }
+
+    //////////////////////////////////////////////
+
+    void PostProcessShaderPass::setUniforms(ShaderProgram&)
+    {}
+
+    //////////////////////////////////////////////
+    //////////////////////////////////////////////
+
     PostProcessor::PostProcessor(const RenderTarget& mainTarget)
         : Subsystem             (0),
           m_shaderSources       (),
@@ -103,7 +233,8 @@ namespace jop
           m_bloomThreshold      ("engine@Graphics|Postprocessor|Bloom|fThreshold", ns_defBloomThreshold),
           m_subBloomThresholdExp("engine@Graphics|Postprocessor|Bloom|fSubThresholdExponent", 4.f),
           m_ditherMatrix        (""),
-          m_bloomTextures       ()
+          m_targetPool          (),
+          m_passes              ()
     {
         JOP_ASSERT(m_instance == nullptr, "There must only be one jop::PostProcessor instance!");
         m_instance = this;
@@ -151,9 +282,6 @@ namespace jop
         // Bloom
         {
             static const FunctionEnabler enabler("engine@Graphics|Postprocessor|Bloom|bEnabled", Function::Bloom, false);
-
-            if (m_functions & Function::Bloom)
-                enableBloom();
         }
 
         // Gamma correction settings
@@ -206,58 +334,203 @@ namespace jop
     }
 
     PostProcessor::~PostProcessor()
-    {}
+    {
+        m_passes.clear();
+        m_instance = nullptr;
+    }
 
     //////////////////////////////////////////////
 
-    void PostProcessor::draw()
+    void PostProcessor::removePass(const uint32 weight)
     {
-        if (m_shaders.find(m_functions) == m_shaders.end())
-        {
-            std::string pp;
-            getPreprocessorStr(m_functions, pp);
+        m_passes.erase(weight);
+    }
 
-            auto& shader = ResourceManager::getNamed<ShaderProgram>("jop_pp_shader_" + std::to_string(m_functions), pp, Shader::Type::Vertex, m_shaderSources[0], Shader::Type::Fragment, m_shaderSources[1]);
+    //////////////////////////////////////////////
 
-            JOP_ASSERT(&shader != &ShaderProgram::getError(), "Failed to compile post process shader!");
+    RenderTexture& PostProcessor::acquireTarget(const glm::uvec2& size, const Texture::Format format)
+    {
+        return m_targetPool.acquire(size, format);
+    }
 
-            shader.setPersistence(1);
-            m_shaders[m_functions] = static_ref_cast<ShaderProgram>(shader.getReference());
+    //////////////////////////////////////////////
+
+    void PostProcessor::releaseTarget(const RenderTexture& target)
+    {
+        m_targetPool.release(target);
+    }
+
+    //////////////////////////////////////////////
+
+    Texture::Format PostProcessor::getBufferFormat() const
+    {
+        auto tex = static_cast<const RenderTexture&>(m_mainTarget).getTextureAttachment(RenderTexture::Slot::Color0);
+
+        // The main target is either RGBA_F_16 or RGBA_UB_8, see MainRenderTarget
+        return tex && tex->getPixelDepth() > 4 ? Texture::Format::RGBA_F_16 : Texture::Format::RGBA_UB_8;
+    }
+
+    //////////////////////////////////////////////
+
+    const std::string& PostProcessor::getVertexSource() const
+    {
+        return m_shaderSources[0];
+    }
+
+    //////////////////////////////////////////////
+
+    void PostProcessor::drawQuad() const
+    {
+        m_quad.draw();
+    }
+
+    //////////////////////////////////////////////
+
+    PostProcessor::Statistics PostProcessor::getStatistics() const
+    {
+        Statistics stats;
+        stats.passes.reserve(m_passes.size());
+
+        for (auto& i : m_passes)
+        {
+            PassStatistics pass;
+            pass.name = i.second->getName();
+            pass.weight = i.first;
+            pass.time = i.second->m_time;
+
+            stats.passes.emplace_back(std::move(pass));
         }
 
-        auto& shdr = *m_shaders[m_functions];
+        stats.targets = m_targetPool.getTargetCount();
+        stats.memory = m_targetPool.getMemoryUsage();
+        stats.creations = m_targetPool.getCreationCount();
+
+        return stats;
+    }
+
+    //////////////////////////////////////////////
+
+    void PostProcessor::printStatistics() const
+    {
+        const auto stats = getStatistics();
+
+        std::ostringstream stream;
+        stream << std::fixed << std::setprecision(3) << "Post processor statistics:"
+               << "\n    Render targets: " << stats.targets << " (" << (stats.memory / 1024) << " KB), " << stats.creations << " created in total";
 
-        if (m_functions > 0)
+        for (auto& i : stats.passes)
+            stream << "\n    " << std::left << std::setw(40) << i.name << " weight " << i.weight << "  last " << i.time << " ms";
+
+        DebugHandler::getInstance() << DebugHandler::Severity::__Always << stream.str() << std::endl;
+    }
+
+    //////////////////////////////////////////////
+
+    void PostProcessor::draw()
+    {
+        const auto& scene = static_cast<const RenderTexture&>(m_mainTarget);
+        const RenderTexture* input = &scene;
+
+        for (auto& i : m_passes)
         {
-            if ((m_functions & Function::ToneMap) != 0)
-                shdr.setUniform("u_Exposure", m_exposure);
+            auto& pass = *i.second;
 
-            if ((m_functions & Function::Bloom) != 0)
+            if (!pass.isActive())
             {
-                if (m_bloomTextures.empty())
-                    enableBloom();
+                pass.m_time = 0.0;
+                continue;
+            }
 
-                makeBloom();
+            const uint64 start = Profiler::now();
+            {
+                JOP_PROFILE(pass.m_profileName);
+                JOP_PROFILE_GPU(pass.m_profileName);
 
-            #ifdef JOP_ENABLE_BLOOM
+                auto output = pass.process(*input);
 
-                for (unsigned int i = 0; i < m_bloomTextures.size(); ++i)
-                    shdr.setUniform("u_Bloom[" + std::to_string(i) + "]", *m_bloomTextures[i][1].getTextureAttachment(RenderTexture::Slot::Color0), 3 + i);
+                if (output && output != input)
+                {
+                    if (input != &scene)
+                        releaseTarget(*input);
 
-            #endif
+                    input = output;
+                }
             }
+            pass.m_time = (Profiler::now() - start) / 1000000.0;
+        }
 
-            if ((m_functions & Function::Dither) != 0)
-                shdr.setUniform("u_DitherMatrix", m_ditherMatrix, 2);
+        const RenderTexture* bloom = nullptr;
 
-            if ((m_functions & Function::GammaCorrection) != 0)
-                shdr.setUniform("u_Gamma", m_gamma);
+        if ((m_functions & Function::Bloom) != 0)
+        {
+            JOP_PROFILE_GPU("GPU PostProcessor::bloom");
+            bloom = makeBloom(*input);
         }
 
+        auto& shdr = getShader(bloom ? m_functions : m_functions & ~Function::Bloom);
+        const int* handles = shdr.getUniformHandles(ns_compositeUniforms);
+
+        if ((m_functions & Function::ToneMap) != 0)
+            shdr.setUniform(handles[1], m_exposure);
+
+        if (bloom)
+            shdr.setUniform(handles[2], *bloom->getTextureAttachment(RenderTexture::Slot::Color0), 3);
+
+        if ((m_functions & Function::Dither) != 0)
+            shdr.setUniform(handles[3], m_ditherMatrix, 2);
+
+        if ((m_functions & Function::GammaCorrection) != 0)
+            shdr.setUniform(handles[4], m_gamma);
+
         RenderTexture::unbind();
-        
-        shdr.setUniform("u_Scene", *static_cast<const RenderTexture&>(m_mainTarget).getTextureAttachment(RenderTexture::Slot::Color0), 1);
-        m_quad.draw();
+
+        {
+            JOP_PROFILE_GPU("GPU PostProcessor::composite");
+
+            shdr.setUniform(handles[0], *input->getTextureAttachment(RenderTexture::Slot::Color0), 1);
+            m_quad.draw();
+        }
+
+        if (bloom)
+            releaseTarget(*bloom);
+
+        if (input != &scene)
+            releaseTarget(*input);
+
+        static const DynamicSetting<unsigned int> idleFrames("engine@Graphics|Postprocessor|uTargetIdleFrames", 60);
+        m_targetPool.endFrame(idleFrames.value);
+    }
+
+    //////////////////////////////////////////////
+
+    Message::Result PostProcessor::receiveMessage(const Message& message)
+    {
+        if (JOP_EXECUTE_COMMAND(PostProcessor, message, this) == Message::Result::Escape)
+            return Message::Result::Escape;
+
+        return Subsystem::receiveMessage(message);
+    }
+
+    //////////////////////////////////////////////
+
+    ShaderProgram& PostProcessor::getShader(const uint32 funcs)
+    {
+        auto& ref = m_shaders[funcs];
+
+        if (ref.expired())
+        {
+            std::string pp;
+            getPreprocessorStr(funcs, pp);
+
+            auto& shader = ResourceManager::getNamed<ShaderProgram>("jop_pp_shader_" + std::to_string(funcs), pp, Shader::Type::Vertex, m_shaderSources[0], Shader::Type::Fragment, m_shaderSources[1]);
+
+            JOP_ASSERT(&shader != &ShaderProgram::getError(), "Failed to compile post process shader!");
+
+            shader.setPersistence(1);
+            ref = static_ref_cast<ShaderProgram>(shader.getReference());
+        }
+
+        return *ref;
     }
 
     //////////////////////////////////////////////
@@ -268,11 +541,7 @@ namespace jop
             str += "#define JPP_TONEMAP\n";
 
         if ((funcs & Function::Bloom) != 0)
-        {
-            str += "#define JPP_BLOOM\n#define JPP_BLOOM_TEXTURES ";
-            str += std::to_string(m_bloomTextures.size());
-            str += "\n";
-        }
+            str += "#define JPP_BLOOM\n";
 
         if ((funcs & Function::Dither) != 0)
             str += "#define JPP_DITHER\n";
@@ -283,103 +552,127 @@ namespace jop
 
     //////////////////////////////////////////////
 
-    void PostProcessor::makeBloom()
+    const RenderTexture* PostProcessor::makeBloom(const RenderTexture& input)
     {
     #ifdef JOP_ENABLE_BLOOM
 
-    #ifdef JOP_OPENGL_ES
-        if (jop::gl::getVersionMajor() < 3)
-            return;
-    #endif
+        if (m_brightShader.expired() || m_blurShader.expired())
+            return nullptr;
 
         const auto slot = RenderTexture::Slot::Color0;
 
-        // Brightness pass
-        m_bloomTextures[0][0].bind();
-        m_bloomTextures[0][0].clear(RenderTarget::ColorBit);
+        static const bool hdr = SettingManager::get<bool>("engine@Graphics|Postprocessor|Bloom|bHDR", !gl::es
 
-        m_brightShader->setUniform("u_Texture", *static_cast<const RenderTexture&>(m_mainTarget).getTextureAttachment(slot), 1);
-        m_brightShader->setUniform("u_Threshold", m_bloomThreshold);
-        m_brightShader->setUniform("u_SubExponent", m_subBloomThresholdExp);
-        m_quad.draw();
+        #ifdef JOP_OPENGL_ES                 
+            || JOP_CHECK_GL_EXTENSION(GL_EXT_color_buffer_half_float)
+        #endif
+        );
+        const auto format = hdr ? Texture::Format::RGB_F_16 : Texture::Format::RGB_UB_8;
 
-        // Blur
-        for (auto itr = m_bloomTextures.begin(); itr != m_bloomTextures.end(); ++itr)
-        {
-            m_blurShader->setUniform("u_Buffer", *(*itr)[0].getTextureAttachment(slot), 1);
-            bool horizontal = true;
+        static const DynamicSetting<unsigned int> levelSetting("engine@Graphics|Postprocessor|Bloom|uLevels", 4);
+        static const DynamicSetting<unsigned int> kernelSize("engine@Graphics|Postprocessor|Bloom|uKernelSize", 3);
 
-            static const DynamicSetting<unsigned int> kernelSize("engine@Graphics|Postprocessor|Bloom|uKernelSize", 5);
+        const unsigned int maxLevels = glm::clamp(levelSetting.value, 1u, ns_maxBloomLevels);
 
-            for (unsigned int j = 0; j < kernelSize.value * 2; ++j)
-            {
-                (*itr)[horizontal].bind();
-                m_blurShader->setUniform("u_Horizontal", horizontal);
-                m_blurShader->setUniform("u_Buffer", *(*itr)[!horizontal].getTextureAttachment(slot), 1);
+        std::array<RenderTexture*, ns_maxBloomLevels> levels;
+        unsigned int numLevels = 1;
 
-                m_quad.draw();
-                horizontal = !horizontal;
-            }
+        GlState::setBlendFunc(false);
 
-            if (itr != (m_bloomTextures.end() - 1))
-            {
-                auto& src = (*itr)[1];
-                auto& dst = (*++itr)[0];
+        // Brightness pass, at half resolution
+        glm::uvec2 size(glm::max(input.getSize() / 2u, glm::uvec2(1)));
 
-                dst.bind();
-                src.bindRead();
+        levels[0] = &acquireTarget(size, format);
+        levels[0]->bind();
+        {
+            auto& shader = *m_brightShader;
+            const int* handles = shader.getUniformHandles(ns_brightUniforms);
 
-                glCheck(glBlitFramebuffer(0, 0, src.getSize().x, src.getSize().y,
-                                          0, 0, dst.getSize().x, dst.getSize().y,
-                                          GL_COLOR_BUFFER_BIT, GL_LINEAR));
-            }
+            shader.setUniform(handles[0], *input.getTextureAttachment(slot), 1);
+            shader.setUniform(handles[1], m_bloomThreshold.value);
+            shader.setUniform(handles[2], m_subBloomThresholdExp.value);
+            m_quad.draw();
         }
 
-    #endif
-    }
+        // Blur and downsample, each level at half the resolution of the previous one
+        for (;;)
+        {
+            auto& src = *levels[numLevels - 1];
+            blur(src, format, kernelSize.value);
 
-    //////////////////////////////////////////////
+            size /= 2u;
 
-    void PostProcessor::enableBloom()
-    {
-    #ifdef JOP_ENABLE_BLOOM
+            if (numLevels >= maxLevels || glm::min(size.x, size.y) < ns_minBloomSize)
+                break;
 
-    #ifdef JOP_OPENGL_ES
+            auto& dst = acquireTarget(size, format);
 
-        if (gl::getVersionMajor() < 3)
-            return;
+            dst.bind();
+            src.bindRead();
 
-    #endif
+            glCheck(glBlitFramebuffer(0, 0, src.getSize().x, src.getSize().y,
+                                      0, 0, dst.getSize().x, dst.getSize().y,
+                                      GL_COLOR_BUFFER_BIT, GL_LINEAR));
 
-        using CAS = RenderTexture::Slot;
-        using CA = Texture::Format;
-        using TSR = TextureSampler::Repeat;
-        using TSF = TextureSampler::Filter;
+            levels[numLevels++] = &dst;
+        }
 
-        for (unsigned int i = 0; i < m_bloomTextures.size(); ++i)
+        // Accumulate the levels into the first one, starting from the smallest
+        if (numLevels > 1)
         {
-            for (auto& j : m_bloomTextures[i])
-            {
-                glm::uvec2 size(glm::uvec2((16 << m_bloomTextures.size()) >> i));
-                size.y = static_cast<glm::uvec2::value_type>(size.y * (m_mainTarget.getSize().y / static_cast<float>(m_mainTarget.getSize().x)));
+            auto& copyShader = getShader(0);
+            const int sceneHandle = copyShader.getUniformHandles(ns_compositeUniforms)[0];
 
-                static const bool hdr = SettingManager::get<bool>("engine@Graphics|Postprocessor|Bloom|bHDR", !gl::es
+            GlState::setBlendFunc(true, GlState::BlendFunc::One, GlState::BlendFunc::One);
 
-                #ifdef JOP_OPENGL_ES                 
-                    || JOP_CHECK_GL_EXTENSION(GL_EXT_color_buffer_half_float)
-                #endif
-                );
+            for (unsigned int i = numLevels - 1; i > 0; --i)
+            {
+                levels[i - 1]->bind();
+                copyShader.setUniform(sceneHandle, *levels[i]->getTextureAttachment(slot), 1);
+                m_quad.draw();
 
-                j.setSize(size);
-                j.addTextureAttachment(CAS::Color0, hdr ? CA::RGB_F_16 : CA::RGB_UB_8);
-                j.getTextureAttachment(CAS::Color0)->setRepeatMode(TSR::ClampEdge).setFilterMode(TSF::Bilinear);
+                releaseTarget(*levels[i]);
             }
+
+            GlState::setBlendFunc(false);
         }
 
+        return levels[0];
+
+    #else
+
+        return nullptr;
+
     #endif
     }
 
     //////////////////////////////////////////////
 
+    void PostProcessor::blur(RenderTexture& target, const Texture::Format format, const unsigned int iterations)
+    {
+        const auto slot = RenderTexture::Slot::Color0;
+
+        auto& temp = acquireTarget(target.getSize(), format);
+        auto& shader = *m_blurShader;
+        const int* handles = shader.getUniformHandles(ns_blurUniforms);
+
+        for (unsigned int i = 0; i < iterations; ++i)
+        {
+            temp.bind();
+            shader.setUniform(handles[0], *target.getTextureAttachment(slot), 1);
+            shader.setUniform(handles[1], true);
+            m_quad.draw();
+
+            target.bind();
+            shader.setUniform(handles[0], *temp.getTextureAttachment(slot), 1);
+            shader.setUniform(handles[1], false);
+            m_quad.draw();
+        }
+
+        releaseTarget(temp);
+    }
+
+    //////////////////////////////////////////////
+
     PostProcessor* PostProcessor::m_instance = nullptr;
 }
\ No newline at end of file
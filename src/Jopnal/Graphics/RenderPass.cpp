@@ -28,21 +28,99 @@
 
     #include <Jopnal/Core/Engine.hpp>
     #include <Jopnal/Core/Object.hpp>
+    #include <Jopnal/Core/Profiler.hpp>
     #include <Jopnal/Core/Scene.hpp>
+    #include <Jopnal/Core/SettingManager.hpp>
     #include <Jopnal/Graphics/Camera.hpp>
     #include <Jopnal/Graphics/Drawable.hpp>
+    #include <Jopnal/Graphics/LightClusters.hpp>
     #include <Jopnal/Graphics/LightSource.hpp>
     #include <Jopnal/Graphics/Material.hpp>
     #include <Jopnal/Graphics/Renderer.hpp>
     #include <Jopnal/Graphics/RenderTarget.hpp>
+    #include <Jopnal/Graphics/ShaderAssembler.hpp>
+    #include <Jopnal/Graphics/ShaderProgram.hpp>
+    #include <Jopnal/Graphics/Sprite.hpp>
+    #include <Jopnal/Graphics/SpriteBatch.hpp>
     #include <Jopnal/Graphics/OpenGL/GlState.hpp>
     #include <glm/gtx/norm.hpp>
+    #include <algorithm>
+    #include <cstdint>
+    #include <typeinfo>
+    #include <unordered_set>
 
 #endif
 
 //////////////////////////////////////////////
 
 
+namespace
+{
+    // Sort key layout, from the most significant bits:
+    //
+    // Opaque & sky:    bucket | program | material | mesh | depth
+    // Translucent:     bucket | inverted depth | program | material | mesh
+    //
+    const unsigned int ns_bucketBits   = 2;
+    const unsigned int ns_programBits  = 12;
+    const unsigned int ns_materialBits = 14;
+    const unsigned int ns_meshBits     = 14;
+    const unsigned int ns_stateBits    = ns_programBits + ns_materialBits + ns_meshBits;
+    const unsigned int ns_depthBits    = 64 - ns_bucketBits - ns_stateBits;
+
+    jop::uint64 foldPointer(const void* ptr, const unsigned int bits)
+    {
+        // Heap allocations are at least 16-byte aligned, skip the lowest bits
+        jop::uint64 val = static_cast<jop::uint64>(reinterpret_cast<std::uintptr_t>(ptr)) >> 4;
+
+        jop::uint64 folded = 0;
+        while (val)
+        {
+            folded ^= val;
+            val >>= bits;
+        }
+
+        return folded & ((1ull << bits) - 1);
+    }
+
+    bool canInstance(const jop::Drawable& drawable)
+    {
+        using namespace jop;
+
+        // Derived drawables may draw themselves in any way, only the plain one is safe
+        return typeid(drawable) == typeid(Drawable)
+            && !drawable.hasOverrideShader()
+            && drawable.getMesh()
+            && drawable.getMaterial()
+            && !drawable.getMesh()->hasVertexComponent(Mesh::Color);
+    }
+
+    bool isBatchedSprite(const jop::Drawable& drawable)
+    {
+        return (drawable.getAttributes() & jop::Drawable::Attribute::__Sprite) != 0 && static_cast<const jop::Sprite&>(drawable).isBatched();
+    }
+
+    bool instanceCompatible(const jop::Drawable& left, const jop::Drawable& right)
+    {
+        using namespace jop;
+
+        return left.getMesh() == right.getMesh()
+            && left.getMaterial() == right.getMaterial()
+            && (left.hasFlag(Drawable::ReceiveLights) == right.hasFlag(Drawable::ReceiveLights))
+            && (left.hasFlag(Drawable::ReceiveShadows) == right.hasFlag(Drawable::ReceiveShadows));
+    }
+
+    const char* profileName(const jop::RenderPass::Pass pass, const jop::uint32 weight)
+    {
+        // Set elements never move, so the names stay valid for the profiler
+        static std::unordered_set<std::string> names;
+
+        const std::string name = std::string(pass == jop::RenderPass::Pass::BeforePost ? "GPU RenderPass BeforePost " : "GPU RenderPass AfterPost ") + std::to_string(weight);
+
+        return names.insert(name).first->c_str();
+    }
+}
+
 namespace jop
 {
     const uint32 RenderPass::DefaultWeight = 0x88888888;
@@ -54,7 +132,8 @@ namespace jop
           m_target      (target),
           m_weight      (weight),
           m_pass        (pass),
-          m_active      (true)
+          m_active      (true),
+          m_profileName (profileName(pass, weight))
     {}
 
     RenderPass::~RenderPass()
@@ -123,24 +202,278 @@ namespace jop
 
 
     SortedRenderPass::SortedRenderPass(Renderer& renderer, const RenderTarget& target, const Pass pass, const uint32 weight)
-        : RenderPass(renderer, target, pass, weight)
+        : RenderPass        (renderer, target, pass, weight),
+          m_drawables       (),
+          m_indices         (),
+          m_queue           (),
+          m_sortBuffer      (),
+          m_lightIndex      (),
+          m_clusters        (LightClusters::isEnabled() ? std::make_unique<LightClusters>() : nullptr),
+          m_clusterLights   (),
+          m_instanceData    (),
+          m_instanceBuffer  (Buffer::Type::ArrayBuffer, Buffer::StreamDraw),
+          m_cameraBlock     (Buffer::StreamDraw)
     {}
 
+    SortedRenderPass::~SortedRenderPass()
+    {}
+
+    //////////////////////////////////////////////
+
+    SortedRenderPass::Bucket SortedRenderPass::getBucket(const uint64 key)
+    {
+        return static_cast<Bucket>(key >> (64 - ns_bucketBits));
+    }
+
+    //////////////////////////////////////////////
+
+    void SortedRenderPass::sortQueue(std::vector<QueueItem>& queue, std::vector<QueueItem>& buffer)
+    {
+        // Not worth the histogram overhead for tiny queues
+        if (queue.size() < 64)
+        {
+            std::stable_sort(queue.begin(), queue.end(), [](const QueueItem& left, const QueueItem& right)
+            {
+                return left.key < right.key;
+            });
+
+            return;
+        }
+
+        buffer.resize(queue.size());
+
+        // Build the histograms for all the byte positions in a single pass
+        std::size_t counts[8][256] = {};
+
+        for (auto& i : queue)
+        {
+            for (unsigned int b = 0; b < 8; ++b)
+                ++counts[b][(i.key >> (b * 8)) & 0xFF];
+        }
+
+        for (unsigned int b = 0; b < 8; ++b)
+        {
+            auto& count = counts[b];
+            const unsigned int shift = b * 8;
+
+            // Every key has the same value in this position, nothing to do
+            if (count[(queue.front().key >> shift) & 0xFF] == queue.size())
+                continue;
+
+            std::size_t offset = 0;
+            for (auto& c : count)
+            {
+                const std::size_t temp = c;
+                c = offset;
+                offset += temp;
+            }
+
+            for (auto& i : queue)
+                buffer[count[(i.key >> shift) & 0xFF]++] = i;
+
+            queue.swap(buffer);
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    void SortedRenderPass::updateState(DrawableState& entry)
+    {
+        auto& d = *entry.drawable;
+        auto mat = d.getMaterial();
+
+        if (entry.version == d.getStateVersion() && entry.material == mat && (!mat || entry.materialVersion == mat->getVersion()))
+            return;
+
+        static const uint64 skyAttrib = Drawable::Attribute::__SkyBox | Drawable::Attribute::__SkySphere;
+
+        entry.bucket = (d.getAttributes() & skyAttrib) != 0 ? Bucket::Sky : (d.hasAlpha() ? Bucket::Translucent : Bucket::Opaque);
+
+        // Sprites have no material, the texture decides which ones can be batched together
+        const void* material = isBatchedSprite(d) ? static_cast<const void*>(&static_cast<const Sprite&>(d).getTexture()) : mat;
+
+        entry.state = (foldPointer(&d.getShader(), ns_programBits) << (ns_materialBits + ns_meshBits)) |
+                      (foldPointer(material, ns_materialBits) << ns_meshBits) |
+                       foldPointer(d.getMesh(), ns_meshBits);
+
+        entry.material = mat;
+        entry.version = d.getStateVersion();
+        entry.materialVersion = mat ? mat->getVersion() : 0;
+    }
+
     //////////////////////////////////////////////
 
     const LightContainer ns_dummyLightCont;
 
+    void SortedRenderPass::buildQueue(const Camera& camera)
+    {
+        m_queue.clear();
+
+        const glm::vec3 camPos = camera.getObject()->getGlobalPosition();
+
+        // Depth is normalized using the far clipping plane
+        const auto& planes = camera.getClippingPlanes();
+        const float farPlane = std::max(std::abs(planes.first), std::abs(planes.second));
+        const float invFar = farPlane > 0.f ? 1.f / farPlane : 0.f;
+
+        static const uint64 maxDepth = (1ull << ns_depthBits) - 1;
+
+        for (auto& entry : m_drawables)
+        {
+            auto d = entry.drawable;
+
+            if (!d->isActive() || !camera.inView(*d))
+                continue;
+
+            updateState(entry);
+
+            const float dist = glm::distance(d->getObject()->getGlobalPosition(), camPos) * invFar;
+            uint64 depth = static_cast<uint64>(glm::clamp(dist, 0.f, 1.f) * static_cast<float>(maxDepth));
+
+            uint64 key = static_cast<uint64>(entry.bucket) << (64 - ns_bucketBits);
+
+            // Translucent drawables must be drawn back to front, so depth takes
+            // precedence over the render state
+            if (entry.bucket == Bucket::Translucent)
+                key |= ((maxDepth - depth) << ns_stateBits) | entry.state;
+            else
+                key |= (entry.state << ns_depthBits) | depth;
+
+            // Batched sprites are never lit
+            auto& lights = d->hasFlag(Drawable::ReceiveLights) && !isBatchedSprite(*d) ? m_lightIndex.getLights(*d) : ns_dummyLightCont;
+
+            m_queue.push_back({key, d, &lights});
+        }
+
+        sortQueue(m_queue, m_sortBuffer);
+    }
+
+    //////////////////////////////////////////////
+
+    std::size_t SortedRenderPass::getInstanceRun(const std::size_t first) const
+    {
+        auto& frontItem = m_queue[first];
+        auto& front = *frontItem.drawable;
+
+        if (getBucket(m_queue[first].key) != Bucket::Opaque || !canInstance(front))
+            return 1;
+
+        std::size_t last = first + 1;
+
+        while (last < m_queue.size() &&
+               getBucket(m_queue[last].key) == Bucket::Opaque &&
+               canInstance(*m_queue[last].drawable) &&
+               m_queue[last].lights == frontItem.lights &&
+               instanceCompatible(front, *m_queue[last].drawable))
+        {
+            ++last;
+        }
+
+        return last - first;
+    }
+
+    //////////////////////////////////////////////
+
+    std::size_t SortedRenderPass::getSpriteRun(const std::size_t first) const
+    {
+        const Bucket bucket = getBucket(m_queue[first].key);
+
+        std::size_t last = first + 1;
+
+        while (last < m_queue.size() &&
+               getBucket(m_queue[last].key) == bucket &&
+               isBatchedSprite(*m_queue[last].drawable))
+        {
+            ++last;
+        }
+
+        return last - first;
+    }
+
+    //////////////////////////////////////////////
+
+    void SortedRenderPass::drawSprites(const std::size_t first, const std::size_t amount, const glm::mat4& projView)
+    {
+        auto& batch = getRenderer().getSpriteBatch();
+
+        // The batch is flushed whenever the texture changes
+        batch.begin(projView);
+
+        for (std::size_t i = first; i < first + amount; ++i)
+            batch.add(static_cast<const Sprite&>(*m_queue[i].drawable));
+
+        batch.flush();
+    }
+
+    //////////////////////////////////////////////
+
+    void SortedRenderPass::drawInstanced(const std::size_t first, const std::size_t amount, const Camera& camera, const LightContainer& lights)
+    {
+        auto& front = *m_queue[first].drawable;
+        auto& mesh = *front.getMesh();
+        auto& mat = *front.getMaterial();
+
+        m_instanceData.resize(amount);
+
+        for (std::size_t i = 0; i < amount; ++i)
+        {
+            auto& d = *m_queue[first + i].drawable;
+
+            m_instanceData[i].modelMatrix = d.getObject()->getTransform().getMatrix();
+            m_instanceData[i].color = d.getColor().asRGBAVector();
+        }
+
+        m_instanceBuffer.setData(m_instanceData.data(), m_instanceData.size() * sizeof(Mesh::InstanceData));
+
+        auto& shdr = ShaderAssembler::getShader(mat.getAttributes(), Drawable::Attribute::__Instanced);
+        auto& viewMat = camera.getViewMatrix();
+
+        const bool lighting = (mat.getAttributes() & Material::LightingAttribs) != 0;
+
+        // The camera block is updated in draw()
+        if (UniformBuffer::isAvailable())
+            m_cameraBlock.bindBase(UniformBuffer::Binding::Camera);
+
+        else
+        {
+            shdr.setUniform(shdr.getUniformHandle(ShaderProgram::Uniform::PVMatrix), camera.getProjectionMatrix() * viewMat);
+
+            if (lighting)
+                shdr.setUniform(shdr.getUniformHandle(ShaderProgram::Uniform::VMatrix), viewMat);
+        }
+
+        if (lighting)
+            lights.sendToShader(shdr, front, viewMat);
+
+        mat.sendToShader(shdr);
+
+        mesh.drawInstanced(m_instanceBuffer, static_cast<uint32>(amount));
+    }
+
+    //////////////////////////////////////////////
+
     void SortedRenderPass::draw()
     {
         if (!isActive() || m_drawables.empty())
             return;
 
+        JOP_PROFILE("SortedRenderPass::draw");
+
         const auto& rend = getRenderer();
 
         const auto& target = rend.getRenderTarget();
         const auto& cameras = rend.getCameras();
         const auto& lights = rend.getLights();
 
+        static const DynamicSetting<unsigned int> minInstances("engine@Graphics|uMinInstances", 8);
+        const bool instancing = minInstances.value > 1 && Mesh::instancingSupported();
+
+        // The drawables' light selections are done in buildQueue()
+        m_lightIndex.update(lights);
+
+        if (m_clusters)
+            m_clusterLights.assign(lights.begin(), lights.end());
+
         for (auto cam : cameras)
         {
             if (!cam->isActive() || !cam->getRenderMask())
@@ -153,65 +486,69 @@ namespace jop
 
             cam->applyViewport(target);
 
-            // 0 - Opaque
-            // 1 - Translucent
-            // 2 - Skybox & skysphere
-            //
-            std::vector<const Drawable*> sorted[3];
-            sorted[0].reserve(m_drawables.size());
+            buildQueue(*cam);
 
-            for (auto d : m_drawables)
+            if (m_clusters)
             {
-                if (!d->isActive() || !cam->inView(*d))
-                    continue;
+                m_clusters->build(m_clusterLights, *cam, target);
+                m_clusters->bind();
+            }
 
-                static const uint64 skyAttrib = Drawable::Attribute::__SkyBox | Drawable::Attribute::__SkySphere;
+            if (instancing && UniformBuffer::isAvailable())
+            {
+                const glm::mat4 cameraBlock[] =
+                {
+                    projInfo.viewMatrix,
+                    projInfo.projectionMatrix * projInfo.viewMatrix
+                };
 
-                sorted[std::min(2, d->hasAlpha() + ((d->getAttributes() & skyAttrib) != 0) * 2)].push_back(d);
+                m_cameraBlock.setData(cameraBlock, sizeof(cameraBlock));
             }
 
-            std::sort(sorted[0].begin(), sorted[0].end(), [&projInfo](const Drawable* left, const Drawable* right) -> bool
-            {
-                return glm::distance2(left->getObject()->getGlobalPosition(), projInfo.cameraPosition) <
-                       glm::distance2(right->getObject()->getGlobalPosition(), projInfo.cameraPosition);
-            });
+            GlState::setDepthTest(true);
+            GlState::setDepthWrite(true);
+            GlState::setBlendFunc(false);
 
-            std::sort(sorted[1].begin(), sorted[1].end(), [&projInfo](const Drawable* left, const Drawable* right) -> bool
-            {
-                return glm::distance2(left->getObject()->getGlobalPosition(), projInfo.cameraPosition) >
-                       glm::distance2(right->getObject()->getGlobalPosition(), projInfo.cameraPosition);
-            });
+            bool translucent = false;
 
-            auto drawSet = [&projInfo, &lights](const std::vector<const Drawable*>& set) -> void
+            for (std::size_t i = 0; i < m_queue.size();)
             {
-                for (auto d : set)
+                auto& item = m_queue[i];
+
+                if (!translucent && getBucket(item.key) == Bucket::Translucent)
                 {
-                    if (d->hasFlag(Drawable::ReceiveLights))
-                    {
-                        LightContainer lightCont;
-
-                        for (auto l : lights)
-                        {
-                            if (lightCont[l->getType()].size() < LightSource::getMaximumLights(l->getType()))
-                                lightCont[l->getType()].push_back(l);
-                        }
-
-                        d->draw(projInfo, lightCont);
-                    }
-                    else
-                        d->draw(projInfo, ns_dummyLightCont);
+                    GlState::setBlendFunc(true);
+                    GlState::setDepthWrite(false);
+                    translucent = true;
                 }
-            };
 
-            GlState::setDepthTest(true);
-            GlState::setDepthWrite(true);
-            GlState::setBlendFunc(false);
-            drawSet(sorted[0]);
-            drawSet(sorted[2]);
+                if (isBatchedSprite(*item.drawable))
+                {
+                    const std::size_t run = getSpriteRun(i);
+
+                    drawSprites(i, run, projInfo.projectionMatrix * projInfo.viewMatrix);
+                    i += run;
+
+                    continue;
+                }
+
+                // Every drawable in a run has the same lights
+                auto& drawLights = *item.lights;
+
+                const std::size_t run = instancing ? getInstanceRun(i) : 1;
+
+                if (instancing && run >= minInstances.value)
+                {
+                    drawInstanced(i, run, *cam, drawLights);
+                    i += run;
+                }
+                else
+                {
+                    for (const std::size_t end = i + run; i < end; ++i)
+                        m_queue[i].drawable->draw(projInfo, drawLights);
+                }
+            }
 
-            GlState::setBlendFunc(true);
-            GlState::setDepthWrite(false);
-            drawSet(sorted[1]);
             GlState::setDepthWrite(true);
         }
     }
@@ -220,14 +557,32 @@ namespace jop
 
     void SortedRenderPass::bind(const Drawable* drawable)
     {
-        m_drawables.insert(drawable);
+        // The state version can never match the one of a new entry, forcing the state to be computed on the first use
+        if (m_indices.emplace(drawable, m_drawables.size()).second)
+            m_drawables.push_back({drawable, nullptr, 0, drawable->getStateVersion() - 1, 0, Bucket::Opaque});
     }
 
     //////////////////////////////////////////////
 
     void SortedRenderPass::unbind(const Drawable* drawable)
     {
-        m_drawables.erase(drawable);
+        auto itr = m_indices.find(drawable);
+
+        if (itr != m_indices.end())
+        {
+            // Swap with the last element to avoid shifting
+            const std::size_t index = itr->second;
+            m_indices.erase(itr);
+            m_lightIndex.forget(*drawable);
+
+            if (index != m_drawables.size() - 1)
+            {
+                m_drawables[index] = m_drawables.back();
+                m_indices[m_drawables[index].drawable] = index;
+            }
+
+            m_drawables.pop_back();
+        }
     }
 
     //////////////////////////////////////////////
@@ -243,10 +598,13 @@ namespace jop
         if (!isActive() || m_drawables.empty())
             return;
 
+        JOP_PROFILE("OrderedRenderPass::draw");
+
         const auto& rend = getRenderer();
 
         const auto& target = m_target;
         const auto& cameras = rend.getCameras();
+        auto& batch = rend.getSpriteBatch();
 
         GlState::setDepthTest(true, GlState::DepthFunc::Always);
         GlState::setBlendFunc(true);
@@ -265,13 +623,25 @@ namespace jop
 
             cam->applyViewport(target);
 
+            // Consecutive sprites are batched, the batch is flushed before drawing anything else
+            batch.begin(projInfo.projectionMatrix * projInfo.viewMatrix);
+
             for (auto d : m_drawables)
             {
                 if (!d->isActive() || !((1 << d->getRenderGroup()) & camMask))
                     continue;
 
-                d->draw(projInfo, ns_dummyLightCont);
+                if (isBatchedSprite(*d))
+                    batch.add(static_cast<const Sprite&>(*d));
+
+                else
+                {
+                    batch.flush();
+                    d->draw(projInfo, ns_dummyLightCont);
+                }
             }
+
+            batch.flush();
         }
 
         GlState::setDepthTest(true);
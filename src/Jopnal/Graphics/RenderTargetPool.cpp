@@ -0,0 +1,167 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+// Headers
+#include JOP_PRECOMPILED_HEADER_FILE
+
+#ifndef JOP_PRECOMPILED_HEADER
+
+    #include <Jopnal/Graphics/RenderTargetPool.hpp>
+
+    #include <Jopnal/Core/DebugHandler.hpp>
+    #include <algorithm>
+
+#endif
+
+//////////////////////////////////////////////
+
+
+namespace jop
+{
+    RenderTargetPool::RenderTargetPool()
+        : m_entries     (),
+          m_memory      (0),
+          m_creations   (0)
+    {}
+
+    RenderTargetPool::~RenderTargetPool()
+    {}
+
+    //////////////////////////////////////////////
+
+    RenderTexture& RenderTargetPool::acquire(const glm::uvec2& size, const Texture::Format format)
+    {
+        for (auto& i : m_entries)
+        {
+            if (!i.inUse && i.format == format && i.target->getSize() == size)
+            {
+                i.inUse = true;
+                i.idleFrames = 0;
+
+                return *i.target;
+            }
+        }
+
+        using Slot = RenderTexture::Slot;
+
+        Entry entry;
+        entry.target = std::make_unique<RenderTexture>();
+        entry.format = format;
+        entry.idleFrames = 0;
+        entry.inUse = true;
+
+        auto& target = *entry.target;
+        target.setSize(glm::max(size, glm::uvec2(1)));
+
+        if (target.addTextureAttachment(Slot::Color0, format))
+        {
+            auto& tex = *target.getTextureAttachment(Slot::Color0);
+            tex.setFilterMode(TextureSampler::Filter::Bilinear).setRepeatMode(TextureSampler::Repeat::ClampEdge);
+
+            m_memory += tex.getMemoryUsage().gpu;
+        }
+        else
+            JOP_DEBUG_ERROR("Failed to create pooled render target (" << size.x << "x" << size.y << ")");
+
+        ++m_creations;
+        m_entries.emplace_back(std::move(entry));
+
+        return target;
+    }
+
+    //////////////////////////////////////////////
+
+    void RenderTargetPool::release(const RenderTexture& target)
+    {
+        for (auto& i : m_entries)
+        {
+            if (i.target.get() == &target)
+            {
+                JOP_ASSERT(i.inUse, "Tried to release a pooled render target twice!");
+                i.inUse = false;
+
+                return;
+            }
+        }
+
+        JOP_ASSERT(false, "Tried to release a render target not belonging to the pool!");
+    }
+
+    //////////////////////////////////////////////
+
+    void RenderTargetPool::endFrame(const unsigned int maxIdleFrames)
+    {
+        // Compact the kept entries to the front. The memory has to be subtracted
+        // before the target is destroyed by the move
+        auto kept = m_entries.begin();
+
+        for (auto& i : m_entries)
+        {
+            if (!i.inUse && ++i.idleFrames > maxIdleFrames)
+            {
+                auto tex = i.target->getTextureAttachment(RenderTexture::Slot::Color0);
+
+                if (tex)
+                    m_memory -= tex->getMemoryUsage().gpu;
+
+                continue;
+            }
+
+            if (&*kept != &i)
+                *kept = std::move(i);
+
+            ++kept;
+        }
+
+        m_entries.erase(kept, m_entries.end());
+    }
+
+    //////////////////////////////////////////////
+
+    void RenderTargetPool::clear()
+    {
+        JOP_ASSERT(std::none_of(m_entries.begin(), m_entries.end(), [](const Entry& entry){ return entry.inUse; }), "Tried to clear a render target pool while targets are in use!");
+
+        m_entries.clear();
+        m_memory = 0;
+    }
+
+    //////////////////////////////////////////////
+
+    std::size_t RenderTargetPool::getTargetCount() const
+    {
+        return m_entries.size();
+    }
+
+    //////////////////////////////////////////////
+
+    std::size_t RenderTargetPool::getMemoryUsage() const
+    {
+        return m_memory;
+    }
+
+    //////////////////////////////////////////////
+
+    unsigned int RenderTargetPool::getCreationCount() const
+    {
+        return m_creations;
+    }
+}
\ No newline at end of file
@@ -33,6 +33,7 @@
     #include <Jopnal/Graphics/Texture/Cubemap.hpp>
     #include <Jopnal/Utility/Assert.hpp>
     #include <Jopnal/Graphics/OpenGL/GlCheck.hpp>
+    #include <Jopnal/Graphics/OpenGL/GlState.hpp>
     #include <Jopnal/Window/Window.hpp>
     #include <vector>
 
@@ -427,11 +428,20 @@ namespace jop
         if (!framebuffer && !attachments)
             return;
 
-        unbind();
+        const bool contextThread = GlState::isContextThread();
+
+        if (contextThread)
+            unbind();
 
         if (framebuffer)
         {
-            glCheck(glDeleteFramebuffers(1, &m_frameBuffer));
+            if (!contextThread)
+                GlState::deferDelete(GlState::ObjectType::Framebuffer, m_frameBuffer);
+            else
+            {
+                glCheck(glDeleteFramebuffers(1, &m_frameBuffer));
+            }
+
             m_frameBuffer = 0;
         }
 
@@ -439,7 +449,14 @@ namespace jop
         {
             for (auto& i : m_attachments)
             {
-                glCheck(glDeleteRenderbuffers(1, &std::get<0>(i)));
+                if (!contextThread)
+                    GlState::deferDelete(GlState::ObjectType::Renderbuffer, std::get<0>(i));
+                else
+                {
+                    glCheck(glDeleteRenderbuffers(1, &std::get<0>(i)));
+                }
+
+                std::get<0>(i) = 0;
                 std::get<1>(i).reset();
             }
 
@@ -28,10 +28,16 @@
 
     #include <Jopnal/Core/Engine.hpp>
     #include <Jopnal/Core/Object.hpp>
+    #include <Jopnal/Core/Profiler.hpp>
+    #include <Jopnal/Graphics/OpenGL/GpuTimer.hpp>
     #include <Jopnal/Core/Scene.hpp>
     #include <Jopnal/Graphics/Camera.hpp>
+    #include <Jopnal/Graphics/Culling/CullingTree.hpp>
+    #include <Jopnal/Graphics/Drawable.hpp>
     #include <Jopnal/Graphics/LightSource.hpp>
     #include <Jopnal/Graphics/EnvironmentRecorder.hpp>
+    #include <Jopnal/Graphics/Material.hpp>
+    #include <algorithm>
 
 #endif
 
@@ -45,6 +51,11 @@ namespace jop
           m_cameras             (),
           m_passes              (),
           m_envRecorders        (),
+          m_drawables           (),
+          m_shadowMapUpdates    (0),
+          m_shadowAtlas         (),
+          m_spriteBatch         (),
+          m_cullingTree         (detail::CullingTree::cullingEnabled() ? std::make_unique<detail::CullingTree>() : nullptr),
           m_target              (mainTarget),
           m_sceneRef            (sceneRef)
     {
@@ -52,6 +63,9 @@ namespace jop
         createRenderPass<OrderedRenderPass>(RenderPass::Pass::AfterPost, RenderPass::DefaultWeight);
     }
 
+    Renderer::~Renderer()
+    {}
+
     //////////////////////////////////////////////
 
     const RenderTarget& Renderer::getRenderTarget() const
@@ -91,6 +105,8 @@ namespace jop
 
     void Renderer::bind(const Drawable* drawable, const RenderPass::Pass pass, const uint32 weight)
     {
+        m_drawables.insert(drawable);
+
         auto& passArr = m_passes[static_cast<int>(pass)];
         auto passItr = passArr.find(weight);
 
@@ -125,6 +141,11 @@ namespace jop
 
     void Renderer::unbind(const Drawable* drawable, const RenderPass::Pass pass, const uint32 weight)
     {
+        auto drawItr = m_drawables.find(drawable);
+
+        if (drawItr != m_drawables.end())
+            m_drawables.erase(drawItr);
+
         auto& passArr = m_passes[static_cast<int>(pass)];
         auto passItr = passArr.find(weight);
         
@@ -158,11 +179,44 @@ namespace jop
 
     void Renderer::draw(const RenderPass::Pass pass)
     {
+        JOP_PROFILE("Renderer::draw");
+
+        // Materials may have been changed since the last pass
+        Material::resetUniformCache();
+
         if (pass == RenderPass::Pass::BeforePost)
         {
+            // Refit the culling tree and gather the visible drawables for every camera.
+            // The lists are sorted so that they can be searched in Camera::inView()
+            if (m_cullingTree)
+            {
+                JOP_PROFILE("Renderer::cull");
+
+                m_cullingTree->update();
+
+                for (auto cam : m_cameras)
+                {
+                    m_cullingTree->query(cam->getProjectionMatrix() * cam->getViewMatrix(), cam->getRenderMask(), cam->m_visible);
+                    std::sort(cam->m_visible.begin(), cam->m_visible.end());
+                }
+            }
+
             // Render shadow maps
-            for (auto light : m_lights)
-                light->drawShadowMap();
+            {
+                JOP_PROFILE("Renderer::drawShadowMaps");
+                JOP_PROFILE_GPU("GPU Renderer::drawShadowMaps");
+
+                m_shadowMapUpdates = 0;
+
+                allocateShadowTiles();
+
+                // Every light draws into the same framebuffer
+                if (m_shadowAtlas.isValid() && m_shadowAtlas.bind())
+                {
+                    for (auto light : m_lights)
+                        m_shadowMapUpdates += light->drawShadowMap();
+                }
+            }
 
             // Render environment maps
             /*for (auto envmap : m_envRecorders)
@@ -173,14 +227,176 @@ namespace jop
         }
 
         // Render objects
-        for (auto& i : m_passes[static_cast<int>(pass)])
-            i.second->draw();
+        {
+            JOP_PROFILE_GPU(pass == RenderPass::Pass::BeforePost ? "GPU Renderer::draw BeforePost" : "GPU Renderer::draw AfterPost");
+
+            for (auto& i : m_passes[static_cast<int>(pass)])
+            {
+                if (!i.second->isActive())
+                    continue;
+
+                JOP_PROFILE_GPU(i.second->m_profileName);
+                i.second->draw();
+            }
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    void Renderer::queryDrawables(const glm::mat4& pvMatrix, const uint32 renderMask, std::vector<const Drawable*>& drawables) const
+    {
+        if (m_cullingTree)
+        {
+            m_cullingTree->query(pvMatrix, renderMask, drawables);
+            return;
+        }
+
+        drawables.clear();
+
+        glm::vec4 planes[6];
+
+        for (int i = 0; i < 6; ++i)
+        {
+            const int row = i / 2;
+            const float sign = (i % 2) == 0 ? 1.f : -1.f;
+
+            planes[i] = glm::vec4(pvMatrix[0][3] + sign * pvMatrix[0][row],
+                                  pvMatrix[1][3] + sign * pvMatrix[1][row],
+                                  pvMatrix[2][3] + sign * pvMatrix[2][row],
+                                  pvMatrix[3][3] + sign * pvMatrix[3][row]);
+        }
+
+        for (auto itr = m_drawables.begin(); itr != m_drawables.end(); itr = m_drawables.upper_bound(*itr))
+        {
+            auto d = *itr;
+
+            if ((renderMask & (1 << d->getRenderGroup())) == 0)
+                continue;
+
+            const auto bounds = d->getGlobalBounds();
+            const glm::vec3 center = (bounds.first + bounds.second) * 0.5f;
+            const glm::vec3 extent = (bounds.second - bounds.first) * 0.5f;
+
+            bool inside = true;
+
+            for (int i = 0; i < 6 && inside; ++i)
+            {
+                const glm::vec3 normal(planes[i]);
+                inside = glm::dot(normal, center) + planes[i].w + glm::dot(glm::abs(normal), extent) >= 0.f;
+            }
+
+            if (inside)
+                drawables.push_back(d);
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 Renderer::getShadowMapUpdates() const
+    {
+        return m_shadowMapUpdates;
+    }
+
+    //////////////////////////////////////////////
+
+    const ShadowAtlas& Renderer::getShadowAtlas() const
+    {
+        return m_shadowAtlas;
+    }
+
+    //////////////////////////////////////////////
+
+    SpriteBatch& Renderer::getSpriteBatch() const
+    {
+        return m_spriteBatch;
+    }
+
+    //////////////////////////////////////////////
+
+    void Renderer::allocateShadowTiles()
+    {
+        JOP_PROFILE("Renderer::allocateShadowTiles");
+
+        // Wanted tile size & light
+        static std::vector<std::pair<unsigned int, const LightSource*>> requests;
+        requests.clear();
+
+        bool anyShadows = false;
+
+        for (auto light : m_lights)
+        {
+            light->m_shadowTiles.clear();
+            anyShadows |= light->castsShadows();
+
+            if (light->castsShadows() && light->isActive() && light->getRenderMask())
+                requests.emplace_back(light->getShadowTileSize(), light);
+        }
+
+        if (!anyShadows)
+        {
+            m_shadowAtlas.destroy();
+            return;
+        }
+
+        if (requests.empty() || !m_shadowAtlas.create())
+            return;
+
+        m_shadowAtlas.reset();
+
+        // Scale the tiles down until they all fit. Power of two tiles allocated
+        // from the largest to the smallest pack into the quad tree without gaps
+        uint64 area = 0;
+        unsigned int scale = 1;
+
+        for (auto& r : requests)
+        {
+            // Round up like the atlas does
+            unsigned int size = ShadowAtlas::getMinimumTileSize();
+
+            while (size < r.first && size < m_shadowAtlas.getSize())
+                size *= 2;
+
+            r.first = size;
+            area += static_cast<uint64>(r.first) * r.first * r.second->m_lightSpaceMatrices.size();
+        }
+
+        const uint64 atlasArea = static_cast<uint64>(m_shadowAtlas.getSize()) * m_shadowAtlas.getSize();
+
+        while (area / (static_cast<uint64>(scale) * scale) > atlasArea && scale < m_shadowAtlas.getSize())
+            scale *= 2;
+
+        std::sort(requests.begin(), requests.end(), [](const std::pair<unsigned int, const LightSource*>& a, const std::pair<unsigned int, const LightSource*>& b)
+        {
+            return a.first > b.first;
+        });
+
+        for (auto& r : requests)
+        {
+            auto& tiles = r.second->m_shadowTiles;
+
+            for (std::size_t i = 0; i < r.second->m_lightSpaceMatrices.size(); ++i)
+            {
+                const auto tile = m_shadowAtlas.allocate(std::max(r.first / scale, ShadowAtlas::getMinimumTileSize()));
+
+                // The least important lights go without shadows when there's no more space
+                if (!tile.isValid())
+                {
+                    for (auto& t : tiles)
+                        m_shadowAtlas.release(t);
+
+                    tiles.clear();
+                    break;
+                }
+
+                tiles.push_back(tile);
+            }
+        }
     }
 
     //////////////////////////////////////////////
 
-    World& Renderer::getCullingWorld()
+    detail::CullingTree& Renderer::getCullingTree()
     {
-        return m_sceneRef.m_cullingWorld;
+        return *m_cullingTree;
     }
 }
\ No newline at end of file
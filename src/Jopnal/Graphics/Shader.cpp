@@ -30,7 +30,10 @@
     #include <Jopnal/Core/FileLoader.hpp>
     #include <Jopnal/Graphics/OpenGL/OpenGL.hpp>
     #include <Jopnal/Graphics/OpenGL/GlCheck.hpp>
+    #include <Jopnal/Graphics/OpenGL/GlState.hpp>
+    #include <Jopnal/Graphics/LightClusters.hpp>
     #include <Jopnal/Graphics/ShaderAssembler.hpp>
+    #include <Jopnal/Graphics/UniformBuffer.hpp>
     #include <queue>
 
 #endif
@@ -70,7 +73,13 @@ namespace jop
 
     void Shader::destroy()
     {
-        glCheck(glDeleteShader(m_handle));
+        if (!GlState::isContextThread())
+            GlState::deferDelete(GlState::ObjectType::Shader, m_handle);
+        else
+        {
+            glCheck(glDeleteShader(m_handle));
+        }
+
         m_sources.clear();
         m_handle = 0;
     }
@@ -355,6 +364,14 @@ namespace jop
             if (gl::getGLSLVersion() < 300 && JOP_CHECK_GL_EXTENSION(NV_explicit_attrib_location))
                 extString += "#extension GL_NV_explicit_attrib_location : enable\n";
         #endif
+
+            // Tells the engine shaders to declare their uniforms in blocks
+            if (UniformBuffer::isAvailable())
+                extString += "#define JOP_UNIFORM_BLOCKS\n";
+
+            // Point and spot lights are read from the light clusters
+            if (LightClusters::isEnabled())
+                extString += "#define JOP_CLUSTERED_LIGHTING\n";
         }
 
         return extString;
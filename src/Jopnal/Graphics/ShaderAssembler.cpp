@@ -72,6 +72,7 @@ namespace jop
         addPlugins(std::string(reinterpret_cast<const char*>(jopr::lightingPlugins), sizeof(jopr::lightingPlugins)));
         addPlugins(std::string(reinterpret_cast<const char*>(jopr::structurePlugins), sizeof(jopr::structurePlugins)));
         addPlugins(std::string(reinterpret_cast<const char*>(jopr::shadowPlugins), sizeof(jopr::shadowPlugins)));
+        addPlugins(std::string(reinterpret_cast<const char*>(jopr::blockPlugins), sizeof(jopr::blockPlugins)));
     }
 
     ShaderAssembler::~ShaderAssembler()
@@ -116,14 +117,9 @@ namespace jop
                 cont[combinedAttribs] = static_ref_cast<ShaderProgram>(s->getReference());
             }
 
-            // Needed so that different samplers don't all point to zero
+            // Needed so that the atlas doesn't point to the diffuse map unit
             if ((materialAttribs & Material::FragLightingAttribs) != 0)
-            {
-                static const int maxUnits = Texture::getMaxTextureUnits();
-
-                for (std::size_t i = 0; i < LightSource::getMaximumLights(LightSource::Type::Point); ++i)
-                    s->setUniform("u_PointLightShadowMaps[" + std::to_string(i) + "]", maxUnits - 1);
-            }
+                s->setUniform(s->getUniformHandle(ShaderProgram::Uniform::ShadowAtlas), static_cast<int>(Material::Map::__Last));
         }
 
         return *s;
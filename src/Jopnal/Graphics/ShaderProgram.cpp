@@ -31,11 +31,14 @@
     #include <Jopnal/Core/ResourceManager.hpp>
     #include <Jopnal/Graphics/OpenGL/OpenGL.hpp>
     #include <Jopnal/Graphics/OpenGL/GlCheck.hpp>
+    #include <Jopnal/Graphics/OpenGL/GlState.hpp>
     #include <Jopnal/Graphics/Mesh/Mesh.hpp>
+    #include <Jopnal/Graphics/LightClusters.hpp>
     #include <Jopnal/Graphics/Material.hpp>
     #include <Jopnal/Graphics/ShaderAssembler.hpp>
     #include <Jopnal/Graphics/Texture/Texture.hpp>
     #include <Jopnal/Graphics/Shader.hpp>
+    #include <Jopnal/Graphics/UniformBuffer.hpp>
     #include <glm/gtc/type_ptr.hpp>
     #include <vector>
 
@@ -49,6 +52,34 @@
 namespace
 {
     unsigned int ns_currentProgram = 0;
+
+    const char* const ns_engineUnifNames[] =
+    {
+        "u_PVMMatrix",
+        "u_VMMatrix",
+        "u_NMatrix",
+        "u_PVMatrix",
+        "u_VMatrix",
+        "u_DiffuseMap",
+        "u_ReceiveLights",
+        "u_ReceiveShadows",
+        "u_NumPointLights",
+        "u_NumSpotLights",
+        "u_NumDirectionalLights",
+        "u_ShadowAtlas"
+    };
+
+    static_assert(sizeof(ns_engineUnifNames) / sizeof(ns_engineUnifNames[0]) == jop::ShaderProgram::Uniform::__Last, "Engine uniform name array out of sync");
+
+    const char* const ns_engineBlockNames[] =
+    {
+        "jop_CameraBlock",
+        "jop_LightBlock",
+        "jop_MaterialBlock",
+        "jop_ClusterBlock"
+    };
+
+    static_assert(sizeof(ns_engineBlockNames) / sizeof(ns_engineBlockNames[0]) == jop::UniformBuffer::Binding::__Last, "Engine uniform block name array out of sync");
 }
 
 namespace jop
@@ -78,8 +109,12 @@ namespace jop
         : Resource      (name),
           m_shaders     (),
           m_unifMap     (),
+          m_engineUnifs (),
+          m_unifTables  (),
           m_programID   (0)
-    {}
+    {
+        m_engineUnifs.fill(-1);
+    }
 
     ShaderProgram::~ShaderProgram()
     {
@@ -178,6 +213,8 @@ namespace jop
 
         m_shaders.clear();
 
+        resolveEngineUniforms();
+
         return true;
     }
 
@@ -187,13 +224,25 @@ namespace jop
     {
         if (m_programID)
         {
-            if (m_programID == ns_currentProgram)
-                unbind();
+            // The uniform caches are reset before every frame is drawn, which
+            // covers the programs deleted at the end of the previous one
+            if (!GlState::isContextThread())
+                GlState::deferDelete(GlState::ObjectType::Program, m_programID);
+            else
+            {
+                if (m_programID == ns_currentProgram)
+                    unbind();
 
-            glCheck(glDeleteProgram(m_programID));
+                glCheck(glDeleteProgram(m_programID));
+
+                // The uniform values are lost along with the program
+                Material::resetUniformCache();
+            }
         }
 
         m_unifMap.clear();
+        m_unifTables.clear();
+        m_engineUnifs.fill(-1);
         m_programID = 0;
     }
 
@@ -207,6 +256,8 @@ namespace jop
             {
                 glCheck(glUseProgram(m_programID));
                 ns_currentProgram = m_programID;
+
+                ++GlState::getFrameStatistics().programSwitches;
             }
 
             return true;
@@ -257,6 +308,65 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    int ShaderProgram::getUniformHandle(const std::string& name)
+    {
+        auto itr = m_unifMap.find(name);
+
+        if (itr != m_unifMap.end())
+            return itr->second;
+
+        int location = -1;
+
+        if (m_programID)
+        {
+            location = glCheck(glGetUniformLocation(m_programID, name.c_str()));
+        }
+
+        // Failed lookups are cached as well, the map is cleared when relinking
+        m_unifMap[name] = location;
+
+        return location;
+    }
+
+    //////////////////////////////////////////////
+
+    int ShaderProgram::getUniformHandle(const uint32 uniform) const
+    {
+        JOP_ASSERT(uniform < Uniform::__Last, "Engine uniform out of range!");
+
+        return m_engineUnifs[uniform];
+    }
+
+    //////////////////////////////////////////////
+
+    const int* ShaderProgram::getUniformHandles(const UniformTable& table)
+    {
+        for (auto& i : m_unifTables)
+        {
+            if (i.first == &table)
+                return i.second.data();
+        }
+
+        std::vector<int> handles;
+        handles.reserve(table.size());
+
+        for (auto& i : table)
+        {
+            int location = -1;
+
+            if (m_programID)
+            {
+                location = glCheck(glGetUniformLocation(m_programID, i.c_str()));
+            }
+
+            handles.push_back(location);
+        }
+
+        m_unifTables.emplace_back(&table, std::move(handles));
+
+        return m_unifTables.back().second.data();
+    }
+
     bool ShaderProgram::setUniform(const std::string& name, const glm::mat4& matrix)
     {
         return setUniform(name, glm::value_ptr(matrix), 1);
@@ -384,6 +494,108 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    bool ShaderProgram::setUniform(const int handle, const glm::mat4& matrix)
+    {
+        if (handle == -1 || !bind())
+            return false;
+
+        glCheck(glUniformMatrix4fv(handle, 1, GL_FALSE, glm::value_ptr(matrix)));
+
+        return true;
+    }
+
+    //////////////////////////////////////////////
+
+    bool ShaderProgram::setUniform(const int handle, const glm::mat3& matrix)
+    {
+        if (handle == -1 || !bind())
+            return false;
+
+        glCheck(glUniformMatrix3fv(handle, 1, GL_FALSE, glm::value_ptr(matrix)));
+
+        return true;
+    }
+
+    //////////////////////////////////////////////
+
+    bool ShaderProgram::setUniform(const int handle, const glm::vec2& vector)
+    {
+        if (handle == -1 || !bind())
+            return false;
+
+        glCheck(glUniform2f(handle, vector.x, vector.y));
+
+        return true;
+    }
+
+    //////////////////////////////////////////////
+
+    bool ShaderProgram::setUniform(const int handle, const glm::vec3& vector)
+    {
+        if (handle == -1 || !bind())
+            return false;
+
+        glCheck(glUniform3f(handle, vector.x, vector.y, vector.z));
+
+        return true;
+    }
+
+    //////////////////////////////////////////////
+
+    bool ShaderProgram::setUniform(const int handle, const glm::vec4& vector)
+    {
+        if (handle == -1 || !bind())
+            return false;
+
+        glCheck(glUniform4f(handle, vector.x, vector.y, vector.z, vector.w));
+
+        return true;
+    }
+
+    //////////////////////////////////////////////
+
+    bool ShaderProgram::setUniform(const int handle, const Texture& texture, const unsigned int unit)
+    {
+        if (handle == -1 || !bind())
+            return false;
+
+        texture.bind(unit);
+        glCheck(glUniform1i(handle, static_cast<int>(unit)));
+
+        return true;
+    }
+
+    //////////////////////////////////////////////
+
+    bool ShaderProgram::setUniform(const int handle, const float value)
+    {
+        if (handle == -1 || !bind())
+            return false;
+
+        glCheck(glUniform1f(handle, value));
+
+        return true;
+    }
+
+    //////////////////////////////////////////////
+
+    bool ShaderProgram::setUniform(const int handle, const int value)
+    {
+        if (handle == -1 || !bind())
+            return false;
+
+        glCheck(glUniform1i(handle, value));
+
+        return true;
+    }
+
+    //////////////////////////////////////////////
+
+    bool ShaderProgram::setUniform(const int handle, const bool value)
+    {
+        return setUniform(handle, value ? 1 : 0);
+    }
+
     ShaderProgram& ShaderProgram::getDefault()
     {
         static WeakReference<ShaderProgram> defShader;
@@ -438,6 +650,45 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    void ShaderProgram::resolveEngineUniforms()
+    {
+        for (std::size_t i = 0; i < m_engineUnifs.size(); ++i)
+        {
+            m_engineUnifs[i] = glCheck(glGetUniformLocation(m_programID, ns_engineUnifNames[i]));
+        }
+
+    #if !defined(JOP_OPENGL_ES) || defined(JOP_OPENGL_ES3)
+
+        if (UniformBuffer::isAvailable())
+        {
+            for (uint32 i = 0; i < UniformBuffer::Binding::__Last; ++i)
+            {
+                const GLuint index = glCheck(glGetUniformBlockIndex(m_programID, ns_engineBlockNames[i]));
+
+                if (index != GL_INVALID_INDEX)
+                {
+                    glCheck(glUniformBlockBinding(m_programID, index, i));
+                }
+            }
+
+            // The cluster textures stay bound to fixed units for the whole frame
+            if (LightClusters::isEnabled())
+            {
+                const unsigned int unit = LightClusters::getTextureUnit();
+
+                const int lights = glCheck(glGetUniformLocation(m_programID, "u_ClusterLights"));
+                const int data = glCheck(glGetUniformLocation(m_programID, "u_ClusterData"));
+
+                setUniform(lights, static_cast<int>(unit));
+                setUniform(data, static_cast<int>(unit + 1));
+            }
+        }
+
+    #endif
+    }
+
+    //////////////////////////////////////////////
+
     int ShaderProgram::getUniformLocation(const std::string& name)
     {
         if (bind())
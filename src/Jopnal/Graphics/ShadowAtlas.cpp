@@ -0,0 +1,334 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+// Headers
+#include JOP_PRECOMPILED_HEADER_FILE
+
+#ifndef JOP_PRECOMPILED_HEADER
+
+    #include <Jopnal/Graphics/ShadowAtlas.hpp>
+
+    #include <Jopnal/Core/SettingManager.hpp>
+    #include <Jopnal/Graphics/Color.hpp>
+    #include <Jopnal/Graphics/Texture/Texture2D.hpp>
+    #include <Jopnal/Graphics/OpenGL/OpenGL.hpp>
+    #include <Jopnal/Graphics/OpenGL/GlCheck.hpp>
+    #include <algorithm>
+
+#endif
+
+//////////////////////////////////////////////
+
+
+namespace
+{
+    unsigned int floorPow2(unsigned int value)
+    {
+        unsigned int result = 1;
+
+        while (result <= value / 2)
+            result *= 2;
+
+        return result;
+    }
+}
+
+namespace jop
+{
+    ShadowAtlas::Tile::Tile()
+        : position  (0),
+          size      (0)
+    {}
+
+    //////////////////////////////////////////////
+
+    bool ShadowAtlas::Tile::isValid() const
+    {
+        return size > 0;
+    }
+
+    //////////////////////////////////////////////
+
+
+    ShadowAtlas::ShadowAtlas()
+        : m_target      (),
+          m_free        (),
+          m_size        (0),
+          m_generation  (0),
+          m_packed      (false)
+    {}
+
+    //////////////////////////////////////////////
+
+    bool ShadowAtlas::create()
+    {
+        if (isValid())
+            return true;
+
+        static const unsigned int size = floorPow2(std::min(SettingManager::get<unsigned int>("engine@Graphics|Shading|uShadowAtlasSize", 4096), Texture2D::getMaximumSize()));
+
+        using Slot = RenderTexture::Slot;
+
+        m_target.setSize(glm::uvec2(size));
+        m_packed = !m_target.addTextureAttachment(Slot::Depth, Texture::Format::Depth_US_16);
+
+        // Packed depth is written as color, the depth test still needs a depth buffer
+        if (m_packed)
+        {
+            if (!m_target.addTextureAttachment(Slot::Color0, Texture::Format::RGBA_UB_8) ||
+                !m_target.addRenderbufferAttachment(Slot::Depth, Texture::Format::Depth_US_16))
+            {
+                destroy();
+                return false;
+            }
+
+            m_target.setClearColor(Color::White);
+        }
+
+        // Tiles are only sampled inside their bounds, no need for border color
+        m_target.getTextureAttachment(m_packed ? Slot::Color0 : Slot::Depth)->setFilterMode(TextureSampler::Filter::Bilinear)
+                                                                             .setRepeatMode(TextureSampler::Repeat::ClampEdge);
+
+        ++m_generation;
+        reset(size, getMinimumTileSize());
+
+        return true;
+    }
+
+    //////////////////////////////////////////////
+
+    void ShadowAtlas::destroy()
+    {
+        m_target.destroy(true, true);
+        m_free.clear();
+        m_size = 0;
+    }
+
+    //////////////////////////////////////////////
+
+    bool ShadowAtlas::isValid() const
+    {
+        return m_target.isValid();
+    }
+
+    //////////////////////////////////////////////
+
+    void ShadowAtlas::reset()
+    {
+        // The level count remembers the minimum tile size
+        if (m_size)
+            reset(m_size, m_size >> (m_free.size() - 1));
+    }
+
+    //////////////////////////////////////////////
+
+    void ShadowAtlas::reset(const unsigned int size, const unsigned int minTileSize)
+    {
+        m_size = size;
+        m_free.clear();
+
+        if (!size)
+            return;
+
+        // One level for each power of two down to the minimum tile size
+        std::size_t levels = 1;
+
+        for (unsigned int s = size; s > minTileSize; s /= 2)
+            ++levels;
+
+        m_free.resize(levels);
+        m_free[0].emplace_back(0);
+    }
+
+    //////////////////////////////////////////////
+
+    ShadowAtlas::Tile ShadowAtlas::allocate(const unsigned int size)
+    {
+        Tile tile;
+
+        if (m_free.empty())
+            return tile;
+
+        // Level of the wanted size, rounded up
+        std::size_t level = 0;
+
+        for (unsigned int s = getSize() / 2; level + 1 < m_free.size() && s >= std::max(size, 1u); s /= 2)
+            ++level;
+
+        // Find the smallest free node that fits
+        std::size_t found = level + 1;
+
+        for (std::size_t i = level + 1; i-- > 0;)
+        {
+            if (!m_free[i].empty())
+            {
+                found = i;
+                break;
+            }
+        }
+
+        if (found > level)
+            return tile;
+
+        glm::uvec2 node = m_free[found].back();
+        m_free[found].pop_back();
+
+        // Split down to the wanted level, keeping the first quadrant
+        for (std::size_t i = found; i < level; ++i)
+        {
+            const unsigned int half = getSize() >> (i + 1);
+
+            m_free[i + 1].emplace_back(node.x + half, node.y);
+            m_free[i + 1].emplace_back(node.x, node.y + half);
+            m_free[i + 1].emplace_back(node.x + half, node.y + half);
+        }
+
+        tile.position = node;
+        tile.size = getSize() >> level;
+
+        return tile;
+    }
+
+    //////////////////////////////////////////////
+
+    void ShadowAtlas::release(const Tile& tile)
+    {
+        if (!tile.isValid() || m_free.empty())
+            return;
+
+        std::size_t level = 0;
+
+        while (level + 1 < m_free.size() && (getSize() >> level) > tile.size)
+            ++level;
+
+        glm::uvec2 node = tile.position;
+
+        // Merge with the siblings as long as all four quadrants are free
+        for (; level > 0; --level)
+        {
+            auto& free = m_free[level];
+            const unsigned int size = getSize() >> (level - 1);
+            const glm::uvec2 parent = node - node % size;
+
+            const auto isSibling = [&parent, &node, size](const glm::uvec2& n)
+            {
+                return n != node && n - n % size == parent;
+            };
+
+            if (std::count_if(free.begin(), free.end(), isSibling) < 3)
+                break;
+
+            free.erase(std::remove_if(free.begin(), free.end(), isSibling), free.end());
+            node = parent;
+        }
+
+        m_free[level].push_back(node);
+    }
+
+    //////////////////////////////////////////////
+
+    glm::vec4 ShadowAtlas::getRect(const Tile& tile) const
+    {
+        if (!tile.isValid() || !isValid())
+            return glm::vec4(0.f);
+
+        const float size = static_cast<float>(getSize());
+
+        return glm::vec4(glm::vec2(tile.position) / size, glm::vec2(static_cast<float>(tile.size) / size));
+    }
+
+    //////////////////////////////////////////////
+
+    bool ShadowAtlas::bind() const
+    {
+        return m_target.bind();
+    }
+
+    //////////////////////////////////////////////
+
+    void ShadowAtlas::setTile(const Tile& tile, const bool clear) const
+    {
+        const GLint x = static_cast<GLint>(tile.position.x);
+        const GLint y = static_cast<GLint>(tile.position.y);
+        const GLsizei size = static_cast<GLsizei>(tile.size);
+
+        glCheck(glViewport(x, y, size, size));
+        glCheck(glScissor (x, y, size, size));
+
+        if (clear)
+        {
+            // Not using RenderTarget::clear(), it would reset the viewport
+            glCheck(glClearColor(1.f, 1.f, 1.f, 1.f));
+
+        #ifndef JOP_OPENGL_ES
+            glCheck(glClearDepth(1.0));
+        #else
+            glCheck(glClearDepthf(1.f));
+        #endif
+
+            glCheck(glClear(GL_DEPTH_BUFFER_BIT | (m_packed ? GL_COLOR_BUFFER_BIT : 0)));
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    const Texture* ShadowAtlas::getTexture() const
+    {
+        return m_target.getTextureAttachment(m_packed ? RenderTexture::Slot::Color0 : RenderTexture::Slot::Depth);
+    }
+
+    //////////////////////////////////////////////
+
+    const RenderTexture& ShadowAtlas::getRenderTexture() const
+    {
+        return m_target;
+    }
+
+    //////////////////////////////////////////////
+
+    unsigned int ShadowAtlas::getSize() const
+    {
+        return m_size;
+    }
+
+    //////////////////////////////////////////////
+
+    bool ShadowAtlas::isPacked() const
+    {
+        return m_packed;
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 ShadowAtlas::getGeneration() const
+    {
+        return m_generation;
+    }
+
+    //////////////////////////////////////////////
+
+    unsigned int ShadowAtlas::getMinimumTileSize()
+    {
+        static const unsigned int size = floorPow2(std::max(SettingManager::get<unsigned int>("engine@Graphics|Shading|uShadowAtlasMinTileSize", 64), 1u));
+
+        return size;
+    }
+}
\ No newline at end of file
@@ -70,7 +70,7 @@ namespace jop
 
         // Uniforms
         {
-            shdr.setUniform("u_PVMMatrix", proj.projectionMatrix * glm::mat4(glm::mat3(proj.viewMatrix)));
+            shdr.setUniform(shdr.getUniformHandle(ShaderProgram::Uniform::PVMMatrix), proj.projectionMatrix * glm::mat4(glm::mat3(proj.viewMatrix)));
 
             m_material.sendToShader(shdr);
 
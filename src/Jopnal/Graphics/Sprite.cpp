@@ -27,11 +27,12 @@
     #include <Jopnal/Graphics/Sprite.hpp>
 
     #include <Jopnal/Core/Object.hpp>
+    #include <Jopnal/Graphics/Renderer.hpp>
+    #include <Jopnal/Graphics/SpriteBatch.hpp>
     #include <Jopnal/Graphics/Texture/Texture2D.hpp>
+    #include <Jopnal/Graphics/Texture/TextureAtlas.hpp>
     #include <Jopnal/Graphics/ShaderAssembler.hpp>
     #include <Jopnal/Graphics/ShaderProgram.hpp>
-    #include <Jopnal/Graphics/OpenGL/OpenGL.hpp>
-    #include <Jopnal/Graphics/OpenGL/GlCheck.hpp>
 
 #endif
 
@@ -47,50 +48,63 @@ namespace jop
     Sprite::Sprite(Object& object, Renderer& renderer, const RenderPass::Pass pass, const uint32 weight, const bool cull)
         : Drawable      (object, renderer, pass, weight, cull),
           m_texture     (),
-          m_mesh        (""),
-          m_texCoords   (glm::vec2(0.f), glm::vec2(1.f))
+          m_size        (0.f),
+          m_texCoords   (glm::vec2(0.f), glm::vec2(1.f)),
+          m_batchType   (&typeid(Sprite))
     {
+        m_attributes |= Attribute::__Sprite;
+
         setTexture(Texture2D::getDefault(), true);
         setOverrideShader(ShaderAssembler::getShader(1 << static_cast<uint64>(Material::Map::Diffuse0), 0));
     }
 
     Sprite::Sprite(const Sprite& other, Object& newObj)
         : Drawable      (other, newObj),
-          m_texture     (),
-          m_mesh        (""),
-          m_texCoords   (other.m_texCoords)
-    {
-        setTexture(Texture2D::getDefault(), true);
-    }
+          m_texture     (other.m_texture),
+          m_size        (other.m_size),
+          m_texCoords   (other.m_texCoords),
+          m_batchType   (&typeid(Sprite))
+    {}
 
     //////////////////////////////////////////////
 
     void Sprite::draw(const ProjectionInfo& proj, const LightContainer&) const
     {
-        // Uniforms
-        {
-            auto& tex = getTexture();
+        auto& batch = getRenderer().getSpriteBatch();
 
-            auto& shdr = getShader();
-            auto& modelMat = getObject()->getTransform().getMatrix();
+        batch.begin(proj.projectionMatrix * proj.viewMatrix);
+        batch.add(*this);
+        batch.flush();
+    }
 
-            shdr.setUniform("u_PVMMatrix", proj.projectionMatrix * proj.viewMatrix * modelMat);
-            shdr.setUniform("u_DiffuseMap", tex, static_cast<unsigned int>(Material::Map::Diffuse0));
+    //////////////////////////////////////////////
 
-            glCheck(glVertexAttrib4fv(Mesh::VertexIndex::Color, &getColor().colors[0]));
+    Sprite& Sprite::setTexture(const Texture2D& texture, const bool updateSize)
+    {
+        // The texture is used in place of a material when sorting
+        if (m_texture.get() != &texture)
+        {
+            m_texture = static_ref_cast<const Texture2D>(texture.getReference());
+            invalidateState();
         }
 
-        m_mesh.draw();
+        if (updateSize)
+            return setSize(texture.getSize());
+
+        return *this;
     }
 
     //////////////////////////////////////////////
 
-    Sprite& Sprite::setTexture(const Texture2D& texture, const bool updateSize)
+    Sprite& Sprite::setTexture(const TextureAtlas& atlas, const unsigned int index, const bool updateSize)
     {
-        m_texture = static_ref_cast<const Texture2D>(texture.getReference());
+        const auto coords = atlas.getCoordinates(index);
+
+        setTexture(atlas.getTexture(), false);
+        setTextureCoordinates(coords.first, coords.second);
 
         if (updateSize)
-            return setSize(texture.getSize());
+            return setSize(glm::abs(coords.second - coords.first) * glm::vec2(atlas.getTexture().getSize()));
 
         return *this;
     }
@@ -109,7 +123,7 @@ namespace jop
 
     Sprite& Sprite::setSize(const glm::vec2& size)
     {
-        m_mesh.load(size, m_texCoords.first, m_texCoords.second);
+        m_size = size;
         return *this;
     }
 
@@ -117,7 +131,7 @@ namespace jop
 
     const glm::vec2& Sprite::getSize() const
     {
-        return m_mesh.getSize();
+        return m_size;
     }
 
     //////////////////////////////////////////////
@@ -127,7 +141,7 @@ namespace jop
         m_texCoords.first = min;
         m_texCoords.second = max;
 
-        return setSize(getSize());
+        return *this;
     }
 
     //////////////////////////////////////////////
@@ -136,4 +150,19 @@ namespace jop
     {
         return m_texCoords;
     }
+
+    //////////////////////////////////////////////
+
+    bool Sprite::isBatched() const
+    {
+        // A derived class may override draw(), which the batch would bypass
+        return typeid(*this) == *m_batchType;
+    }
+
+    //////////////////////////////////////////////
+
+    void Sprite::enableBatching(const std::type_info& type)
+    {
+        m_batchType = &type;
+    }
 }
\ No newline at end of file
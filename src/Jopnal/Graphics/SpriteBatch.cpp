@@ -0,0 +1,198 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+// Headers
+#include JOP_PRECOMPILED_HEADER_FILE
+
+#ifndef JOP_PRECOMPILED_HEADER
+
+    #include <Jopnal/Graphics/SpriteBatch.hpp>
+
+    #include <Jopnal/Core/Object.hpp>
+    #include <Jopnal/Graphics/Material.hpp>
+    #include <Jopnal/Graphics/ShaderProgram.hpp>
+    #include <Jopnal/Graphics/Sprite.hpp>
+    #include <Jopnal/Graphics/Mesh/Mesh.hpp>
+    #include <Jopnal/Graphics/Texture/Texture2D.hpp>
+    #include <Jopnal/Graphics/OpenGL/OpenGL.hpp>
+    #include <Jopnal/Graphics/OpenGL/GlCheck.hpp>
+    #include <Jopnal/Graphics/OpenGL/GlState.hpp>
+    #include <cstddef>
+
+#endif
+
+//////////////////////////////////////////////
+
+
+namespace
+{
+    const unsigned int ns_maxSprites = 0x10000 / 4;
+    const unsigned int ns_minSprites = 64;
+}
+
+namespace jop
+{
+    SpriteBatch::SpriteBatch()
+        : m_vertices        (),
+          m_vertexBuffer    (Buffer::Type::ArrayBuffer, Buffer::StreamDraw),
+          m_indexBuffer     (Buffer::Type::ElementArrayBuffer, Buffer::StaticDraw),
+          m_projView        (1.f),
+          m_texture         (nullptr),
+          m_shader          (nullptr),
+          m_indexCapacity   (0)
+    {}
+
+    SpriteBatch::~SpriteBatch()
+    {}
+
+    //////////////////////////////////////////////
+
+    void SpriteBatch::begin(const glm::mat4& projView)
+    {
+        flush();
+
+        m_projView = projView;
+    }
+
+    //////////////////////////////////////////////
+
+    void SpriteBatch::add(const Sprite& sprite)
+    {
+        auto& texture = sprite.getTexture();
+        auto& shader = sprite.getShader();
+
+        if (&texture != m_texture || &shader != m_shader || getPendingSprites() >= ns_maxSprites)
+        {
+            flush();
+
+            m_texture = &texture;
+            m_shader = &shader;
+        }
+
+        const glm::mat4& model = sprite.getObject()->getTransform().getMatrix();
+        const glm::vec2 half(sprite.getSize() * 0.5f);
+        const auto& coords = sprite.getTextureCoordinates();
+        const glm::vec4 color(sprite.getColor().asRGBAVector());
+
+        const glm::vec3 center(model[3]);
+        const glm::vec3 right(glm::vec3(model[0]) * half.x);
+        const glm::vec3 up(glm::vec3(model[1]) * half.y);
+
+        // Same layout as RectangleMesh
+        m_vertices.push_back({center - right - up, glm::vec2(coords.first.x,  coords.second.y), color});
+        m_vertices.push_back({center + right - up, glm::vec2(coords.second.x, coords.second.y), color});
+        m_vertices.push_back({center + right + up, glm::vec2(coords.second.x, coords.first.y),  color});
+        m_vertices.push_back({center - right + up, glm::vec2(coords.first.x,  coords.first.y),  color});
+    }
+
+    //////////////////////////////////////////////
+
+    void SpriteBatch::flush()
+    {
+        const unsigned int sprites = getPendingSprites();
+
+        if (!sprites)
+            return;
+
+        // Grow the index buffer to the next power of two
+        if (sprites > m_indexCapacity)
+        {
+            m_indexCapacity = ns_minSprites;
+
+            while (m_indexCapacity < sprites)
+                m_indexCapacity *= 2;
+
+            m_indexCapacity = std::min(m_indexCapacity, ns_maxSprites);
+
+            std::vector<uint16> indices(m_indexCapacity * 6);
+
+            for (unsigned int i = 0; i < m_indexCapacity; ++i)
+            {
+                const uint16 base = static_cast<uint16>(i * 4);
+                uint16* quad = &indices[i * 6];
+
+                quad[0] = base;
+                quad[1] = base + 1;
+                quad[2] = base + 2;
+                quad[3] = base + 2;
+                quad[4] = base + 3;
+                quad[5] = base;
+            }
+
+            m_indexBuffer.setData(indices.data(), indices.size() * sizeof(uint16));
+        }
+
+        m_vertexBuffer.setData(m_vertices.data(), m_vertices.size() * sizeof(Vertex));
+
+        // Uniforms
+        {
+            auto& shdr = *m_shader;
+
+            shdr.setUniform(shdr.getUniformHandle(ShaderProgram::Uniform::PVMMatrix), m_projView);
+            shdr.setUniform(shdr.getUniformHandle(ShaderProgram::Uniform::DiffuseMap), *m_texture, static_cast<unsigned int>(Material::Map::Diffuse0));
+        }
+
+        // Vertex attributes. These are specified into the default vertex array,
+        // so the pointers of the last drawn mesh are no longer valid
+        {
+            typedef Mesh::VertexIndex VI;
+
+            GlState::setVertexAttributeSource(nullptr);
+
+            m_vertexBuffer.bind();
+
+            GlState::setVertexAttribute(true, VI::Position);
+            glCheck(glVertexAttribPointer(VI::Position, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, position))));
+
+            GlState::setVertexAttribute(true, VI::TexCoords);
+            glCheck(glVertexAttribPointer(VI::TexCoords, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, texCoords))));
+
+            GlState::setVertexAttribute(false, VI::Normal);
+
+            GlState::setVertexAttribute(true, VI::Color);
+            glCheck(glVertexAttribPointer(VI::Color, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, color))));
+
+            m_indexBuffer.bind();
+        }
+
+        glCheck(glDrawElements(GL_TRIANGLES, sprites * 6, GL_UNSIGNED_SHORT, 0));
+        ++GlState::getFrameStatistics().drawCalls;
+
+        // Drawables without vertex colors set the color as a constant attribute
+        GlState::setVertexAttribute(false, Mesh::VertexIndex::Color);
+
+        m_vertices.clear();
+    }
+
+    //////////////////////////////////////////////
+
+    unsigned int SpriteBatch::getPendingSprites() const
+    {
+        return static_cast<unsigned int>(m_vertices.size() / 4);
+    }
+
+    //////////////////////////////////////////////
+
+    unsigned int SpriteBatch::getMaxSprites()
+    {
+        return ns_maxSprites;
+    }
+}
\ No newline at end of file
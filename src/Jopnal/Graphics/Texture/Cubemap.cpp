@@ -82,6 +82,7 @@ namespace jop
             &back, &front
         };
 
+        contentsChanged();
         destroy();
         m_size = glm::uvec2(0);
 
@@ -155,6 +156,7 @@ namespace jop
 
     bool Cubemap::load(const glm::uvec2& size, const Format format, const uint32 flags)
     {
+        contentsChanged();
         destroy();
         m_size = glm::uvec2(0);
 
@@ -208,6 +210,7 @@ namespace jop
         if (!image.isCubemap() || !JOP_CHECK_GL_EXTENSION(EXT_texture_compression_s3tc) || !detail::errorCheckCube(image.getSize()))
             return false;
 
+        contentsChanged();
         destroy();
         bind();
 
@@ -31,6 +31,7 @@
     #include <Jopnal/Graphics/Image.hpp>
     #include <Jopnal/Graphics/OpenGL/OpenGL.hpp>
     #include <Jopnal/Graphics/OpenGL/GlCheck.hpp>
+    #include <Jopnal/Graphics/OpenGL/GlState.hpp>
 
 #endif
 
@@ -223,6 +224,11 @@ namespace jop
                 case F::RGBA_F_16:
                     return GL_RGBA;
 
+                // 128 bit RGBA float texture
+                // Support will be checked elsewhere
+                case F::RGBA_F_32:
+                    return GL_RGBA;
+
                 // 16 bit and 24 bit depth textures
                 // Support will be checked elsewhere
                 case F::Depth_US_16:
@@ -400,6 +406,33 @@ namespace jop
                 #endif
                 }
 
+                // 128 bit RGBA floating point texture
+                // Not supported in GLES 2.0
+                case F::RGBA_F_32:
+                {
+                #if defined(JOP_OPENGL_ES) && JOP_MIN_OPENGL_ES_VERSION < 300
+
+                    if (gl::getVersionMajor() < 3)
+                        JOP_DEBUG_ERROR_ONCE("32 bit floating point textures are not supported");
+
+                    return
+
+                    #ifdef GL_ES_VERSION_3_0
+
+                        // If version >= 3.0
+                        gl::getVersionMajor() >= 3 ? GL_RGBA32F :
+
+                    #endif
+
+                    // If version < 3.0
+                    0;
+
+                #else
+                    return GL_RGBA32F;
+
+                #endif
+                }
+
                 // 16 and 24 bit depth textures
                 // Only with extension in GLES 2.0
                 case F::Depth_US_16:
@@ -533,6 +566,11 @@ namespace jop
                 #endif
                 }
 
+                // 128 bit RGBA float texture
+                // Support is checked elsewhere
+                case F::RGBA_F_32:
+                    return GL_FLOAT;
+
                 // 16 bit depth texture
                 // Support is checked elsewhere
                 case F::Depth_US_16:
@@ -667,7 +705,17 @@ namespace jop
 
     void Texture::destroy()
     {
-        glCheck(glDeleteTextures(1, &m_texture));
+        if (m_texture)
+        {
+            if (!GlState::isContextThread())
+                GlState::deferDelete(GlState::ObjectType::Texture, m_texture);
+            else
+            {
+                GlState::releaseTexture(m_texture);
+                glCheck(glDeleteTextures(1, &m_texture));
+            }
+        }
+
         m_texture = 0;
         m_format = Format::None;
     }
@@ -676,16 +724,16 @@ namespace jop
 
     bool Texture::bind(const unsigned int texUnit) const
     {
+        markUsed();
+
         if (!m_texture)
         {
             glCheck(glGenTextures(1, &m_texture));
-            glCheck(glActiveTexture(GL_TEXTURE0 + texUnit));
-            glCheck(glBindTexture(m_target, m_texture));
+            GlState::bindTexture(texUnit, m_target, m_texture);
             updateSampling();
         }
 
-        glCheck(glActiveTexture(GL_TEXTURE0 + texUnit));
-        glCheck(glBindTexture(m_target, m_texture));
+        GlState::bindTexture(texUnit, m_target, m_texture);
 
         if (!m_sampler.expired())
             m_sampler->bind(texUnit);
@@ -699,8 +747,7 @@ namespace jop
 
     void Texture::unbind(const unsigned int texUnit) const
     {
-        glCheck(glActiveTexture(GL_TEXTURE0 + texUnit));
-        glCheck(glBindTexture(m_target, 0));
+        GlState::bindTexture(texUnit, m_target, 0);
     }
 
     //////////////////////////////////////////////
@@ -845,6 +892,7 @@ namespace jop
 
             case Format::RGB_F_16:
             case Format::RGBA_F_16:
+            case Format::RGBA_F_32:
                 param = 8;
         }
 
@@ -924,6 +972,9 @@ namespace jop
                 return Format::RGB_F_16;
             case 8:
                 return Format::RGBA_F_16;
+
+            case 16:
+                return Format::RGBA_F_32;
         }
 
         return Format::None;
@@ -951,6 +1002,9 @@ namespace jop
                 return 6;
             case Format::RGBA_F_16:
                 return 8;
+
+            case Format::RGBA_F_32:
+                return 16;
         }
 
         return 0;
@@ -958,6 +1012,31 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    Resource::MemoryUsage Texture::getMemoryUsage() const
+    {
+        MemoryUsage usage;
+        usage.cpu = 0;
+        usage.gpu = 0;
+
+        if (isValid())
+        {
+            const glm::uvec2 size = getSize();
+            usage.gpu = static_cast<std::size_t>(size.x) * size.y * getPixelDepth() * (m_target == GL_TEXTURE_CUBE_MAP ? 6 : 1);
+        }
+
+        return usage;
+    }
+
+    //////////////////////////////////////////////
+
+    bool Texture::releaseMemory()
+    {
+        destroy();
+        return true;
+    }
+
+    //////////////////////////////////////////////
+
     void Texture::setAlphaSwizzle(const Format format)
     {
     #if !defined(JOP_OPENGL_ES) || defined(GL_ES_VERSION_3_0)
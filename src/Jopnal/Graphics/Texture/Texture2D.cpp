@@ -96,6 +96,7 @@ namespace jop
         if (!detail::errorCheck(size))
             return false;
 
+        contentsChanged();
         destroy();
         m_size = glm::uvec2(0);
 
@@ -137,6 +138,7 @@ namespace jop
             if (!detail::errorCheck(image.getSize()))
                 return false;
 
+            contentsChanged();
             destroy();
             bind();
 
@@ -198,6 +200,7 @@ namespace jop
 
         const FormatBundle f(m_format, false);
 
+        contentsChanged();
         bind();
         setUnpackAlignment(m_format);
         glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, start.x, start.y, size.x, size.y, f.format, f.type, pixels));
@@ -320,4 +323,19 @@ namespace jop
 
         return *defTex;
     }
+
+    //////////////////////////////////////////////
+
+    std::function<bool(Texture2D&)> AsyncLoadTraits<Texture2D>::prepare(const std::string& path, const uint32 flags)
+    {
+        auto image = std::make_shared<Image>();
+
+        if (!image->load(path, (flags & Texture::Flag::DisallowCompression) == 0))
+            return nullptr;
+
+        return [image, flags](Texture2D& texture)
+        {
+            return texture.load(*image, flags);
+        };
+    }
 }
\ No newline at end of file
@@ -30,6 +30,7 @@
     #include <Jopnal/Core/SettingManager.hpp>
     #include <Jopnal/Graphics/OpenGL/OpenGL.hpp>
     #include <Jopnal/Graphics/OpenGL/GlCheck.hpp>
+    #include <Jopnal/Graphics/OpenGL/GlState.hpp>
 
 #endif
 
@@ -105,7 +106,13 @@ namespace jop
     #endif
 
         {
-            glCheck(glDeleteSamplers(1, &m_sampler));
+            if (!GlState::isContextThread())
+                GlState::deferDelete(GlState::ObjectType::Sampler, m_sampler);
+            else
+            {
+                glCheck(glDeleteSamplers(1, &m_sampler));
+            }
+
             m_sampler = 0;
         }
 
@@ -0,0 +1,116 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+// Headers
+#include JOP_PRECOMPILED_HEADER_FILE
+
+#ifndef JOP_PRECOMPILED_HEADER
+
+    #include <Jopnal/Graphics/UniformBuffer.hpp>
+
+    #include <Jopnal/Core/SettingManager.hpp>
+    #include <Jopnal/Graphics/OpenGL/OpenGL.hpp>
+    #include <Jopnal/Graphics/OpenGL/GlCheck.hpp>
+    #include <Jopnal/Graphics/OpenGL/GlState.hpp>
+
+#endif
+
+//////////////////////////////////////////////
+
+
+namespace jop
+{
+    UniformBuffer::UniformBuffer(const Usage usage)
+        : Buffer(Type::UniformBuffer, usage)
+    {}
+
+    UniformBuffer::UniformBuffer(UniformBuffer&& other)
+        : Buffer(std::move(other))
+    {}
+
+    UniformBuffer& UniformBuffer::operator =(UniformBuffer&& other)
+    {
+        Buffer::operator =(std::move(other));
+
+        return *this;
+    }
+
+    //////////////////////////////////////////////
+
+    void UniformBuffer::setData(const void* data, const std::size_t bytes)
+    {
+        if (bytes && data)
+        {
+            bind();
+
+            if (bytes == m_bytesAllocated)
+            {
+                glCheck(glBufferSubData(m_bufferType, 0, bytes, data));
+                return;
+            }
+
+            glCheck(glBufferData(m_bufferType, bytes, data, m_usage));
+            m_bytesAllocated = bytes;
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    void UniformBuffer::setSubData(const void* data, const std::size_t offset, const std::size_t size)
+    {
+        if (data && size && (offset + size) <= m_bytesAllocated)
+        {
+            bind();
+            glCheck(glBufferSubData(m_bufferType, offset, size, data));
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    void UniformBuffer::bindBase(const uint32 index) const
+    {
+        if (!m_buffer)
+        {
+            glCheck(glGenBuffers(1, &m_buffer));
+        }
+
+        GlState::bindUniformBuffer(index, m_buffer);
+    }
+
+    //////////////////////////////////////////////
+
+    bool UniformBuffer::isAvailable()
+    {
+    #if !defined(JOP_OPENGL_ES) || defined(JOP_OPENGL_ES3)
+
+        // The light structures use the GLES 2 compatibility path below GLSL 3.30
+        static const bool available = gl::getGLSLVersion() >= 300 &&
+                                      SettingManager::get<bool>("engine@Graphics|Shading|bUniformBlocks", true);
+
+        return available;
+
+    #else
+
+        return false;
+
+    #endif
+    }
+}
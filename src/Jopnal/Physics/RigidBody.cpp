@@ -50,6 +50,8 @@ namespace jop
 {
     JOP_REGISTER_COMMAND_HANDLER(RigidBody)
 
+        JOP_COMMAND_RECEIVERS(Message::Component);
+
         JOP_BIND_MEMBER_COMMAND(&RigidBody::setGravityScale, "setBodyGravity");
         JOP_BIND_MEMBER_COMMAND(&RigidBody::setFixedMovement, "setLinearFactor");
         JOP_BIND_MEMBER_COMMAND(&RigidBody::setFixedRotation, "setFixedRotation");
@@ -381,7 +383,7 @@ namespace jop
 
     Message::Result RigidBody::receiveMessage(const Message& message)
     {
-        if (JOP_EXECUTE_COMMAND(RigidBody, message.getString(), this) == Message::Result::Escape)
+        if (JOP_EXECUTE_COMMAND(RigidBody, message, this) == Message::Result::Escape)
             return Message::Result::Escape;
 
         return Component::receiveMessage(message);
@@ -29,6 +29,7 @@
     #include <Jopnal/Core/Object.hpp>   
     #include <Jopnal/Core/SettingManager.hpp>
     #include <Jopnal/Core/DebugHandler.hpp>
+    #include <Jopnal/Core/Profiler.hpp>
     #include <Jopnal/Core/ResourceManager.hpp>
     #include <Jopnal/Utility/CommandHandler.hpp>
     #include <Jopnal/Graphics/Camera.hpp>
@@ -64,6 +65,8 @@ namespace jop
 {
     JOP_REGISTER_COMMAND_HANDLER(World)
 
+        JOP_COMMAND_RECEIVERS(Message::Component);
+
         JOP_BIND_MEMBER_COMMAND(&World::setDebugMode, "setWorldDebugMode");
 
     JOP_END_COMMAND_HANDLER(World)
@@ -160,6 +163,7 @@ namespace jop
 
                     shdr->setUniform("u_PVMatrix", m_proj->projectionMatrix * m_proj->viewMatrix);
 
+                    GlState::setVertexAttributeSource(nullptr);
                     GlState::setVertexAttribute(true, Mesh::VertexIndex::Position);
                     GlState::setVertexAttribute(true, Mesh::VertexIndex::Color);
                     glCheck(glVertexAttribPointer(Mesh::VertexIndex::Position, 3, GL_FLOAT, GL_FALSE, sizeof(LineVec::value_type), 0));
@@ -369,6 +373,8 @@ namespace jop
             {*val = 1.f / value;}
 
         } cb(&timeStep, str);
+
+        JOP_PROFILE("World::update");
         
         m_worldData->world->stepSimulation(deltaTime, 10, timeStep);
     }
@@ -533,7 +539,7 @@ namespace jop
 
     Message::Result World::receiveMessage(const Message& message)
     {
-        if (JOP_EXECUTE_COMMAND(World, message.getString(), this) == Message::Result::Escape)
+        if (JOP_EXECUTE_COMMAND(World, message, this) == Message::Result::Escape)
             return Message::Result::Escape;
 
         return Component::receiveMessage(message);
@@ -44,6 +44,8 @@ namespace jop
 {
     JOP_REGISTER_COMMAND_HANDLER(RigidBody2D)
 
+        JOP_COMMAND_RECEIVERS(Message::Component);
+
         JOP_BIND_MEMBER_COMMAND(&RigidBody2D::setGravityScale, "setGravityScale");
         JOP_BIND_MEMBER_COMMAND(&RigidBody2D::setFixedRotation, "setFixedRotation");
         JOP_BIND_MEMBER_COMMAND(&RigidBody2D::applyForce, "applyForce");
@@ -329,7 +331,7 @@ namespace jop
 
     Message::Result RigidBody2D::receiveMessage(const Message& message)
     {
-        if (JOP_EXECUTE_COMMAND(RigidBody2D, message.getString(), this) == Message::Result::Escape)
+        if (JOP_EXECUTE_COMMAND(RigidBody2D, message, this) == Message::Result::Escape)
             return Message::Result::Escape;
 
         return Component::receiveMessage(message);
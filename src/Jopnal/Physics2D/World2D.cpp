@@ -26,6 +26,7 @@
 
     #include <Jopnal/Physics2D/World2D.hpp>
 
+    #include <Jopnal/Core/Profiler.hpp>
     #include <Jopnal/Core/ResourceManager.hpp>
     #include <Jopnal/Core/SettingManager.hpp>
     #include <Jopnal/Graphics/Camera.hpp>
@@ -59,6 +60,8 @@ namespace jop
 {
     JOP_REGISTER_COMMAND_HANDLER(World2D)
 
+        JOP_COMMAND_RECEIVERS(Message::Component);
+
         JOP_BIND_MEMBER_COMMAND(&World2D::setDebugMode, "setWorldDebugMode");
 
     JOP_END_COMMAND_HANDLER(World2D)
@@ -174,6 +177,7 @@ namespace jop
 
                     shdr->setUniform("u_PVMatrix", m_proj->projectionMatrix * m_proj->viewMatrix);
 
+                    GlState::setVertexAttributeSource(nullptr);
                     GlState::setVertexAttribute(true, Mesh::VertexIndex::Position);
                     GlState::setVertexAttribute(true, Mesh::VertexIndex::Color);
                     glCheck(glVertexAttribPointer(Mesh::VertexIndex::Position, 3, GL_FLOAT, GL_FALSE, sizeof(LineVec::value_type), reinterpret_cast<void*>(0)));
@@ -279,6 +283,8 @@ namespace jop
             }
         } cb(&timeStep, str);
 
+        JOP_PROFILE("World2D::update");
+
         m_step = std::min(0.1f, m_step + deltaTime);
 
         while (m_step >= timeStep)
@@ -441,7 +447,7 @@ namespace jop
 
     Message::Result World2D::receiveMessage(const Message& message)
     {
-        if (JOP_EXECUTE_COMMAND(World2D, message.getString(), this) == Message::Result::Escape)
+        if (JOP_EXECUTE_COMMAND(World2D, message, this) == Message::Result::Escape)
             return Message::Result::Escape;
 
         return Component::receiveMessage(message);
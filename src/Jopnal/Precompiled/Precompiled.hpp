@@ -47,6 +47,7 @@
 // OpenGL
 #include <Jopnal/Graphics/OpenGL/OpenGL.hpp>
 #include <Jopnal/Graphics/OpenGL/GlCheck.hpp>
+#include <Jopnal/Graphics/OpenGL/GpuTimer.hpp>
 
 // GLFW
 #ifdef JOP_OS_DESKTOP
@@ -122,6 +123,8 @@
 #include <Jopnal/Audio/AudioReader.hpp>
 #include <Jopnal/Window/SensorManager.hpp>
 #include <Jopnal/Window/InputEnumsImpl.hpp>
-#include <Jopnal/Graphics/Culling/CullerComponent.hpp>
+#include <Jopnal/Graphics/Culling/CullingTree.hpp>
+#include <Jopnal/Core/Hierarchy/ObjectIndex.hpp>
+#include <Jopnal/Core/Hierarchy/TransformStore.hpp>
 
 #endif
\ No newline at end of file
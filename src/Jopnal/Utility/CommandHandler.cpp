@@ -34,26 +34,24 @@
 //////////////////////////////////////////////
 
 
-namespace
+namespace jop
 {
-    void handleCommand(const std::string& orig, std::string& command, std::string& args)
-    {
-        std::size_t commandStart = orig.find_first_not_of("     \r\n");
-        std::size_t commandEnd = orig.find_first_of("     \r\n", commandStart);
-        std::size_t commandLen = (commandStart != std::string::npos) ? ((commandEnd == std::string::npos ? orig.length() : commandEnd) - commandStart) : 0;
+    CommandHandler::CommandHandler()
+        : m_commands    (),
+          m_receivers   (Message::Global)
+    {}
 
-        std::size_t argStart = std::min(commandStart + commandLen + 1, orig.length());
-        std::size_t argEnd = orig.find_last_not_of("     \r\n");
-        std::size_t argLen = std::max(argStart, argEnd) - argStart + 1;
+    //////////////////////////////////////////////
 
-        // Values
-        command = (commandLen > 0) ? orig.substr(commandStart, commandLen) : "";
-        args = (commandLen > 0) ? orig.substr(argStart, argLen) : "";
+    void CommandHandler::setReceivers(const unsigned short receivers)
+    {
+        JOP_ASSERT(m_commands.empty(), "Command handler receivers must be set before binding any commands!");
+
+        m_receivers = receivers;
     }
-}
 
-namespace jop
-{
+    //////////////////////////////////////////////
+
     std::tuple<std::string, std::string> detail::splitFirstArguments(const std::string& args)
     {
         std::size_t pos1 = 0, pos2 = 0, pos3;
@@ -100,30 +98,47 @@ namespace jop
 
     //////////////////////////////////////////////
 
-    Message::Result CommandHandler::execute(const std::string& command, void* instance)
+    Message::Result CommandHandler::execute(const Message& message, void* instance)
     {
-        std::string comm, args;
-        handleCommand(command, comm, args);
+        const uint32 id = message.getCommandID();
 
+        if (id >= m_commands.size())
+            return Message::Result::Continue;
+
+        auto& entry = m_commands[id];
+
+        if (entry.func)
         {
-            auto itr = m_funcParsers.find(comm);
-            if (itr != m_funcParsers.end())
-            {
-                itr->second.first(args);
-                return itr->second.second;
-            }
+            entry.func(message);
+            return entry.funcResult;
         }
 
-        if (instance)
+        if (instance && entry.member)
         {
-            auto itr = m_memberParsers.find(comm);
-            if (itr != m_memberParsers.end())
-            {
-                itr->second.first(args, instance);
-                itr->second.second;
-            }
+            entry.member(message, instance);
+            return entry.memberResult;
         }
 
         return Message::Result::Continue;
     }
+
+    //////////////////////////////////////////////
+
+    Message::Result CommandHandler::execute(const std::string& command, void* instance)
+    {
+        return execute(Message(command), instance);
+    }
+
+    //////////////////////////////////////////////
+
+    CommandHandler::Entry& CommandHandler::getEntry(const std::string& command)
+    {
+        const uint32 id = Message::internCommand(command);
+        Message::addCommandReceivers(id, m_receivers);
+
+        if (id >= m_commands.size())
+            m_commands.resize(id + 1, Entry{nullptr, nullptr, Message::Result::Continue, Message::Result::Continue});
+
+        return m_commands[id];
+    }
 }
\ No newline at end of file
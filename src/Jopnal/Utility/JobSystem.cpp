@@ -0,0 +1,261 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+// Headers
+#include JOP_PRECOMPILED_HEADER_FILE
+
+#ifndef JOP_PRECOMPILED_HEADER
+
+    #include <Jopnal/Utility/JobSystem.hpp>
+
+    #include <Jopnal/Core/SettingManager.hpp>
+    #include <algorithm>
+
+#endif
+
+//////////////////////////////////////////////
+
+
+namespace
+{
+    // The job system the calling thread is a worker of, and the index of its queue
+    thread_local const jop::JobSystem* ns_owner = nullptr;
+    thread_local jop::uint32 ns_queueIndex = 0;
+}
+
+namespace jop
+{
+    JobSystem::Counter::Counter()
+        : m_pending(0)
+    {}
+
+    //////////////////////////////////////////////
+
+    bool JobSystem::Counter::isDone() const
+    {
+        return m_pending.load() == 0;
+    }
+
+    //////////////////////////////////////////////
+
+    JobSystem::JobSystem(const uint32 workers)
+        : m_queues          (),
+          m_threads         (),
+          m_sleepMutex      (),
+          m_sleepCondition  (),
+          m_queued          (0),
+          m_exit            (false)
+    {
+        m_queues.reserve(workers + 1);
+
+        for (uint32 i = 0; i < workers + 1; ++i)
+            m_queues.emplace_back(std::make_unique<Queue>());
+
+        m_threads.reserve(workers);
+
+        for (uint32 i = 0; i < workers; ++i)
+            m_threads.emplace_back(&JobSystem::workerLoop, this, i + 1);
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            m_exit.store(true);
+        }
+
+        m_sleepCondition.notify_all();
+
+        // Thread destructors join
+        m_threads.clear();
+    }
+
+    //////////////////////////////////////////////
+
+    void JobSystem::run(Job job, Counter& counter)
+    {
+        ++counter.m_pending;
+
+        Task task;
+        task.job = std::move(job);
+        task.counter = &counter;
+
+        push(std::move(task));
+    }
+
+    //////////////////////////////////////////////
+
+    void JobSystem::wait(const Counter& counter)
+    {
+        const uint32 index = getQueueIndex();
+
+        while (!counter.isDone())
+        {
+            if (!runOne(index))
+                std::this_thread::yield();
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    void JobSystem::parallelFor(const uint32 count, const uint32 batchSize, const RangeJob& job)
+    {
+        const uint32 batch = std::max(1u, batchSize);
+
+        // Not worth the scheduling overhead
+        if (count <= batch || m_threads.empty())
+        {
+            if (count > 0)
+                job(0, count);
+
+            return;
+        }
+
+        Counter counter;
+
+        for (uint32 begin = 0; begin < count; begin += batch)
+        {
+            const uint32 end = std::min(count, begin + batch);
+            run([&job, begin, end]() { job(begin, end); }, counter);
+        }
+
+        wait(counter);
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 JobSystem::getWorkerCount() const
+    {
+        return static_cast<uint32>(m_threads.size());
+    }
+
+    //////////////////////////////////////////////
+
+    JobSystem& JobSystem::getDefault()
+    {
+        static JobSystem system([]() -> uint32
+        {
+            const uint32 workers = SettingManager::get<unsigned int>("engine@Threading|uWorkerThreads", 0);
+
+            if (workers > 0)
+                return workers;
+
+            const uint32 hardware = std::thread::hardware_concurrency();
+            return hardware > 1 ? hardware - 1 : 0;
+        }());
+
+        return system;
+    }
+
+    //////////////////////////////////////////////
+
+    void JobSystem::push(Task task)
+    {
+        auto& queue = *m_queues[getQueueIndex()];
+
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.emplace_back(std::move(task));
+        }
+
+        ++m_queued;
+
+        // Taking the lock makes sure a worker can't miss the notification
+        // between checking the queue count and going to sleep
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+
+        m_sleepCondition.notify_one();
+    }
+
+    //////////////////////////////////////////////
+
+    bool JobSystem::runOne(const uint32 index)
+    {
+        Task task;
+        bool found = false;
+
+        // Own queue first, newest job first for cache locality
+        {
+            auto& queue = *m_queues[index];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+
+            if (!queue.tasks.empty())
+            {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+                found = true;
+            }
+        }
+
+        // Steal the oldest job from someone else
+        for (std::size_t i = 1; !found && i < m_queues.size(); ++i)
+        {
+            auto& queue = *m_queues[(index + i) % m_queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+
+            if (!queue.tasks.empty())
+            {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                found = true;
+            }
+        }
+
+        if (!found)
+            return false;
+
+        --m_queued;
+
+        task.job();
+        --task.counter->m_pending;
+
+        return true;
+    }
+
+    //////////////////////////////////////////////
+
+    void JobSystem::workerLoop(const uint32 index)
+    {
+        ns_owner = this;
+        ns_queueIndex = index;
+
+        while (!m_exit.load())
+        {
+            if (runOne(index))
+                continue;
+
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_sleepCondition.wait(lock, [this]()
+            {
+                return m_exit.load() || m_queued.load() > 0;
+            });
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 JobSystem::getQueueIndex() const
+    {
+        return ns_owner == this ? ns_queueIndex : 0;
+    }
+}
\ No newline at end of file
@@ -27,17 +27,49 @@
     #include <Jopnal/Utility/Message.hpp>
 
     #include <Jopnal/Core/DebugHandler.hpp>
+    #include <mutex>
+    #include <unordered_map>
+    #include <vector>
 
 #endif
 
 //////////////////////////////////////////////
 
 
+namespace
+{
+    // Commands are interned during static initialization, when the
+    // command handlers are registered
+    std::mutex& getCommandMutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    std::unordered_map<std::string, jop::uint32>& getCommandIDs()
+    {
+        static std::unordered_map<std::string, jop::uint32> ids;
+        return ids;
+    }
+
+    // Filter bits of the receivers that have bound each command, indexed by the command identifier
+    std::vector<unsigned short>& getCommandReceiverBits()
+    {
+        static std::vector<unsigned short> receivers;
+        return receivers;
+    }
+}
+
 namespace jop
 {
     Message::Message(const std::string& message)
         : m_command         (),
           m_commandStr      (),
+          m_arguments       (),
+          m_commandID       (0),
+          m_commandParsed   (false),
+          m_parsedType      (nullptr),
+          m_parsedArguments (),
           m_idPattern       (),
           m_filterBits      (Filter::Global),
           m_idMatchMethod   (nullptr),
@@ -91,6 +123,22 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    uint32 Message::getCommandID() const
+    {
+        parseCommand();
+        return m_commandID;
+    }
+
+    //////////////////////////////////////////////
+
+    const std::string& Message::getArguments() const
+    {
+        parseCommand();
+        return m_arguments;
+    }
+
+    //////////////////////////////////////////////
+
     bool Message::passFilter(const unsigned short filter) const
     {
         return (m_filterBits & filter) != 0;
@@ -234,4 +282,80 @@ namespace jop
     {
         return m_command.rdbuf()->in_avail() > 0;
     }
+
+    //////////////////////////////////////////////
+
+    uint32 Message::internCommand(const std::string& command)
+    {
+        if (command.empty())
+            return 0;
+
+        std::lock_guard<std::mutex> lock(getCommandMutex());
+
+        auto& ids = getCommandIDs();
+        return ids.emplace(command, static_cast<uint32>(ids.size() + 1)).first->second;
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 Message::findCommand(const std::string& command)
+    {
+        if (command.empty())
+            return 0;
+
+        std::lock_guard<std::mutex> lock(getCommandMutex());
+
+        auto& ids = getCommandIDs();
+        auto itr = ids.find(command);
+
+        return itr != ids.end() ? itr->second : 0;
+    }
+
+    //////////////////////////////////////////////
+
+    void Message::addCommandReceivers(const uint32 id, const unsigned short receivers)
+    {
+        std::lock_guard<std::mutex> lock(getCommandMutex());
+
+        auto& bits = getCommandReceiverBits();
+
+        if (id >= bits.size())
+            bits.resize(id + 1, 0);
+
+        bits[id] |= receivers;
+    }
+
+    //////////////////////////////////////////////
+
+    unsigned short Message::getCommandReceivers(const uint32 id)
+    {
+        std::lock_guard<std::mutex> lock(getCommandMutex());
+
+        auto& bits = getCommandReceiverBits();
+
+        return id < bits.size() ? bits[id] : 0;
+    }
+
+    //////////////////////////////////////////////
+
+    void Message::parseCommand() const
+    {
+        if (m_commandParsed)
+            return;
+
+        const std::string& str = getString();
+
+        std::size_t commandStart = str.find_first_not_of(" \t\r\n");
+        std::size_t commandEnd = str.find_first_of(" \t\r\n", commandStart);
+        std::size_t commandLen = (commandStart != std::string::npos) ? ((commandEnd == std::string::npos ? str.length() : commandEnd) - commandStart) : 0;
+
+        std::size_t argStart = std::min(commandStart + commandLen + 1, str.length());
+        std::size_t argEnd = str.find_last_not_of(" \t\r\n");
+        std::size_t argLen = std::max(argStart, argEnd) - argStart + 1;
+
+        // Unknown commands have no handlers, so there's no need to intern them
+        m_commandID = commandLen > 0 ? findCommand(str.substr(commandStart, commandLen)) : 0;
+        m_arguments = commandLen > 0 ? str.substr(argStart, argLen) : "";
+        m_commandParsed = true;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,94 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+// Headers
+#include JOP_PRECOMPILED_HEADER_FILE
+
+#ifndef JOP_PRECOMPILED_HEADER
+
+    #include <Jopnal/Utility/SafeReferenceable.hpp>
+
+    #include <mutex>
+
+#endif
+
+//////////////////////////////////////////////
+
+
+namespace
+{
+    std::mutex& getTableMutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    jop::uint32 ns_slotCount = 0;
+    jop::uint32 ns_freeHead = jop::detail::ReferenceTable::NullSlot;
+}
+
+namespace jop { namespace detail
+{
+    ReferenceTable::Slot* ReferenceTable::m_pages[ReferenceTable::MaxPages] = {};
+
+    //////////////////////////////////////////////
+
+    uint32 ReferenceTable::allocate(void* object)
+    {
+        std::lock_guard<std::mutex> lock(getTableMutex());
+
+        uint32 slot = ns_freeHead;
+
+        if (slot != NullSlot)
+            ns_freeHead = getSlot(slot).nextFree;
+        else
+        {
+            slot = ns_slotCount++;
+
+            const uint32 page = slot >> PageBits;
+            JOP_ASSERT(page < MaxPages, "Too many referenceable objects!");
+
+            // Pages are only ever added, so readers never see a slot move
+            if (!m_pages[page])
+                m_pages[page] = new Slot[1 << PageBits]();
+        }
+
+        auto& s = getSlot(slot);
+        s.object = object;
+        s.nextFree = NullSlot;
+
+        return slot;
+    }
+
+    //////////////////////////////////////////////
+
+    void ReferenceTable::release(const uint32 slot)
+    {
+        std::lock_guard<std::mutex> lock(getTableMutex());
+
+        auto& s = getSlot(slot);
+        s.object = nullptr;
+        ++s.generation;
+        s.nextFree = ns_freeHead;
+
+        ns_freeHead = slot;
+    }
+}}
\ No newline at end of file
@@ -32,6 +32,7 @@
     #include <Jopnal/Core/Android/ActivityState.hpp>
     #include <Jopnal/Graphics/OpenGL/GlCheck.hpp>
     #include <Jopnal/Graphics/OpenGL/GlState.hpp>
+    #include <Jopnal/Graphics/OpenGL/GpuTimer.hpp>
     #include <Jopnal/Graphics/OpenGL/OpenGL.hpp>
     #include <Jopnal/Graphics/RenderTexture.hpp>
     #include <Jopnal/Utility/CommandHandler.hpp>
@@ -62,6 +63,8 @@ namespace jop
 {
     JOP_REGISTER_COMMAND_HANDLER(Window)
 
+        JOP_COMMAND_RECEIVERS(Message::Subsystem);
+
         JOP_BIND_MEMBER_COMMAND(&Window::setMouseMode, "setMouseMode");
 
     JOP_END_COMMAND_HANDLER(Window)
@@ -135,6 +138,8 @@ namespace jop
 
             #endif
             }
+
+            GlState::endFrame();
         }
     }
 
@@ -241,7 +246,12 @@ namespace jop
     }
 
     Window::~Window()
-    {}
+    {
+    #ifdef JOP_ENABLE_PROFILING
+        // The context is destroyed along with the implementation
+        detail::GpuTimer::destroy();
+    #endif
+    }
 
     //////////////////////////////////////////////
 
@@ -305,6 +315,8 @@ namespace jop
         m_impl = std::make_unique<detail::WindowImpl>(settings, *this);
         auto s = getSize();
 
+        GlState::setContextThread();
+
         static const Color defColor(SettingManager::get<std::string>("engine@DefaultWindow|sClearColor", "000000FF"));
         setClearColor(defColor);
 
@@ -313,7 +325,7 @@ namespace jop
         if (gl::getVersionMajor() >= 3)
         {
             glCheck(glGenVertexArrays(1, &m_vertexArray));
-            glCheck(glBindVertexArray(m_vertexArray));
+            GlState::setDefaultVertexArray(m_vertexArray);
         }
 
     #endif
@@ -328,12 +340,14 @@ namespace jop
     void Window::close()
     {
         std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+        GlState::deleteDeferred();
         
     #if !defined(JOP_OPENGL_ES) || defined(JOP_OPENGL_ES3)
 
         if (gl::getVersionMajor() >= 3)
         {
-            glCheck(glBindVertexArray(0));
+            GlState::setDefaultVertexArray(0);
             glCheck(glDeleteVertexArrays(1, &m_vertexArray));
         }
 
@@ -465,7 +479,7 @@ namespace jop
 
     Message::Result Window::receiveMessage(const Message& message)
     {
-        if (JOP_EXECUTE_COMMAND(Window, message.getString(), this) == Message::Result::Escape)
+        if (JOP_EXECUTE_COMMAND(Window, message, this) == Message::Result::Escape)
             return Message::Result::Escape;
 
         return Subsystem::receiveMessage(message);
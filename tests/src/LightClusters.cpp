@@ -0,0 +1,139 @@
+// Light cluster binning test
+//
+// Bins a handful of lights with known positions and radii into a small grid
+// and checks that every cluster contains exactly the lights it should.
+// ClusterGrid doesn't need an OpenGL context or a running engine.
+
+#include <Jopnal/Graphics/LightClusters.hpp>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    int ns_failures = 0;
+
+    void check(const bool condition, const char* what)
+    {
+        if (!condition)
+        {
+            std::cerr << "FAILED: " << what << std::endl;
+            ++ns_failures;
+        }
+    }
+
+    // Inclusive range of clusters a light is expected to touch
+    struct Expected
+    {
+        glm::uvec3 min;
+        glm::uvec3 max;
+    };
+
+    bool contains(const Expected& e, const glm::uvec3& c)
+    {
+        return glm::all(glm::greaterThanEqual(c, e.min)) && glm::all(glm::lessThanEqual(c, e.max));
+    }
+}
+
+int main()
+{
+    using namespace jop;
+
+    // 4x4 tiles, 4 logarithmic slices between 1 and 100. The slice borders
+    // are at depths 1, 3.16, 10, 31.6 and 100
+    ClusterGrid grid(glm::uvec3(4, 4, 4));
+
+    const float nearPlane = 1.f;
+    const float farPlane = 100.f;
+    const glm::mat4 proj = glm::perspective(glm::half_pi<float>(), 1.f, nearPlane, farPlane);
+
+    // View space, the camera looks towards -z. With a 90 degree field of view
+    // NDC x = x / depth
+    const std::vector<glm::vec4> spheres =
+    {
+        glm::vec4(0.f, 0.f, -5.f, 1.f),     // 0: Centered, NDC [-0.25, 0.25], depth [4, 6]
+        glm::vec4(0.f, 0.f, 5.f, 1.f),      // 1: Behind the camera
+        glm::vec4(0.f, 0.f, -200.f, 1.f),   // 2: Beyond the far plane
+        glm::vec4(0.f, 0.f, -1.5f, 1.f),    // 3: Crosses the near plane, covers the whole screen
+        glm::vec4(4.2f, 0.f, -5.f, 1.f),    // 4: Right edge, NDC x [0.53, 1.3]
+        glm::vec4(20.f, 0.f, -5.f, 1.f),    // 5: Outside the frustum
+        glm::vec4(0.f, 0.f, -30.f, 8.f)     // 6: Spans two slices, depth [22, 38]
+    };
+
+    const std::vector<std::pair<uint32, Expected>> expected =
+    {
+        {0, {glm::uvec3(1, 1, 1), glm::uvec3(2, 2, 1)}},
+        {3, {glm::uvec3(0, 0, 0), glm::uvec3(3, 3, 0)}},
+        {4, {glm::uvec3(3, 1, 1), glm::uvec3(3, 2, 1)}},
+        {6, {glm::uvec3(1, 1, 2), glm::uvec3(2, 2, 3)}}
+    };
+
+    // Run twice to make sure the previous results don't leak into the next binning
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        grid.bin(spheres, proj, nearPlane, farPlane);
+
+        const auto& dims = grid.getDimensions();
+        const auto& cells = grid.getCells();
+        const auto& indices = grid.getIndices();
+
+        check(dims == glm::uvec3(4, 4, 4), "grid dimensions");
+        check(cells.size() == 4 * 4 * 4, "cell count");
+
+        std::size_t total = 0;
+
+        for (uint32 z = 0; z < dims.z; ++z)
+        {
+            for (uint32 y = 0; y < dims.y; ++y)
+            {
+                for (uint32 x = 0; x < dims.x; ++x)
+                {
+                    const glm::uvec3 c(x, y, z);
+                    const auto& cell = cells[grid.getClusterIndex(c)];
+
+                    std::vector<uint32> actual(indices.begin() + cell.x, indices.begin() + cell.x + cell.y);
+                    std::vector<uint32> wanted;
+
+                    for (auto& e : expected)
+                    {
+                        if (contains(e.second, c))
+                            wanted.push_back(e.first);
+                    }
+
+                    std::sort(actual.begin(), actual.end());
+
+                    if (actual != wanted)
+                    {
+                        std::cerr << "Cluster (" << x << ", " << y << ", " << z << ") has " << actual.size()
+                                  << " lights, expected " << wanted.size() << std::endl;
+
+                        check(false, "cluster membership");
+                    }
+
+                    total += cell.y;
+                }
+            }
+        }
+
+        check(total == indices.size(), "index list size");
+    }
+
+    // Orthographic projections use linear slices
+    ClusterGrid ortho(glm::uvec3(2, 2, 2));
+    ortho.bin({glm::vec4(-2.f, 2.f, -75.f, 1.f)}, glm::ortho(-5.f, 5.f, -5.f, 5.f, 0.f, 100.f), 0.f, 100.f);
+
+    check(ortho.getDepthParameters().z == 0.f, "linear slices");
+    check(ortho.getCells()[ortho.getClusterIndex(glm::uvec3(0, 1, 1))].y == 1, "orthographic membership");
+    check(ortho.getIndices().size() == 1, "orthographic index list size");
+
+    if (ns_failures)
+    {
+        std::cerr << ns_failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+// Render target pool test
+//
+// Acquires and releases pooled targets over a few frames and checks that
+// endFrame() destroys only the targets idle for too long. The kept ones are
+// compacted to the front, so they must stay the same objects, still be
+// releasable and keep their share of the memory count. Creating the targets
+// needs an OpenGL context, so the test is skipped when there's no display to
+// open a window on.
+
+#include <Jopnal/Jopnal.hpp>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+    int ns_failures = 0;
+
+    // Returned when the test can't run, see tests/CMakeLists.txt
+    const int ns_skipped = 77;
+
+    void check(const bool condition, const char* what)
+    {
+        if (!condition)
+        {
+            std::cerr << "FAILED: " << what << std::endl;
+            ++ns_failures;
+        }
+    }
+
+    std::size_t memoryOf(const jop::RenderTexture& target)
+    {
+        auto tex = target.getTextureAttachment(jop::RenderTexture::Slot::Color0);
+
+        return tex ? tex->getMemoryUsage().gpu : 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace jop;
+
+#ifdef JOP_OS_LINUX
+
+    if (!std::getenv("DISPLAY") && !std::getenv("WAYLAND_DISPLAY"))
+    {
+        std::cout << "No display, skipped" << std::endl;
+        return ns_skipped;
+    }
+
+#endif
+
+    JOP_ENGINE_INIT("render_target_pool_test", argc, argv);
+
+    // The pool has to go before the engine closes the context
+    {
+        RenderTargetPool pool;
+
+        auto& first  = pool.acquire(glm::uvec2(64),  Texture::Format::RGBA_UB_8);
+        auto& second = pool.acquire(glm::uvec2(128), Texture::Format::RGBA_UB_8);
+        auto& third  = pool.acquire(glm::uvec2(64),  Texture::Format::RGB_UB_8);
+
+        check(pool.getTargetCount() == 3 && pool.getCreationCount() == 3, "three targets created");
+        check(memoryOf(first) > 0 && pool.getMemoryUsage() == memoryOf(first) + memoryOf(second) + memoryOf(third), "memory of all targets counted");
+
+        pool.release(first);
+        pool.release(second);
+
+        // Released once, not yet over the limit
+        pool.endFrame(1);
+        check(pool.getTargetCount() == 3, "targets idle for one frame are kept");
+
+        // Same size and format as a released target
+        check(&pool.acquire(glm::uvec2(128), Texture::Format::RGBA_UB_8) == &second, "released target is reused");
+        check(pool.getCreationCount() == 3, "reuse doesn't create a target");
+
+        // The first target is destroyed, the others move to the front
+        pool.endFrame(1);
+        check(pool.getTargetCount() == 2, "target idle for two frames is destroyed");
+        check(pool.getMemoryUsage() == memoryOf(second) + memoryOf(third), "destroyed target's memory is subtracted");
+        check(second.getSize() == glm::uvec2(128) && third.getSize() == glm::uvec2(64), "kept targets survive the compaction");
+
+        // Kept targets are still known to the pool
+        pool.release(second);
+        pool.release(third);
+
+        check(&pool.acquire(glm::uvec2(64), Texture::Format::RGB_UB_8) == &third, "kept target is reused after the compaction");
+        pool.release(third);
+
+        pool.endFrame(0);
+        check(pool.getTargetCount() == 0 && pool.getMemoryUsage() == 0, "all idle targets destroyed");
+    }
+
+    if (ns_failures)
+    {
+        std::cerr << ns_failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}
\ No newline at end of file
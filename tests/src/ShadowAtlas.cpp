@@ -0,0 +1,105 @@
+// Shadow atlas allocation test
+//
+// Allocates and releases tiles in a 1024 pixel quad tree and checks their
+// sizes, positions and that released space merges back into bigger tiles.
+// The tree is reset with a size instead of creating the texture, so no
+// OpenGL context is needed. The minimum tile size is 64.
+
+#include <Jopnal/Graphics/ShadowAtlas.hpp>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    int ns_failures = 0;
+
+    void check(const bool condition, const char* what)
+    {
+        if (!condition)
+        {
+            std::cerr << "FAILED: " << what << std::endl;
+            ++ns_failures;
+        }
+    }
+
+    bool overlaps(const jop::ShadowAtlas::Tile& a, const jop::ShadowAtlas::Tile& b)
+    {
+        return a.position.x < b.position.x + b.size && b.position.x < a.position.x + a.size &&
+               a.position.y < b.position.y + b.size && b.position.y < a.position.y + a.size;
+    }
+}
+
+int main()
+{
+    using namespace jop;
+
+    ShadowAtlas atlas;
+
+    check(!atlas.allocate(64).isValid(), "no tiles before a reset");
+
+    atlas.reset(1024, 64);
+    check(atlas.getSize() == 1024, "size after reset");
+
+    // The whole atlas
+    auto full = atlas.allocate(1024);
+    check(full.isValid() && full.size == 1024 && full.position == glm::uvec2(0), "full tile");
+    check(!atlas.allocate(64).isValid(), "no space left after the full tile");
+
+    atlas.release(full);
+
+    // Four quadrants fill the atlas without overlapping
+    std::vector<ShadowAtlas::Tile> quadrants;
+
+    for (int i = 0; i < 4; ++i)
+        quadrants.push_back(atlas.allocate(512));
+
+    check(std::all_of(quadrants.begin(), quadrants.end(), [](const ShadowAtlas::Tile& t){ return t.isValid() && t.size == 512; }), "four 512 tiles");
+    check(!atlas.allocate(512).isValid(), "no fifth 512 tile");
+
+    for (std::size_t i = 0; i < quadrants.size(); ++i)
+    {
+        for (std::size_t j = i + 1; j < quadrants.size(); ++j)
+            check(!overlaps(quadrants[i], quadrants[j]), "quadrants don't overlap");
+    }
+
+    // A released quadrant can be split into smaller tiles
+    atlas.release(quadrants[3]);
+
+    std::vector<ShadowAtlas::Tile> small;
+
+    for (int i = 0; i < 4; ++i)
+        small.push_back(atlas.allocate(256));
+
+    check(std::all_of(small.begin(), small.end(), [&quadrants](const ShadowAtlas::Tile& t){ return t.isValid() && !overlaps(t, quadrants[0]) && !overlaps(t, quadrants[1]) && !overlaps(t, quadrants[2]); }),
+          "256 tiles go into the released quadrant");
+    check(!atlas.allocate(256).isValid(), "no fifth 256 tile");
+
+    // Releasing everything merges the tree back into one tile
+    for (auto& t : small)
+        atlas.release(t);
+
+    for (int i = 0; i < 3; ++i)
+        atlas.release(quadrants[i]);
+
+    check(atlas.allocate(1024).isValid(), "released tiles merge back into the full atlas");
+
+    // Sizes are rounded up to a power of two and clamped to the minimum tile size
+    atlas.reset();
+
+    check(atlas.allocate(300).size == 512, "300 rounds up to 512");
+    check(atlas.allocate(1).size == 64, "1 rounds up to the minimum tile size");
+    check(!atlas.allocate(2048).isValid(), "no tile bigger than the free space");
+
+    atlas.reset(0, 64);
+    check(atlas.getSize() == 0 && !atlas.allocate(64).isValid(), "no tiles after a reset to zero");
+
+    if (ns_failures)
+    {
+        std::cerr << ns_failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}
\ No newline at end of file
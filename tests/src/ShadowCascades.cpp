@@ -0,0 +1,81 @@
+// Shadow cascade split test
+//
+// Checks the split distances of directional light cascades: the last one
+// ends at the shadow distance, they grow monotonically, unused cascades
+// stay at zero and the blend factor moves between the uniform and the
+// logarithmic split.
+
+#include <Jopnal/Graphics/LightSource.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+    int ns_failures = 0;
+
+    void check(const bool condition, const char* what)
+    {
+        if (!condition)
+        {
+            std::cerr << "FAILED: " << what << std::endl;
+            ++ns_failures;
+        }
+    }
+
+    bool closeTo(const float a, const float b)
+    {
+        return std::abs(a - b) <= 1e-3f * std::max(1.f, std::abs(b));
+    }
+}
+
+int main()
+{
+    using jop::LightSource;
+
+    const float clipNear = 0.5f;
+    const float distance = 100.f;
+
+    // A single cascade covers the whole range
+    const glm::vec4 single = LightSource::makeCascadeSplits(clipNear, distance, 0.75f, 1);
+    check(closeTo(single.x, distance) && single.y == 0.f && single.z == 0.f && single.w == 0.f, "single cascade ends at the shadow distance");
+
+    // Every blend ends at the shadow distance and grows monotonically
+    for (const float lambda : {0.f, 0.5f, 0.75f, 1.f})
+    {
+        const glm::vec4 splits = LightSource::makeCascadeSplits(clipNear, distance, lambda, 4);
+
+        check(closeTo(splits.w, distance), "last cascade ends at the shadow distance");
+        check(clipNear < splits.x && splits.x < splits.y && splits.y < splits.z && splits.z < splits.w, "splits grow monotonically");
+    }
+
+    // Unused cascades are left at zero
+    const glm::vec4 two = LightSource::makeCascadeSplits(clipNear, distance, 0.75f, 2);
+    check(closeTo(two.y, distance) && two.z == 0.f && two.w == 0.f, "unused cascades are zero");
+
+    // Zero blends to a uniform split
+    const glm::vec4 uniform = LightSource::makeCascadeSplits(clipNear, distance, 0.f, 4);
+    const float step = (distance - clipNear) / 4.f;
+    check(closeTo(uniform.x, clipNear + step) && closeTo(uniform.y, clipNear + step * 2.f) && closeTo(uniform.z, clipNear + step * 3.f), "uniform split");
+
+    // One blends to a logarithmic split, each cascade is the same ratio further away
+    const glm::vec4 logarithmic = LightSource::makeCascadeSplits(clipNear, distance, 1.f, 4);
+    const float ratio = std::pow(distance / clipNear, 0.25f);
+    check(closeTo(logarithmic.x, clipNear * ratio) && closeTo(logarithmic.y / logarithmic.x, ratio) && closeTo(logarithmic.z / logarithmic.y, ratio), "logarithmic split");
+
+    // The logarithmic split keeps the near cascades tighter
+    check(logarithmic.x < uniform.x, "logarithmic split is tighter near the camera");
+
+    // More cascades than supported are clamped
+    const glm::vec4 many = LightSource::makeCascadeSplits(clipNear, distance, 0.75f, 8);
+    check(closeTo(many.w, distance), "cascade count is clamped");
+
+    if (ns_failures)
+    {
+        std::cerr << ns_failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}
\ No newline at end of file
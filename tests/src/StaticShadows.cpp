@@ -0,0 +1,113 @@
+// Static shadow layer test
+//
+// Draws a scene whose only shadow caster is static, then checks that its depth
+// ends up in the shadow atlas. Static casters are drawn into a separate layer
+// and blitted into the atlas, so an atlas left at the clear depth means the
+// blit went elsewhere. This needs a window, so the test is skipped when there's
+// no display to open one on.
+
+#include <Jopnal/Jopnal.hpp>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+    int ns_failures = 0;
+
+    // Returned when the test can't run, see tests/CMakeLists.txt
+    const int ns_skipped = 77;
+
+    void check(const bool condition, const char* what)
+    {
+        if (!condition)
+        {
+            std::cerr << "FAILED: " << what << std::endl;
+            ++ns_failures;
+        }
+    }
+
+    class ShadowScene : public jop::Scene
+    {
+    public:
+
+        ShadowScene()
+            : jop::Scene("ShadowScene"),
+              m_frames  (0)
+        {
+            using namespace jop;
+
+            auto cam = createChild("cam");
+            cam->setPosition(0.f, 5.f, 10.f).lookAt(0.f, 0.f, 0.f);
+            cam->createComponent<Camera>(getRenderer(), Camera::Projection::Perspective);
+
+            // Looks straight down, the scale is the size of the shadow volume
+            auto light = createChild("light");
+            light->setPosition(0.f, 10.f, 0.f).setRotation(-glm::half_pi<float>(), 0.f, 0.f).setScale(20.f, 20.f, 40.f);
+            light->createComponent<LightSource>(getRenderer(), LightSource::Type::Directional).setCastShadows(true).setShadowCascades(1);
+
+            auto& drawable = createChild("caster")->createComponent<Drawable>(getRenderer());
+            drawable.setMesh(ResourceManager::getNamed<BoxMesh>("static_shadow_test_box", glm::vec3(2.f)));
+            drawable.setFlags(Drawable::ReceiveLights | Drawable::ReceiveShadows | Drawable::CastShadows | Drawable::StaticShadows);
+        }
+
+        void postUpdate(const float) override
+        {
+            // Gives the renderer a couple of frames to draw the shadow map
+            if (++m_frames < 3)
+                return;
+
+            auto texture = dynamic_cast<const jop::Texture2D*>(getRenderer().getShadowAtlas().getTexture());
+            check(texture != nullptr, "The shadow atlas has a texture");
+
+            if (texture)
+            {
+                // Cleared texels are all ones, in both the depth and the packed formats
+                const auto image = texture->getImage();
+                const auto pixels = image.getPixels();
+                const std::size_t bytes = image.getSize().x * image.getSize().y * image.getPixelDepth();
+
+                bool written = false;
+
+                for (std::size_t i = 0; i < bytes && !written; ++i)
+                    written = pixels[i] != 0xFF;
+
+                check(written, "A static-only scene writes its shadows into the atlas");
+            }
+
+            jop::Engine::exit();
+        }
+
+    private:
+
+        unsigned int m_frames;
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace jop;
+
+#ifdef JOP_OS_LINUX
+
+    if (!std::getenv("DISPLAY") && !std::getenv("WAYLAND_DISPLAY"))
+    {
+        std::cout << "No display, skipped" << std::endl;
+        return ns_skipped;
+    }
+
+#endif
+
+    JOP_ENGINE_INIT("static_shadows_test", argc, argv);
+
+    Engine::createScene<ShadowScene>();
+    JOP_MAIN_LOOP;
+
+    if (ns_failures)
+    {
+        std::cerr << ns_failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}
\ No newline at end of file
@@ -5275,7 +5275,7 @@ const unsigned char defaultShaderVert[466] =
 115,105,116,105,111,110,44,32,49,46,48,41,59,13,10,125,
 };
 
-const unsigned char defaultUberShaderFrag[6147] =
+const unsigned char defaultUberShaderFrag[6635] =
 {
 47,47,32,74,79,80,78,65,76,32,68,69,70,65,85,76,84,32,70,82,65,71,77,69,78,84,32,85,66,69,82,83,72,65,68,69,82,13,10,47,47,13,10,47,47,32,74,111,112,110,
 97,108,32,108,105,99,101,110,115,101,32,97,112,112,108,105,101,115,13,10,13,10,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,
@@ -5299,110 +5299,120 @@ const unsigned char defaultUberShaderFrag[6147] =
 35,105,110,99,108,117,100,101,32,60,74,111,112,110,97,108,47,68,101,102,97,117,108,116,76,105,103,104,116,105,110,103,47,85,110,105,102,111,114,109,115,62,13,10,13,10,32,32,32,32,
 35,105,102,100,101,102,32,74,77,65,84,95,80,72,79,78,71,13,10,13,10,32,32,32,32,32,32,32,32,35,105,110,99,108,117,100,101,32,60,74,111,112,110,97,108,47,68,101,102,97,
 117,108,116,76,105,103,104,116,105,110,103,47,83,104,97,100,111,119,115,62,13,10,32,32,32,32,32,32,32,32,35,105,110,99,108,117,100,101,32,60,74,111,112,110,97,108,47,68,101,102,
-97,117,108,116,76,105,103,104,116,105,110,103,47,76,105,103,104,116,105,110,103,62,13,10,13,10,32,32,32,32,35,101,108,115,101,13,10,13,10,32,32,32,32,32,32,32,32,35,105,102,
-100,101,102,32,74,77,65,84,95,70,76,65,84,13,10,32,32,32,32,32,32,32,32,32,32,32,32,74,79,80,95,70,76,65,84,13,10,32,32,32,32,32,32,32,32,35,101,110,100,105,
-102,13,10,32,32,32,32,32,32,32,32,74,79,80,95,86,65,82,89,73,78,71,95,73,78,32,118,101,99,51,32,118,102,95,65,109,98,68,105,102,102,76,105,103,104,116,59,13,10,13,
-10,32,32,32,32,32,32,32,32,35,105,102,100,101,102,32,74,77,65,84,95,70,76,65,84,13,10,32,32,32,32,32,32,32,32,32,32,32,32,74,79,80,95,70,76,65,84,13,10,32,
-32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,32,32,32,32,74,79,80,95,86,65,82,89,73,78,71,95,73,78,32,118,101,99,51,32,118,102,95,83,112,101,99,
-76,105,103,104,116,59,13,10,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,35,101,110,100,105,102,13,10,13,10,47,47,32,70,105,110,97,108,32,102,114,97,103,109,101,110,
-116,32,99,111,108,111,114,13,10,74,79,80,95,67,79,76,79,82,95,79,85,84,40,48,41,13,10,13,10,118,111,105,100,32,109,97,105,110,40,41,32,13,10,123,13,10,35,105,102,100,
-101,102,32,74,68,82,87,95,83,75,89,66,79,88,13,10,32,32,32,32,74,79,80,95,70,82,65,71,95,67,79,76,79,82,40,48,41,32,61,32,74,79,80,95,84,69,88,84,85,82,
-69,95,67,85,66,69,40,117,95,69,110,118,105,114,111,110,109,101,110,116,77,97,112,44,32,118,102,95,80,111,115,105,116,105,111,110,41,32,42,32,118,102,95,67,111,108,111,114,59,13,
-10,35,101,108,115,101,13,10,13,10,32,32,32,32,47,47,32,65,115,115,105,103,110,32,116,104,101,32,105,110,105,116,105,97,108,32,99,111,108,111,114,13,10,32,32,32,32,118,101,99,
-52,32,116,101,109,112,67,111,108,111,114,32,61,32,118,102,95,67,111,108,111,114,13,10,13,10,32,32,32,32,35,105,102,100,101,102,32,74,77,65,84,95,68,73,70,70,85,83,69,77,
-65,80,13,10,32,32,32,32,32,32,32,32,42,32,74,79,80,95,84,69,88,84,85,82,69,95,50,68,40,117,95,68,105,102,102,117,115,101,77,97,112,44,32,118,102,95,84,101,120,67,
-111,111,114,100,115,41,13,10,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,59,13,10,13,10,32,32,32,32,35,105,102,100,101,102,32,74,77,65,84,95,69,78,86,73,82,
-79,78,77,69,78,84,77,65,80,13,10,13,10,32,32,32,32,32,32,32,32,118,101,99,51,32,114,101,102,108,32,61,32,118,101,99,51,40,74,79,80,95,84,69,88,84,85,82,69,95,
-67,85,66,69,40,117,95,69,110,118,105,114,111,110,109,101,110,116,77,97,112,44,32,114,101,102,108,101,99,116,40,110,111,114,109,97,108,105,122,101,40,118,102,95,80,111,115,105,116,105,
-111,110,41,44,32,118,102,95,78,111,114,109,97,108,41,41,41,13,10,13,10,32,32,32,32,32,32,32,32,35,105,102,100,101,102,32,74,77,65,84,95,82,69,70,76,69,67,84,73,79,
-78,77,65,80,13,10,32,32,32,32,32,32,32,32,32,32,32,32,42,32,74,79,80,95,84,69,88,84,85,82,69,95,50,68,40,117,95,82,101,102,108,101,99,116,105,111,110,77,97,112,
-44,32,118,102,95,84,101,120,67,111,111,114,100,115,41,46,97,13,10,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,32,32,32,32,35,105,102,100,101,102,32,
-74,77,65,84,95,76,73,71,72,84,73,78,71,13,10,32,32,32,32,32,32,32,32,32,32,32,32,42,32,117,95,77,97,116,101,114,105,97,108,46,114,101,102,108,101,99,116,105,118,105,
-116,121,13,10,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,32,32,32,32,59,13,10,13,10,32,32,32,32,32,32,32,32,116,101,109,112,67,111,108,111,114,
-32,43,61,32,118,101,99,52,40,114,101,102,108,44,32,48,46,48,41,59,13,10,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,47,47,32,68,111,32,108,105,
-103,104,116,105,110,103,32,99,97,108,99,117,108,97,116,105,111,110,115,13,10,32,32,32,32,35,105,102,100,101,102,32,74,77,65,84,95,76,73,71,72,84,73,78,71,13,10,13,10,32,
-32,32,32,32,32,32,32,118,101,99,51,32,116,101,109,112,76,105,103,104,116,91,51,93,59,13,10,13,10,32,32,32,32,32,32,32,32,35,105,102,100,101,102,32,74,77,65,84,95,80,
-72,79,78,71,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,116,101,109,112,76,105,103,104,116,91,48,93,32,61,32,118,101,99,51,40,48,46,48,41,59,13,10,32,32,32,
-32,32,32,32,32,32,32,32,32,116,101,109,112,76,105,103,104,116,91,49,93,32,61,32,118,101,99,51,40,48,46,48,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,116,101,
-109,112,76,105,103,104,116,91,50,93,32,61,32,118,101,99,51,40,48,46,48,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,115,104,105,110,105,
-110,101,115,115,77,117,108,116,32,61,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,105,102,100,101,102,32,74,77,65,84,95,71,76,79,83,83,77,65,80,13,10,32,32,32,32,
-32,32,32,32,32,32,32,32,32,32,32,32,74,79,80,95,84,69,88,84,85,82,69,95,50,68,40,117,95,71,108,111,115,115,77,97,112,44,32,118,102,95,84,101,120,67,111,111,114,100,
-115,41,46,97,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,101,108,115,101,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,49,46,48,13,10,32,32,32,32,
-32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,32,32,32,32,32,32,32,32,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,105,102,32,40,117,
-95,82,101,99,101,105,118,101,76,105,103,104,116,115,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,101,
-99,51,32,108,105,103,104,116,91,51,93,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,105,102,32,74,77,65,84,95,77,65,88,95,80,79,73,78,84,95,76,73,71,
-72,84,83,32,62,32,48,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,80,111,105,110,116,32,108,105,103,104,116,115,13,10,32,32,32,32,32,32,
-32,32,32,32,32,32,32,32,32,32,102,111,114,32,40,105,110,116,32,105,32,61,32,48,59,32,105,32,60,32,74,79,80,95,80,79,73,78,84,95,76,73,77,73,84,59,32,43,43,105,
-41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,106,111,112,95,67,97,108,99,
-117,108,97,116,101,80,111,105,110,116,76,105,103,104,116,40,105,44,32,115,104,105,110,105,110,101,115,115,77,117,108,116,44,32,108,105,103,104,116,91,48,93,44,32,108,105,103,104,116,91,
-49,93,44,32,108,105,103,104,116,91,50,93,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,83,104,97,100,111,119,32,99,97,
-108,99,117,108,97,116,105,111,110,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,115,104,97,100,111,119,32,61,32,49,46,48,59,
-13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,102,32,40,117,95,80,111,105,110,116,76,105,103,104,116,115,91,105,93,46,99,97,115,116,83,104,97,
-100,111,119,32,38,38,32,117,95,82,101,99,101,105,118,101,83,104,97,100,111,119,115,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,
-115,104,97,100,111,119,32,45,61,32,106,111,112,95,67,97,108,99,117,108,97,116,101,80,111,105,110,116,83,104,97,100,111,119,40,117,95,80,111,105,110,116,76,105,103,104,116,115,91,105,
-93,46,112,111,115,105,116,105,111,110,32,45,32,118,102,95,80,111,115,105,116,105,111,110,44,32,117,95,80,111,105,110,116,76,105,103,104,116,115,91,105,93,46,102,97,114,80,108,97,110,
-101,44,32,117,95,80,111,105,110,116,76,105,103,104,116,83,104,97,100,111,119,77,97,112,115,91,105,93,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,
-32,32,32,32,116,101,109,112,76,105,103,104,116,91,48,93,32,43,61,32,108,105,103,104,116,91,48,93,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,
-32,116,101,109,112,76,105,103,104,116,91,49,93,32,43,61,32,108,105,103,104,116,91,49,93,32,42,32,115,104,97,100,111,119,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,
-32,32,32,32,32,32,32,116,101,109,112,76,105,103,104,116,91,50,93,32,43,61,32,108,105,103,104,116,91,50,93,32,42,32,115,104,97,100,111,119,59,13,10,32,32,32,32,32,32,32,
-32,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,32,32,32,32,32,32,32,32,13,10,32,32,
-32,32,32,32,32,32,32,32,32,32,35,105,102,32,74,77,65,84,95,77,65,88,95,68,73,82,69,67,84,73,79,78,65,76,95,76,73,71,72,84,83,32,62,32,48,13,10,13,10,32,
-32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,68,105,114,101,99,116,105,111,110,97,108,32,108,105,103,104,116,115,13,10,32,32,32,32,32,32,32,32,32,32,32,32,
-32,32,32,32,102,111,114,32,40,105,110,116,32,105,32,61,32,48,59,32,105,32,60,32,74,79,80,95,68,73,82,95,76,73,77,73,84,59,32,43,43,105,41,13,10,32,32,32,32,32,
-32,32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,106,111,112,95,67,97,108,99,117,108,97,116,101,68,105,114,
-101,99,116,105,111,110,97,108,76,105,103,104,116,40,105,44,32,115,104,105,110,105,110,101,115,115,77,117,108,116,44,32,108,105,103,104,116,91,48,93,44,32,108,105,103,104,116,91,49,93,
-44,32,108,105,103,104,116,91,50,93,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,83,104,97,100,111,119,32,99,97,108,99,
-117,108,97,116,105,111,110,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,115,104,97,100,111,119,32,61,32,49,46,48,59,13,10,
-32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,102,32,40,117,95,68,105,114,101,99,116,105,111,110,97,108,76,105,103,104,116,115,91,105,93,46,99,97,115,
-116,83,104,97,100,111,119,32,38,38,32,117,95,82,101,99,101,105,118,101,83,104,97,100,111,119,115,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,
-32,32,32,32,115,104,97,100,111,119,32,45,61,32,106,111,112,95,67,97,108,99,117,108,97,116,101,68,105,114,83,112,111,116,83,104,97,100,111,119,40,118,101,99,51,40,117,95,68,105,
-114,101,99,116,105,111,110,97,108,76,105,103,104,116,115,91,105,93,46,108,115,77,97,116,114,105,120,32,42,32,118,101,99,52,40,118,102,95,80,111,115,105,116,105,111,110,44,32,49,46,
-48,41,41,32,42,32,48,46,53,32,43,32,48,46,53,44,32,118,102,95,78,111,114,109,97,108,44,32,45,117,95,68,105,114,101,99,116,105,111,110,97,108,76,105,103,104,116,115,91,105,
-93,46,100,105,114,101,99,116,105,111,110,44,32,32,117,95,68,105,114,101,99,116,105,111,110,97,108,76,105,103,104,116,83,104,97,100,111,119,77,97,112,115,91,105,93,41,59,13,10,13,
+97,117,108,116,76,105,103,104,116,105,110,103,47,76,105,103,104,116,105,110,103,62,13,10,32,32,32,32,32,32,32,32,35,105,110,99,108,117,100,101,32,60,74,111,112,110,97,108,47,68,
+101,102,97,117,108,116,76,105,103,104,116,105,110,103,47,67,108,117,115,116,101,114,115,62,13,10,13,10,32,32,32,32,35,101,108,115,101,13,10,13,10,32,32,32,32,32,32,32,32,35,
+105,102,100,101,102,32,74,77,65,84,95,70,76,65,84,13,10,32,32,32,32,32,32,32,32,32,32,32,32,74,79,80,95,70,76,65,84,13,10,32,32,32,32,32,32,32,32,35,101,110,
+100,105,102,13,10,32,32,32,32,32,32,32,32,74,79,80,95,86,65,82,89,73,78,71,95,73,78,32,118,101,99,51,32,118,102,95,65,109,98,68,105,102,102,76,105,103,104,116,59,13,
+10,13,10,32,32,32,32,32,32,32,32,35,105,102,100,101,102,32,74,77,65,84,95,70,76,65,84,13,10,32,32,32,32,32,32,32,32,32,32,32,32,74,79,80,95,70,76,65,84,13,
+10,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,32,32,32,32,74,79,80,95,86,65,82,89,73,78,71,95,73,78,32,118,101,99,51,32,118,102,95,83,112,
+101,99,76,105,103,104,116,59,13,10,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,35,101,110,100,105,102,13,10,13,10,47,47,32,70,105,110,97,108,32,102,114,97,103,109,
+101,110,116,32,99,111,108,111,114,13,10,74,79,80,95,67,79,76,79,82,95,79,85,84,40,48,41,13,10,13,10,118,111,105,100,32,109,97,105,110,40,41,32,13,10,123,13,10,35,105,
+102,100,101,102,32,74,68,82,87,95,83,75,89,66,79,88,13,10,32,32,32,32,74,79,80,95,70,82,65,71,95,67,79,76,79,82,40,48,41,32,61,32,74,79,80,95,84,69,88,84,
+85,82,69,95,67,85,66,69,40,117,95,69,110,118,105,114,111,110,109,101,110,116,77,97,112,44,32,118,102,95,80,111,115,105,116,105,111,110,41,32,42,32,118,102,95,67,111,108,111,114,
+59,13,10,35,101,108,115,101,13,10,13,10,32,32,32,32,47,47,32,65,115,115,105,103,110,32,116,104,101,32,105,110,105,116,105,97,108,32,99,111,108,111,114,13,10,32,32,32,32,118,
+101,99,52,32,116,101,109,112,67,111,108,111,114,32,61,32,118,102,95,67,111,108,111,114,13,10,13,10,32,32,32,32,35,105,102,100,101,102,32,74,77,65,84,95,68,73,70,70,85,83,
+69,77,65,80,13,10,32,32,32,32,32,32,32,32,42,32,74,79,80,95,84,69,88,84,85,82,69,95,50,68,40,117,95,68,105,102,102,117,115,101,77,97,112,44,32,118,102,95,84,101,
+120,67,111,111,114,100,115,41,13,10,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,59,13,10,13,10,32,32,32,32,35,105,102,100,101,102,32,74,77,65,84,95,69,78,86,
+73,82,79,78,77,69,78,84,77,65,80,13,10,13,10,32,32,32,32,32,32,32,32,118,101,99,51,32,114,101,102,108,32,61,32,118,101,99,51,40,74,79,80,95,84,69,88,84,85,82,
+69,95,67,85,66,69,40,117,95,69,110,118,105,114,111,110,109,101,110,116,77,97,112,44,32,114,101,102,108,101,99,116,40,110,111,114,109,97,108,105,122,101,40,118,102,95,80,111,115,105,
+116,105,111,110,41,44,32,118,102,95,78,111,114,109,97,108,41,41,41,13,10,13,10,32,32,32,32,32,32,32,32,35,105,102,100,101,102,32,74,77,65,84,95,82,69,70,76,69,67,84,
+73,79,78,77,65,80,13,10,32,32,32,32,32,32,32,32,32,32,32,32,42,32,74,79,80,95,84,69,88,84,85,82,69,95,50,68,40,117,95,82,101,102,108,101,99,116,105,111,110,77,
+97,112,44,32,118,102,95,84,101,120,67,111,111,114,100,115,41,46,97,13,10,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,32,32,32,32,35,105,102,100,101,
+102,32,74,77,65,84,95,76,73,71,72,84,73,78,71,13,10,32,32,32,32,32,32,32,32,32,32,32,32,42,32,117,95,77,97,116,101,114,105,97,108,46,114,101,102,108,101,99,116,105,
+118,105,116,121,13,10,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,32,32,32,32,59,13,10,13,10,32,32,32,32,32,32,32,32,116,101,109,112,67,111,108,
+111,114,32,43,61,32,118,101,99,52,40,114,101,102,108,44,32,48,46,48,41,59,13,10,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,47,47,32,68,111,32,
+108,105,103,104,116,105,110,103,32,99,97,108,99,117,108,97,116,105,111,110,115,13,10,32,32,32,32,35,105,102,100,101,102,32,74,77,65,84,95,76,73,71,72,84,73,78,71,13,10,13,
+10,32,32,32,32,32,32,32,32,118,101,99,51,32,116,101,109,112,76,105,103,104,116,91,51,93,59,13,10,13,10,32,32,32,32,32,32,32,32,35,105,102,100,101,102,32,74,77,65,84,
+95,80,72,79,78,71,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,116,101,109,112,76,105,103,104,116,91,48,93,32,61,32,118,101,99,51,40,48,46,48,41,59,13,10,32,
+32,32,32,32,32,32,32,32,32,32,32,116,101,109,112,76,105,103,104,116,91,49,93,32,61,32,118,101,99,51,40,48,46,48,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,
+116,101,109,112,76,105,103,104,116,91,50,93,32,61,32,118,101,99,51,40,48,46,48,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,115,104,105,
+110,105,110,101,115,115,77,117,108,116,32,61,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,105,102,100,101,102,32,74,77,65,84,95,71,76,79,83,83,77,65,80,13,10,32,32,
+32,32,32,32,32,32,32,32,32,32,32,32,32,32,74,79,80,95,84,69,88,84,85,82,69,95,50,68,40,117,95,71,108,111,115,115,77,97,112,44,32,118,102,95,84,101,120,67,111,111,
+114,100,115,41,46,97,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,101,108,115,101,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,49,46,48,13,10,32,32,
+32,32,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,32,32,32,32,32,32,32,32,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,105,102,32,
+40,117,95,82,101,99,101,105,118,101,76,105,103,104,116,115,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,
+118,101,99,51,32,108,105,103,104,116,91,51,93,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,105,102,100,101,102,32,74,79,80,95,67,76,85,83,84,69,82,69,68,
+95,76,73,71,72,84,73,78,71,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,80,111,105,110,116,32,97,110,100,32,115,112,111,116,32,108,105,103,
+104,116,115,32,111,102,32,116,104,105,115,32,102,114,97,103,109,101,110,116,39,115,32,99,108,117,115,116,101,114,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,101,
+99,52,32,99,101,108,108,32,61,32,106,111,112,95,70,101,116,99,104,67,108,117,115,116,101,114,68,97,116,97,40,106,111,112,95,71,101,116,67,108,117,115,116,101,114,40,41,41,59,13,
+10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,111,114,32,40,105,110,116,32,105,32,61,32,48,59,32,105,32,60,32,105,110,116,40,99,101,108,108,46,121,41,
+59,32,43,43,105,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,106,111,112,
+95,67,97,108,99,117,108,97,116,101,67,108,117,115,116,101,114,76,105,103,104,116,40,106,111,112,95,71,101,116,67,108,117,115,116,101,114,76,105,103,104,116,40,105,110,116,40,99,101,108,
+108,46,120,41,44,32,105,41,44,32,115,104,105,110,105,110,101,115,115,77,117,108,116,44,32,108,105,103,104,116,91,48,93,44,32,108,105,103,104,116,91,49,93,44,32,108,105,103,104,116,
+91,50,93,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,116,101,109,112,76,105,103,104,116,91,48,93,32,43,61,32,108,105,103,104,116,
+91,48,93,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,116,101,109,112,76,105,103,104,116,91,49,93,32,43,61,32,108,105,103,104,116,91,49,93,
+59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,116,101,109,112,76,105,103,104,116,91,50,93,32,43,61,32,108,105,103,104,116,91,50,93,59,13,10,
+32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,101,108,105,102,32,74,77,65,84,95,77,65,88,95,80,79,
+73,78,84,95,76,73,71,72,84,83,32,62,32,48,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,80,111,105,110,116,32,108,105,103,104,116,115,13,
+10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,111,114,32,40,105,110,116,32,105,32,61,32,48,59,32,105,32,60,32,74,79,80,95,80,79,73,78,84,95,76,73,77,
+73,84,59,32,43,43,105,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,106,
+111,112,95,67,97,108,99,117,108,97,116,101,80,111,105,110,116,76,105,103,104,116,40,105,44,32,115,104,105,110,105,110,101,115,115,77,117,108,116,44,32,108,105,103,104,116,91,48,93,44,
+32,108,105,103,104,116,91,49,93,44,32,108,105,103,104,116,91,50,93,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,83,104,
+97,100,111,119,32,99,97,108,99,117,108,97,116,105,111,110,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,115,104,97,100,111,119,
+32,61,32,49,46,48,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,102,32,40,117,95,80,111,105,110,116,76,105,103,104,116,115,91,105,93,46,
+99,97,115,116,83,104,97,100,111,119,32,38,38,32,117,95,82,101,99,101,105,118,101,83,104,97,100,111,119,115,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,
+32,32,32,32,32,32,32,115,104,97,100,111,119,32,45,61,32,106,111,112,95,67,97,108,99,117,108,97,116,101,80,111,105,110,116,83,104,97,100,111,119,40,117,95,80,111,105,110,116,76,
+105,103,104,116,115,91,105,93,44,32,117,95,80,111,105,110,116,76,105,103,104,116,115,91,105,93,46,112,111,115,105,116,105,111,110,32,45,32,118,102,95,80,111,115,105,116,105,111,110,41,
+59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,116,101,109,112,76,105,103,104,116,91,48,93,32,43,61,32,108,105,103,104,116,91,48,93,59,
+13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,116,101,109,112,76,105,103,104,116,91,49,93,32,43,61,32,108,105,103,104,116,91,49,93,32,42,32,115,
+104,97,100,111,119,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,116,101,109,112,76,105,103,104,116,91,50,93,32,43,61,32,108,105,103,104,116,91,
+50,93,32,42,32,115,104,97,100,111,119,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,101,110,
+100,105,102,13,10,32,32,32,32,32,32,32,32,32,32,32,32,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,105,102,32,74,77,65,84,95,77,65,88,95,68,73,82,69,67,84,
+73,79,78,65,76,95,76,73,71,72,84,83,32,62,32,48,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,68,105,114,101,99,116,105,111,110,97,108,
+32,108,105,103,104,116,115,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,111,114,32,40,105,110,116,32,105,32,61,32,48,59,32,105,32,60,32,74,79,80,95,68,
+73,82,95,76,73,77,73,84,59,32,43,43,105,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,
+32,32,32,32,32,106,111,112,95,67,97,108,99,117,108,97,116,101,68,105,114,101,99,116,105,111,110,97,108,76,105,103,104,116,40,105,44,32,115,104,105,110,105,110,101,115,115,77,117,108,
+116,44,32,108,105,103,104,116,91,48,93,44,32,108,105,103,104,116,91,49,93,44,32,108,105,103,104,116,91,50,93,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,
+32,32,32,32,32,32,32,47,47,32,83,104,97,100,111,119,32,99,97,108,99,117,108,97,116,105,111,110,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,
+102,108,111,97,116,32,115,104,97,100,111,119,32,61,32,49,46,48,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,102,32,40,117,95,68,105,114,
+101,99,116,105,111,110,97,108,76,105,103,104,116,115,91,105,93,46,99,97,115,116,83,104,97,100,111,119,32,38,38,32,117,95,82,101,99,101,105,118,101,83,104,97,100,111,119,115,41,13,
+10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,115,104,97,100,111,119,32,45,61,32,106,111,112,95,67,97,108,99,117,108,97,116,101,67,97,
+115,99,97,100,101,83,104,97,100,111,119,40,117,95,68,105,114,101,99,116,105,111,110,97,108,76,105,103,104,116,115,91,105,93,44,32,118,102,95,78,111,114,109,97,108,41,59,13,10,13,
 10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,116,101,109,112,76,105,103,104,116,91,48,93,32,43,61,32,108,105,103,104,116,91,48,93,59,13,10,32,32,
 32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,116,101,109,112,76,105,103,104,116,91,49,93,32,43,61,32,108,105,103,104,116,91,49,93,32,42,32,115,104,97,100,111,
 119,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,116,101,109,112,76,105,103,104,116,91,50,93,32,43,61,32,108,105,103,104,116,91,50,93,32,42,
 32,115,104,97,100,111,119,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,
-10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,105,102,32,74,77,65,84,95,77,65,88,95,83,80,
-79,84,95,76,73,71,72,84,83,32,62,32,48,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,83,112,111,116,32,108,105,103,104,116,115,13,10,32,
-32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,111,114,32,40,105,110,116,32,105,32,61,32,48,59,32,105,32,60,32,74,79,80,95,83,80,79,84,95,76,73,77,73,84,59,
-32,43,43,105,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,106,111,112,95,
-67,97,108,99,117,108,97,116,101,83,112,111,116,76,105,103,104,116,40,105,44,32,115,104,105,110,105,110,101,115,115,77,117,108,116,44,32,108,105,103,104,116,91,48,93,44,32,108,105,103,
-104,116,91,49,93,44,32,108,105,103,104,116,91,50,93,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,83,104,97,100,111,119,
-32,99,97,108,99,117,108,97,116,105,111,110,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,115,104,97,100,111,119,32,61,32,49,
-46,48,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,102,32,40,117,95,83,112,111,116,76,105,103,104,116,115,91,105,93,46,99,97,115,116,83,
-104,97,100,111,119,32,38,38,32,117,95,82,101,99,101,105,118,101,83,104,97,100,111,119,115,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,123,13,
-10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,52,32,116,101,109,112,67,111,111,114,100,115,32,61,32,117,95,83,112,111,116,76,
-105,103,104,116,115,91,105,93,46,108,115,77,97,116,114,105,120,32,42,32,118,101,99,52,40,118,102,95,80,111,115,105,116,105,111,110,44,32,49,46,48,41,59,13,10,32,32,32,32,32,
-32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,115,104,97,100,111,119,32,45,61,32,106,111,112,95,67,97,108,99,117,108,97,116,101,68,105,114,83,112,111,116,83,
-104,97,100,111,119,40,40,116,101,109,112,67,111,111,114,100,115,46,120,121,122,32,47,32,116,101,109,112,67,111,111,114,100,115,46,119,41,32,42,32,48,46,53,32,43,32,48,46,53,44,
-32,118,102,95,78,111,114,109,97,108,44,32,117,95,83,112,111,116,76,105,103,104,116,115,91,105,93,46,112,111,115,105,116,105,111,110,32,45,32,118,102,95,80,111,115,105,116,105,111,110,
-44,32,117,95,83,112,111,116,76,105,103,104,116,83,104,97,100,111,119,77,97,112,115,91,105,93,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,
-125,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,116,101,109,112,76,
-105,103,104,116,91,48,93,32,43,61,32,108,105,103,104,116,91,48,93,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,116,101,109,112,76,105,103,104,
-116,91,49,93,32,43,61,32,108,105,103,104,116,91,49,93,32,42,32,115,104,97,100,111,119,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,116,101,
-109,112,76,105,103,104,116,91,50,93,32,43,61,32,108,105,103,104,116,91,50,93,32,42,32,115,104,97,100,111,119,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,
-125,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,32,32,32,32,
-35,101,108,115,101,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,116,101,109,112,76,105,103,104,116,91,48,93,32,61,32,118,102,95,65,109,98,68,105,102,102,76,105,103,104,
-116,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,116,101,109,112,76,105,103,104,116,91,49,93,32,61,32,118,101,99,51,40,48,46,48,41,59,13,10,32,32,32,32,32,32,32,
-32,32,32,32,32,116,101,109,112,76,105,103,104,116,91,50,93,32,61,32,118,102,95,83,112,101,99,76,105,103,104,116,59,13,10,13,10,32,32,32,32,32,32,32,32,35,101,110,100,105,
-102,32,47,47,74,77,65,84,95,80,72,79,78,71,13,10,13,10,32,32,32,32,32,32,32,32,35,105,102,100,101,102,32,74,77,65,84,95,83,80,69,67,85,76,65,82,77,65,80,13,
-10,32,32,32,32,32,32,32,32,32,32,32,32,116,101,109,112,76,105,103,104,116,91,50,93,32,42,61,32,118,101,99,51,40,74,79,80,95,84,69,88,84,85,82,69,95,50,68,40,117,
-95,83,112,101,99,117,108,97,114,77,97,112,44,32,118,102,95,84,101,120,67,111,111,114,100,115,41,41,59,13,10,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,
-32,32,32,32,32,32,32,116,101,109,112,67,111,108,111,114,32,42,61,32,118,101,99,52,40,116,101,109,112,76,105,103,104,116,91,48,93,32,43,32,116,101,109,112,76,105,103,104,116,91,
-49,93,32,43,32,116,101,109,112,76,105,103,104,116,91,50,93,44,32,117,95,77,97,116,101,114,105,97,108,46,97,109,98,105,101,110,116,46,97,32,42,32,117,95,77,97,116,101,114,105,
-97,108,46,100,105,102,102,117,115,101,46,97,32,42,32,117,95,77,97,116,101,114,105,97,108,46,115,112,101,99,117,108,97,114,46,97,41,59,13,10,32,32,32,32,32,32,32,32,116,101,
-109,112,67,111,108,111,114,32,43,61,32,117,95,77,97,116,101,114,105,97,108,46,101,109,105,115,115,105,111,110,13,10,32,32,32,32,32,32,32,32,13,10,32,32,32,32,32,32,32,32,
-35,105,102,100,101,102,32,74,77,65,84,95,69,77,73,83,83,73,79,78,77,65,80,13,10,32,32,32,32,32,32,32,32,32,32,32,32,42,32,74,79,80,95,84,69,88,84,85,82,69,
-95,50,68,40,117,95,69,109,105,115,115,105,111,110,77,97,112,44,32,118,102,95,84,101,120,67,111,111,114,100,115,41,13,10,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,
-32,32,32,32,32,32,32,32,59,13,10,13,10,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,13,10,32,32,32,32,35,105,102,100,101,102,32,74,77,65,84,95,79,80,65,
-67,73,84,89,77,65,80,13,10,32,32,32,32,32,32,32,32,116,101,109,112,67,111,108,111,114,46,97,32,42,61,32,74,79,80,95,84,69,88,84,85,82,69,95,50,68,40,117,95,79,
-112,97,99,105,116,121,77,97,112,44,32,118,102,95,84,101,120,67,111,111,114,100,115,41,46,97,59,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,47,47,32,
-70,105,110,97,108,108,121,32,97,115,115,105,103,110,32,116,111,32,116,104,101,32,102,114,97,103,109,101,110,116,32,111,117,116,112,117,116,13,10,32,32,32,32,74,79,80,95,70,82,65,
-71,95,67,79,76,79,82,40,48,41,32,61,32,116,101,109,112,67,111,108,111,114,59,13,10,13,10,35,101,110,100,105,102,32,47,47,32,83,107,121,32,98,111,120,13,10,125,
+10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,105,102,32,33,100,101,102,105,110,101,100,40,74,79,
+80,95,67,76,85,83,84,69,82,69,68,95,76,73,71,72,84,73,78,71,41,32,38,38,32,74,77,65,84,95,77,65,88,95,83,80,79,84,95,76,73,71,72,84,83,32,62,32,48,13,
+10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,83,112,111,116,32,108,105,103,104,116,115,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,
+32,102,111,114,32,40,105,110,116,32,105,32,61,32,48,59,32,105,32,60,32,74,79,80,95,83,80,79,84,95,76,73,77,73,84,59,32,43,43,105,41,13,10,32,32,32,32,32,32,32,
+32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,106,111,112,95,67,97,108,99,117,108,97,116,101,83,112,111,116,76,
+105,103,104,116,40,105,44,32,115,104,105,110,105,110,101,115,115,77,117,108,116,44,32,108,105,103,104,116,91,48,93,44,32,108,105,103,104,116,91,49,93,44,32,108,105,103,104,116,91,50,
+93,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,83,104,97,100,111,119,32,99,97,108,99,117,108,97,116,105,111,110,13,10,
+32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,115,104,97,100,111,119,32,61,32,49,46,48,59,13,10,32,32,32,32,32,32,32,32,32,
+32,32,32,32,32,32,32,32,32,32,32,105,102,32,40,117,95,83,112,111,116,76,105,103,104,116,115,91,105,93,46,99,97,115,116,83,104,97,100,111,119,32,38,38,32,117,95,82,101,99,
+101,105,118,101,83,104,97,100,111,119,115,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,
+32,32,32,32,32,32,32,32,32,32,32,118,101,99,52,32,116,101,109,112,67,111,111,114,100,115,32,61,32,117,95,83,112,111,116,76,105,103,104,116,115,91,105,93,46,108,115,77,97,116,
+114,105,120,32,42,32,118,101,99,52,40,118,102,95,80,111,115,105,116,105,111,110,44,32,49,46,48,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,
+32,32,32,32,32,115,104,97,100,111,119,32,45,61,32,106,111,112,95,67,97,108,99,117,108,97,116,101,68,105,114,83,112,111,116,83,104,97,100,111,119,40,40,116,101,109,112,67,111,111,
+114,100,115,46,120,121,122,32,47,32,116,101,109,112,67,111,111,114,100,115,46,119,41,32,42,32,48,46,53,32,43,32,48,46,53,44,32,118,102,95,78,111,114,109,97,108,44,32,117,95,
+83,112,111,116,76,105,103,104,116,115,91,105,93,46,112,111,115,105,116,105,111,110,32,45,32,118,102,95,80,111,115,105,116,105,111,110,44,32,117,95,83,112,111,116,76,105,103,104,116,115,
+91,105,93,46,115,104,97,100,111,119,84,105,108,101,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,125,13,10,32,32,32,32,32,32,32,32,32,
+32,32,32,32,32,32,32,32,32,32,32,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,116,101,109,112,76,105,103,104,116,91,48,93,32,43,61,32,108,
+105,103,104,116,91,48,93,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,116,101,109,112,76,105,103,104,116,91,49,93,32,43,61,32,108,105,103,104,
+116,91,49,93,32,42,32,115,104,97,100,111,119,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,116,101,109,112,76,105,103,104,116,91,50,93,32,43,
+61,32,108,105,103,104,116,91,50,93,32,42,32,115,104,97,100,111,119,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,32,32,32,
+32,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,32,32,32,32,35,101,108,115,101,13,10,13,10,32,32,32,
+32,32,32,32,32,32,32,32,32,116,101,109,112,76,105,103,104,116,91,48,93,32,61,32,118,102,95,65,109,98,68,105,102,102,76,105,103,104,116,59,13,10,32,32,32,32,32,32,32,32,
+32,32,32,32,116,101,109,112,76,105,103,104,116,91,49,93,32,61,32,118,101,99,51,40,48,46,48,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,116,101,109,112,76,105,103,
+104,116,91,50,93,32,61,32,118,102,95,83,112,101,99,76,105,103,104,116,59,13,10,13,10,32,32,32,32,32,32,32,32,35,101,110,100,105,102,32,47,47,74,77,65,84,95,80,72,79,
+78,71,13,10,13,10,32,32,32,32,32,32,32,32,35,105,102,100,101,102,32,74,77,65,84,95,83,80,69,67,85,76,65,82,77,65,80,13,10,32,32,32,32,32,32,32,32,32,32,32,
+32,116,101,109,112,76,105,103,104,116,91,50,93,32,42,61,32,118,101,99,51,40,74,79,80,95,84,69,88,84,85,82,69,95,50,68,40,117,95,83,112,101,99,117,108,97,114,77,97,112,
+44,32,118,102,95,84,101,120,67,111,111,114,100,115,41,41,59,13,10,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,32,32,32,32,116,101,109,112,67,
+111,108,111,114,32,42,61,32,118,101,99,52,40,116,101,109,112,76,105,103,104,116,91,48,93,32,43,32,116,101,109,112,76,105,103,104,116,91,49,93,32,43,32,116,101,109,112,76,105,103,
+104,116,91,50,93,44,32,117,95,77,97,116,101,114,105,97,108,46,97,109,98,105,101,110,116,46,97,32,42,32,117,95,77,97,116,101,114,105,97,108,46,100,105,102,102,117,115,101,46,97,
+32,42,32,117,95,77,97,116,101,114,105,97,108,46,115,112,101,99,117,108,97,114,46,97,41,59,13,10,32,32,32,32,32,32,32,32,116,101,109,112,67,111,108,111,114,32,43,61,32,117,
+95,77,97,116,101,114,105,97,108,46,101,109,105,115,115,105,111,110,13,10,32,32,32,32,32,32,32,32,13,10,32,32,32,32,32,32,32,32,35,105,102,100,101,102,32,74,77,65,84,95,
+69,77,73,83,83,73,79,78,77,65,80,13,10,32,32,32,32,32,32,32,32,32,32,32,32,42,32,74,79,80,95,84,69,88,84,85,82,69,95,50,68,40,117,95,69,109,105,115,115,105,
+111,110,77,97,112,44,32,118,102,95,84,101,120,67,111,111,114,100,115,41,13,10,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,32,32,32,32,59,13,10,13,
+10,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,13,10,32,32,32,32,35,105,102,100,101,102,32,74,77,65,84,95,79,80,65,67,73,84,89,77,65,80,13,10,32,32,32,
+32,32,32,32,32,116,101,109,112,67,111,108,111,114,46,97,32,42,61,32,74,79,80,95,84,69,88,84,85,82,69,95,50,68,40,117,95,79,112,97,99,105,116,121,77,97,112,44,32,118,
+102,95,84,101,120,67,111,111,114,100,115,41,46,97,59,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,47,47,32,70,105,110,97,108,108,121,32,97,115,115,105,
+103,110,32,116,111,32,116,104,101,32,102,114,97,103,109,101,110,116,32,111,117,116,112,117,116,13,10,32,32,32,32,74,79,80,95,70,82,65,71,95,67,79,76,79,82,40,48,41,32,61,
+32,116,101,109,112,67,111,108,111,114,59,13,10,13,10,35,101,110,100,105,102,32,47,47,32,83,107,121,32,98,111,120,13,10,125,
 };
 
-const unsigned char defaultUberShaderVert[2845] =
+const unsigned char defaultUberShaderVert[3525] =
 {
 47,47,32,74,79,80,78,65,76,32,68,69,70,65,85,76,84,32,86,69,82,84,69,88,32,85,66,69,82,83,72,65,68,69,82,13,10,47,47,13,10,47,47,32,74,111,112,110,97,108,
 32,108,105,99,101,110,115,101,32,97,112,112,108,105,101,115,13,10,13,10,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,
@@ -5411,94 +5421,123 @@ const unsigned char defaultUberShaderVert[2845] =
 116,101,120,32,97,116,116,114,105,98,117,116,101,115,13,10,74,79,80,95,65,84,84,82,73,66,85,84,69,40,48,41,32,118,101,99,52,32,97,95,80,111,115,105,116,105,111,110,59,13,
 10,74,79,80,95,65,84,84,82,73,66,85,84,69,40,49,41,32,118,101,99,50,32,97,95,84,101,120,67,111,111,114,100,115,59,13,10,74,79,80,95,65,84,84,82,73,66,85,84,69,
 40,50,41,32,118,101,99,51,32,97,95,78,111,114,109,97,108,59,13,10,74,79,80,95,65,84,84,82,73,66,85,84,69,40,51,41,32,118,101,99,52,32,97,95,67,111,108,111,114,59,
-13,10,13,10,47,47,32,77,97,116,114,105,99,101,115,13,10,117,110,105,102,111,114,109,32,109,97,116,52,32,117,95,86,77,77,97,116,114,105,120,59,13,10,117,110,105,102,111,114,109,
-32,109,97,116,52,32,117,95,80,86,77,77,97,116,114,105,120,59,13,10,117,110,105,102,111,114,109,32,109,97,116,51,32,117,95,78,77,97,116,114,105,120,59,13,10,13,10,47,47,32,
-86,101,114,116,101,120,32,97,116,116,114,105,98,117,116,101,115,32,116,111,32,102,114,97,103,109,101,110,116,32,115,104,97,100,101,114,13,10,74,79,80,95,86,65,82,89,73,78,71,95,
-79,85,84,32,118,101,99,51,32,118,102,95,80,111,115,105,116,105,111,110,59,13,10,74,79,80,95,86,65,82,89,73,78,71,95,79,85,84,32,118,101,99,50,32,118,102,95,84,101,120,
-67,111,111,114,100,115,59,13,10,74,79,80,95,86,65,82,89,73,78,71,95,79,85,84,32,118,101,99,51,32,118,102,95,78,111,114,109,97,108,59,13,10,74,79,80,95,86,65,82,89,
-73,78,71,95,79,85,84,32,118,101,99,52,32,118,102,95,67,111,108,111,114,59,13,10,13,10,35,105,102,100,101,102,32,74,77,65,84,95,71,79,85,82,65,85,68,13,10,13,10,32,
-32,32,32,35,105,110,99,108,117,100,101,32,60,74,111,112,110,97,108,47,68,101,102,97,117,108,116,76,105,103,104,116,105,110,103,47,85,110,105,102,111,114,109,115,62,13,10,32,32,32,
-32,35,105,110,99,108,117,100,101,32,60,74,111,112,110,97,108,47,68,101,102,97,117,108,116,76,105,103,104,116,105,110,103,47,76,105,103,104,116,105,110,103,62,13,10,13,10,32,32,32,
-32,117,110,105,102,111,114,109,32,98,111,111,108,32,117,95,82,101,99,101,105,118,101,76,105,103,104,116,115,59,13,10,13,10,32,32,32,32,35,105,102,100,101,102,32,74,77,65,84,95,
-70,76,65,84,13,10,32,32,32,32,32,32,32,32,74,79,80,95,70,76,65,84,13,10,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,74,79,80,95,86,65,82,89,73,78,
-71,95,79,85,84,32,118,101,99,51,32,118,102,95,65,109,98,68,105,102,102,76,105,103,104,116,59,13,10,32,32,32,32,35,105,102,100,101,102,32,74,77,65,84,95,70,76,65,84,13,
-10,32,32,32,32,32,32,32,32,74,79,80,95,70,76,65,84,13,10,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,74,79,80,95,86,65,82,89,73,78,71,95,79,85,84,
-32,118,101,99,51,32,118,102,95,83,112,101,99,76,105,103,104,116,59,13,10,13,10,35,101,110,100,105,102,13,10,13,10,118,111,105,100,32,109,97,105,110,40,41,13,10,123,13,10,32,
-32,32,32,47,47,32,65,115,115,105,103,110,32,97,116,116,114,105,98,117,116,101,115,13,10,32,32,32,32,118,102,95,80,111,115,105,116,105,111,110,32,32,32,32,32,61,32,40,13,10,
-32,32,32,32,35,105,102,32,33,100,101,102,105,110,101,100,40,74,68,82,87,95,83,75,89,66,79,88,41,32,38,38,32,33,100,101,102,105,110,101,100,40,74,68,82,87,95,83,75,89,
-83,80,72,69,82,69,41,13,10,32,32,32,32,32,32,32,32,117,95,86,77,77,97,116,114,105,120,32,42,32,13,10,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,32,32,
-32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,97,95,80,111,115,105,116,105,111,110,41,46,120,121,122,59,13,10,32,32,32,32,118,102,95,84,101,120,67,111,111,114,100,115,
-32,32,32,32,61,32,97,95,84,101,120,67,111,111,114,100,115,59,13,10,32,32,32,32,118,102,95,78,111,114,109,97,108,32,32,32,32,32,32,32,61,32,110,111,114,109,97,108,105,122,
-101,40,117,95,78,77,97,116,114,105,120,32,42,32,97,95,78,111,114,109,97,108,41,59,13,10,32,32,32,32,118,102,95,67,111,108,111,114,32,32,32,32,32,32,32,32,61,32,97,95,
-67,111,108,111,114,59,13,10,13,10,32,32,32,32,47,47,32,67,97,108,99,117,108,97,116,101,32,97,110,100,32,97,115,115,105,103,110,32,112,111,115,105,116,105,111,110,13,10,32,32,
-32,32,103,108,95,80,111,115,105,116,105,111,110,32,61,32,40,117,95,80,86,77,77,97,116,114,105,120,32,42,32,97,95,80,111,115,105,116,105,111,110,41,13,10,32,32,32,32,13,10,
-32,32,32,32,35,105,102,32,40,100,101,102,105,110,101,100,40,74,68,82,87,95,83,75,89,66,79,88,41,32,124,124,32,100,101,102,105,110,101,100,40,74,68,82,87,95,83,75,89,83,
-80,72,69,82,69,41,41,13,10,32,32,32,32,32,32,32,32,46,120,121,119,119,13,10,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,59,13,10,13,10,32,32,32,32,47,
-47,32,71,111,117,114,97,117,100,47,102,108,97,116,32,108,105,103,104,116,105,110,103,13,10,32,32,32,32,35,105,102,100,101,102,32,74,77,65,84,95,71,79,85,82,65,85,68,13,10,
-13,10,32,32,32,32,32,32,32,32,118,102,95,65,109,98,68,105,102,102,76,105,103,104,116,32,61,32,118,101,99,51,40,48,46,48,41,59,13,10,32,32,32,32,32,32,32,32,118,102,
-95,83,112,101,99,76,105,103,104,116,32,61,32,118,101,99,51,40,48,46,48,41,59,13,10,13,10,32,32,32,32,32,32,32,32,105,102,32,40,117,95,82,101,99,101,105,118,101,76,105,
-103,104,116,115,41,13,10,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,32,108,105,103,104,116,91,51,93,59,13,10,13,10,32,32,
-32,32,32,32,32,32,35,105,102,32,74,77,65,84,95,77,65,88,95,80,79,73,78,84,95,76,73,71,72,84,83,32,62,32,48,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,
-32,47,47,32,80,111,105,110,116,32,108,105,103,104,116,115,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,111,114,32,40,105,110,116,32,105,32,61,32,48,59,32,105,32,60,32,
-74,79,80,95,80,79,73,78,84,95,76,73,77,73,84,59,32,43,43,105,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,
-32,32,32,32,106,111,112,95,67,97,108,99,117,108,97,116,101,80,111,105,110,116,76,105,103,104,116,40,105,44,32,49,46,48,44,32,108,105,103,104,116,91,48,93,44,32,108,105,103,104,
-116,91,49,93,44,32,108,105,103,104,116,91,50,93,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,102,95,65,109,98,68,105,102,102,76,105,103,104,
-116,32,43,61,32,108,105,103,104,116,91,48,93,32,43,32,108,105,103,104,116,91,49,93,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,102,95,83,112,101,99,
-76,105,103,104,116,32,43,61,32,108,105,103,104,116,91,50,93,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,32,32,32,32,35,101,110,100,105,
-102,13,10,32,32,32,32,32,32,32,32,13,10,32,32,32,32,32,32,32,32,35,105,102,32,74,77,65,84,95,77,65,88,95,68,73,82,69,67,84,73,79,78,65,76,95,76,73,71,72,
-84,83,32,62,32,48,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,68,105,114,101,99,116,105,111,110,97,108,32,108,105,103,104,116,115,13,10,32,32,32,32,32,
-32,32,32,32,32,32,32,102,111,114,32,40,105,110,116,32,105,32,61,32,48,59,32,105,32,60,32,74,79,80,95,68,73,82,95,76,73,77,73,84,59,32,43,43,105,41,13,10,32,32,
-32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,106,111,112,95,67,97,108,99,117,108,97,116,101,68,105,114,101,99,116,105,111,
-110,97,108,76,105,103,104,116,40,105,44,32,49,46,48,44,32,108,105,103,104,116,91,48,93,44,32,108,105,103,104,116,91,49,93,44,32,108,105,103,104,116,91,50,93,41,59,13,10,13,
-10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,102,95,65,109,98,68,105,102,102,76,105,103,104,116,32,43,61,32,108,105,103,104,116,91,48,93,32,43,32,108,105,103,
-104,116,91,49,93,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,102,95,83,112,101,99,76,105,103,104,116,32,43,61,32,108,105,103,104,116,91,50,93,59,13,
-10,32,32,32,32,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,
-13,10,32,32,32,32,32,32,32,32,35,105,102,32,74,77,65,84,95,77,65,88,95,83,80,79,84,95,76,73,71,72,84,83,32,62,32,48,13,10,13,10,32,32,32,32,32,32,32,32,
-32,32,32,32,47,47,32,83,112,111,116,32,108,105,103,104,116,115,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,111,114,32,40,105,110,116,32,105,32,61,32,48,59,32,105,32,
-60,32,74,79,80,95,83,80,79,84,95,76,73,77,73,84,59,32,43,43,105,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,
-32,32,32,32,32,106,111,112,95,67,97,108,99,117,108,97,116,101,83,112,111,116,76,105,103,104,116,40,105,44,32,49,46,48,44,32,108,105,103,104,116,91,48,93,44,32,108,105,103,104,
-116,91,49,93,44,32,108,105,103,104,116,91,50,93,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,
-32,32,118,102,95,65,109,98,68,105,102,102,76,105,103,104,116,32,43,61,32,108,105,103,104,116,91,48,93,32,43,32,108,105,103,104,116,91,49,93,59,13,10,32,32,32,32,32,32,32,
-32,32,32,32,32,32,32,32,32,118,102,95,83,112,101,99,76,105,103,104,116,32,43,61,32,108,105,103,104,116,91,50,93,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,125,13,
-10,13,10,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,35,101,110,100,105,102,13,10,125,
+13,10,13,10,35,105,102,100,101,102,32,74,68,82,87,95,73,78,83,84,65,78,67,69,68,13,10,13,10,32,32,32,32,47,47,32,80,101,114,45,105,110,115,116,97,110,99,101,32,109,
+111,100,101,108,32,109,97,116,114,105,120,44,32,111,99,99,117,112,105,101,115,32,108,111,99,97,116,105,111,110,115,32,52,45,55,46,13,10,32,32,32,32,47,47,32,97,95,67,111,108,
+111,114,32,105,115,32,97,108,115,111,32,112,101,114,45,105,110,115,116,97,110,99,101,13,10,32,32,32,32,74,79,80,95,65,84,84,82,73,66,85,84,69,40,52,41,32,109,97,116,52,
+32,97,95,77,77,97,116,114,105,120,59,13,10,13,10,32,32,32,32,47,47,32,77,97,116,114,105,99,101,115,13,10,32,32,32,32,35,105,110,99,108,117,100,101,32,60,74,111,112,110,
+97,108,47,66,108,111,99,107,115,47,67,97,109,101,114,97,62,13,10,13,10,32,32,32,32,35,105,102,110,100,101,102,32,74,79,80,95,85,78,73,70,79,82,77,95,66,76,79,67,75,
+83,13,10,32,32,32,32,32,32,32,32,117,110,105,102,111,114,109,32,109,97,116,52,32,117,95,86,77,97,116,114,105,120,59,13,10,32,32,32,32,32,32,32,32,117,110,105,102,111,114,
+109,32,109,97,116,52,32,117,95,80,86,77,97,116,114,105,120,59,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,35,101,108,115,101,13,10,13,10,32,32,32,32,47,47,32,
+77,97,116,114,105,99,101,115,13,10,32,32,32,32,117,110,105,102,111,114,109,32,109,97,116,52,32,117,95,86,77,77,97,116,114,105,120,59,13,10,32,32,32,32,117,110,105,102,111,114,
+109,32,109,97,116,52,32,117,95,80,86,77,77,97,116,114,105,120,59,13,10,32,32,32,32,117,110,105,102,111,114,109,32,109,97,116,51,32,117,95,78,77,97,116,114,105,120,59,13,10,
+13,10,35,101,110,100,105,102,13,10,13,10,47,47,32,86,101,114,116,101,120,32,97,116,116,114,105,98,117,116,101,115,32,116,111,32,102,114,97,103,109,101,110,116,32,115,104,97,100,101,
+114,13,10,74,79,80,95,86,65,82,89,73,78,71,95,79,85,84,32,118,101,99,51,32,118,102,95,80,111,115,105,116,105,111,110,59,13,10,74,79,80,95,86,65,82,89,73,78,71,95,
+79,85,84,32,118,101,99,50,32,118,102,95,84,101,120,67,111,111,114,100,115,59,13,10,74,79,80,95,86,65,82,89,73,78,71,95,79,85,84,32,118,101,99,51,32,118,102,95,78,111,
+114,109,97,108,59,13,10,74,79,80,95,86,65,82,89,73,78,71,95,79,85,84,32,118,101,99,52,32,118,102,95,67,111,108,111,114,59,13,10,13,10,35,105,102,100,101,102,32,74,77,
+65,84,95,71,79,85,82,65,85,68,13,10,13,10,32,32,32,32,35,105,110,99,108,117,100,101,32,60,74,111,112,110,97,108,47,68,101,102,97,117,108,116,76,105,103,104,116,105,110,103,
+47,85,110,105,102,111,114,109,115,62,13,10,32,32,32,32,35,105,110,99,108,117,100,101,32,60,74,111,112,110,97,108,47,68,101,102,97,117,108,116,76,105,103,104,116,105,110,103,47,76,
+105,103,104,116,105,110,103,62,13,10,13,10,32,32,32,32,117,110,105,102,111,114,109,32,98,111,111,108,32,117,95,82,101,99,101,105,118,101,76,105,103,104,116,115,59,13,10,13,10,32,
+32,32,32,35,105,102,100,101,102,32,74,77,65,84,95,70,76,65,84,13,10,32,32,32,32,32,32,32,32,74,79,80,95,70,76,65,84,13,10,32,32,32,32,35,101,110,100,105,102,13,
+10,32,32,32,32,74,79,80,95,86,65,82,89,73,78,71,95,79,85,84,32,118,101,99,51,32,118,102,95,65,109,98,68,105,102,102,76,105,103,104,116,59,13,10,32,32,32,32,35,105,
+102,100,101,102,32,74,77,65,84,95,70,76,65,84,13,10,32,32,32,32,32,32,32,32,74,79,80,95,70,76,65,84,13,10,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,
+74,79,80,95,86,65,82,89,73,78,71,95,79,85,84,32,118,101,99,51,32,118,102,95,83,112,101,99,76,105,103,104,116,59,13,10,13,10,35,101,110,100,105,102,13,10,13,10,118,111,
+105,100,32,109,97,105,110,40,41,13,10,123,13,10,32,32,32,32,35,105,102,100,101,102,32,74,68,82,87,95,73,78,83,84,65,78,67,69,68,13,10,32,32,32,32,32,32,32,32,109,
+97,116,52,32,86,77,77,97,116,114,105,120,32,61,32,117,95,86,77,97,116,114,105,120,32,42,32,97,95,77,77,97,116,114,105,120,59,13,10,32,32,32,32,32,32,32,32,109,97,116,
+52,32,80,86,77,77,97,116,114,105,120,32,61,32,117,95,80,86,77,97,116,114,105,120,32,42,32,97,95,77,77,97,116,114,105,120,59,13,10,32,32,32,32,32,32,32,32,109,97,116,
+51,32,78,77,97,116,114,105,120,32,61,32,116,114,97,110,115,112,111,115,101,40,105,110,118,101,114,115,101,40,109,97,116,51,40,86,77,77,97,116,114,105,120,41,41,41,59,13,10,32,
+32,32,32,35,101,108,115,101,13,10,32,32,32,32,32,32,32,32,109,97,116,52,32,86,77,77,97,116,114,105,120,32,61,32,117,95,86,77,77,97,116,114,105,120,59,13,10,32,32,32,
+32,32,32,32,32,109,97,116,52,32,80,86,77,77,97,116,114,105,120,32,61,32,117,95,80,86,77,77,97,116,114,105,120,59,13,10,32,32,32,32,32,32,32,32,109,97,116,51,32,78,
+77,97,116,114,105,120,32,61,32,117,95,78,77,97,116,114,105,120,59,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,47,47,32,65,115,115,105,103,110,32,97,
+116,116,114,105,98,117,116,101,115,13,10,32,32,32,32,118,102,95,80,111,115,105,116,105,111,110,32,32,32,32,32,61,32,40,13,10,32,32,32,32,35,105,102,32,33,100,101,102,105,110,
+101,100,40,74,68,82,87,95,83,75,89,66,79,88,41,32,38,38,32,33,100,101,102,105,110,101,100,40,74,68,82,87,95,83,75,89,83,80,72,69,82,69,41,13,10,32,32,32,32,32,
+32,32,32,86,77,77,97,116,114,105,120,32,42,32,13,10,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,
+97,95,80,111,115,105,116,105,111,110,41,46,120,121,122,59,13,10,32,32,32,32,118,102,95,84,101,120,67,111,111,114,100,115,32,32,32,32,61,32,97,95,84,101,120,67,111,111,114,100,
+115,59,13,10,32,32,32,32,118,102,95,78,111,114,109,97,108,32,32,32,32,32,32,32,61,32,110,111,114,109,97,108,105,122,101,40,78,77,97,116,114,105,120,32,42,32,97,95,78,111,
+114,109,97,108,41,59,13,10,32,32,32,32,118,102,95,67,111,108,111,114,32,32,32,32,32,32,32,32,61,32,97,95,67,111,108,111,114,59,13,10,13,10,32,32,32,32,47,47,32,67,
+97,108,99,117,108,97,116,101,32,97,110,100,32,97,115,115,105,103,110,32,112,111,115,105,116,105,111,110,13,10,32,32,32,32,103,108,95,80,111,115,105,116,105,111,110,32,61,32,40,80,
+86,77,77,97,116,114,105,120,32,42,32,97,95,80,111,115,105,116,105,111,110,41,13,10,32,32,32,32,13,10,32,32,32,32,35,105,102,32,40,100,101,102,105,110,101,100,40,74,68,82,
+87,95,83,75,89,66,79,88,41,32,124,124,32,100,101,102,105,110,101,100,40,74,68,82,87,95,83,75,89,83,80,72,69,82,69,41,41,13,10,32,32,32,32,32,32,32,32,46,120,121,
+119,119,13,10,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,59,13,10,13,10,32,32,32,32,47,47,32,71,111,117,114,97,117,100,47,102,108,97,116,32,108,105,103,104,116,
+105,110,103,13,10,32,32,32,32,35,105,102,100,101,102,32,74,77,65,84,95,71,79,85,82,65,85,68,13,10,13,10,32,32,32,32,32,32,32,32,118,102,95,65,109,98,68,105,102,102,
+76,105,103,104,116,32,61,32,118,101,99,51,40,48,46,48,41,59,13,10,32,32,32,32,32,32,32,32,118,102,95,83,112,101,99,76,105,103,104,116,32,61,32,118,101,99,51,40,48,46,
+48,41,59,13,10,13,10,32,32,32,32,32,32,32,32,105,102,32,40,117,95,82,101,99,101,105,118,101,76,105,103,104,116,115,41,13,10,32,32,32,32,32,32,32,32,123,13,10,32,32,
+32,32,32,32,32,32,32,32,32,32,118,101,99,51,32,108,105,103,104,116,91,51,93,59,13,10,13,10,32,32,32,32,32,32,32,32,35,105,102,32,74,77,65,84,95,77,65,88,95,80,
+79,73,78,84,95,76,73,71,72,84,83,32,62,32,48,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,80,111,105,110,116,32,108,105,103,104,116,115,13,10,32,32,
+32,32,32,32,32,32,32,32,32,32,102,111,114,32,40,105,110,116,32,105,32,61,32,48,59,32,105,32,60,32,74,79,80,95,80,79,73,78,84,95,76,73,77,73,84,59,32,43,43,105,
+41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,106,111,112,95,67,97,108,99,117,108,97,116,101,80,111,105,
+110,116,76,105,103,104,116,40,105,44,32,49,46,48,44,32,108,105,103,104,116,91,48,93,44,32,108,105,103,104,116,91,49,93,44,32,108,105,103,104,116,91,50,93,41,59,13,10,13,10,
+32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,102,95,65,109,98,68,105,102,102,76,105,103,104,116,32,43,61,32,108,105,103,104,116,91,48,93,32,43,32,108,105,103,104,
+116,91,49,93,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,102,95,83,112,101,99,76,105,103,104,116,32,43,61,32,108,105,103,104,116,91,50,93,59,13,10,
+32,32,32,32,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,32,32,32,32,13,10,32,32,32,32,32,32,32,
+32,35,105,102,32,74,77,65,84,95,77,65,88,95,68,73,82,69,67,84,73,79,78,65,76,95,76,73,71,72,84,83,32,62,32,48,13,10,13,10,32,32,32,32,32,32,32,32,32,32,
+32,32,47,47,32,68,105,114,101,99,116,105,111,110,97,108,32,108,105,103,104,116,115,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,111,114,32,40,105,110,116,32,105,32,61,32,
+48,59,32,105,32,60,32,74,79,80,95,68,73,82,95,76,73,77,73,84,59,32,43,43,105,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,
+32,32,32,32,32,32,32,32,32,106,111,112,95,67,97,108,99,117,108,97,116,101,68,105,114,101,99,116,105,111,110,97,108,76,105,103,104,116,40,105,44,32,49,46,48,44,32,108,105,103,
+104,116,91,48,93,44,32,108,105,103,104,116,91,49,93,44,32,108,105,103,104,116,91,50,93,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,102,95,
+65,109,98,68,105,102,102,76,105,103,104,116,32,43,61,32,108,105,103,104,116,91,48,93,32,43,32,108,105,103,104,116,91,49,93,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,
+32,32,32,32,118,102,95,83,112,101,99,76,105,103,104,116,32,43,61,32,108,105,103,104,116,91,50,93,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,
+32,32,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,13,10,32,32,32,32,32,32,32,32,35,105,102,32,74,77,65,84,95,77,
+65,88,95,83,80,79,84,95,76,73,71,72,84,83,32,62,32,48,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,83,112,111,116,32,108,105,103,104,116,115,13,10,
+32,32,32,32,32,32,32,32,32,32,32,32,102,111,114,32,40,105,110,116,32,105,32,61,32,48,59,32,105,32,60,32,74,79,80,95,83,80,79,84,95,76,73,77,73,84,59,32,43,43,
+105,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,106,111,112,95,67,97,108,99,117,108,97,116,101,83,112,
+111,116,76,105,103,104,116,40,105,44,32,49,46,48,44,32,108,105,103,104,116,91,48,93,44,32,108,105,103,104,116,91,49,93,44,32,108,105,103,104,116,91,50,93,41,59,13,10,32,32,
+32,32,32,32,32,32,32,32,32,32,32,32,32,32,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,102,95,65,109,98,68,105,102,102,76,105,103,104,116,32,43,61,
+32,108,105,103,104,116,91,48,93,32,43,32,108,105,103,104,116,91,49,93,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,102,95,83,112,101,99,76,105,103,104,
+116,32,43,61,32,108,105,103,104,116,91,50,93,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,32,
+32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,35,101,110,100,105,102,13,10,125,
 };
 
-const unsigned char depthRecordShaderFrag[811] =
+const unsigned char depthRecordShaderFrag[1291] =
 {
 47,47,32,74,79,80,78,65,76,32,68,69,80,84,72,32,82,69,67,79,82,68,32,83,72,65,68,69,82,13,10,47,47,13,10,47,47,32,74,111,112,110,97,108,32,108,105,99,101,110,
 115,101,32,97,112,112,108,105,101,115,13,10,13,10,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,
-47,47,47,47,47,47,47,47,47,47,13,10,13,10,35,105,102,100,101,102,32,74,79,80,95,80,65,67,75,95,68,69,80,84,72,13,10,13,10,32,32,32,32,118,97,114,121,105,110,103,
-32,118,101,99,52,32,118,102,95,80,111,115,105,116,105,111,110,59,13,10,13,10,35,101,110,100,105,102,13,10,13,10,118,111,105,100,32,109,97,105,110,40,41,13,10,123,13,10,32,32,
-32,32,47,47,32,68,101,112,116,104,32,114,101,99,111,114,100,105,110,103,32,104,97,112,112,101,110,115,32,97,117,116,111,109,97,116,105,99,97,108,108,121,44,32,117,110,108,101,115,115,
-32,100,101,112,116,104,32,116,101,120,116,117,114,101,115,32,97,114,101,32,117,110,115,117,112,112,111,114,116,101,100,44,13,10,32,32,32,32,47,47,32,105,110,32,119,104,105,99,104,32,
-99,97,115,101,32,119,101,39,108,108,32,110,101,101,100,32,116,111,32,112,97,99,107,32,116,104,101,32,116,101,120,116,117,114,101,32,105,110,116,111,32,97,32,114,101,103,117,108,97,114,
-32,82,71,66,65,32,116,101,120,116,117,114,101,46,13,10,13,10,35,105,102,100,101,102,32,74,79,80,95,80,65,67,75,95,68,69,80,84,72,13,10,32,32,32,32,32,32,32,32,13,
-10,32,32,32,32,99,111,110,115,116,32,118,101,99,52,32,98,105,116,83,104,105,102,116,32,61,32,118,101,99,52,13,10,32,32,32,32,40,13,10,32,32,32,32,32,32,32,32,50,53,
-54,46,48,32,42,32,50,53,54,46,48,32,42,32,50,53,54,46,48,44,13,10,32,32,32,32,32,32,32,32,50,53,54,46,48,32,42,32,50,53,54,46,48,44,13,10,32,32,32,32,
-32,32,32,32,50,53,54,46,48,44,13,10,32,32,32,32,32,32,32,32,49,46,48,13,10,32,32,32,32,41,59,13,10,32,32,32,32,99,111,110,115,116,32,118,101,99,52,32,98,105,
-116,77,97,115,107,32,61,32,118,101,99,52,13,10,32,32,32,32,40,13,10,32,32,32,32,32,32,32,32,48,44,13,10,32,32,32,32,32,32,32,32,49,46,48,32,47,32,50,53,54,
-46,48,44,13,10,32,32,32,32,32,32,32,32,49,46,48,32,47,32,50,53,54,46,48,44,13,10,32,32,32,32,32,32,32,32,49,46,48,32,47,32,50,53,54,46,48,13,10,32,32,
-32,32,41,59,13,10,13,10,32,32,32,32,118,101,99,52,32,99,111,109,112,32,61,32,102,114,97,99,116,40,40,118,80,111,115,105,116,105,111,110,46,122,32,47,32,118,80,111,115,105,
-116,105,111,110,46,119,32,43,32,49,46,48,41,32,42,32,48,46,53,32,42,32,98,105,116,83,104,105,102,116,41,59,13,10,32,32,32,32,99,111,109,112,32,45,61,32,99,111,109,112,
-46,120,120,121,122,32,42,32,98,105,116,77,97,115,107,59,13,10,32,32,32,32,13,10,32,32,32,32,103,108,95,70,114,97,103,67,111,108,111,114,32,61,32,99,111,109,112,59,13,10,
-13,10,35,101,110,100,105,102,13,10,125,
+47,47,47,47,47,47,47,47,47,47,13,10,13,10,35,105,110,99,108,117,100,101,32,60,74,111,112,110,97,108,47,67,111,109,112,97,116,47,86,97,114,121,105,110,103,115,62,13,10,13,
+10,35,105,102,100,101,102,32,74,79,80,95,80,65,67,75,95,68,69,80,84,72,13,10,13,10,32,32,32,32,118,97,114,121,105,110,103,32,118,101,99,52,32,118,102,95,80,111,115,105,
+116,105,111,110,59,13,10,13,10,35,101,110,100,105,102,13,10,13,10,35,105,102,100,101,102,32,74,79,80,95,76,73,78,69,65,82,95,68,69,80,84,72,13,10,13,10,32,32,32,32,
+47,47,32,76,105,103,104,116,32,112,111,115,105,116,105,111,110,32,38,32,102,97,114,32,112,108,97,110,101,44,32,117,115,101,100,32,116,111,32,109,97,112,32,116,104,101,32,100,105,115,
+116,97,110,99,101,32,116,111,32,91,48,44,49,93,13,10,32,32,32,32,117,110,105,102,111,114,109,32,118,101,99,51,32,117,95,76,105,103,104,116,80,111,115,105,116,105,111,110,59,13,
+10,32,32,32,32,117,110,105,102,111,114,109,32,102,108,111,97,116,32,117,95,70,97,114,67,108,105,112,112,105,110,103,80,108,97,110,101,59,13,10,13,10,32,32,32,32,74,79,80,95,
+86,65,82,89,73,78,71,95,73,78,32,118,101,99,51,32,118,102,95,87,111,114,108,100,80,111,115,105,116,105,111,110,59,13,10,13,10,35,101,110,100,105,102,13,10,13,10,118,111,105,
+100,32,109,97,105,110,40,41,13,10,123,13,10,32,32,32,32,47,47,32,80,111,105,110,116,32,108,105,103,104,116,32,115,104,97,100,111,119,32,109,97,112,115,32,115,116,111,114,101,32,
+116,104,101,32,100,105,115,116,97,110,99,101,32,116,111,32,116,104,101,32,108,105,103,104,116,32,105,110,115,116,101,97,100,32,111,102,32,116,104,101,32,100,101,112,116,104,13,10,13,10,
+35,105,102,100,101,102,32,74,79,80,95,76,73,78,69,65,82,95,68,69,80,84,72,13,10,13,10,32,32,32,32,103,108,95,70,114,97,103,68,101,112,116,104,32,61,32,108,101,110,103,
+116,104,40,118,102,95,87,111,114,108,100,80,111,115,105,116,105,111,110,32,45,32,117,95,76,105,103,104,116,80,111,115,105,116,105,111,110,41,32,47,32,117,95,70,97,114,67,108,105,112,
+112,105,110,103,80,108,97,110,101,59,13,10,13,10,35,101,110,100,105,102,13,10,13,10,32,32,32,32,47,47,32,68,101,112,116,104,32,114,101,99,111,114,100,105,110,103,32,104,97,112,
+112,101,110,115,32,97,117,116,111,109,97,116,105,99,97,108,108,121,44,32,117,110,108,101,115,115,32,100,101,112,116,104,32,116,101,120,116,117,114,101,115,32,97,114,101,32,117,110,115,117,
+112,112,111,114,116,101,100,44,13,10,32,32,32,32,47,47,32,105,110,32,119,104,105,99,104,32,99,97,115,101,32,119,101,39,108,108,32,110,101,101,100,32,116,111,32,112,97,99,107,32,
+116,104,101,32,116,101,120,116,117,114,101,32,105,110,116,111,32,97,32,114,101,103,117,108,97,114,32,82,71,66,65,32,116,101,120,116,117,114,101,46,13,10,13,10,35,105,102,100,101,102,
+32,74,79,80,95,80,65,67,75,95,68,69,80,84,72,13,10,32,32,32,32,32,32,32,32,13,10,32,32,32,32,99,111,110,115,116,32,118,101,99,52,32,98,105,116,83,104,105,102,116,
+32,61,32,118,101,99,52,13,10,32,32,32,32,40,13,10,32,32,32,32,32,32,32,32,50,53,54,46,48,32,42,32,50,53,54,46,48,32,42,32,50,53,54,46,48,44,13,10,32,32,
+32,32,32,32,32,32,50,53,54,46,48,32,42,32,50,53,54,46,48,44,13,10,32,32,32,32,32,32,32,32,50,53,54,46,48,44,13,10,32,32,32,32,32,32,32,32,49,46,48,13,
+10,32,32,32,32,41,59,13,10,32,32,32,32,99,111,110,115,116,32,118,101,99,52,32,98,105,116,77,97,115,107,32,61,32,118,101,99,52,13,10,32,32,32,32,40,13,10,32,32,32,
+32,32,32,32,32,48,44,13,10,32,32,32,32,32,32,32,32,49,46,48,32,47,32,50,53,54,46,48,44,13,10,32,32,32,32,32,32,32,32,49,46,48,32,47,32,50,53,54,46,48,
+44,13,10,32,32,32,32,32,32,32,32,49,46,48,32,47,32,50,53,54,46,48,13,10,32,32,32,32,41,59,13,10,13,10,32,32,32,32,118,101,99,52,32,99,111,109,112,32,61,32,
+102,114,97,99,116,40,40,118,102,95,80,111,115,105,116,105,111,110,46,122,32,47,32,118,102,95,80,111,115,105,116,105,111,110,46,119,32,43,32,49,46,48,41,32,42,32,48,46,53,32,
+42,32,98,105,116,83,104,105,102,116,41,59,13,10,32,32,32,32,99,111,109,112,32,45,61,32,99,111,109,112,46,120,120,121,122,32,42,32,98,105,116,77,97,115,107,59,13,10,32,32,
+32,32,13,10,32,32,32,32,103,108,95,70,114,97,103,67,111,108,111,114,32,61,32,99,111,109,112,59,13,10,13,10,35,101,110,100,105,102,13,10,125,
 };
 
-const unsigned char depthRecordShaderVert[627] =
+const unsigned char depthRecordShaderVert[933] =
 {
 47,47,32,74,79,80,78,65,76,32,68,69,80,84,72,32,82,69,67,79,82,68,32,83,72,65,68,69,82,13,10,47,47,13,10,47,47,32,74,111,112,110,97,108,32,108,105,99,101,110,
 115,101,32,97,112,112,108,105,101,115,13,10,13,10,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,
 47,47,47,47,47,47,47,47,47,47,13,10,13,10,35,105,110,99,108,117,100,101,32,60,74,111,112,110,97,108,47,67,111,109,112,97,116,47,65,116,116,114,105,98,117,116,101,115,62,13,
-10,13,10,47,47,32,80,101,114,115,112,101,99,116,105,118,101,45,118,105,101,119,32,40,108,105,103,104,116,32,115,112,97,99,101,41,32,109,97,116,114,105,120,13,10,117,110,105,102,111,
-114,109,32,109,97,116,52,32,117,95,80,86,77,97,116,114,105,120,59,13,10,13,10,47,47,32,77,111,100,101,108,32,109,97,116,114,105,120,13,10,117,110,105,102,111,114,109,32,109,97,
-116,52,32,97,95,77,77,97,116,114,105,120,59,13,10,13,10,47,47,32,80,111,115,105,116,105,111,110,32,97,116,116,114,105,98,117,116,101,13,10,74,79,80,95,65,84,84,82,73,66,
-85,84,69,40,48,41,32,118,101,99,51,32,97,95,80,111,115,105,116,105,111,110,59,13,10,13,10,47,47,32,78,111,32,110,101,101,100,32,102,111,114,32,99,111,109,112,97,116,105,98,
-105,108,105,116,121,32,108,97,121,101,114,44,32,116,104,105,115,32,119,105,108,108,32,111,110,108,121,32,104,97,112,112,101,110,13,10,47,47,32,111,110,32,71,76,69,83,32,50,46,48,
-13,10,35,105,102,100,101,102,32,74,79,80,95,80,65,67,75,95,68,69,80,84,72,13,10,32,32,32,32,118,97,114,121,105,110,103,32,118,101,99,52,32,118,102,95,80,111,115,105,116,
-105,111,110,59,13,10,35,101,110,100,105,102,13,10,13,10,118,111,105,100,32,109,97,105,110,40,41,13,10,123,13,10,32,32,32,32,103,108,95,80,111,115,105,116,105,111,110,32,61,32,
-117,95,80,86,77,97,116,114,105,120,32,42,32,97,95,77,77,97,116,114,105,120,32,42,32,118,101,99,52,40,97,95,80,111,115,105,116,105,111,110,44,32,49,46,48,41,59,13,10,13,
-10,32,32,32,32,35,105,102,100,101,102,32,74,79,80,95,80,65,67,75,95,68,69,80,84,72,13,10,32,32,32,32,32,32,32,32,118,102,95,80,111,115,105,116,105,111,110,32,61,32,
-103,108,95,80,111,115,105,116,105,111,110,59,13,10,32,32,32,32,35,101,110,100,105,102,13,10,125,
+10,35,105,110,99,108,117,100,101,32,60,74,111,112,110,97,108,47,67,111,109,112,97,116,47,86,97,114,121,105,110,103,115,62,13,10,13,10,47,47,32,80,101,114,115,112,101,99,116,105,
+118,101,45,118,105,101,119,32,40,108,105,103,104,116,32,115,112,97,99,101,41,32,109,97,116,114,105,120,13,10,117,110,105,102,111,114,109,32,109,97,116,52,32,117,95,80,86,77,97,116,
+114,105,120,59,13,10,13,10,47,47,32,77,111,100,101,108,32,109,97,116,114,105,120,13,10,117,110,105,102,111,114,109,32,109,97,116,52,32,97,95,77,77,97,116,114,105,120,59,13,10,
+13,10,47,47,32,80,111,115,105,116,105,111,110,32,97,116,116,114,105,98,117,116,101,13,10,74,79,80,95,65,84,84,82,73,66,85,84,69,40,48,41,32,118,101,99,51,32,97,95,80,
+111,115,105,116,105,111,110,59,13,10,13,10,47,47,32,78,111,32,110,101,101,100,32,102,111,114,32,99,111,109,112,97,116,105,98,105,108,105,116,121,32,108,97,121,101,114,44,32,116,104,
+105,115,32,119,105,108,108,32,111,110,108,121,32,104,97,112,112,101,110,13,10,47,47,32,111,110,32,71,76,69,83,32,50,46,48,13,10,35,105,102,100,101,102,32,74,79,80,95,80,65,
+67,75,95,68,69,80,84,72,13,10,32,32,32,32,118,97,114,121,105,110,103,32,118,101,99,52,32,118,102,95,80,111,115,105,116,105,111,110,59,13,10,35,101,110,100,105,102,13,10,13,
+10,47,47,32,87,111,114,108,100,32,112,111,115,105,116,105,111,110,44,32,112,111,105,110,116,32,108,105,103,104,116,115,32,114,101,99,111,114,100,32,116,104,101,32,100,105,115,116,97,110,
+99,101,32,116,111,32,105,116,13,10,35,105,102,100,101,102,32,74,79,80,95,76,73,78,69,65,82,95,68,69,80,84,72,13,10,32,32,32,32,74,79,80,95,86,65,82,89,73,78,71,
+95,79,85,84,32,118,101,99,51,32,118,102,95,87,111,114,108,100,80,111,115,105,116,105,111,110,59,13,10,35,101,110,100,105,102,13,10,13,10,118,111,105,100,32,109,97,105,110,40,41,
+13,10,123,13,10,32,32,32,32,118,101,99,52,32,119,111,114,108,100,80,111,115,105,116,105,111,110,32,61,32,97,95,77,77,97,116,114,105,120,32,42,32,118,101,99,52,40,97,95,80,
+111,115,105,116,105,111,110,44,32,49,46,48,41,59,13,10,13,10,32,32,32,32,103,108,95,80,111,115,105,116,105,111,110,32,61,32,117,95,80,86,77,97,116,114,105,120,32,42,32,119,
+111,114,108,100,80,111,115,105,116,105,111,110,59,13,10,13,10,32,32,32,32,35,105,102,100,101,102,32,74,79,80,95,80,65,67,75,95,68,69,80,84,72,13,10,32,32,32,32,32,32,
+32,32,118,102,95,80,111,115,105,116,105,111,110,32,61,32,103,108,95,80,111,115,105,116,105,111,110,59,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,35,105,
+102,100,101,102,32,74,79,80,95,76,73,78,69,65,82,95,68,69,80,84,72,13,10,32,32,32,32,32,32,32,32,118,102,95,87,111,114,108,100,80,111,115,105,116,105,111,110,32,61,32,
+119,111,114,108,100,80,111,115,105,116,105,111,110,46,120,121,122,59,13,10,32,32,32,32,35,101,110,100,105,102,13,10,125,
 };
 
 const unsigned char gaussianBlurShaderFrag[1354] =
@@ -5561,7 +5600,7 @@ const unsigned char physicsDebugShaderVert[598] =
 10,32,32,32,32,47,47,32,65,115,115,105,103,110,32,99,111,108,111,114,13,10,32,32,32,32,118,102,95,67,111,108,111,114,32,61,32,97,95,67,111,108,111,114,59,13,10,125,
 };
 
-const unsigned char postProcessFrag[1222] =
+const unsigned char postProcessFrag[1132] =
 {
 47,47,32,74,79,80,78,65,76,32,80,79,83,84,32,80,82,79,67,69,83,83,32,70,82,65,71,77,69,78,84,32,83,72,65,68,69,82,13,10,47,47,13,10,47,47,32,74,111,112,
 110,97,108,32,108,105,99,101,110,115,101,32,97,112,112,108,105,101,115,13,10,13,10,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,47,
@@ -5571,23 +5610,21 @@ const unsigned char postProcessFrag[1222] =
 118,101,99,50,32,118,102,95,84,101,120,67,111,111,114,100,115,59,13,10,13,10,117,110,105,102,111,114,109,32,115,97,109,112,108,101,114,50,68,32,117,95,83,99,101,110,101,59,13,10,
 13,10,117,110,105,102,111,114,109,32,102,108,111,97,116,32,117,95,69,120,112,111,115,117,114,101,59,13,10,117,110,105,102,111,114,109,32,115,97,109,112,108,101,114,50,68,32,117,95,68,
 105,116,104,101,114,77,97,116,114,105,120,59,13,10,117,110,105,102,111,114,109,32,102,108,111,97,116,32,117,95,71,97,109,109,97,59,13,10,13,10,35,105,102,100,101,102,32,74,80,80,
-95,66,76,79,79,77,13,10,32,32,32,32,117,110,105,102,111,114,109,32,115,97,109,112,108,101,114,50,68,32,117,95,66,108,111,111,109,91,74,80,80,95,66,76,79,79,77,95,84,69,
-88,84,85,82,69,83,93,59,13,10,35,101,110,100,105,102,13,10,13,10,74,79,80,95,67,79,76,79,82,95,79,85,84,40,48,41,13,10,13,10,118,111,105,100,32,109,97,105,110,40,
-41,13,10,123,13,10,32,32,32,32,118,101,99,52,32,116,101,109,112,67,111,108,111,114,32,61,32,74,79,80,95,84,69,88,84,85,82,69,95,50,68,40,117,95,83,99,101,110,101,44,
-32,118,102,95,84,101,120,67,111,111,114,100,115,41,59,13,10,13,10,32,32,32,32,35,105,102,100,101,102,32,74,80,80,95,66,76,79,79,77,13,10,13,10,32,32,32,32,32,32,32,
-32,102,111,114,32,40,105,110,116,32,105,32,61,32,48,59,32,105,32,60,32,105,110,116,40,117,95,66,108,111,111,109,46,108,101,110,103,116,104,40,41,41,59,32,43,43,105,41,13,10,
-32,32,32,32,32,32,32,32,32,32,32,32,116,101,109,112,67,111,108,111,114,32,43,61,32,40,74,79,80,95,84,69,88,84,85,82,69,95,50,68,40,117,95,66,108,111,111,109,91,105,
-93,44,32,118,102,95,84,101,120,67,111,111,114,100,115,41,41,59,13,10,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,116,101,109,112,67,111,108,111,114,32,
-61,32,118,101,99,52,40,13,10,32,32,32,32,32,32,32,32,13,10,32,32,32,32,35,105,102,100,101,102,32,74,80,80,95,84,79,78,69,77,65,80,13,10,32,32,32,32,32,32,32,
-32,118,101,99,51,40,49,46,48,41,32,45,32,101,120,112,40,45,116,101,109,112,67,111,108,111,114,46,114,103,98,32,42,32,117,95,69,120,112,111,115,117,114,101,41,13,10,32,32,32,
-32,35,101,108,115,101,13,10,32,32,32,32,32,32,32,32,116,101,109,112,67,111,108,111,114,46,114,103,98,13,10,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,44,32,49,
-46,48,41,59,13,10,13,10,32,32,32,32,35,105,102,100,101,102,32,74,80,80,95,68,73,84,72,69,82,13,10,32,32,32,32,32,32,32,32,116,101,109,112,67,111,108,111,114,32,43,
-61,32,118,101,99,52,40,74,79,80,95,84,69,88,84,85,82,69,95,50,68,40,117,95,68,105,116,104,101,114,77,97,116,114,105,120,44,32,103,108,95,70,114,97,103,67,111,111,114,100,
-46,120,121,32,47,32,56,46,48,41,46,114,32,47,32,54,52,46,48,32,45,32,40,49,46,48,32,47,32,49,50,56,46,48,41,41,59,13,10,32,32,32,32,35,101,110,100,105,102,13,
-10,13,10,32,32,32,32,74,79,80,95,70,82,65,71,95,67,79,76,79,82,40,48,41,32,61,13,10,13,10,32,32,32,32,35,105,102,100,101,102,32,74,80,80,95,71,65,77,77,65,
-67,79,82,82,69,67,84,73,79,78,13,10,32,32,32,32,32,32,32,32,118,101,99,52,40,112,111,119,40,116,101,109,112,67,111,108,111,114,46,114,103,98,44,32,118,101,99,51,40,49,
-46,48,32,47,32,117,95,71,97,109,109,97,41,41,44,32,49,46,48,41,13,10,32,32,32,32,35,101,108,115,101,13,10,32,32,32,32,32,32,32,32,116,101,109,112,67,111,108,111,114,
-13,10,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,59,13,10,125,
+95,66,76,79,79,77,13,10,32,32,32,32,117,110,105,102,111,114,109,32,115,97,109,112,108,101,114,50,68,32,117,95,66,108,111,111,109,59,13,10,35,101,110,100,105,102,13,10,13,10,
+74,79,80,95,67,79,76,79,82,95,79,85,84,40,48,41,13,10,13,10,118,111,105,100,32,109,97,105,110,40,41,13,10,123,13,10,32,32,32,32,118,101,99,52,32,116,101,109,112,67,
+111,108,111,114,32,61,32,74,79,80,95,84,69,88,84,85,82,69,95,50,68,40,117,95,83,99,101,110,101,44,32,118,102,95,84,101,120,67,111,111,114,100,115,41,59,13,10,13,10,32,
+32,32,32,35,105,102,100,101,102,32,74,80,80,95,66,76,79,79,77,13,10,32,32,32,32,32,32,32,32,116,101,109,112,67,111,108,111,114,32,43,61,32,74,79,80,95,84,69,88,84,
+85,82,69,95,50,68,40,117,95,66,108,111,111,109,44,32,118,102,95,84,101,120,67,111,111,114,100,115,41,59,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,
+116,101,109,112,67,111,108,111,114,32,61,32,118,101,99,52,40,13,10,32,32,32,32,32,32,32,32,13,10,32,32,32,32,35,105,102,100,101,102,32,74,80,80,95,84,79,78,69,77,65,
+80,13,10,32,32,32,32,32,32,32,32,118,101,99,51,40,49,46,48,41,32,45,32,101,120,112,40,45,116,101,109,112,67,111,108,111,114,46,114,103,98,32,42,32,117,95,69,120,112,111,
+115,117,114,101,41,13,10,32,32,32,32,35,101,108,115,101,13,10,32,32,32,32,32,32,32,32,116,101,109,112,67,111,108,111,114,46,114,103,98,13,10,32,32,32,32,35,101,110,100,105,
+102,13,10,32,32,32,32,44,32,49,46,48,41,59,13,10,13,10,32,32,32,32,35,105,102,100,101,102,32,74,80,80,95,68,73,84,72,69,82,13,10,32,32,32,32,32,32,32,32,116,
+101,109,112,67,111,108,111,114,32,43,61,32,118,101,99,52,40,74,79,80,95,84,69,88,84,85,82,69,95,50,68,40,117,95,68,105,116,104,101,114,77,97,116,114,105,120,44,32,103,108,
+95,70,114,97,103,67,111,111,114,100,46,120,121,32,47,32,56,46,48,41,46,114,32,47,32,54,52,46,48,32,45,32,40,49,46,48,32,47,32,49,50,56,46,48,41,41,59,13,10,32,
+32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,74,79,80,95,70,82,65,71,95,67,79,76,79,82,40,48,41,32,61,13,10,13,10,32,32,32,32,35,105,102,100,101,102,
+32,74,80,80,95,71,65,77,77,65,67,79,82,82,69,67,84,73,79,78,13,10,32,32,32,32,32,32,32,32,118,101,99,52,40,112,111,119,40,116,101,109,112,67,111,108,111,114,46,114,
+103,98,44,32,118,101,99,51,40,49,46,48,32,47,32,117,95,71,97,109,109,97,41,41,44,32,49,46,48,41,13,10,32,32,32,32,35,101,108,115,101,13,10,32,32,32,32,32,32,32,
+32,116,101,109,112,67,111,108,111,114,13,10,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,59,13,10,125,
 };
 
 const unsigned char postProcessVert[400] =
@@ -5685,150 +5722,231 @@ const unsigned char compatibilityPlugins[2059] =
 112,108,117,103,105,110,101,110,100,
 };
 
-const unsigned char lightingPlugins[6920] =
+const unsigned char lightingPlugins[10960] =
 {
 47,47,32,74,111,112,110,97,108,32,108,105,103,104,116,105,110,103,32,115,104,97,100,101,114,32,112,108,117,103,105,110,32,102,105,108,101,13,10,47,47,13,10,47,47,32,74,111,112,110,
 97,108,32,108,105,99,101,110,115,101,32,97,112,112,108,105,101,115,46,13,10,13,10,47,47,32,82,101,113,117,105,114,101,100,32,117,110,105,102,111,114,109,115,32,102,111,114,32,108,105,
 103,104,116,105,110,103,32,99,97,108,99,117,108,97,116,105,111,110,115,13,10,47,47,13,10,47,47,32,82,101,113,117,105,114,101,100,32,98,121,32,98,111,116,104,32,108,105,103,104,116,
 105,110,103,32,97,110,100,32,115,104,97,100,111,119,115,13,10,47,47,13,10,35,112,108,117,103,105,110,32,60,74,111,112,110,97,108,47,68,101,102,97,117,108,116,76,105,103,104,116,105,
 110,103,47,85,110,105,102,111,114,109,115,62,13,10,13,10,32,32,32,32,35,105,110,99,108,117,100,101,32,60,74,111,112,110,97,108,47,68,101,102,97,117,108,116,76,105,103,104,116,105,
-110,103,47,83,116,114,117,99,116,117,114,101,115,62,13,10,13,10,32,32,32,32,117,110,105,102,111,114,109,32,77,97,116,101,114,105,97,108,32,117,95,77,97,116,101,114,105,97,108,59,
-13,10,13,10,32,32,32,32,35,105,102,32,74,77,65,84,95,77,65,88,95,80,79,73,78,84,95,76,73,71,72,84,83,32,62,32,48,13,10,13,10,32,32,32,32,32,32,32,32,117,
-110,105,102,111,114,109,32,80,111,105,110,116,76,105,103,104,116,73,110,102,111,32,117,95,80,111,105,110,116,76,105,103,104,116,115,91,74,77,65,84,95,77,65,88,95,80,79,73,78,84,
-95,76,73,71,72,84,83,93,59,13,10,32,32,32,32,32,32,32,32,117,110,105,102,111,114,109,32,105,110,116,32,117,95,78,117,109,80,111,105,110,116,76,105,103,104,116,115,59,13,10,
-13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,35,105,102,32,74,77,65,84,95,77,65,88,95,83,80,79,84,95,76,73,71,72,84,83,32,62,32,48,13,10,
-13,10,32,32,32,32,32,32,32,32,117,110,105,102,111,114,109,32,83,112,111,116,76,105,103,104,116,73,110,102,111,32,117,95,83,112,111,116,76,105,103,104,116,115,91,74,77,65,84,95,
-77,65,88,95,83,80,79,84,95,76,73,71,72,84,83,93,59,13,10,32,32,32,32,32,32,32,32,117,110,105,102,111,114,109,32,105,110,116,32,117,95,78,117,109,83,112,111,116,76,105,
-103,104,116,115,59,13,10,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,35,105,102,32,74,77,65,84,95,77,65,88,95,68,73,82,69,67,84,73,79,78,65,
-76,95,76,73,71,72,84,83,32,62,32,48,13,10,13,10,32,32,32,32,32,32,32,32,117,110,105,102,111,114,109,32,68,105,114,101,99,116,105,111,110,97,108,76,105,103,104,116,73,110,
-102,111,32,117,95,68,105,114,101,99,116,105,111,110,97,108,76,105,103,104,116,115,91,74,77,65,84,95,77,65,88,95,68,73,82,69,67,84,73,79,78,65,76,95,76,73,71,72,84,83,
-93,59,13,10,32,32,32,32,32,32,32,32,117,110,105,102,111,114,109,32,105,110,116,32,117,95,78,117,109,68,105,114,101,99,116,105,111,110,97,108,76,105,103,104,116,115,59,13,10,13,
-10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,35,112,108,117,103,105,110,101,110,100,13,10,13,10,47,47,32,68,101,102,97,117,108,116,32,108,105,103,104,116,105,110,103,32,102,
-117,110,99,116,105,111,110,115,13,10,47,47,13,10,47,47,13,10,35,112,108,117,103,105,110,32,60,74,111,112,110,97,108,47,68,101,102,97,117,108,116,76,105,103,104,116,105,110,103,47,
-76,105,103,104,116,105,110,103,62,13,10,13,10,32,32,32,32,35,105,102,32,74,77,65,84,95,77,65,88,95,80,79,73,78,84,95,76,73,71,72,84,83,32,62,32,48,13,10,32,32,
-32,32,32,32,32,32,13,10,32,32,32,32,32,32,32,32,47,47,32,80,111,105,110,116,32,108,105,103,104,116,32,99,97,108,99,117,108,97,116,105,111,110,13,10,32,32,32,32,32,32,
-32,32,118,111,105,100,32,106,111,112,95,67,97,108,99,117,108,97,116,101,80,111,105,110,116,76,105,103,104,116,40,99,111,110,115,116,32,105,110,32,105,110,116,32,105,110,100,101,120,44,
-32,99,111,110,115,116,32,105,110,32,102,108,111,97,116,32,115,104,105,110,105,110,101,115,115,77,117,108,116,44,32,111,117,116,32,118,101,99,51,32,97,109,98,105,101,110,116,44,32,111,
-117,116,32,118,101,99,51,32,100,105,102,102,117,115,101,44,32,111,117,116,32,118,101,99,51,32,115,112,101,99,117,108,97,114,41,13,10,32,32,32,32,32,32,32,32,123,13,10,32,32,
-32,32,32,32,32,32,32,32,32,32,80,111,105,110,116,76,105,103,104,116,73,110,102,111,32,108,32,61,32,117,95,80,111,105,110,116,76,105,103,104,116,115,91,105,110,100,101,120,93,59,
-13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,105,102,32,95,95,86,69,82,83,73,79,78,95,95,32,60,32,51,48,48,13,10,13,10,32,32,32,32,32,32,32,32,32,
-32,32,32,32,32,32,32,105,102,32,40,33,108,46,101,110,97,98,108,101,100,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,
-32,32,32,32,32,32,32,32,32,32,32,32,32,97,109,98,105,101,110,116,32,61,32,118,101,99,51,40,48,46,48,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,
-32,32,32,32,32,100,105,102,102,117,115,101,32,61,32,118,101,99,51,40,48,46,48,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,115,112,101,
-99,117,108,97,114,32,61,32,118,101,99,51,40,48,46,48,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,32,32,32,32,32,
-32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,68,105,114,101,99,116,105,111,110,32,102,114,111,109,32,102,114,97,103,109,101,110,
-116,32,116,111,32,108,105,103,104,116,13,10,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,32,108,105,103,104,116,68,105,114,32,61,32,110,111,114,109,97,108,105,122,101,40,
-108,46,112,111,115,105,116,105,111,110,32,45,32,118,102,95,80,111,115,105,116,105,111,110,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,68,105,114,101,99,
-116,105,111,110,32,102,114,111,109,32,102,114,97,103,109,101,110,116,32,116,111,32,101,121,101,13,10,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,32,118,105,101,119,68,105,
-114,32,61,32,110,111,114,109,97,108,105,122,101,40,45,118,102,95,80,111,115,105,116,105,111,110,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,67,97,108,
-99,117,108,97,116,101,32,114,101,102,108,101,99,116,105,111,110,32,100,105,114,101,99,116,105,111,110,32,40,117,115,101,32,97,32,104,97,108,102,45,119,97,121,32,118,101,99,116,111,114,
-41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,32,114,101,102,108,101,99,116,68,105,114,32,61,32,110,111,114,109,97,108,105,122,101,40,108,105,103,104,116,68,105,
-114,32,43,32,118,105,101,119,68,105,114,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,65,109,98,105,101,110,116,32,105,109,112,97,99,116,13,10,32,32,
-32,32,32,32,32,32,32,32,32,32,97,109,98,105,101,110,116,32,61,32,108,46,97,109,98,105,101,110,116,32,42,32,118,101,99,51,40,117,95,77,97,116,101,114,105,97,108,46,97,109,
-98,105,101,110,116,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,68,105,102,102,117,115,101,32,105,109,112,97,99,116,13,10,32,32,32,32,32,32,32,32,
-32,32,32,32,102,108,111,97,116,32,100,105,102,102,32,61,32,109,97,120,40,100,111,116,40,118,102,95,78,111,114,109,97,108,44,32,108,105,103,104,116,68,105,114,41,44,32,48,46,48,
-41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,100,105,102,102,117,115,101,32,61,32,100,105,102,102,32,42,32,108,46,100,105,102,102,117,115,101,32,42,32,118,101,99,51,40,
-117,95,77,97,116,101,114,105,97,108,46,100,105,102,102,117,115,101,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,83,112,101,99,117,108,97,114,32,105,109,
-112,97,99,116,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,115,104,105,110,105,110,101,115,115,32,61,32,109,97,120,40,49,46,48,44,32,117,95,77,97,116,
-101,114,105,97,108,46,115,104,105,110,105,110,101,115,115,32,42,32,115,104,105,110,105,110,101,115,115,77,117,108,116,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,
-97,116,32,115,112,101,99,32,61,32,40,56,46,48,32,43,32,115,104,105,110,105,110,101,115,115,41,32,47,32,40,56,46,48,32,42,32,51,46,49,52,49,53,57,50,54,53,41,32,42,
-32,112,111,119,40,109,97,120,40,100,111,116,40,118,102,95,78,111,114,109,97,108,44,32,114,101,102,108,101,99,116,68,105,114,41,44,32,48,46,48,41,44,32,115,104,105,110,105,110,101,
-115,115,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,115,112,101,99,117,108,97,114,32,61,32,108,46,115,112,101,99,117,108,97,114,32,42,32,115,112,101,99,32,42,32,118,
-101,99,51,40,117,95,77,97,116,101,114,105,97,108,46,115,112,101,99,117,108,97,114,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,65,116,116,101,110,117,
-97,116,105,111,110,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,100,105,115,116,32,61,32,108,101,110,103,116,104,40,108,46,112,111,115,105,116,105,111,110,32,
-45,32,118,102,95,80,111,115,105,116,105,111,110,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,97,116,116,101,110,117,97,116,105,111,110,32,61,32,49,
-46,48,32,47,32,40,108,46,97,116,116,101,110,117,97,116,105,111,110,46,120,32,43,32,108,46,97,116,116,101,110,117,97,116,105,111,110,46,121,32,42,32,100,105,115,116,32,43,32,108,
-46,97,116,116,101,110,117,97,116,105,111,110,46,122,32,42,32,40,100,105,115,116,32,42,32,100,105,115,116,41,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,97,109,98,105,
-101,110,116,32,42,61,32,97,116,116,101,110,117,97,116,105,111,110,59,32,100,105,102,102,117,115,101,32,42,61,32,97,116,116,101,110,117,97,116,105,111,110,59,32,115,112,101,99,117,108,
-97,114,32,42,61,32,97,116,116,101,110,117,97,116,105,111,110,59,13,10,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,
-32,35,105,102,32,74,77,65,84,95,77,65,88,95,83,80,79,84,95,76,73,71,72,84,83,32,62,32,48,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,83,112,111,116,32,108,
-105,103,104,116,32,99,97,108,99,117,108,97,116,105,111,110,13,10,32,32,32,32,32,32,32,32,118,111,105,100,32,106,111,112,95,67,97,108,99,117,108,97,116,101,83,112,111,116,76,105,
-103,104,116,40,99,111,110,115,116,32,105,110,32,105,110,116,32,105,110,100,101,120,44,32,99,111,110,115,116,32,105,110,32,102,108,111,97,116,32,115,104,105,110,105,110,101,115,115,77,117,
-108,116,44,32,111,117,116,32,118,101,99,51,32,97,109,98,105,101,110,116,44,32,111,117,116,32,118,101,99,51,32,100,105,102,102,117,115,101,44,32,111,117,116,32,118,101,99,51,32,115,
-112,101,99,117,108,97,114,41,13,10,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,83,112,111,116,76,105,103,104,116,73,110,102,111,32,108,32,61,
-32,117,95,83,112,111,116,76,105,103,104,116,115,91,105,110,100,101,120,93,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,105,102,32,95,95,86,69,82,83,73,79,78,
-95,95,32,60,32,51,48,48,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,102,32,40,33,108,46,101,110,97,98,108,101,100,41,13,10,32,32,32,32,32,
-32,32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,97,109,98,105,101,110,116,32,61,32,118,101,99,51,40,48,
-46,48,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,100,105,102,102,117,115,101,32,61,32,118,101,99,51,40,48,46,48,41,59,13,10,32,32,
-32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,115,112,101,99,117,108,97,114,32,61,32,118,101,99,51,40,48,46,48,41,59,13,10,32,32,32,32,32,32,32,32,32,
-32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,68,
-105,114,101,99,116,105,111,110,32,102,114,111,109,32,102,114,97,103,109,101,110,116,32,116,111,32,108,105,103,104,116,13,10,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,32,
-108,105,103,104,116,68,105,114,32,61,32,110,111,114,109,97,108,105,122,101,40,108,46,112,111,115,105,116,105,111,110,32,45,32,118,102,95,80,111,115,105,116,105,111,110,41,59,13,10,13,
-10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,68,105,114,101,99,116,105,111,110,32,102,114,111,109,32,102,114,97,103,109,101,110,116,32,116,111,32,101,121,101,13,10,32,32,
-32,32,32,32,32,32,32,32,32,32,118,101,99,51,32,118,105,101,119,68,105,114,32,61,32,110,111,114,109,97,108,105,122,101,40,45,118,102,95,80,111,115,105,116,105,111,110,41,59,13,
-10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,67,97,108,99,117,108,97,116,101,32,114,101,102,108,101,99,116,105,111,110,32,100,105,114,101,99,116,105,111,110,32,40,
-117,115,101,32,97,32,104,97,108,102,45,119,97,121,32,118,101,99,116,111,114,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,32,114,101,102,108,101,99,116,68,105,
-114,32,61,32,110,111,114,109,97,108,105,122,101,40,108,105,103,104,116,68,105,114,32,43,32,118,105,101,119,68,105,114,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,
-47,47,32,65,109,98,105,101,110,116,32,105,109,112,97,99,116,13,10,32,32,32,32,32,32,32,32,32,32,32,32,97,109,98,105,101,110,116,32,61,32,108,46,97,109,98,105,101,110,116,
-32,42,32,118,101,99,51,40,117,95,77,97,116,101,114,105,97,108,46,97,109,98,105,101,110,116,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,68,105,102,
-102,117,115,101,32,105,109,112,97,99,116,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,100,105,102,102,32,61,32,109,97,120,40,100,111,116,40,118,102,95,78,
-111,114,109,97,108,44,32,108,105,103,104,116,68,105,114,41,44,32,48,46,48,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,100,105,102,102,117,115,101,32,61,32,108,46,100,
-105,102,102,117,115,101,32,42,32,100,105,102,102,32,42,32,118,101,99,51,40,117,95,77,97,116,101,114,105,97,108,46,100,105,102,102,117,115,101,41,59,13,10,13,10,32,32,32,32,32,
-32,32,32,32,32,32,32,47,47,32,83,112,101,99,117,108,97,114,32,105,109,112,97,99,116,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,115,104,105,110,105,
-110,101,115,115,32,61,32,109,97,120,40,49,46,48,44,32,117,95,77,97,116,101,114,105,97,108,46,115,104,105,110,105,110,101,115,115,32,42,32,115,104,105,110,105,110,101,115,115,77,117,
-108,116,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,115,112,101,99,32,61,32,40,56,46,48,32,43,32,115,104,105,110,105,110,101,115,115,41,32,47,
-32,40,56,46,48,32,42,32,51,46,49,52,49,53,57,50,54,53,41,32,42,32,112,111,119,40,109,97,120,40,100,111,116,40,118,102,95,78,111,114,109,97,108,44,32,114,101,102,108,101,
-99,116,68,105,114,41,44,32,48,46,48,41,44,32,115,104,105,110,105,110,101,115,115,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,115,112,101,99,117,108,97,114,32,61,32,
-108,46,115,112,101,99,117,108,97,114,32,42,32,115,112,101,99,32,42,32,118,101,99,51,40,117,95,77,97,116,101,114,105,97,108,46,115,112,101,99,117,108,97,114,41,59,13,10,13,10,
-32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,83,112,111,116,108,105,103,104,116,32,115,111,102,116,32,101,100,103,101,115,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,
-108,111,97,116,32,116,104,101,116,97,32,61,32,100,111,116,40,108,105,103,104,116,68,105,114,44,32,45,108,46,100,105,114,101,99,116,105,111,110,41,59,13,10,32,32,32,32,32,32,32,
-32,32,32,32,32,102,108,111,97,116,32,101,112,115,105,108,111,110,32,61,32,40,108,46,99,117,116,111,102,102,46,120,32,45,32,108,46,99,117,116,111,102,102,46,121,41,59,13,10,32,
-32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,105,110,116,101,110,115,105,116,121,32,61,32,99,108,97,109,112,40,40,116,104,101,116,97,32,45,32,108,46,99,117,116,111,
-102,102,46,121,41,32,47,32,101,112,115,105,108,111,110,44,32,48,46,48,44,32,49,46,48,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,97,109,98,105,101,110,116,32,42,
-61,32,105,110,116,101,110,115,105,116,121,59,32,100,105,102,102,117,115,101,32,42,61,32,105,110,116,101,110,115,105,116,121,59,32,115,112,101,99,117,108,97,114,32,42,61,32,105,110,116,
-101,110,115,105,116,121,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,65,116,116,101,110,117,97,116,105,111,110,13,10,32,32,32,32,32,32,32,32,32,32,32,
-32,102,108,111,97,116,32,100,105,115,116,32,61,32,108,101,110,103,116,104,40,108,46,112,111,115,105,116,105,111,110,32,45,32,118,102,95,80,111,115,105,116,105,111,110,41,59,13,10,32,
-32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,97,116,116,101,110,117,97,116,105,111,110,32,61,32,49,46,48,32,47,32,40,108,46,97,116,116,101,110,117,97,116,105,111,
-110,46,120,32,43,32,108,46,97,116,116,101,110,117,97,116,105,111,110,46,121,32,42,32,100,105,115,116,32,43,32,108,46,97,116,116,101,110,117,97,116,105,111,110,46,122,32,42,32,40,
-100,105,115,116,32,42,32,100,105,115,116,41,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,97,109,98,105,101,110,116,32,42,61,32,97,116,116,101,110,117,97,116,105,111,110,
-59,32,100,105,102,102,117,115,101,32,42,61,32,97,116,116,101,110,117,97,116,105,111,110,59,32,115,112,101,99,117,108,97,114,32,42,61,32,97,116,116,101,110,117,97,116,105,111,110,59,
-13,10,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,35,105,102,32,74,77,65,84,95,77,65,88,95,68,73,82,69,
-67,84,73,79,78,65,76,95,76,73,71,72,84,83,32,62,32,48,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,68,105,114,101,99,116,105,111,110,97,108,32,108,105,103,104,116,
-32,99,97,108,99,117,108,97,116,105,111,110,13,10,32,32,32,32,32,32,32,32,118,111,105,100,32,106,111,112,95,67,97,108,99,117,108,97,116,101,68,105,114,101,99,116,105,111,110,97,
-108,76,105,103,104,116,40,99,111,110,115,116,32,105,110,32,105,110,116,32,105,110,100,101,120,44,32,99,111,110,115,116,32,105,110,32,102,108,111,97,116,32,115,104,105,110,105,110,101,115,
-115,77,117,108,116,44,32,111,117,116,32,118,101,99,51,32,97,109,98,105,101,110,116,44,32,111,117,116,32,118,101,99,51,32,100,105,102,102,117,115,101,44,32,111,117,116,32,118,101,99,
-51,32,115,112,101,99,117,108,97,114,41,13,10,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,68,105,114,101,99,116,105,111,110,97,108,76,105,103,
-104,116,73,110,102,111,32,108,32,61,32,117,95,68,105,114,101,99,116,105,111,110,97,108,76,105,103,104,116,115,91,105,110,100,101,120,93,59,13,10,13,10,32,32,32,32,32,32,32,32,
-32,32,32,32,35,105,102,32,95,95,86,69,82,83,73,79,78,95,95,32,60,32,51,48,48,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,102,32,40,33,
-108,46,101,110,97,98,108,101,100,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,
-32,97,109,98,105,101,110,116,32,61,32,118,101,99,51,40,48,46,48,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,100,105,102,102,117,115,101,
-32,61,32,118,101,99,51,40,48,46,48,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,115,112,101,99,117,108,97,114,32,61,32,118,101,99,51,
-40,48,46,48,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,13,
-10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,68,105,114,101,99,116,105,111,110,32,102,114,111,109,32,108,105,103,104,116,32,116,111,32,102,114,97,103,109,101,110,116,46,13,
-10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,68,105,114,101,99,116,105,111,110,97,108,32,108,105,103,104,116,32,115,104,105,110,101,115,32,105,110,102,105,110,105,116,101,108,
-121,32,105,110,32,116,104,101,32,115,97,109,101,32,100,105,114,101,99,116,105,111,110,44,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,115,111,32,110,111,32,110,101,101,
-100,32,116,111,32,116,97,107,101,32,102,114,97,103,109,101,110,116,32,112,111,115,105,116,105,111,110,32,105,110,116,111,32,97,99,99,111,117,110,116,13,10,32,32,32,32,32,32,32,32,
-32,32,32,32,118,101,99,51,32,108,105,103,104,116,68,105,114,32,61,32,45,108,46,100,105,114,101,99,116,105,111,110,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,
-47,32,68,105,114,101,99,116,105,111,110,32,102,114,111,109,32,102,114,97,103,109,101,110,116,32,116,111,32,101,121,101,13,10,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,
-32,118,105,101,119,68,105,114,32,61,32,110,111,114,109,97,108,105,122,101,40,45,118,102,95,80,111,115,105,116,105,111,110,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,
-32,47,47,32,67,97,108,99,117,108,97,116,101,32,114,101,102,108,101,99,116,105,111,110,32,100,105,114,101,99,116,105,111,110,32,40,117,115,101,32,97,32,104,97,108,102,45,119,97,121,
-32,118,101,99,116,111,114,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,32,114,101,102,108,101,99,116,68,105,114,32,61,32,110,111,114,109,97,108,105,122,101,40,
-108,105,103,104,116,68,105,114,32,43,32,118,105,101,119,68,105,114,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,65,109,98,105,101,110,116,32,105,109,112,
-97,99,116,13,10,32,32,32,32,32,32,32,32,32,32,32,32,97,109,98,105,101,110,116,32,61,32,108,46,97,109,98,105,101,110,116,32,42,32,118,101,99,51,40,117,95,77,97,116,101,
-114,105,97,108,46,97,109,98,105,101,110,116,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,68,105,102,102,117,115,101,32,105,109,112,97,99,116,13,10,32,
-32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,100,105,102,102,32,61,32,109,97,120,40,100,111,116,40,118,102,95,78,111,114,109,97,108,44,32,108,105,103,104,116,68,105,
-114,41,44,32,48,46,48,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,100,105,102,102,117,115,101,32,61,32,108,46,100,105,102,102,117,115,101,32,42,32,100,105,102,102,32,
-42,32,118,101,99,51,40,117,95,77,97,116,101,114,105,97,108,46,100,105,102,102,117,115,101,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,83,112,101,99,
-117,108,97,114,32,105,109,112,97,99,116,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,115,104,105,110,105,110,101,115,115,32,61,32,109,97,120,40,49,46,48,
-44,32,117,95,77,97,116,101,114,105,97,108,46,115,104,105,110,105,110,101,115,115,32,42,32,115,104,105,110,105,110,101,115,115,77,117,108,116,41,59,13,10,32,32,32,32,32,32,32,32,
-32,32,32,32,102,108,111,97,116,32,115,112,101,99,32,61,32,40,56,46,48,32,43,32,115,104,105,110,105,110,101,115,115,41,32,47,32,40,56,46,48,32,42,32,51,46,49,52,49,53,
-57,50,54,53,41,32,42,32,112,111,119,40,109,97,120,40,100,111,116,40,118,102,95,78,111,114,109,97,108,44,32,114,101,102,108,101,99,116,68,105,114,41,44,32,48,46,48,41,44,32,
-115,104,105,110,105,110,101,115,115,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,115,112,101,99,117,108,97,114,32,61,32,108,46,115,112,101,99,117,108,97,114,32,42,32,115,
-112,101,99,32,42,32,118,101,99,51,40,117,95,77,97,116,101,114,105,97,108,46,115,112,101,99,117,108,97,114,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,
-32,78,111,32,97,116,116,101,110,117,97,116,105,111,110,32,99,97,108,99,117,108,97,116,105,111,110,115,32,104,101,114,101,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,
-68,105,114,101,99,116,105,111,110,97,108,32,76,105,103,104,116,32,105,115,32,105,110,102,105,110,105,116,101,44,32,68,105,114,101,99,116,105,111,110,97,108,32,76,105,103,104,116,32,105,
-115,32,101,116,101,114,110,97,108,13,10,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,35,105,102,32,95,95,86,69,
-82,83,73,79,78,95,95,32,62,61,32,51,48,48,13,10,32,32,32,32,32,32,32,32,35,100,101,102,105,110,101,32,74,79,80,95,80,79,73,78,84,95,76,73,77,73,84,32,117,95,
-78,117,109,80,111,105,110,116,76,105,103,104,116,115,13,10,32,32,32,32,32,32,32,32,35,100,101,102,105,110,101,32,74,79,80,95,68,73,82,95,76,73,77,73,84,32,117,95,78,117,
-109,68,105,114,101,99,116,105,111,110,97,108,76,105,103,104,116,115,13,10,32,32,32,32,32,32,32,32,35,100,101,102,105,110,101,32,74,79,80,95,83,80,79,84,95,76,73,77,73,84,
-32,117,95,78,117,109,83,112,111,116,76,105,103,104,116,115,13,10,32,32,32,32,35,101,108,115,101,13,10,32,32,32,32,32,32,32,32,35,100,101,102,105,110,101,32,74,79,80,95,80,
-79,73,78,84,95,76,73,77,73,84,32,74,77,65,84,95,77,65,88,95,80,79,73,78,84,95,76,73,71,72,84,83,13,10,32,32,32,32,32,32,32,32,35,100,101,102,105,110,101,32,
-74,79,80,95,68,73,82,95,76,73,77,73,84,32,74,77,65,84,95,77,65,88,95,68,73,82,69,67,84,73,79,78,65,76,95,76,73,71,72,84,83,13,10,32,32,32,32,32,32,32,
-32,35,100,101,102,105,110,101,32,74,79,80,95,83,80,79,84,95,76,73,77,73,84,32,74,77,65,84,95,77,65,88,95,83,80,79,84,95,76,73,71,72,84,83,13,10,32,32,32,32,
-35,101,110,100,105,102,13,10,13,10,35,112,108,117,103,105,110,101,110,100,
+110,103,47,83,116,114,117,99,116,117,114,101,115,62,13,10,32,32,32,32,35,105,110,99,108,117,100,101,32,60,74,111,112,110,97,108,47,66,108,111,99,107,115,47,76,105,103,104,116,115,
+62,13,10,32,32,32,32,35,105,110,99,108,117,100,101,32,60,74,111,112,110,97,108,47,66,108,111,99,107,115,47,77,97,116,101,114,105,97,108,62,13,10,13,10,32,32,32,32,47,47,
+32,87,105,116,104,111,117,116,32,117,110,105,102,111,114,109,32,98,108,111,99,107,115,32,101,118,101,114,121,32,118,97,108,117,101,32,105,115,32,97,110,32,105,110,100,105,118,105,100,117,
+97,108,32,117,110,105,102,111,114,109,13,10,32,32,32,32,35,105,102,110,100,101,102,32,74,79,80,95,85,78,73,70,79,82,77,95,66,76,79,67,75,83,13,10,13,10,32,32,32,32,
+32,32,32,32,117,110,105,102,111,114,109,32,77,97,116,101,114,105,97,108,32,117,95,77,97,116,101,114,105,97,108,59,13,10,13,10,32,32,32,32,32,32,32,32,35,105,102,32,74,77,
+65,84,95,77,65,88,95,80,79,73,78,84,95,76,73,71,72,84,83,32,62,32,48,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,117,110,105,102,111,114,109,32,80,111,105,
+110,116,76,105,103,104,116,73,110,102,111,32,117,95,80,111,105,110,116,76,105,103,104,116,115,91,74,77,65,84,95,77,65,88,95,80,79,73,78,84,95,76,73,71,72,84,83,93,59,13,
+10,32,32,32,32,32,32,32,32,32,32,32,32,117,110,105,102,111,114,109,32,105,110,116,32,117,95,78,117,109,80,111,105,110,116,76,105,103,104,116,115,59,13,10,13,10,32,32,32,32,
+32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,32,32,32,32,35,105,102,32,74,77,65,84,95,77,65,88,95,83,80,79,84,95,76,73,71,72,84,83,32,62,32,48,
+13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,117,110,105,102,111,114,109,32,83,112,111,116,76,105,103,104,116,73,110,102,111,32,117,95,83,112,111,116,76,105,103,104,116,115,
+91,74,77,65,84,95,77,65,88,95,83,80,79,84,95,76,73,71,72,84,83,93,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,117,110,105,102,111,114,109,32,105,110,116,32,117,
+95,78,117,109,83,112,111,116,76,105,103,104,116,115,59,13,10,13,10,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,32,32,32,32,35,105,102,32,74,
+77,65,84,95,77,65,88,95,68,73,82,69,67,84,73,79,78,65,76,95,76,73,71,72,84,83,32,62,32,48,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,117,110,105,102,
+111,114,109,32,68,105,114,101,99,116,105,111,110,97,108,76,105,103,104,116,73,110,102,111,32,117,95,68,105,114,101,99,116,105,111,110,97,108,76,105,103,104,116,115,91,74,77,65,84,95,
+77,65,88,95,68,73,82,69,67,84,73,79,78,65,76,95,76,73,71,72,84,83,93,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,117,110,105,102,111,114,109,32,105,110,116,32,
+117,95,78,117,109,68,105,114,101,99,116,105,111,110,97,108,76,105,103,104,116,115,59,13,10,13,10,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,35,
+101,110,100,105,102,13,10,13,10,35,112,108,117,103,105,110,101,110,100,13,10,13,10,47,47,32,68,101,102,97,117,108,116,32,108,105,103,104,116,105,110,103,32,102,117,110,99,116,105,111,
+110,115,13,10,47,47,13,10,47,47,13,10,35,112,108,117,103,105,110,32,60,74,111,112,110,97,108,47,68,101,102,97,117,108,116,76,105,103,104,116,105,110,103,47,76,105,103,104,116,105,
+110,103,62,13,10,13,10,32,32,32,32,35,105,102,32,74,77,65,84,95,77,65,88,95,80,79,73,78,84,95,76,73,71,72,84,83,32,62,32,48,13,10,32,32,32,32,32,32,32,32,
+13,10,32,32,32,32,32,32,32,32,47,47,32,80,111,105,110,116,32,108,105,103,104,116,32,99,97,108,99,117,108,97,116,105,111,110,13,10,32,32,32,32,32,32,32,32,118,111,105,100,
+32,106,111,112,95,67,97,108,99,117,108,97,116,101,80,111,105,110,116,76,105,103,104,116,40,99,111,110,115,116,32,105,110,32,105,110,116,32,105,110,100,101,120,44,32,99,111,110,115,116,
+32,105,110,32,102,108,111,97,116,32,115,104,105,110,105,110,101,115,115,77,117,108,116,44,32,111,117,116,32,118,101,99,51,32,97,109,98,105,101,110,116,44,32,111,117,116,32,118,101,99,
+51,32,100,105,102,102,117,115,101,44,32,111,117,116,32,118,101,99,51,32,115,112,101,99,117,108,97,114,41,13,10,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,
+32,32,32,32,80,111,105,110,116,76,105,103,104,116,73,110,102,111,32,108,32,61,32,117,95,80,111,105,110,116,76,105,103,104,116,115,91,105,110,100,101,120,93,59,13,10,13,10,32,32,
+32,32,32,32,32,32,32,32,32,32,35,105,102,32,95,95,86,69,82,83,73,79,78,95,95,32,60,32,51,48,48,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,
+32,105,102,32,40,33,108,46,101,110,97,98,108,101,100,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,
+32,32,32,32,32,32,32,97,109,98,105,101,110,116,32,61,32,118,101,99,51,40,48,46,48,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,100,
+105,102,102,117,115,101,32,61,32,118,101,99,51,40,48,46,48,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,115,112,101,99,117,108,97,114,32,
+61,32,118,101,99,51,40,48,46,48,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,101,110,
+100,105,102,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,68,105,114,101,99,116,105,111,110,32,102,114,111,109,32,102,114,97,103,109,101,110,116,32,116,111,32,108,
+105,103,104,116,13,10,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,32,108,105,103,104,116,68,105,114,32,61,32,110,111,114,109,97,108,105,122,101,40,108,46,112,111,115,105,
+116,105,111,110,32,45,32,118,102,95,80,111,115,105,116,105,111,110,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,68,105,114,101,99,116,105,111,110,32,102,
+114,111,109,32,102,114,97,103,109,101,110,116,32,116,111,32,101,121,101,13,10,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,32,118,105,101,119,68,105,114,32,61,32,110,111,
+114,109,97,108,105,122,101,40,45,118,102,95,80,111,115,105,116,105,111,110,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,67,97,108,99,117,108,97,116,101,
+32,114,101,102,108,101,99,116,105,111,110,32,100,105,114,101,99,116,105,111,110,32,40,117,115,101,32,97,32,104,97,108,102,45,119,97,121,32,118,101,99,116,111,114,41,13,10,32,32,32,
+32,32,32,32,32,32,32,32,32,118,101,99,51,32,114,101,102,108,101,99,116,68,105,114,32,61,32,110,111,114,109,97,108,105,122,101,40,108,105,103,104,116,68,105,114,32,43,32,118,105,
+101,119,68,105,114,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,65,109,98,105,101,110,116,32,105,109,112,97,99,116,13,10,32,32,32,32,32,32,32,32,
+32,32,32,32,97,109,98,105,101,110,116,32,61,32,108,46,97,109,98,105,101,110,116,32,42,32,118,101,99,51,40,117,95,77,97,116,101,114,105,97,108,46,97,109,98,105,101,110,116,41,
+59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,68,105,102,102,117,115,101,32,105,109,112,97,99,116,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,
+111,97,116,32,100,105,102,102,32,61,32,109,97,120,40,100,111,116,40,118,102,95,78,111,114,109,97,108,44,32,108,105,103,104,116,68,105,114,41,44,32,48,46,48,41,59,13,10,32,32,
+32,32,32,32,32,32,32,32,32,32,100,105,102,102,117,115,101,32,61,32,100,105,102,102,32,42,32,108,46,100,105,102,102,117,115,101,32,42,32,118,101,99,51,40,117,95,77,97,116,101,
+114,105,97,108,46,100,105,102,102,117,115,101,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,83,112,101,99,117,108,97,114,32,105,109,112,97,99,116,13,10,
+32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,115,104,105,110,105,110,101,115,115,32,61,32,109,97,120,40,49,46,48,44,32,117,95,77,97,116,101,114,105,97,108,46,
+115,104,105,110,105,110,101,115,115,32,42,32,115,104,105,110,105,110,101,115,115,77,117,108,116,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,115,112,101,
+99,32,61,32,40,56,46,48,32,43,32,115,104,105,110,105,110,101,115,115,41,32,47,32,40,56,46,48,32,42,32,51,46,49,52,49,53,57,50,54,53,41,32,42,32,112,111,119,40,109,
+97,120,40,100,111,116,40,118,102,95,78,111,114,109,97,108,44,32,114,101,102,108,101,99,116,68,105,114,41,44,32,48,46,48,41,44,32,115,104,105,110,105,110,101,115,115,41,59,13,10,
+32,32,32,32,32,32,32,32,32,32,32,32,115,112,101,99,117,108,97,114,32,61,32,108,46,115,112,101,99,117,108,97,114,32,42,32,115,112,101,99,32,42,32,118,101,99,51,40,117,95,
+77,97,116,101,114,105,97,108,46,115,112,101,99,117,108,97,114,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,65,116,116,101,110,117,97,116,105,111,110,13,
+10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,100,105,115,116,32,61,32,108,101,110,103,116,104,40,108,46,112,111,115,105,116,105,111,110,32,45,32,118,102,95,80,
+111,115,105,116,105,111,110,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,97,116,116,101,110,117,97,116,105,111,110,32,61,32,49,46,48,32,47,32,40,
+108,46,97,116,116,101,110,117,97,116,105,111,110,46,120,32,43,32,108,46,97,116,116,101,110,117,97,116,105,111,110,46,121,32,42,32,100,105,115,116,32,43,32,108,46,97,116,116,101,110,
+117,97,116,105,111,110,46,122,32,42,32,40,100,105,115,116,32,42,32,100,105,115,116,41,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,97,109,98,105,101,110,116,32,42,61,
+32,97,116,116,101,110,117,97,116,105,111,110,59,32,100,105,102,102,117,115,101,32,42,61,32,97,116,116,101,110,117,97,116,105,111,110,59,32,115,112,101,99,117,108,97,114,32,42,61,32,
+97,116,116,101,110,117,97,116,105,111,110,59,13,10,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,35,105,102,32,74,
+77,65,84,95,77,65,88,95,83,80,79,84,95,76,73,71,72,84,83,32,62,32,48,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,83,112,111,116,32,108,105,103,104,116,32,99,
+97,108,99,117,108,97,116,105,111,110,13,10,32,32,32,32,32,32,32,32,118,111,105,100,32,106,111,112,95,67,97,108,99,117,108,97,116,101,83,112,111,116,76,105,103,104,116,40,99,111,
+110,115,116,32,105,110,32,105,110,116,32,105,110,100,101,120,44,32,99,111,110,115,116,32,105,110,32,102,108,111,97,116,32,115,104,105,110,105,110,101,115,115,77,117,108,116,44,32,111,117,
+116,32,118,101,99,51,32,97,109,98,105,101,110,116,44,32,111,117,116,32,118,101,99,51,32,100,105,102,102,117,115,101,44,32,111,117,116,32,118,101,99,51,32,115,112,101,99,117,108,97,
+114,41,13,10,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,83,112,111,116,76,105,103,104,116,73,110,102,111,32,108,32,61,32,117,95,83,112,111,
+116,76,105,103,104,116,115,91,105,110,100,101,120,93,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,105,102,32,95,95,86,69,82,83,73,79,78,95,95,32,60,32,51,
+48,48,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,102,32,40,33,108,46,101,110,97,98,108,101,100,41,13,10,32,32,32,32,32,32,32,32,32,32,32,
+32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,97,109,98,105,101,110,116,32,61,32,118,101,99,51,40,48,46,48,41,59,13,10,
+32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,100,105,102,102,117,115,101,32,61,32,118,101,99,51,40,48,46,48,41,59,13,10,32,32,32,32,32,32,32,32,
+32,32,32,32,32,32,32,32,32,32,32,32,115,112,101,99,117,108,97,114,32,61,32,118,101,99,51,40,48,46,48,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,
+32,125,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,68,105,114,101,99,116,105,
+111,110,32,102,114,111,109,32,102,114,97,103,109,101,110,116,32,116,111,32,108,105,103,104,116,13,10,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,32,108,105,103,104,116,68,
+105,114,32,61,32,110,111,114,109,97,108,105,122,101,40,108,46,112,111,115,105,116,105,111,110,32,45,32,118,102,95,80,111,115,105,116,105,111,110,41,59,13,10,13,10,32,32,32,32,32,
+32,32,32,32,32,32,32,47,47,32,68,105,114,101,99,116,105,111,110,32,102,114,111,109,32,102,114,97,103,109,101,110,116,32,116,111,32,101,121,101,13,10,32,32,32,32,32,32,32,32,
+32,32,32,32,118,101,99,51,32,118,105,101,119,68,105,114,32,61,32,110,111,114,109,97,108,105,122,101,40,45,118,102,95,80,111,115,105,116,105,111,110,41,59,13,10,13,10,32,32,32,
+32,32,32,32,32,32,32,32,32,47,47,32,67,97,108,99,117,108,97,116,101,32,114,101,102,108,101,99,116,105,111,110,32,100,105,114,101,99,116,105,111,110,32,40,117,115,101,32,97,32,
+104,97,108,102,45,119,97,121,32,118,101,99,116,111,114,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,32,114,101,102,108,101,99,116,68,105,114,32,61,32,110,111,
+114,109,97,108,105,122,101,40,108,105,103,104,116,68,105,114,32,43,32,118,105,101,119,68,105,114,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,65,109,98,
+105,101,110,116,32,105,109,112,97,99,116,13,10,32,32,32,32,32,32,32,32,32,32,32,32,97,109,98,105,101,110,116,32,61,32,108,46,97,109,98,105,101,110,116,32,42,32,118,101,99,
+51,40,117,95,77,97,116,101,114,105,97,108,46,97,109,98,105,101,110,116,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,68,105,102,102,117,115,101,32,105,
+109,112,97,99,116,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,100,105,102,102,32,61,32,109,97,120,40,100,111,116,40,118,102,95,78,111,114,109,97,108,44,
+32,108,105,103,104,116,68,105,114,41,44,32,48,46,48,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,100,105,102,102,117,115,101,32,61,32,108,46,100,105,102,102,117,115,101,
+32,42,32,100,105,102,102,32,42,32,118,101,99,51,40,117,95,77,97,116,101,114,105,97,108,46,100,105,102,102,117,115,101,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,
+32,47,47,32,83,112,101,99,117,108,97,114,32,105,109,112,97,99,116,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,115,104,105,110,105,110,101,115,115,32,61,
+32,109,97,120,40,49,46,48,44,32,117,95,77,97,116,101,114,105,97,108,46,115,104,105,110,105,110,101,115,115,32,42,32,115,104,105,110,105,110,101,115,115,77,117,108,116,41,59,13,10,
+32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,115,112,101,99,32,61,32,40,56,46,48,32,43,32,115,104,105,110,105,110,101,115,115,41,32,47,32,40,56,46,48,32,
+42,32,51,46,49,52,49,53,57,50,54,53,41,32,42,32,112,111,119,40,109,97,120,40,100,111,116,40,118,102,95,78,111,114,109,97,108,44,32,114,101,102,108,101,99,116,68,105,114,41,
+44,32,48,46,48,41,44,32,115,104,105,110,105,110,101,115,115,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,115,112,101,99,117,108,97,114,32,61,32,108,46,115,112,101,99,
+117,108,97,114,32,42,32,115,112,101,99,32,42,32,118,101,99,51,40,117,95,77,97,116,101,114,105,97,108,46,115,112,101,99,117,108,97,114,41,59,13,10,13,10,32,32,32,32,32,32,
+32,32,32,32,32,32,47,47,32,83,112,111,116,108,105,103,104,116,32,115,111,102,116,32,101,100,103,101,115,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,116,
+104,101,116,97,32,61,32,100,111,116,40,108,105,103,104,116,68,105,114,44,32,45,108,46,100,105,114,101,99,116,105,111,110,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,
+108,111,97,116,32,101,112,115,105,108,111,110,32,61,32,40,108,46,99,117,116,111,102,102,46,120,32,45,32,108,46,99,117,116,111,102,102,46,121,41,59,13,10,32,32,32,32,32,32,32,
+32,32,32,32,32,102,108,111,97,116,32,105,110,116,101,110,115,105,116,121,32,61,32,99,108,97,109,112,40,40,116,104,101,116,97,32,45,32,108,46,99,117,116,111,102,102,46,121,41,32,
+47,32,101,112,115,105,108,111,110,44,32,48,46,48,44,32,49,46,48,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,97,109,98,105,101,110,116,32,42,61,32,105,110,116,101,
+110,115,105,116,121,59,32,100,105,102,102,117,115,101,32,42,61,32,105,110,116,101,110,115,105,116,121,59,32,115,112,101,99,117,108,97,114,32,42,61,32,105,110,116,101,110,115,105,116,121,
+59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,65,116,116,101,110,117,97,116,105,111,110,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,
+32,100,105,115,116,32,61,32,108,101,110,103,116,104,40,108,46,112,111,115,105,116,105,111,110,32,45,32,118,102,95,80,111,115,105,116,105,111,110,41,59,13,10,32,32,32,32,32,32,32,
+32,32,32,32,32,102,108,111,97,116,32,97,116,116,101,110,117,97,116,105,111,110,32,61,32,49,46,48,32,47,32,40,108,46,97,116,116,101,110,117,97,116,105,111,110,46,120,32,43,32,
+108,46,97,116,116,101,110,117,97,116,105,111,110,46,121,32,42,32,100,105,115,116,32,43,32,108,46,97,116,116,101,110,117,97,116,105,111,110,46,122,32,42,32,40,100,105,115,116,32,42,
+32,100,105,115,116,41,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,97,109,98,105,101,110,116,32,42,61,32,97,116,116,101,110,117,97,116,105,111,110,59,32,100,105,102,102,
+117,115,101,32,42,61,32,97,116,116,101,110,117,97,116,105,111,110,59,32,115,112,101,99,117,108,97,114,32,42,61,32,97,116,116,101,110,117,97,116,105,111,110,59,13,10,32,32,32,32,
+32,32,32,32,125,13,10,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,35,105,102,32,74,77,65,84,95,77,65,88,95,68,73,82,69,67,84,73,79,78,65,
+76,95,76,73,71,72,84,83,32,62,32,48,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,68,105,114,101,99,116,105,111,110,97,108,32,108,105,103,104,116,32,99,97,108,99,117,
+108,97,116,105,111,110,13,10,32,32,32,32,32,32,32,32,118,111,105,100,32,106,111,112,95,67,97,108,99,117,108,97,116,101,68,105,114,101,99,116,105,111,110,97,108,76,105,103,104,116,
+40,99,111,110,115,116,32,105,110,32,105,110,116,32,105,110,100,101,120,44,32,99,111,110,115,116,32,105,110,32,102,108,111,97,116,32,115,104,105,110,105,110,101,115,115,77,117,108,116,44,
+32,111,117,116,32,118,101,99,51,32,97,109,98,105,101,110,116,44,32,111,117,116,32,118,101,99,51,32,100,105,102,102,117,115,101,44,32,111,117,116,32,118,101,99,51,32,115,112,101,99,
+117,108,97,114,41,13,10,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,68,105,114,101,99,116,105,111,110,97,108,76,105,103,104,116,73,110,102,111,
+32,108,32,61,32,117,95,68,105,114,101,99,116,105,111,110,97,108,76,105,103,104,116,115,91,105,110,100,101,120,93,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,105,
+102,32,95,95,86,69,82,83,73,79,78,95,95,32,60,32,51,48,48,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,102,32,40,33,108,46,101,110,97,98,
+108,101,100,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,97,109,98,105,101,
+110,116,32,61,32,118,101,99,51,40,48,46,48,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,100,105,102,102,117,115,101,32,61,32,118,101,99,
+51,40,48,46,48,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,115,112,101,99,117,108,97,114,32,61,32,118,101,99,51,40,48,46,48,41,59,
+13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,32,
+32,32,32,32,32,32,32,47,47,32,68,105,114,101,99,116,105,111,110,32,102,114,111,109,32,108,105,103,104,116,32,116,111,32,102,114,97,103,109,101,110,116,46,13,10,32,32,32,32,32,
+32,32,32,32,32,32,32,47,47,32,68,105,114,101,99,116,105,111,110,97,108,32,108,105,103,104,116,32,115,104,105,110,101,115,32,105,110,102,105,110,105,116,101,108,121,32,105,110,32,116,
+104,101,32,115,97,109,101,32,100,105,114,101,99,116,105,111,110,44,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,115,111,32,110,111,32,110,101,101,100,32,116,111,32,116,
+97,107,101,32,102,114,97,103,109,101,110,116,32,112,111,115,105,116,105,111,110,32,105,110,116,111,32,97,99,99,111,117,110,116,13,10,32,32,32,32,32,32,32,32,32,32,32,32,118,101,
+99,51,32,108,105,103,104,116,68,105,114,32,61,32,45,108,46,100,105,114,101,99,116,105,111,110,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,68,105,114,101,
+99,116,105,111,110,32,102,114,111,109,32,102,114,97,103,109,101,110,116,32,116,111,32,101,121,101,13,10,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,32,118,105,101,119,68,
+105,114,32,61,32,110,111,114,109,97,108,105,122,101,40,45,118,102,95,80,111,115,105,116,105,111,110,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,67,97,
+108,99,117,108,97,116,101,32,114,101,102,108,101,99,116,105,111,110,32,100,105,114,101,99,116,105,111,110,32,40,117,115,101,32,97,32,104,97,108,102,45,119,97,121,32,118,101,99,116,111,
+114,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,32,114,101,102,108,101,99,116,68,105,114,32,61,32,110,111,114,109,97,108,105,122,101,40,108,105,103,104,116,68,
+105,114,32,43,32,118,105,101,119,68,105,114,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,65,109,98,105,101,110,116,32,105,109,112,97,99,116,13,10,32,
+32,32,32,32,32,32,32,32,32,32,32,97,109,98,105,101,110,116,32,61,32,108,46,97,109,98,105,101,110,116,32,42,32,118,101,99,51,40,117,95,77,97,116,101,114,105,97,108,46,97,
+109,98,105,101,110,116,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,68,105,102,102,117,115,101,32,105,109,112,97,99,116,13,10,32,32,32,32,32,32,32,
+32,32,32,32,32,102,108,111,97,116,32,100,105,102,102,32,61,32,109,97,120,40,100,111,116,40,118,102,95,78,111,114,109,97,108,44,32,108,105,103,104,116,68,105,114,41,44,32,48,46,
+48,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,100,105,102,102,117,115,101,32,61,32,108,46,100,105,102,102,117,115,101,32,42,32,100,105,102,102,32,42,32,118,101,99,51,
+40,117,95,77,97,116,101,114,105,97,108,46,100,105,102,102,117,115,101,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,83,112,101,99,117,108,97,114,32,105,
+109,112,97,99,116,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,115,104,105,110,105,110,101,115,115,32,61,32,109,97,120,40,49,46,48,44,32,117,95,77,97,
+116,101,114,105,97,108,46,115,104,105,110,105,110,101,115,115,32,42,32,115,104,105,110,105,110,101,115,115,77,117,108,116,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,
+111,97,116,32,115,112,101,99,32,61,32,40,56,46,48,32,43,32,115,104,105,110,105,110,101,115,115,41,32,47,32,40,56,46,48,32,42,32,51,46,49,52,49,53,57,50,54,53,41,32,
+42,32,112,111,119,40,109,97,120,40,100,111,116,40,118,102,95,78,111,114,109,97,108,44,32,114,101,102,108,101,99,116,68,105,114,41,44,32,48,46,48,41,44,32,115,104,105,110,105,110,
+101,115,115,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,115,112,101,99,117,108,97,114,32,61,32,108,46,115,112,101,99,117,108,97,114,32,42,32,115,112,101,99,32,42,32,
+118,101,99,51,40,117,95,77,97,116,101,114,105,97,108,46,115,112,101,99,117,108,97,114,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,78,111,32,97,116,
+116,101,110,117,97,116,105,111,110,32,99,97,108,99,117,108,97,116,105,111,110,115,32,104,101,114,101,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,68,105,114,101,99,116,
+105,111,110,97,108,32,76,105,103,104,116,32,105,115,32,105,110,102,105,110,105,116,101,44,32,68,105,114,101,99,116,105,111,110,97,108,32,76,105,103,104,116,32,105,115,32,101,116,101,114,
+110,97,108,13,10,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,35,105,102,32,95,95,86,69,82,83,73,79,78,95,
+95,32,62,61,32,51,48,48,13,10,32,32,32,32,32,32,32,32,35,100,101,102,105,110,101,32,74,79,80,95,80,79,73,78,84,95,76,73,77,73,84,32,117,95,78,117,109,80,111,105,
+110,116,76,105,103,104,116,115,13,10,32,32,32,32,32,32,32,32,35,100,101,102,105,110,101,32,74,79,80,95,68,73,82,95,76,73,77,73,84,32,117,95,78,117,109,68,105,114,101,99,
+116,105,111,110,97,108,76,105,103,104,116,115,13,10,32,32,32,32,32,32,32,32,35,100,101,102,105,110,101,32,74,79,80,95,83,80,79,84,95,76,73,77,73,84,32,117,95,78,117,109,
+83,112,111,116,76,105,103,104,116,115,13,10,32,32,32,32,35,101,108,115,101,13,10,32,32,32,32,32,32,32,32,35,100,101,102,105,110,101,32,74,79,80,95,80,79,73,78,84,95,76,
+73,77,73,84,32,74,77,65,84,95,77,65,88,95,80,79,73,78,84,95,76,73,71,72,84,83,13,10,32,32,32,32,32,32,32,32,35,100,101,102,105,110,101,32,74,79,80,95,68,73,
+82,95,76,73,77,73,84,32,74,77,65,84,95,77,65,88,95,68,73,82,69,67,84,73,79,78,65,76,95,76,73,71,72,84,83,13,10,32,32,32,32,32,32,32,32,35,100,101,102,105,
+110,101,32,74,79,80,95,83,80,79,84,95,76,73,77,73,84,32,74,77,65,84,95,77,65,88,95,83,80,79,84,95,76,73,71,72,84,83,13,10,32,32,32,32,35,101,110,100,105,102,
+13,10,13,10,35,112,108,117,103,105,110,101,110,100,13,10,13,10,47,47,32,67,108,117,115,116,101,114,101,100,32,108,105,103,104,116,105,110,103,32,102,117,110,99,116,105,111,110,115,13,
+10,47,47,13,10,47,47,32,79,110,108,121,32,117,115,101,100,32,98,121,32,116,104,101,32,112,104,111,110,103,32,115,104,97,100,101,114,115,32,119,104,101,110,32,99,108,117,115,116,101,
+114,101,100,13,10,47,47,32,108,105,103,104,116,105,110,103,32,105,115,32,101,110,97,98,108,101,100,13,10,47,47,13,10,35,112,108,117,103,105,110,32,60,74,111,112,110,97,108,47,68,
+101,102,97,117,108,116,76,105,103,104,116,105,110,103,47,67,108,117,115,116,101,114,115,62,13,10,13,10,32,32,32,32,35,105,110,99,108,117,100,101,32,60,74,111,112,110,97,108,47,66,
+108,111,99,107,115,47,67,108,117,115,116,101,114,115,62,13,10,13,10,32,32,32,32,35,105,102,100,101,102,32,74,79,80,95,67,76,85,83,84,69,82,69,68,95,76,73,71,72,84,73,
+78,71,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,80,111,105,110,116,32,97,110,100,32,115,112,111,116,32,108,105,103,104,116,32,100,97,116,97,44,32,115,105,120,32,116,101,
+120,101,108,115,32,112,101,114,32,108,105,103,104,116,13,10,32,32,32,32,32,32,32,32,117,110,105,102,111,114,109,32,104,105,103,104,112,32,115,97,109,112,108,101,114,50,68,32,117,95,
+67,108,117,115,116,101,114,76,105,103,104,116,115,59,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,67,108,117,115,116,101,114,32,99,101,108,108,115,32,102,111,108,108,111,119,101,
+100,32,98,121,32,116,104,101,32,108,105,103,104,116,32,105,110,100,101,120,32,108,105,115,116,115,13,10,32,32,32,32,32,32,32,32,117,110,105,102,111,114,109,32,104,105,103,104,112,32,
+115,97,109,112,108,101,114,50,68,32,117,95,67,108,117,115,116,101,114,68,97,116,97,59,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,67,108,117,115,116,101,114,32,100,97,116,
+97,32,116,101,120,101,108,44,32,116,104,101,32,116,101,120,116,117,114,101,32,105,115,32,49,48,50,52,32,116,101,120,101,108,115,32,119,105,100,101,13,10,32,32,32,32,32,32,32,32,
+118,101,99,52,32,106,111,112,95,70,101,116,99,104,67,108,117,115,116,101,114,68,97,116,97,40,99,111,110,115,116,32,105,110,32,105,110,116,32,116,101,120,101,108,41,13,10,32,32,32,
+32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,114,101,116,117,114,110,32,116,101,120,101,108,70,101,116,99,104,40,117,95,67,108,117,115,116,101,114,68,97,116,
+97,44,32,105,118,101,99,50,40,116,101,120,101,108,32,45,32,40,116,101,120,101,108,32,47,32,49,48,50,52,41,32,42,32,49,48,50,52,44,32,116,101,120,101,108,32,47,32,49,48,
+50,52,41,44,32,48,41,59,13,10,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,73,110,100,101,120,32,111,102,32,116,104,101,32,99,108,117,
+115,116,101,114,32,99,111,110,116,97,105,110,105,110,103,32,116,104,105,115,32,102,114,97,103,109,101,110,116,13,10,32,32,32,32,32,32,32,32,105,110,116,32,106,111,112,95,71,101,116,
+67,108,117,115,116,101,114,40,41,13,10,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,50,32,116,105,108,101,32,61,32,40,103,108,95,
+70,114,97,103,67,111,111,114,100,46,120,121,32,45,32,117,95,67,108,117,115,116,101,114,86,105,101,119,112,111,114,116,46,120,121,41,32,42,32,117,95,67,108,117,115,116,101,114,86,105,
+101,119,112,111,114,116,46,122,119,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,100,101,112,116,104,32,61,32,45,118,102,95,80,111,115,105,116,105,
+111,110,46,122,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,115,108,105,99,101,32,61,32,40,117,95,67,108,117,115,116,101,114,68,101,112,116,104,46,122,
+32,62,32,48,46,53,32,63,32,108,111,103,40,109,97,120,40,100,101,112,116,104,44,32,48,46,48,48,48,49,41,41,32,58,32,100,101,112,116,104,41,32,42,32,117,95,67,108,117,115,
+116,101,114,68,101,112,116,104,46,120,32,43,32,117,95,67,108,117,115,116,101,114,68,101,112,116,104,46,121,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,105,118,101,99,
+51,32,99,108,117,115,116,101,114,32,61,32,99,108,97,109,112,40,105,118,101,99,51,40,102,108,111,111,114,40,118,101,99,51,40,116,105,108,101,44,32,115,108,105,99,101,41,41,41,44,
+32,105,118,101,99,51,40,48,41,44,32,117,95,67,108,117,115,116,101,114,71,114,105,100,46,120,121,122,32,45,32,49,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,
+114,101,116,117,114,110,32,99,108,117,115,116,101,114,46,120,32,43,32,117,95,67,108,117,115,116,101,114,71,114,105,100,46,120,32,42,32,40,99,108,117,115,116,101,114,46,121,32,43,32,
+117,95,67,108,117,115,116,101,114,71,114,105,100,46,121,32,42,32,99,108,117,115,116,101,114,46,122,41,59,13,10,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,32,32,
+32,32,47,47,32,73,110,100,101,120,32,111,102,32,116,104,101,32,110,116,104,32,108,105,103,104,116,32,105,110,32,97,32,99,108,117,115,116,101,114,39,115,32,108,105,115,116,13,10,32,
+32,32,32,32,32,32,32,105,110,116,32,106,111,112,95,71,101,116,67,108,117,115,116,101,114,76,105,103,104,116,40,99,111,110,115,116,32,105,110,32,105,110,116,32,111,102,102,115,101,116,
+44,32,99,111,110,115,116,32,105,110,32,105,110,116,32,110,41,13,10,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,105,110,116,32,105,32,61,32,
+111,102,102,115,101,116,32,43,32,110,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,114,101,116,117,114,110,32,105,110,116,40,106,111,112,95,70,101,116,99,104,67,108,117,115,116,
+101,114,68,97,116,97,40,117,95,67,108,117,115,116,101,114,71,114,105,100,46,119,32,43,32,105,32,47,32,52,41,91,105,32,45,32,40,105,32,47,32,52,41,32,42,32,52,93,41,59,
+13,10,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,80,111,105,110,116,32,111,114,32,115,112,111,116,32,108,105,103,104,116,32,99,97,108,99,
+117,108,97,116,105,111,110,13,10,32,32,32,32,32,32,32,32,118,111,105,100,32,106,111,112,95,67,97,108,99,117,108,97,116,101,67,108,117,115,116,101,114,76,105,103,104,116,40,99,111,
+110,115,116,32,105,110,32,105,110,116,32,105,110,100,101,120,44,32,99,111,110,115,116,32,105,110,32,102,108,111,97,116,32,115,104,105,110,105,110,101,115,115,77,117,108,116,44,32,111,117,
+116,32,118,101,99,51,32,97,109,98,105,101,110,116,44,32,111,117,116,32,118,101,99,51,32,100,105,102,102,117,115,101,44,32,111,117,116,32,118,101,99,51,32,115,112,101,99,117,108,97,
+114,41,13,10,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,52,32,112,111,115,105,116,105,111,110,32,61,32,116,101,120,101,108,70,101,
+116,99,104,40,117,95,67,108,117,115,116,101,114,76,105,103,104,116,115,44,32,105,118,101,99,50,40,48,44,32,105,110,100,101,120,41,44,32,48,41,59,13,10,32,32,32,32,32,32,32,
+32,32,32,32,32,118,101,99,52,32,97,109,98,32,61,32,116,101,120,101,108,70,101,116,99,104,40,117,95,67,108,117,115,116,101,114,76,105,103,104,116,115,44,32,105,118,101,99,50,40,
+49,44,32,105,110,100,101,120,41,44,32,48,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,52,32,100,105,102,102,32,61,32,116,101,120,101,108,70,101,116,99,104,
+40,117,95,67,108,117,115,116,101,114,76,105,103,104,116,115,44,32,105,118,101,99,50,40,50,44,32,105,110,100,101,120,41,44,32,48,41,59,13,10,32,32,32,32,32,32,32,32,32,32,
+32,32,118,101,99,52,32,115,112,101,99,32,61,32,116,101,120,101,108,70,101,116,99,104,40,117,95,67,108,117,115,116,101,114,76,105,103,104,116,115,44,32,105,118,101,99,50,40,51,44,
+32,105,110,100,101,120,41,44,32,48,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,32,97,116,116,101,110,32,61,32,116,101,120,101,108,70,101,116,99,104,40,
+117,95,67,108,117,115,116,101,114,76,105,103,104,116,115,44,32,105,118,101,99,50,40,52,44,32,105,110,100,101,120,41,44,32,48,41,46,120,121,122,59,13,10,13,10,32,32,32,32,32,
+32,32,32,32,32,32,32,47,47,32,68,105,114,101,99,116,105,111,110,32,102,114,111,109,32,102,114,97,103,109,101,110,116,32,116,111,32,108,105,103,104,116,13,10,32,32,32,32,32,32,
+32,32,32,32,32,32,118,101,99,51,32,108,105,103,104,116,68,105,114,32,61,32,110,111,114,109,97,108,105,122,101,40,112,111,115,105,116,105,111,110,46,120,121,122,32,45,32,118,102,95,
+80,111,115,105,116,105,111,110,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,68,105,114,101,99,116,105,111,110,32,102,114,111,109,32,102,114,97,103,109,101,
+110,116,32,116,111,32,101,121,101,13,10,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,32,118,105,101,119,68,105,114,32,61,32,110,111,114,109,97,108,105,122,101,40,45,118,
+102,95,80,111,115,105,116,105,111,110,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,67,97,108,99,117,108,97,116,101,32,114,101,102,108,101,99,116,105,111,
+110,32,100,105,114,101,99,116,105,111,110,32,40,117,115,101,32,97,32,104,97,108,102,45,119,97,121,32,118,101,99,116,111,114,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,118,
+101,99,51,32,114,101,102,108,101,99,116,68,105,114,32,61,32,110,111,114,109,97,108,105,122,101,40,108,105,103,104,116,68,105,114,32,43,32,118,105,101,119,68,105,114,41,59,13,10,13,
+10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,65,109,98,105,101,110,116,32,105,109,112,97,99,116,13,10,32,32,32,32,32,32,32,32,32,32,32,32,97,109,98,105,101,110,
+116,32,61,32,97,109,98,46,114,103,98,32,42,32,118,101,99,51,40,117,95,77,97,116,101,114,105,97,108,46,97,109,98,105,101,110,116,41,59,13,10,13,10,32,32,32,32,32,32,32,
+32,32,32,32,32,47,47,32,68,105,102,102,117,115,101,32,105,109,112,97,99,116,13,10,32,32,32,32,32,32,32,32,32,32,32,32,100,105,102,102,117,115,101,32,61,32,109,97,120,40,
+100,111,116,40,118,102,95,78,111,114,109,97,108,44,32,108,105,103,104,116,68,105,114,41,44,32,48,46,48,41,32,42,32,100,105,102,102,46,114,103,98,32,42,32,118,101,99,51,40,117,
+95,77,97,116,101,114,105,97,108,46,100,105,102,102,117,115,101,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,83,112,101,99,117,108,97,114,32,105,109,112,
+97,99,116,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,115,104,105,110,105,110,101,115,115,32,61,32,109,97,120,40,49,46,48,44,32,117,95,77,97,116,101,
+114,105,97,108,46,115,104,105,110,105,110,101,115,115,32,42,32,115,104,105,110,105,110,101,115,115,77,117,108,116,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,
+116,32,115,112,101,99,70,97,99,116,111,114,32,61,32,40,56,46,48,32,43,32,115,104,105,110,105,110,101,115,115,41,32,47,32,40,56,46,48,32,42,32,51,46,49,52,49,53,57,50,
+54,53,41,32,42,32,112,111,119,40,109,97,120,40,100,111,116,40,118,102,95,78,111,114,109,97,108,44,32,114,101,102,108,101,99,116,68,105,114,41,44,32,48,46,48,41,44,32,115,104,
+105,110,105,110,101,115,115,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,115,112,101,99,117,108,97,114,32,61,32,115,112,101,99,46,114,103,98,32,42,32,115,112,101,99,70,
+97,99,116,111,114,32,42,32,118,101,99,51,40,117,95,77,97,116,101,114,105,97,108,46,115,112,101,99,117,108,97,114,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,
+47,47,32,83,112,111,116,108,105,103,104,116,32,115,111,102,116,32,101,100,103,101,115,44,32,116,104,101,32,99,117,116,111,102,102,32,105,115,32,115,116,111,114,101,100,32,105,110,32,116,
+104,101,32,119,32,99,111,109,112,111,110,101,110,116,115,13,10,32,32,32,32,32,32,32,32,32,32,32,32,105,102,32,40,112,111,115,105,116,105,111,110,46,119,32,62,32,48,46,53,41,
+13,10,32,32,32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,32,100,105,114,101,99,116,105,111,110,32,61,32,
+116,101,120,101,108,70,101,116,99,104,40,117,95,67,108,117,115,116,101,114,76,105,103,104,116,115,44,32,105,118,101,99,50,40,53,44,32,105,110,100,101,120,41,44,32,48,41,46,120,121,
+122,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,116,104,101,116,97,32,61,32,100,111,116,40,108,105,103,104,116,68,105,114,44,32,
+45,100,105,114,101,99,116,105,111,110,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,105,110,116,101,110,115,105,116,121,32,61,32,99,108,
+97,109,112,40,40,116,104,101,116,97,32,45,32,100,105,102,102,46,119,41,32,47,32,40,97,109,98,46,119,32,45,32,100,105,102,102,46,119,41,44,32,48,46,48,44,32,49,46,48,41,
+59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,97,109,98,105,101,110,116,32,42,61,32,105,110,116,101,110,115,105,116,121,59,32,100,105,102,102,117,115,101,32,42,
+61,32,105,110,116,101,110,115,105,116,121,59,32,115,112,101,99,117,108,97,114,32,42,61,32,105,110,116,101,110,115,105,116,121,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,125,
+13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,65,116,116,101,110,117,97,116,105,111,110,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,
+100,105,115,116,32,61,32,108,101,110,103,116,104,40,112,111,115,105,116,105,111,110,46,120,121,122,32,45,32,118,102,95,80,111,115,105,116,105,111,110,41,59,13,10,32,32,32,32,32,32,
+32,32,32,32,32,32,102,108,111,97,116,32,97,116,116,101,110,117,97,116,105,111,110,32,61,32,49,46,48,32,47,32,40,97,116,116,101,110,46,120,32,43,32,97,116,116,101,110,46,121,
+32,42,32,100,105,115,116,32,43,32,97,116,116,101,110,46,122,32,42,32,40,100,105,115,116,32,42,32,100,105,115,116,41,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,97,
+109,98,105,101,110,116,32,42,61,32,97,116,116,101,110,117,97,116,105,111,110,59,32,100,105,102,102,117,115,101,32,42,61,32,97,116,116,101,110,117,97,116,105,111,110,59,32,115,112,101,
+99,117,108,97,114,32,42,61,32,97,116,116,101,110,117,97,116,105,111,110,59,13,10,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,
+35,112,108,117,103,105,110,101,110,100,
 };
 
-const unsigned char structurePlugins[1640] =
+const unsigned char structurePlugins[2353] =
 {
 47,47,32,74,111,112,110,97,108,32,108,105,103,104,116,105,110,103,32,115,116,114,117,99,116,117,114,101,115,32,115,104,97,100,101,114,32,112,108,117,103,105,110,32,102,105,108,101,13,10,
 47,47,13,10,47,47,32,74,111,112,110,97,108,32,108,105,99,101,110,115,101,32,97,112,112,108,105,101,115,46,13,10,13,10,47,47,32,83,116,114,117,99,116,117,114,101,115,32,117,115,
@@ -5837,123 +5955,228 @@ const unsigned char structurePlugins[1640] =
 105,97,108,13,10,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,118,101,99,52,32,97,109,98,105,101,110,116,59,13,10,32,32,32,32,32,32,32,32,118,101,99,52,32,100,105,
 102,102,117,115,101,59,13,10,32,32,32,32,32,32,32,32,118,101,99,52,32,115,112,101,99,117,108,97,114,59,13,10,32,32,32,32,32,32,32,32,118,101,99,52,32,101,109,105,115,115,
 105,111,110,59,13,10,32,32,32,32,13,10,32,32,32,32,32,32,32,32,102,108,111,97,116,32,115,104,105,110,105,110,101,115,115,59,13,10,32,32,32,32,32,32,32,32,102,108,111,97,
-116,32,114,101,102,108,101,99,116,105,118,105,116,121,59,13,10,32,32,32,32,125,59,13,10,13,10,32,32,32,32,47,47,32,80,111,105,110,116,32,108,105,103,104,116,115,13,10,32,32,
-32,32,115,116,114,117,99,116,32,80,111,105,110,116,76,105,103,104,116,73,110,102,111,13,10,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,47,47,32,73,115,32,116,104,105,115,
-32,108,105,103,104,116,32,101,110,97,98,108,101,100,63,32,79,110,108,121,32,117,115,101,100,32,111,110,32,71,76,69,83,32,50,46,48,13,10,32,32,32,32,32,32,32,32,98,111,111,
-108,32,101,110,97,98,108,101,100,59,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,80,111,115,105,116,105,111,110,13,10,32,32,32,32,32,32,32,32,118,101,99,51,32,112,111,
-115,105,116,105,111,110,59,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,73,110,116,101,110,115,105,116,105,101,115,13,10,32,32,32,32,32,32,32,32,118,101,99,51,32,97,109,
-98,105,101,110,116,59,13,10,32,32,32,32,32,32,32,32,118,101,99,51,32,100,105,102,102,117,115,101,59,13,10,32,32,32,32,32,32,32,32,118,101,99,51,32,115,112,101,99,117,108,
-97,114,59,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,65,116,116,101,110,117,97,116,105,111,110,13,10,32,32,32,32,32,32,32,32,47,47,32,120,32,61,32,99,111,110,115,
-116,97,110,116,13,10,32,32,32,32,32,32,32,32,47,47,32,121,32,61,32,108,105,110,101,97,114,13,10,32,32,32,32,32,32,32,32,47,47,32,122,32,61,32,113,117,97,100,114,97,
-116,105,99,13,10,32,32,32,32,32,32,32,32,118,101,99,51,32,97,116,116,101,110,117,97,116,105,111,110,59,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,83,104,97,100,111,
-119,32,109,97,112,32,105,110,102,111,13,10,32,32,32,32,32,32,32,32,98,111,111,108,32,99,97,115,116,83,104,97,100,111,119,59,32,32,32,32,47,47,47,60,32,67,97,115,116,32,
-115,104,97,100,111,119,115,63,13,10,32,32,32,32,32,32,32,32,102,108,111,97,116,32,102,97,114,80,108,97,110,101,59,32,32,32,32,32,47,47,47,60,32,84,104,101,32,108,105,103,
-104,116,39,115,32,102,97,114,32,112,108,97,110,101,13,10,32,32,32,32,125,59,13,10,13,10,32,32,32,32,47,47,32,83,112,111,116,32,108,105,103,104,116,115,13,10,32,32,32,32,
-115,116,114,117,99,116,32,83,112,111,116,76,105,103,104,116,73,110,102,111,13,10,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,98,111,111,108,32,101,110,97,98,108,101,100,59,
-13,10,13,10,32,32,32,32,32,32,32,32,118,101,99,51,32,112,111,115,105,116,105,111,110,59,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,68,105,114,101,99,116,105,111,110,
-13,10,32,32,32,32,32,32,32,32,118,101,99,51,32,100,105,114,101,99,116,105,111,110,59,13,10,13,10,32,32,32,32,32,32,32,32,118,101,99,51,32,97,109,98,105,101,110,116,59,
-13,10,32,32,32,32,32,32,32,32,118,101,99,51,32,100,105,102,102,117,115,101,59,13,10,32,32,32,32,32,32,32,32,118,101,99,51,32,115,112,101,99,117,108,97,114,59,13,10,13,
-10,32,32,32,32,32,32,32,32,118,101,99,51,32,97,116,116,101,110,117,97,116,105,111,110,59,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,67,117,116,111,102,102,13,10,32,
-32,32,32,32,32,32,32,47,47,32,120,32,61,32,105,110,110,101,114,13,10,32,32,32,32,32,32,32,32,47,47,32,121,32,61,32,111,117,116,101,114,13,10,32,32,32,32,32,32,32,
-32,118,101,99,50,32,99,117,116,111,102,102,59,13,10,13,10,32,32,32,32,32,32,32,32,98,111,111,108,32,99,97,115,116,83,104,97,100,111,119,59,13,10,32,32,32,32,32,32,32,
-32,109,97,116,52,32,108,115,77,97,116,114,105,120,59,13,10,32,32,32,32,125,59,13,10,13,10,32,32,32,32,47,47,32,68,105,114,101,99,116,105,111,110,97,108,32,108,105,103,104,
-116,115,13,10,32,32,32,32,115,116,114,117,99,116,32,68,105,114,101,99,116,105,111,110,97,108,76,105,103,104,116,73,110,102,111,13,10,32,32,32,32,123,13,10,32,32,32,32,32,32,
-32,32,98,111,111,108,32,101,110,97,98,108,101,100,59,13,10,13,10,32,32,32,32,32,32,32,32,118,101,99,51,32,100,105,114,101,99,116,105,111,110,59,13,10,13,10,32,32,32,32,
-32,32,32,32,118,101,99,51,32,97,109,98,105,101,110,116,59,13,10,32,32,32,32,32,32,32,32,118,101,99,51,32,100,105,102,102,117,115,101,59,13,10,32,32,32,32,32,32,32,32,
-118,101,99,51,32,115,112,101,99,117,108,97,114,59,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,78,111,32,97,116,116,101,110,117,97,116,105,111,110,32,102,111,114,32,100,105,
-114,101,99,116,105,111,110,97,108,32,108,105,103,104,116,115,13,10,13,10,32,32,32,32,32,32,32,32,98,111,111,108,32,99,97,115,116,83,104,97,100,111,119,59,13,10,32,32,32,32,
-32,32,32,32,109,97,116,52,32,108,115,77,97,116,114,105,120,59,13,10,32,32,32,32,125,59,13,10,13,10,35,112,108,117,103,105,110,101,110,100,
+116,32,114,101,102,108,101,99,116,105,118,105,116,121,59,13,10,32,32,32,32,125,59,13,10,13,10,32,32,32,32,47,47,32,84,104,101,32,108,105,103,104,116,32,115,116,114,117,99,116,
+117,114,101,115,32,97,114,101,32,108,97,105,100,32,111,117,116,32,115,111,32,116,104,97,116,32,116,104,101,121,32,112,97,99,107,32,116,105,103,104,116,108,121,13,10,32,32,32,32,47,
+47,32,117,110,100,101,114,32,116,104,101,32,115,116,100,49,52,48,32,114,117,108,101,115,32,119,104,101,110,32,117,115,101,100,32,105,110,32,116,104,101,32,108,105,103,104,116,32,117,110,
+105,102,111,114,109,32,98,108,111,99,107,13,10,13,10,32,32,32,32,47,47,32,80,111,105,110,116,32,108,105,103,104,116,115,13,10,32,32,32,32,115,116,114,117,99,116,32,80,111,105,
+110,116,76,105,103,104,116,73,110,102,111,13,10,32,32,32,32,123,13,10,32,32,32,32,35,105,102,110,100,101,102,32,74,79,80,95,85,78,73,70,79,82,77,95,66,76,79,67,75,83,
+13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,73,115,32,116,104,105,115,32,108,105,103,104,116,32,101,110,97,98,108,101,100,63,32,79,110,108,121,32,117,115,101,100,32,111,110,
+32,71,76,69,83,32,50,46,48,13,10,32,32,32,32,32,32,32,32,98,111,111,108,32,101,110,97,98,108,101,100,59,13,10,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,
+32,32,32,32,32,32,32,32,47,47,32,80,111,115,105,116,105,111,110,13,10,32,32,32,32,32,32,32,32,118,101,99,51,32,112,111,115,105,116,105,111,110,59,13,10,13,10,32,32,32,
+32,32,32,32,32,47,47,32,83,104,97,100,111,119,32,109,97,112,32,105,110,102,111,13,10,32,32,32,32,32,32,32,32,98,111,111,108,32,99,97,115,116,83,104,97,100,111,119,59,32,
+32,32,32,47,47,47,60,32,67,97,115,116,32,115,104,97,100,111,119,115,63,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,73,110,116,101,110,115,105,116,105,101,115,13,10,32,
+32,32,32,32,32,32,32,118,101,99,51,32,97,109,98,105,101,110,116,59,13,10,32,32,32,32,32,32,32,32,118,101,99,51,32,100,105,102,102,117,115,101,59,13,10,32,32,32,32,32,
+32,32,32,118,101,99,51,32,115,112,101,99,117,108,97,114,59,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,65,116,116,101,110,117,97,116,105,111,110,13,10,32,32,32,32,32,
+32,32,32,47,47,32,120,32,61,32,99,111,110,115,116,97,110,116,13,10,32,32,32,32,32,32,32,32,47,47,32,121,32,61,32,108,105,110,101,97,114,13,10,32,32,32,32,32,32,32,
+32,47,47,32,122,32,61,32,113,117,97,100,114,97,116,105,99,13,10,32,32,32,32,32,32,32,32,118,101,99,51,32,97,116,116,101,110,117,97,116,105,111,110,59,13,10,13,10,32,32,
+32,32,32,32,32,32,102,108,111,97,116,32,102,97,114,80,108,97,110,101,59,32,32,32,32,32,47,47,47,60,32,84,104,101,32,108,105,103,104,116,39,115,32,102,97,114,32,112,108,97,
+110,101,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,83,104,97,100,111,119,32,97,116,108,97,115,32,116,105,108,101,115,32,111,102,32,116,104,101,32,99,117,98,101,32,102,97,
+99,101,115,13,10,32,32,32,32,32,32,32,32,118,101,99,52,32,115,104,97,100,111,119,84,105,108,101,115,91,54,93,59,13,10,32,32,32,32,125,59,13,10,13,10,32,32,32,32,47,
+47,32,83,112,111,116,32,108,105,103,104,116,115,13,10,32,32,32,32,115,116,114,117,99,116,32,83,112,111,116,76,105,103,104,116,73,110,102,111,13,10,32,32,32,32,123,13,10,32,32,
+32,32,35,105,102,110,100,101,102,32,74,79,80,95,85,78,73,70,79,82,77,95,66,76,79,67,75,83,13,10,32,32,32,32,32,32,32,32,98,111,111,108,32,101,110,97,98,108,101,100,
+59,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,32,32,32,32,118,101,99,51,32,112,111,115,105,116,105,111,110,59,13,10,32,32,32,32,32,32,32,32,98,
+111,111,108,32,99,97,115,116,83,104,97,100,111,119,59,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,68,105,114,101,99,116,105,111,110,13,10,32,32,32,32,32,32,32,32,118,
+101,99,51,32,100,105,114,101,99,116,105,111,110,59,13,10,13,10,32,32,32,32,32,32,32,32,118,101,99,51,32,97,109,98,105,101,110,116,59,13,10,32,32,32,32,32,32,32,32,118,
+101,99,51,32,100,105,102,102,117,115,101,59,13,10,32,32,32,32,32,32,32,32,118,101,99,51,32,115,112,101,99,117,108,97,114,59,13,10,13,10,32,32,32,32,32,32,32,32,118,101,
+99,51,32,97,116,116,101,110,117,97,116,105,111,110,59,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,67,117,116,111,102,102,13,10,32,32,32,32,32,32,32,32,47,47,32,120,
+32,61,32,105,110,110,101,114,13,10,32,32,32,32,32,32,32,32,47,47,32,121,32,61,32,111,117,116,101,114,13,10,32,32,32,32,32,32,32,32,118,101,99,50,32,99,117,116,111,102,
+102,59,13,10,13,10,32,32,32,32,32,32,32,32,109,97,116,52,32,108,115,77,97,116,114,105,120,59,13,10,32,32,32,32,32,32,32,32,118,101,99,52,32,115,104,97,100,111,119,84,
+105,108,101,59,13,10,32,32,32,32,125,59,13,10,13,10,32,32,32,32,47,47,32,77,97,120,105,109,117,109,32,97,109,111,117,110,116,32,111,102,32,100,105,114,101,99,116,105,111,110,
+97,108,32,115,104,97,100,111,119,32,99,97,115,99,97,100,101,115,44,13,10,32,32,32,32,47,47,32,109,117,115,116,32,109,97,116,99,104,32,76,105,103,104,116,83,111,117,114,99,101,
+58,58,77,97,120,83,104,97,100,111,119,67,97,115,99,97,100,101,115,13,10,32,32,32,32,35,100,101,102,105,110,101,32,74,79,80,95,77,65,88,95,83,72,65,68,79,87,95,67,65,
+83,67,65,68,69,83,32,52,13,10,13,10,32,32,32,32,47,47,32,68,105,114,101,99,116,105,111,110,97,108,32,108,105,103,104,116,115,13,10,32,32,32,32,115,116,114,117,99,116,32,
+68,105,114,101,99,116,105,111,110,97,108,76,105,103,104,116,73,110,102,111,13,10,32,32,32,32,123,13,10,32,32,32,32,35,105,102,110,100,101,102,32,74,79,80,95,85,78,73,70,79,
+82,77,95,66,76,79,67,75,83,13,10,32,32,32,32,32,32,32,32,98,111,111,108,32,101,110,97,98,108,101,100,59,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,
+32,32,32,32,32,32,118,101,99,51,32,100,105,114,101,99,116,105,111,110,59,13,10,32,32,32,32,32,32,32,32,98,111,111,108,32,99,97,115,116,83,104,97,100,111,119,59,13,10,13,
+10,32,32,32,32,32,32,32,32,118,101,99,51,32,97,109,98,105,101,110,116,59,13,10,32,32,32,32,32,32,32,32,118,101,99,51,32,100,105,102,102,117,115,101,59,13,10,32,32,32,
+32,32,32,32,32,118,101,99,51,32,115,112,101,99,117,108,97,114,59,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,78,111,32,97,116,116,101,110,117,97,116,105,111,110,32,102,
+111,114,32,100,105,114,101,99,116,105,111,110,97,108,32,108,105,103,104,116,115,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,67,97,115,99,97,100,101,32,102,97,114,32,100,105,
+115,116,97,110,99,101,115,32,105,110,32,118,105,101,119,32,115,112,97,99,101,13,10,32,32,32,32,32,32,32,32,118,101,99,52,32,99,97,115,99,97,100,101,83,112,108,105,116,115,59,
+13,10,32,32,32,32,32,32,32,32,105,110,116,32,110,117,109,67,97,115,99,97,100,101,115,59,13,10,13,10,32,32,32,32,32,32,32,32,109,97,116,52,32,108,115,77,97,116,114,105,
+99,101,115,91,74,79,80,95,77,65,88,95,83,72,65,68,79,87,95,67,65,83,67,65,68,69,83,93,59,13,10,32,32,32,32,32,32,32,32,118,101,99,52,32,115,104,97,100,111,119,
+84,105,108,101,115,91,74,79,80,95,77,65,88,95,83,72,65,68,79,87,95,67,65,83,67,65,68,69,83,93,59,13,10,32,32,32,32,125,59,13,10,13,10,35,112,108,117,103,105,110,
+101,110,100,
 };
 
-const unsigned char shadowPlugins[4319] =
+const unsigned char shadowPlugins[6340] =
 {
 47,47,32,74,111,112,110,97,108,32,115,104,97,100,111,119,115,32,115,104,97,100,101,114,32,112,108,117,103,105,110,32,102,105,108,101,13,10,47,47,13,10,47,47,32,74,111,112,110,97,
 108,32,108,105,99,101,110,115,101,32,97,112,112,108,105,101,115,46,13,10,13,10,13,10,35,112,108,117,103,105,110,32,60,74,111,112,110,97,108,47,68,101,102,97,117,108,116,76,105,103,
 104,116,105,110,103,47,83,104,97,100,111,119,115,62,13,10,13,10,32,32,32,32,35,105,102,32,74,77,65,84,95,77,65,88,95,80,79,73,78,84,95,76,73,71,72,84,83,32,62,32,
-48,13,10,13,10,32,32,32,32,32,32,32,32,117,110,105,102,111,114,109,32,115,97,109,112,108,101,114,67,117,98,101,32,117,95,80,111,105,110,116,76,105,103,104,116,83,104,97,100,111,
-119,77,97,112,115,91,74,77,65,84,95,77,65,88,95,80,79,73,78,84,95,76,73,71,72,84,83,93,59,13,10,13,10,32,32,32,32,32,32,32,32,35,105,102,32,95,95,86,69,82,
-83,73,79,78,95,95,32,62,61,32,51,48,48,13,10,32,32,32,32,32,32,32,32,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,79,102,102,115,101,116,32,100,105,114,
-101,99,116,105,111,110,115,32,102,111,114,32,115,97,109,112,108,105,110,103,32,112,111,105,110,116,32,115,104,97,100,111,119,115,13,10,32,32,32,32,32,32,32,32,32,32,32,32,99,111,
-110,115,116,32,118,101,99,51,32,103,95,103,114,105,100,83,97,109,112,108,105,110,103,68,105,115,107,91,50,48,93,32,61,32,118,101,99,51,91,93,13,10,32,32,32,32,32,32,32,32,
-32,32,32,32,40,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,40,49,44,32,49,44,32,32,49,41,44,32,118,101,99,51,40,32,49,44,32,45,49,
-44,32,32,49,41,44,32,118,101,99,51,40,45,49,44,32,45,49,44,32,32,49,41,44,32,118,101,99,51,40,45,49,44,32,49,44,32,32,49,41,44,13,10,32,32,32,32,32,32,32,
-32,32,32,32,32,32,32,32,32,118,101,99,51,40,49,44,32,49,44,32,45,49,41,44,32,118,101,99,51,40,32,49,44,32,45,49,44,32,45,49,41,44,32,118,101,99,51,40,45,49,
-44,32,45,49,44,32,45,49,41,44,32,118,101,99,51,40,45,49,44,32,49,44,32,45,49,41,44,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,40,
-49,44,32,49,44,32,32,48,41,44,32,118,101,99,51,40,32,49,44,32,45,49,44,32,32,48,41,44,32,118,101,99,51,40,45,49,44,32,45,49,44,32,32,48,41,44,32,118,101,99,
-51,40,45,49,44,32,49,44,32,32,48,41,44,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,40,49,44,32,48,44,32,32,49,41,44,32,118,101,99,
-51,40,45,49,44,32,32,48,44,32,32,49,41,44,32,118,101,99,51,40,32,49,44,32,32,48,44,32,45,49,41,44,32,118,101,99,51,40,45,49,44,32,48,44,32,45,49,41,44,13,
-10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,40,48,44,32,49,44,32,32,49,41,44,32,118,101,99,51,40,32,48,44,32,45,49,44,32,32,49,41,44,
-32,118,101,99,51,40,32,48,44,32,45,49,44,32,45,49,41,44,32,118,101,99,51,40,32,48,44,32,49,44,32,45,49,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,41,59,
-13,10,13,10,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,32,32,32,32,102,108,111,97,116,32,106,111,112,95,67,97,108,99,117,108,97,116,101,80,
-111,105,110,116,83,104,97,100,111,119,40,99,111,110,115,116,32,105,110,32,118,101,99,51,32,108,105,103,104,116,68,105,114,44,32,99,111,110,115,116,32,105,110,32,102,108,111,97,116,32,
-102,97,114,80,108,97,110,101,44,32,99,111,110,115,116,32,105,110,32,115,97,109,112,108,101,114,67,117,98,101,32,115,97,109,112,41,13,10,32,32,32,32,32,32,32,32,123,13,10,32,
-32,32,32,32,32,32,32,32,32,32,32,47,47,32,84,101,115,116,32,102,111,114,32,115,104,97,100,111,119,115,32,119,105,116,104,32,80,67,70,13,10,32,32,32,32,32,32,32,32,32,
-32,32,32,35,105,102,32,95,95,86,69,82,83,73,79,78,95,95,32,62,61,32,51,48,48,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,71,101,
-116,32,99,117,114,114,101,110,116,32,108,105,110,101,97,114,32,100,101,112,116,104,32,97,115,32,116,104,101,32,108,101,110,103,116,104,32,98,101,116,119,101,101,110,32,116,104,101,32,102,
-114,97,103,109,101,110,116,32,97,110,100,32,108,105,103,104,116,32,112,111,115,105,116,105,111,110,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,
-99,117,114,114,101,110,116,68,101,112,116,104,32,61,32,108,101,110,103,116,104,40,108,105,103,104,116,68,105,114,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,
-32,32,102,108,111,97,116,32,115,104,97,100,111,119,32,61,32,48,46,48,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,99,111,110,115,116,32,102,108,111,97,116,
-32,98,105,97,115,32,61,32,48,46,49,53,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,99,111,110,115,116,32,105,110,116,32,115,97,109,112,108,101,115,32,61,
-32,50,48,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,118,105,101,119,68,105,115,116,97,110,99,101,32,61,32,108,101,110,103,116,
-104,40,45,118,102,95,80,111,115,105,116,105,111,110,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,100,105,115,107,82,97,100,105,117,115,
-32,61,32,40,49,46,48,32,43,32,40,118,105,101,119,68,105,115,116,97,110,99,101,32,47,32,102,97,114,80,108,97,110,101,41,41,32,47,32,50,53,46,48,59,13,10,32,32,32,32,
-32,32,32,32,32,32,32,32,32,32,32,32,102,111,114,32,40,105,110,116,32,105,32,61,32,48,59,32,105,32,60,32,115,97,109,112,108,101,115,59,32,43,43,105,41,13,10,32,32,32,
-32,32,32,32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,32,115,97,109,112,67,111,111,114,100,
-115,32,61,32,108,105,103,104,116,68,105,114,32,43,32,103,95,103,114,105,100,83,97,109,112,108,105,110,103,68,105,115,107,91,105,93,32,42,32,100,105,115,107,82,97,100,105,117,115,59,
-13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,
-99,108,111,115,101,115,116,68,101,112,116,104,32,61,32,74,79,80,95,84,69,88,84,85,82,69,95,67,85,66,69,40,115,97,109,112,44,32,115,97,109,112,67,111,111,114,100,115,41,46,
-114,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,85,110,100,111,32,109,97,112,112,105,110,103,32,91,48,44,49,93,13,10,32,
-32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,99,108,111,115,101,115,116,68,101,112,116,104,32,42,61,32,102,97,114,80,108,97,110,101,59,13,10,13,10,32,32,
-32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,102,32,40,99,117,114,114,101,110,116,68,101,112,116,104,32,45,32,98,105,97,115,32,62,32,99,108,111,115,101,115,
-116,68,101,112,116,104,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,115,104,97,100,111,119,32,43,61,32,49,46,48,59,13,10,32,
-32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,125,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,115,104,97,100,111,119,32,47,61,32,102,108,111,97,116,40,
-115,97,109,112,108,101,115,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,114,101,116,117,114,110,32,115,104,97,100,111,119,59,13,10,13,10,32,32,32,
-32,32,32,32,32,32,32,32,32,35,101,108,115,101,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,99,108,111,115,101,115,116,68,101,112,
-116,104,32,61,32,74,79,80,95,84,69,88,84,85,82,69,95,67,85,66,69,40,115,97,109,112,44,32,108,105,103,104,116,68,105,114,41,46,114,59,13,10,13,10,32,32,32,32,32,32,
-32,32,32,32,32,32,32,32,32,32,99,108,111,115,101,115,116,68,101,112,116,104,32,42,61,32,102,97,114,80,108,97,110,101,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,
-32,32,32,32,32,102,108,111,97,116,32,99,117,114,114,101,110,116,68,101,112,116,104,32,61,32,108,101,110,103,116,104,40,108,105,103,104,116,68,105,114,41,59,13,10,13,10,32,32,32,
-32,32,32,32,32,32,32,32,32,32,32,32,32,99,111,110,115,116,32,102,108,111,97,116,32,98,105,97,115,32,61,32,48,46,48,53,59,13,10,13,10,32,32,32,32,32,32,32,32,32,
-32,32,32,32,32,32,32,114,101,116,117,114,110,32,99,117,114,114,101,110,116,68,101,112,116,104,32,45,32,98,105,97,115,32,62,32,99,108,111,115,101,115,116,68,101,112,116,104,32,63,
-32,49,46,48,32,58,32,48,46,48,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,
-32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,35,105,102,32,74,77,65,84,95,77,65,88,95,68,73,82,69,67,84,73,79,78,65,76,95,76,73,71,72,84,83,32,62,32,
-48,32,124,124,32,74,77,65,84,95,77,65,88,95,83,80,79,84,95,76,73,71,72,84,83,32,62,32,48,13,10,13,10,32,32,32,32,32,32,32,32,35,105,102,32,74,77,65,84,95,
-77,65,88,95,68,73,82,69,67,84,73,79,78,65,76,95,76,73,71,72,84,83,32,62,32,48,13,10,32,32,32,32,32,32,32,32,32,32,32,32,117,110,105,102,111,114,109,32,115,97,
-109,112,108,101,114,50,68,32,117,95,68,105,114,101,99,116,105,111,110,97,108,76,105,103,104,116,83,104,97,100,111,119,77,97,112,115,91,74,77,65,84,95,77,65,88,95,68,73,82,69,
-67,84,73,79,78,65,76,95,76,73,71,72,84,83,93,59,13,10,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,32,32,32,32,35,105,102,32,74,77,65,84,
-95,77,65,88,95,83,80,79,84,95,76,73,71,72,84,83,32,62,32,48,13,10,32,32,32,32,32,32,32,32,32,32,32,32,117,110,105,102,111,114,109,32,115,97,109,112,108,101,114,50,
-68,32,117,95,83,112,111,116,76,105,103,104,116,83,104,97,100,111,119,77,97,112,115,91,74,77,65,84,95,77,65,88,95,83,80,79,84,95,76,73,71,72,84,83,93,59,13,10,32,32,
-32,32,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,83,104,97,100,111,119,32,99,97,108,99,117,108,97,116,105,111,110,32,102,111,114,32,
-100,105,114,101,99,116,105,111,110,97,108,32,97,110,100,32,115,112,111,116,32,108,105,103,104,116,115,13,10,32,32,32,32,32,32,32,32,102,108,111,97,116,32,106,111,112,95,67,97,108,
-99,117,108,97,116,101,68,105,114,83,112,111,116,83,104,97,100,111,119,40,99,111,110,115,116,32,105,110,32,118,101,99,51,32,112,114,111,106,67,111,111,114,100,115,44,32,99,111,110,115,
-116,32,105,110,32,118,101,99,51,32,110,111,114,109,44,32,99,111,110,115,116,32,105,110,32,118,101,99,51,32,108,105,103,104,116,68,105,114,44,32,99,111,110,115,116,32,105,110,32,115,
-97,109,112,108,101,114,50,68,32,115,97,109,112,41,13,10,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,71,101,116,32,99,108,111,115,
-101,115,116,32,100,101,112,116,104,32,118,97,108,117,101,32,102,114,111,109,32,108,105,103,104,116,39,115,32,112,101,114,115,112,101,99,116,105,118,101,32,40,117,115,105,110,103,32,91,48,
-44,49,93,32,114,97,110,103,101,32,102,114,97,103,80,111,115,76,105,103,104,116,32,97,115,32,99,111,111,114,100,115,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,
-97,116,32,99,108,111,115,101,115,116,68,101,112,116,104,32,61,32,74,79,80,95,84,69,88,84,85,82,69,95,50,68,40,115,97,109,112,44,32,112,114,111,106,67,111,111,114,100,115,46,
-120,121,41,46,114,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,71,101,116,32,100,101,112,116,104,32,111,102,32,99,117,114,114,101,110,116,32,102,114,97,103,
-109,101,110,116,32,102,114,111,109,32,108,105,103,104,116,39,115,32,112,101,114,115,112,101,99,116,105,118,101,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,99,
-117,114,114,101,110,116,68,101,112,116,104,32,61,32,112,114,111,106,67,111,111,114,100,115,46,122,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,67,104,101,99,
-107,32,119,104,101,116,104,101,114,32,99,117,114,114,101,110,116,32,102,114,97,103,32,112,111,115,32,105,115,32,105,110,32,115,104,97,100,111,119,13,10,32,32,32,32,32,32,32,32,32,
-32,32,32,102,108,111,97,116,32,98,105,97,115,32,61,32,109,97,120,40,48,46,48,53,32,42,32,40,49,46,48,32,45,32,100,111,116,40,110,111,114,109,44,32,108,105,103,104,116,68,
-105,114,41,41,44,32,48,46,48,48,53,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,115,104,97,100,111,119,32,61,32,48,46,48,59,13,10,
-13,10,32,32,32,32,32,32,32,32,32,32,32,32,105,102,32,40,112,114,111,106,67,111,111,114,100,115,46,122,32,62,32,49,46,48,41,13,10,32,32,32,32,32,32,32,32,32,32,32,
-32,32,32,32,32,115,104,97,100,111,119,32,61,32,48,46,48,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,68,111,32,112,101,114,99,101,110,116,97,103,101,
-45,99,108,111,115,101,114,32,102,105,108,116,101,114,105,110,103,13,10,32,32,32,32,32,32,32,32,32,32,32,32,101,108,115,101,13,10,32,32,32,32,32,32,32,32,32,32,32,32,123,
-13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,105,102,32,95,95,86,69,82,83,73,79,78,95,95,32,62,61,32,51,48,48,13,10,13,10,32,32,32,32,32,32,32,32,32,32,
-32,32,32,32,32,32,118,101,99,50,32,116,101,120,101,108,83,105,122,101,32,61,32,118,101,99,50,40,49,46,48,41,32,47,32,118,101,99,50,40,116,101,120,116,117,114,101,83,105,122,
-101,40,115,97,109,112,44,32,48,41,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,111,114,40,105,110,116,32,120,32,61,32,45,49,59,32,120,32,60,61,
-32,49,59,32,43,43,120,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,
-111,114,40,105,110,116,32,121,32,61,32,45,49,59,32,121,32,60,61,32,49,59,32,43,43,121,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,123,
-13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,112,99,102,68,101,112,116,104,32,61,32,74,79,80,95,84,69,88,
-84,85,82,69,95,50,68,40,115,97,109,112,44,32,112,114,111,106,67,111,111,114,100,115,46,120,121,32,43,32,118,101,99,50,40,120,44,32,121,41,32,42,32,116,101,120,101,108,83,105,
-122,101,41,46,114,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,115,104,97,100,111,119,32,43,61,32,99,117,114,114,101,110,116,68,
-101,112,116,104,32,45,32,98,105,97,115,32,62,32,112,99,102,68,101,112,116,104,32,63,32,49,46,48,32,58,32,48,46,48,59,32,32,32,32,32,32,32,32,13,10,32,32,32,32,32,
-32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,125,32,32,32,32,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,125,13,10,32,32,32,32,32,32,32,32,32,
-32,32,32,32,32,32,32,115,104,97,100,111,119,32,47,61,32,57,46,48,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,101,108,115,101,13,10,13,10,32,32,32,32,
-32,32,32,32,32,32,32,32,32,32,32,32,115,104,97,100,111,119,32,61,32,102,108,111,97,116,40,99,117,114,114,101,110,116,68,101,112,116,104,32,45,32,98,105,97,115,32,62,32,99,
-108,111,115,101,115,116,68,101,112,116,104,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,32,32,32,32,32,32,32,32,125,
-13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,114,101,116,117,114,110,32,115,104,97,100,111,119,59,13,10,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,35,
-101,110,100,105,102,13,10,13,10,35,112,108,117,103,105,110,101,110,100,
+48,32,124,124,32,74,77,65,84,95,77,65,88,95,68,73,82,69,67,84,73,79,78,65,76,95,76,73,71,72,84,83,32,62,32,48,32,124,124,32,74,77,65,84,95,77,65,88,95,83,
+80,79,84,95,76,73,71,72,84,83,32,62,32,48,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,83,104,97,100,111,119,32,109,97,112,115,32,111,102,32,97,108,108,32,116,104,
+101,32,108,105,103,104,116,115,46,32,69,97,99,104,32,108,105,103,104,116,32,104,97,115,32,105,116,115,32,111,119,110,32,116,105,108,101,115,13,10,32,32,32,32,32,32,32,32,117,110,
+105,102,111,114,109,32,115,97,109,112,108,101,114,50,68,32,117,95,83,104,97,100,111,119,65,116,108,97,115,59,13,10,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,
+32,32,35,105,102,32,74,77,65,84,95,77,65,88,95,80,79,73,78,84,95,76,73,71,72,84,83,32,62,32,48,13,10,13,10,32,32,32,32,32,32,32,32,35,105,102,32,95,95,86,
+69,82,83,73,79,78,95,95,32,62,61,32,51,48,48,13,10,32,32,32,32,32,32,32,32,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,79,102,102,115,101,116,32,100,
+105,114,101,99,116,105,111,110,115,32,102,111,114,32,115,97,109,112,108,105,110,103,32,112,111,105,110,116,32,115,104,97,100,111,119,115,13,10,32,32,32,32,32,32,32,32,32,32,32,32,
+99,111,110,115,116,32,118,101,99,51,32,103,95,103,114,105,100,83,97,109,112,108,105,110,103,68,105,115,107,91,50,48,93,32,61,32,118,101,99,51,91,93,13,10,32,32,32,32,32,32,
+32,32,32,32,32,32,40,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,40,49,44,32,49,44,32,32,49,41,44,32,118,101,99,51,40,32,49,44,32,
+45,49,44,32,32,49,41,44,32,118,101,99,51,40,45,49,44,32,45,49,44,32,32,49,41,44,32,118,101,99,51,40,45,49,44,32,49,44,32,32,49,41,44,13,10,32,32,32,32,32,
+32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,40,49,44,32,49,44,32,45,49,41,44,32,118,101,99,51,40,32,49,44,32,45,49,44,32,45,49,41,44,32,118,101,99,51,40,
+45,49,44,32,45,49,44,32,45,49,41,44,32,118,101,99,51,40,45,49,44,32,49,44,32,45,49,41,44,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,
+51,40,49,44,32,49,44,32,32,48,41,44,32,118,101,99,51,40,32,49,44,32,45,49,44,32,32,48,41,44,32,118,101,99,51,40,45,49,44,32,45,49,44,32,32,48,41,44,32,118,
+101,99,51,40,45,49,44,32,49,44,32,32,48,41,44,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,40,49,44,32,48,44,32,32,49,41,44,32,118,
+101,99,51,40,45,49,44,32,32,48,44,32,32,49,41,44,32,118,101,99,51,40,32,49,44,32,32,48,44,32,45,49,41,44,32,118,101,99,51,40,45,49,44,32,48,44,32,45,49,41,
+44,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,40,48,44,32,49,44,32,32,49,41,44,32,118,101,99,51,40,32,48,44,32,45,49,44,32,32,49,
+41,44,32,118,101,99,51,40,32,48,44,32,45,49,44,32,45,49,41,44,32,118,101,99,51,40,32,48,44,32,49,44,32,45,49,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,
+41,59,13,10,13,10,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,83,97,109,112,108,101,32,116,104,101,32,116,105,108,101,
+32,111,102,32,97,32,99,117,98,101,32,102,97,99,101,46,32,84,104,101,32,102,97,99,101,32,97,110,100,32,116,104,101,32,99,111,111,114,100,105,110,97,116,101,115,13,10,32,32,32,
+32,32,32,32,32,47,47,32,97,114,101,32,115,101,108,101,99,116,101,100,32,116,104,101,32,115,97,109,101,32,119,97,121,32,97,115,32,119,105,116,104,32,99,117,98,101,32,109,97,112,
+115,13,10,32,32,32,32,32,32,32,32,102,108,111,97,116,32,106,111,112,95,83,97,109,112,108,101,80,111,105,110,116,83,104,97,100,111,119,40,99,111,110,115,116,32,105,110,32,80,111,
+105,110,116,76,105,103,104,116,73,110,102,111,32,108,44,32,99,111,110,115,116,32,105,110,32,118,101,99,51,32,100,105,114,41,13,10,32,32,32,32,32,32,32,32,123,13,10,32,32,32,
+32,32,32,32,32,32,32,32,32,118,101,99,51,32,97,32,61,32,97,98,115,40,100,105,114,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,52,32,116,105,108,101,
+59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,50,32,99,111,111,114,100,115,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,105,102,32,40,97,46,120,
+32,62,61,32,97,46,121,32,38,38,32,97,46,120,32,62,61,32,97,46,122,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,
+32,32,32,32,32,116,105,108,101,32,61,32,100,105,114,46,120,32,62,32,48,46,48,32,63,32,108,46,115,104,97,100,111,119,84,105,108,101,115,91,48,93,32,58,32,108,46,115,104,97,
+100,111,119,84,105,108,101,115,91,49,93,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,99,111,111,114,100,115,32,61,32,118,101,99,50,40,100,105,114,46,120,32,
+62,32,48,46,48,32,63,32,45,100,105,114,46,122,32,58,32,100,105,114,46,122,44,32,45,100,105,114,46,121,41,32,47,32,97,46,120,59,13,10,32,32,32,32,32,32,32,32,32,32,
+32,32,125,13,10,32,32,32,32,32,32,32,32,32,32,32,32,101,108,115,101,32,105,102,32,40,97,46,121,32,62,61,32,97,46,122,41,13,10,32,32,32,32,32,32,32,32,32,32,32,
+32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,116,105,108,101,32,61,32,100,105,114,46,121,32,62,32,48,46,48,32,63,32,108,46,115,104,97,100,111,119,84,
+105,108,101,115,91,50,93,32,58,32,108,46,115,104,97,100,111,119,84,105,108,101,115,91,51,93,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,99,111,111,114,100,
+115,32,61,32,118,101,99,50,40,100,105,114,46,120,44,32,100,105,114,46,121,32,62,32,48,46,48,32,63,32,100,105,114,46,122,32,58,32,45,100,105,114,46,122,41,32,47,32,97,46,
+121,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,125,13,10,32,32,32,32,32,32,32,32,32,32,32,32,101,108,115,101,13,10,32,32,32,32,32,32,32,32,32,32,32,32,123,
+13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,116,105,108,101,32,61,32,100,105,114,46,122,32,62,32,48,46,48,32,63,32,108,46,115,104,97,100,111,119,84,105,108,
+101,115,91,52,93,32,58,32,108,46,115,104,97,100,111,119,84,105,108,101,115,91,53,93,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,99,111,111,114,100,115,32,
+61,32,118,101,99,50,40,100,105,114,46,122,32,62,32,48,46,48,32,63,32,100,105,114,46,120,32,58,32,45,100,105,114,46,120,44,32,45,100,105,114,46,121,41,32,47,32,97,46,122,
+59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,99,111,111,114,100,115,32,61,32,99,108,97,109,112,40,99,111,111,
+114,100,115,32,42,32,48,46,53,32,43,32,48,46,53,44,32,48,46,48,44,32,49,46,48,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,114,101,116,117,114,110,32,
+74,79,80,95,84,69,88,84,85,82,69,95,50,68,40,117,95,83,104,97,100,111,119,65,116,108,97,115,44,32,116,105,108,101,46,120,121,32,43,32,99,111,111,114,100,115,32,42,32,116,
+105,108,101,46,122,119,41,46,114,59,13,10,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,32,32,32,32,102,108,111,97,116,32,106,111,112,95,67,97,108,99,117,108,97,
+116,101,80,111,105,110,116,83,104,97,100,111,119,40,99,111,110,115,116,32,105,110,32,80,111,105,110,116,76,105,103,104,116,73,110,102,111,32,108,44,32,99,111,110,115,116,32,105,110,32,
+118,101,99,51,32,108,105,103,104,116,68,105,114,41,13,10,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,102,97,114,80,108,
+97,110,101,32,61,32,108,46,102,97,114,80,108,97,110,101,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,84,101,115,116,32,102,111,114,32,115,104,97,100,111,
+119,115,32,119,105,116,104,32,80,67,70,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,105,102,32,95,95,86,69,82,83,73,79,78,95,95,32,62,61,32,51,48,48,13,10,13,
+10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,71,101,116,32,99,117,114,114,101,110,116,32,108,105,110,101,97,114,32,100,101,112,116,104,32,97,115,32,116,104,
+101,32,108,101,110,103,116,104,32,98,101,116,119,101,101,110,32,116,104,101,32,102,114,97,103,109,101,110,116,32,97,110,100,32,108,105,103,104,116,32,112,111,115,105,116,105,111,110,13,10,
+32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,99,117,114,114,101,110,116,68,101,112,116,104,32,61,32,108,101,110,103,116,104,40,108,105,103,104,116,68,
+105,114,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,115,104,97,100,111,119,32,61,32,48,46,48,59,13,10,32,32,32,32,32,
+32,32,32,32,32,32,32,32,32,32,32,99,111,110,115,116,32,102,108,111,97,116,32,98,105,97,115,32,61,32,48,46,49,53,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,
+32,32,32,99,111,110,115,116,32,105,110,116,32,115,97,109,112,108,101,115,32,61,32,50,48,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,
+116,32,118,105,101,119,68,105,115,116,97,110,99,101,32,61,32,108,101,110,103,116,104,40,45,118,102,95,80,111,115,105,116,105,111,110,41,59,13,10,32,32,32,32,32,32,32,32,32,32,
+32,32,32,32,32,32,102,108,111,97,116,32,100,105,115,107,82,97,100,105,117,115,32,61,32,40,49,46,48,32,43,32,40,118,105,101,119,68,105,115,116,97,110,99,101,32,47,32,102,97,
+114,80,108,97,110,101,41,41,32,47,32,50,53,46,48,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,111,114,32,40,105,110,116,32,105,32,61,32,48,59,32,
+105,32,60,32,115,97,109,112,108,101,115,59,32,43,43,105,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,
+32,32,32,32,32,32,32,32,118,101,99,51,32,115,97,109,112,67,111,111,114,100,115,32,61,32,108,105,103,104,116,68,105,114,32,43,32,103,95,103,114,105,100,83,97,109,112,108,105,110,
+103,68,105,115,107,91,105,93,32,42,32,100,105,115,107,82,97,100,105,117,115,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,13,10,32,32,32,32,
+32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,99,108,111,115,101,115,116,68,101,112,116,104,32,61,32,106,111,112,95,83,97,109,112,108,101,80,111,105,
+110,116,83,104,97,100,111,119,40,108,44,32,115,97,109,112,67,111,111,114,100,115,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,47,47,
+32,85,110,100,111,32,109,97,112,112,105,110,103,32,91,48,44,49,93,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,99,108,111,115,101,115,116,68,101,
+112,116,104,32,42,61,32,102,97,114,80,108,97,110,101,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,102,32,40,99,117,114,114,101,110,
+116,68,101,112,116,104,32,45,32,98,105,97,115,32,62,32,99,108,111,115,101,115,116,68,101,112,116,104,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,
+32,32,32,32,32,115,104,97,100,111,119,32,43,61,32,49,46,48,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,125,13,10,32,32,32,32,32,32,32,32,32,32,
+32,32,32,32,32,32,115,104,97,100,111,119,32,47,61,32,102,108,111,97,116,40,115,97,109,112,108,101,115,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,
+32,114,101,116,117,114,110,32,115,104,97,100,111,119,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,101,108,115,101,13,10,13,10,32,32,32,32,32,32,32,32,32,32,
+32,32,32,32,32,32,102,108,111,97,116,32,99,108,111,115,101,115,116,68,101,112,116,104,32,61,32,106,111,112,95,83,97,109,112,108,101,80,111,105,110,116,83,104,97,100,111,119,40,108,
+44,32,108,105,103,104,116,68,105,114,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,99,108,111,115,101,115,116,68,101,112,116,104,32,42,61,32,102,97,
+114,80,108,97,110,101,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,99,117,114,114,101,110,116,68,101,112,116,104,32,61,32,108,101,
+110,103,116,104,40,108,105,103,104,116,68,105,114,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,99,111,110,115,116,32,102,108,111,97,116,32,98,105,97,
+115,32,61,32,48,46,48,53,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,114,101,116,117,114,110,32,99,117,114,114,101,110,116,68,101,112,116,104,32,45,
+32,98,105,97,115,32,62,32,99,108,111,115,101,115,116,68,101,112,116,104,32,63,32,49,46,48,32,58,32,48,46,48,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,
+101,110,100,105,102,13,10,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,35,105,102,32,74,77,65,84,95,77,65,88,
+95,68,73,82,69,67,84,73,79,78,65,76,95,76,73,71,72,84,83,32,62,32,48,32,124,124,32,74,77,65,84,95,77,65,88,95,83,80,79,84,95,76,73,71,72,84,83,32,62,32,
+48,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,83,104,97,100,111,119,32,99,97,108,99,117,108,97,116,105,111,110,32,102,111,114,32,100,105,114,101,99,116,105,111,110,97,108,
+32,97,110,100,32,115,112,111,116,32,108,105,103,104,116,115,13,10,32,32,32,32,32,32,32,32,102,108,111,97,116,32,106,111,112,95,67,97,108,99,117,108,97,116,101,68,105,114,83,112,
+111,116,83,104,97,100,111,119,40,99,111,110,115,116,32,105,110,32,118,101,99,51,32,112,114,111,106,67,111,111,114,100,115,44,32,99,111,110,115,116,32,105,110,32,118,101,99,51,32,110,
+111,114,109,44,32,99,111,110,115,116,32,105,110,32,118,101,99,51,32,108,105,103,104,116,68,105,114,44,32,99,111,110,115,116,32,105,110,32,118,101,99,52,32,116,105,108,101,41,13,10,
+32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,50,32,116,105,108,101,77,105,110,32,61,32,116,105,108,101,46,120,121,59,13,10,32,32,
+32,32,32,32,32,32,32,32,32,32,118,101,99,50,32,116,105,108,101,77,97,120,32,61,32,116,105,108,101,46,120,121,32,43,32,116,105,108,101,46,122,119,59,13,10,13,10,32,32,32,
+32,32,32,32,32,32,32,32,32,47,47,32,79,117,116,115,105,100,101,32,116,104,101,32,116,105,108,101,32,109,101,97,110,115,32,111,117,116,115,105,100,101,32,116,104,101,32,108,105,103,
+104,116,39,115,32,102,114,117,115,116,117,109,13,10,32,32,32,32,32,32,32,32,32,32,32,32,105,102,32,40,112,114,111,106,67,111,111,114,100,115,46,122,32,62,32,49,46,48,32,124,
+124,32,97,110,121,40,108,101,115,115,84,104,97,110,40,112,114,111,106,67,111,111,114,100,115,46,120,121,44,32,116,105,108,101,77,105,110,41,41,32,124,124,32,97,110,121,40,103,114,101,
+97,116,101,114,84,104,97,110,40,112,114,111,106,67,111,111,114,100,115,46,120,121,44,32,116,105,108,101,77,97,120,41,41,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,
+32,32,114,101,116,117,114,110,32,48,46,48,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,71,101,116,32,100,101,112,116,104,32,111,102,32,99,117,114,114,101,
+110,116,32,102,114,97,103,109,101,110,116,32,102,114,111,109,32,108,105,103,104,116,39,115,32,112,101,114,115,112,101,99,116,105,118,101,13,10,32,32,32,32,32,32,32,32,32,32,32,32,
+102,108,111,97,116,32,99,117,114,114,101,110,116,68,101,112,116,104,32,61,32,112,114,111,106,67,111,111,114,100,115,46,122,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,
+47,47,32,67,104,101,99,107,32,119,104,101,116,104,101,114,32,99,117,114,114,101,110,116,32,102,114,97,103,32,112,111,115,32,105,115,32,105,110,32,115,104,97,100,111,119,13,10,32,32,
+32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,98,105,97,115,32,61,32,109,97,120,40,48,46,48,53,32,42,32,40,49,46,48,32,45,32,100,111,116,40,110,111,114,109,44,
+32,108,105,103,104,116,68,105,114,41,41,44,32,48,46,48,48,53,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,115,104,97,100,111,119,32,61,
+32,48,46,48,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,68,111,32,112,101,114,99,101,110,116,97,103,101,45,99,108,111,115,101,114,32,102,105,108,116,101,
+114,105,110,103,44,32,119,105,116,104,111,117,116,32,108,101,97,118,105,110,103,32,116,104,101,32,116,105,108,101,13,10,32,32,32,32,32,32,32,32,32,32,32,32,35,105,102,32,95,95,
+86,69,82,83,73,79,78,95,95,32,62,61,32,51,48,48,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,50,32,116,101,120,101,108,83,105,122,101,
+32,61,32,118,101,99,50,40,49,46,48,41,32,47,32,118,101,99,50,40,116,101,120,116,117,114,101,83,105,122,101,40,117,95,83,104,97,100,111,119,65,116,108,97,115,44,32,48,41,41,
+59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,111,114,40,105,110,116,32,120,32,61,32,45,49,59,32,120,32,60,61,32,49,59,32,43,43,120,41,13,10,32,
+32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,111,114,40,105,110,116,32,121,32,61,32,
+45,49,59,32,121,32,60,61,32,49,59,32,43,43,121,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,
+32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,112,99,102,68,101,112,116,104,32,61,32,74,79,80,95,84,69,88,84,85,82,69,95,50,68,40,117,95,83,
+104,97,100,111,119,65,116,108,97,115,44,32,99,108,97,109,112,40,112,114,111,106,67,111,111,114,100,115,46,120,121,32,43,32,118,101,99,50,40,120,44,32,121,41,32,42,32,116,101,120,
+101,108,83,105,122,101,44,32,116,105,108,101,77,105,110,44,32,116,105,108,101,77,97,120,41,41,46,114,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,
+32,32,32,32,32,115,104,97,100,111,119,32,43,61,32,99,117,114,114,101,110,116,68,101,112,116,104,32,45,32,98,105,97,115,32,62,32,112,99,102,68,101,112,116,104,32,63,32,49,46,
+48,32,58,32,48,46,48,59,32,32,32,32,32,32,32,32,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,125,32,32,32,32,13,10,32,32,32,32,32,
+32,32,32,32,32,32,32,32,32,32,32,125,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,115,104,97,100,111,119,32,47,61,32,57,46,48,59,13,10,13,10,32,32,
+32,32,32,32,32,32,32,32,32,32,35,101,108,115,101,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,71,101,116,32,99,108,111,115,101,115,116,32,
+100,101,112,116,104,32,118,97,108,117,101,32,102,114,111,109,32,108,105,103,104,116,39,115,32,112,101,114,115,112,101,99,116,105,118,101,32,40,117,115,105,110,103,32,91,48,44,49,93,32,
+114,97,110,103,101,32,102,114,97,103,80,111,115,76,105,103,104,116,32,97,115,32,99,111,111,114,100,115,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,
+97,116,32,99,108,111,115,101,115,116,68,101,112,116,104,32,61,32,74,79,80,95,84,69,88,84,85,82,69,95,50,68,40,117,95,83,104,97,100,111,119,65,116,108,97,115,44,32,112,114,
+111,106,67,111,111,114,100,115,46,120,121,41,46,114,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,115,104,97,100,111,119,32,61,32,102,108,111,97,116,40,
+99,117,114,114,101,110,116,68,101,112,116,104,32,45,32,98,105,97,115,32,62,32,99,108,111,115,101,115,116,68,101,112,116,104,41,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,
+32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,114,101,116,117,114,110,32,115,104,97,100,111,119,59,13,10,32,32,32,32,32,32,32,32,125,13,
+10,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,32,32,32,32,35,105,102,32,74,77,65,84,95,77,65,88,95,68,73,82,69,67,84,73,79,78,65,76,95,76,73,71,72,
+84,83,32,62,32,48,13,10,13,10,32,32,32,32,32,32,32,32,47,47,32,83,104,97,100,111,119,32,99,97,108,99,117,108,97,116,105,111,110,32,102,111,114,32,99,97,115,99,97,100,
+101,100,32,100,105,114,101,99,116,105,111,110,97,108,32,108,105,103,104,116,115,13,10,32,32,32,32,32,32,32,32,102,108,111,97,116,32,106,111,112,95,67,97,108,99,117,108,97,116,101,
+67,97,115,99,97,100,101,83,104,97,100,111,119,40,99,111,110,115,116,32,105,110,32,68,105,114,101,99,116,105,111,110,97,108,76,105,103,104,116,73,110,102,111,32,108,44,32,99,111,110,
+115,116,32,105,110,32,118,101,99,51,32,110,111,114,109,41,13,10,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,118,105,101,
+119,68,101,112,116,104,32,61,32,45,118,102,95,80,111,115,105,116,105,111,110,46,122,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,85,115,101,32,116,104,101,
+32,110,101,97,114,101,115,116,32,99,97,115,99,97,100,101,32,99,111,110,116,97,105,110,105,110,103,32,116,104,101,32,102,114,97,103,109,101,110,116,44,32,116,104,101,32,108,97,115,116,
+32,111,110,101,32,99,111,118,101,114,115,32,116,104,101,32,114,101,115,116,13,10,32,32,32,32,32,32,32,32,32,32,32,32,102,111,114,32,40,105,110,116,32,99,32,61,32,48,59,32,
+99,32,60,32,74,79,80,95,77,65,88,95,83,72,65,68,79,87,95,67,65,83,67,65,68,69,83,59,32,43,43,99,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,123,13,10,
+32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,102,32,40,99,32,60,32,108,46,110,117,109,67,97,115,99,97,100,101,115,32,45,32,49,32,38,38,32,118,105,101,119,68,
+101,112,116,104,32,62,32,108,46,99,97,115,99,97,100,101,83,112,108,105,116,115,91,99,93,41,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,99,111,
+110,116,105,110,117,101,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,114,101,116,117,114,110,32,106,111,112,95,67,97,108,99,117,108,97,116,101,68,105,114,
+83,112,111,116,83,104,97,100,111,119,40,118,101,99,51,40,108,46,108,115,77,97,116,114,105,99,101,115,91,99,93,32,42,32,118,101,99,52,40,118,102,95,80,111,115,105,116,105,111,110,
+44,32,49,46,48,41,41,32,42,32,48,46,53,32,43,32,48,46,53,44,32,110,111,114,109,44,32,45,108,46,100,105,114,101,99,116,105,111,110,44,32,108,46,115,104,97,100,111,119,84,
+105,108,101,115,91,99,93,41,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,114,101,116,117,114,110,32,48,46,48,
+59,13,10,32,32,32,32,32,32,32,32,125,13,10,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,35,112,108,117,103,105,110,101,110,100,
 };
 
+
+const unsigned char blockPlugins[2273] =
+{
+47,47,32,74,111,112,110,97,108,32,117,110,105,102,111,114,109,32,98,108,111,99,107,32,115,104,97,100,101,114,32,112,108,117,103,105,110,32,102,105,108,101,13,10,47,47,13,10,47,47,
+32,74,111,112,110,97,108,32,108,105,99,101,110,115,101,32,97,112,112,108,105,101,115,46,13,10,13,10,47,47,32,84,104,101,32,98,108,111,99,107,115,32,97,114,101,32,111,110,108,121,
+32,100,101,99,108,97,114,101,100,32,119,104,101,110,32,74,79,80,95,85,78,73,70,79,82,77,95,66,76,79,67,75,83,32,105,115,13,10,47,47,32,100,101,102,105,110,101,100,32,40,
+71,76,83,76,32,51,46,51,48,32,38,32,71,76,83,76,32,69,83,32,51,46,48,48,41,46,32,84,104,101,105,114,32,108,97,121,111,117,116,32,109,117,115,116,32,109,97,116,99,104,
+13,10,47,47,32,116,104,101,32,100,97,116,97,32,116,104,101,32,101,110,103,105,110,101,32,117,112,108,111,97,100,115,44,32,115,111,32,100,111,110,39,116,32,109,111,100,105,102,121,32,
+116,104,101,109,46,13,10,13,10,47,47,32,67,97,109,101,114,97,32,109,97,116,114,105,99,101,115,13,10,47,47,13,10,47,47,32,85,112,100,97,116,101,100,32,111,110,99,101,32,112,
+101,114,32,99,97,109,101,114,97,13,10,47,47,13,10,35,112,108,117,103,105,110,32,60,74,111,112,110,97,108,47,66,108,111,99,107,115,47,67,97,109,101,114,97,62,13,10,13,10,32,
+32,32,32,35,105,102,100,101,102,32,74,79,80,95,85,78,73,70,79,82,77,95,66,76,79,67,75,83,13,10,13,10,32,32,32,32,32,32,32,32,108,97,121,111,117,116,40,115,116,100,
+49,52,48,41,32,117,110,105,102,111,114,109,32,106,111,112,95,67,97,109,101,114,97,66,108,111,99,107,13,10,32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,
+32,32,32,109,97,116,52,32,117,95,86,77,97,116,114,105,120,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,109,97,116,52,32,117,95,80,86,77,97,116,114,105,120,59,13,10,
+32,32,32,32,32,32,32,32,125,59,13,10,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,35,112,108,117,103,105,110,101,110,100,13,10,13,10,47,47,32,76,105,103,104,116,
+32,100,97,116,97,13,10,47,47,13,10,47,47,32,85,112,100,97,116,101,100,32,111,110,99,101,32,112,101,114,32,102,114,97,109,101,46,32,76,105,103,104,116,32,112,111,115,105,116,105,
+111,110,115,32,97,114,101,13,10,47,47,32,105,110,32,118,105,101,119,32,115,112,97,99,101,13,10,47,47,13,10,35,112,108,117,103,105,110,32,60,74,111,112,110,97,108,47,66,108,111,
+99,107,115,47,76,105,103,104,116,115,62,13,10,13,10,32,32,32,32,35,105,110,99,108,117,100,101,32,60,74,111,112,110,97,108,47,68,101,102,97,117,108,116,76,105,103,104,116,105,110,
+103,47,83,116,114,117,99,116,117,114,101,115,62,13,10,13,10,32,32,32,32,35,105,102,100,101,102,32,74,79,80,95,85,78,73,70,79,82,77,95,66,76,79,67,75,83,13,10,13,10,
+32,32,32,32,32,32,32,32,108,97,121,111,117,116,40,115,116,100,49,52,48,41,32,117,110,105,102,111,114,109,32,106,111,112,95,76,105,103,104,116,66,108,111,99,107,13,10,32,32,32,
+32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,105,110,116,32,117,95,78,117,109,80,111,105,110,116,76,105,103,104,116,115,59,13,10,32,32,32,32,32,32,32,
+32,32,32,32,32,105,110,116,32,117,95,78,117,109,83,112,111,116,76,105,103,104,116,115,59,13,10,32,32,32,32,32,32,32,32,32,32,32,32,105,110,116,32,117,95,78,117,109,68,105,
+114,101,99,116,105,111,110,97,108,76,105,103,104,116,115,59,13,10,13,10,32,32,32,32,32,32,32,32,35,105,102,32,74,77,65,84,95,77,65,88,95,80,79,73,78,84,95,76,73,71,
+72,84,83,32,62,32,48,13,10,32,32,32,32,32,32,32,32,32,32,32,32,80,111,105,110,116,76,105,103,104,116,73,110,102,111,32,117,95,80,111,105,110,116,76,105,103,104,116,115,91,
+74,77,65,84,95,77,65,88,95,80,79,73,78,84,95,76,73,71,72,84,83,93,59,13,10,32,32,32,32,32,32,32,32,35,101,110,100,105,102,13,10,32,32,32,32,32,32,32,32,35,
+105,102,32,74,77,65,84,95,77,65,88,95,83,80,79,84,95,76,73,71,72,84,83,32,62,32,48,13,10,32,32,32,32,32,32,32,32,32,32,32,32,83,112,111,116,76,105,103,104,116,
+73,110,102,111,32,117,95,83,112,111,116,76,105,103,104,116,115,91,74,77,65,84,95,77,65,88,95,83,80,79,84,95,76,73,71,72,84,83,93,59,13,10,32,32,32,32,32,32,32,32,
+35,101,110,100,105,102,13,10,32,32,32,32,32,32,32,32,35,105,102,32,74,77,65,84,95,77,65,88,95,68,73,82,69,67,84,73,79,78,65,76,95,76,73,71,72,84,83,32,62,32,
+48,13,10,32,32,32,32,32,32,32,32,32,32,32,32,68,105,114,101,99,116,105,111,110,97,108,76,105,103,104,116,73,110,102,111,32,117,95,68,105,114,101,99,116,105,111,110,97,108,76,
+105,103,104,116,115,91,74,77,65,84,95,77,65,88,95,68,73,82,69,67,84,73,79,78,65,76,95,76,73,71,72,84,83,93,59,13,10,32,32,32,32,32,32,32,32,35,101,110,100,105,
+102,13,10,32,32,32,32,32,32,32,32,125,59,13,10,13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,35,112,108,117,103,105,110,101,110,100,13,10,13,10,47,47,32,77,97,
+116,101,114,105,97,108,32,114,101,102,108,101,99,116,105,111,110,32,118,97,108,117,101,115,13,10,47,47,13,10,47,47,32,85,112,100,97,116,101,100,32,119,104,101,110,32,116,104,101,32,
+109,97,116,101,114,105,97,108,32,99,104,97,110,103,101,115,13,10,47,47,13,10,35,112,108,117,103,105,110,32,60,74,111,112,110,97,108,47,66,108,111,99,107,115,47,77,97,116,101,114,
+105,97,108,62,13,10,13,10,32,32,32,32,35,105,110,99,108,117,100,101,32,60,74,111,112,110,97,108,47,68,101,102,97,117,108,116,76,105,103,104,116,105,110,103,47,83,116,114,117,99,
+116,117,114,101,115,62,13,10,13,10,32,32,32,32,35,105,102,100,101,102,32,74,79,80,95,85,78,73,70,79,82,77,95,66,76,79,67,75,83,13,10,13,10,32,32,32,32,32,32,32,
+32,108,97,121,111,117,116,40,115,116,100,49,52,48,41,32,117,110,105,102,111,114,109,32,106,111,112,95,77,97,116,101,114,105,97,108,66,108,111,99,107,13,10,32,32,32,32,32,32,32,
+32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,77,97,116,101,114,105,97,108,32,117,95,77,97,116,101,114,105,97,108,59,13,10,32,32,32,32,32,32,32,32,125,59,13,10,
+13,10,32,32,32,32,35,101,110,100,105,102,13,10,13,10,35,112,108,117,103,105,110,101,110,100,13,10,13,10,47,47,32,76,105,103,104,116,32,99,108,117,115,116,101,114,32,103,114,105,
+100,13,10,47,47,13,10,47,47,32,85,112,100,97,116,101,100,32,111,110,99,101,32,112,101,114,32,99,97,109,101,114,97,32,119,104,101,110,32,99,108,117,115,116,101,114,101,100,32,108,
+105,103,104,116,105,110,103,13,10,47,47,32,105,115,32,101,110,97,98,108,101,100,13,10,47,47,13,10,35,112,108,117,103,105,110,32,60,74,111,112,110,97,108,47,66,108,111,99,107,115,
+47,67,108,117,115,116,101,114,115,62,13,10,13,10,32,32,32,32,35,105,102,100,101,102,32,74,79,80,95,67,76,85,83,84,69,82,69,68,95,76,73,71,72,84,73,78,71,13,10,13,
+10,32,32,32,32,32,32,32,32,108,97,121,111,117,116,40,115,116,100,49,52,48,41,32,117,110,105,102,111,114,109,32,106,111,112,95,67,108,117,115,116,101,114,66,108,111,99,107,13,10,
+32,32,32,32,32,32,32,32,123,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,120,44,32,121,32,61,32,116,105,108,101,115,44,32,122,32,61,32,100,101,112,116,104,32,
+115,108,105,99,101,115,44,32,119,32,61,32,102,105,114,115,116,32,105,110,100,101,120,32,116,101,120,101,108,13,10,32,32,32,32,32,32,32,32,32,32,32,32,105,118,101,99,52,32,117,
+95,67,108,117,115,116,101,114,71,114,105,100,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,120,121,32,61,32,118,105,101,119,112,111,114,116,32,112,111,115,105,
+116,105,111,110,32,105,110,32,112,105,120,101,108,115,44,32,122,119,32,61,32,116,105,108,101,115,32,112,101,114,32,112,105,120,101,108,13,10,32,32,32,32,32,32,32,32,32,32,32,32,
+118,101,99,52,32,117,95,67,108,117,115,116,101,114,86,105,101,119,112,111,114,116,59,13,10,13,10,32,32,32,32,32,32,32,32,32,32,32,32,47,47,32,120,32,61,32,115,108,105,99,
+101,32,115,99,97,108,101,44,32,121,32,61,32,115,108,105,99,101,32,98,105,97,115,44,32,122,32,61,32,108,111,103,97,114,105,116,104,109,105,99,32,115,108,105,99,101,115,13,10,32,
+32,32,32,32,32,32,32,32,32,32,32,118,101,99,52,32,117,95,67,108,117,115,116,101,114,68,101,112,116,104,59,13,10,32,32,32,32,32,32,32,32,125,59,13,10,13,10,32,32,32,
+32,35,101,110,100,105,102,13,10,13,10,35,112,108,117,103,105,110,101,110,100,13,10,
+};
 }
\ No newline at end of file
@@ -18,13 +18,13 @@ extern const unsigned char defaultShaderFrag[266];
 
 extern const unsigned char defaultShaderVert[466];
 
-extern const unsigned char defaultUberShaderFrag[6147];
+extern const unsigned char defaultUberShaderFrag[6635];
 
-extern const unsigned char defaultUberShaderVert[2845];
+extern const unsigned char defaultUberShaderVert[3525];
 
-extern const unsigned char depthRecordShaderFrag[811];
+extern const unsigned char depthRecordShaderFrag[1291];
 
-extern const unsigned char depthRecordShaderVert[627];
+extern const unsigned char depthRecordShaderVert[933];
 
 extern const unsigned char gaussianBlurShaderFrag[1354];
 
@@ -32,7 +32,7 @@ extern const unsigned char physicsDebugShaderFrag[360];
 
 extern const unsigned char physicsDebugShaderVert[598];
 
-extern const unsigned char postProcessFrag[1222];
+extern const unsigned char postProcessFrag[1132];
 
 extern const unsigned char postProcessVert[400];
 
@@ -40,11 +40,13 @@ extern const unsigned char brightFilter[1632];
 
 extern const unsigned char compatibilityPlugins[2059];
 
-extern const unsigned char lightingPlugins[6920];
+extern const unsigned char lightingPlugins[10960];
 
-extern const unsigned char structurePlugins[1640];
+extern const unsigned char structurePlugins[2353];
 
-extern const unsigned char shadowPlugins[4319];
+extern const unsigned char shadowPlugins[6340];
+
+extern const unsigned char blockPlugins[2273];
 
 }
 #endif
\ No newline at end of file
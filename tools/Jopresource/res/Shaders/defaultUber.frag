@@ -50,6 +50,7 @@ JOP_VARYING_IN vec4 vf_Color;
 
         #include <Jopnal/DefaultLighting/Shadows>
         #include <Jopnal/DefaultLighting/Lighting>
+        #include <Jopnal/DefaultLighting/Clusters>
 
     #else
 
@@ -123,7 +124,21 @@ void main()
             {
                 vec3 light[3];
 
-            #if JMAT_MAX_POINT_LIGHTS > 0
+            #ifdef JOP_CLUSTERED_LIGHTING
+
+                // Point and spot lights of this fragment's cluster
+                vec4 cell = jop_FetchClusterData(jop_GetCluster());
+
+                for (int i = 0; i < int(cell.y); ++i)
+                {
+                    jop_CalculateClusterLight(jop_GetClusterLight(int(cell.x), i), shininessMult, light[0], light[1], light[2]);
+
+                    tempLight[0] += light[0];
+                    tempLight[1] += light[1];
+                    tempLight[2] += light[2];
+                }
+
+            #elif JMAT_MAX_POINT_LIGHTS > 0
 
                 // Point lights
                 for (int i = 0; i < JOP_POINT_LIMIT; ++i)
@@ -133,7 +148,7 @@ void main()
                     // Shadow calculation
                     float shadow = 1.0;
                     if (u_PointLights[i].castShadow && u_ReceiveShadows)
-                        shadow -= jop_CalculatePointShadow(u_PointLights[i].position - vf_Position, u_PointLights[i].farPlane, u_PointLightShadowMaps[i]);
+                        shadow -= jop_CalculatePointShadow(u_PointLights[i], u_PointLights[i].position - vf_Position);
 
                     tempLight[0] += light[0];
                     tempLight[1] += light[1] * shadow;
@@ -152,7 +167,7 @@ void main()
                     // Shadow calculation
                     float shadow = 1.0;
                     if (u_DirectionalLights[i].castShadow && u_ReceiveShadows)
-                        shadow -= jop_CalculateDirSpotShadow(vec3(u_DirectionalLights[i].lsMatrix * vec4(vf_Position, 1.0)) * 0.5 + 0.5, vf_Normal, -u_DirectionalLights[i].direction,  u_DirectionalLightShadowMaps[i]);
+                        shadow -= jop_CalculateCascadeShadow(u_DirectionalLights[i], vf_Normal);
 
                     tempLight[0] += light[0];
                     tempLight[1] += light[1] * shadow;
@@ -161,7 +176,7 @@ void main()
 
             #endif
                     
-            #if JMAT_MAX_SPOT_LIGHTS > 0
+            #if !defined(JOP_CLUSTERED_LIGHTING) && JMAT_MAX_SPOT_LIGHTS > 0
 
                 // Spot lights
                 for (int i = 0; i < JOP_SPOT_LIMIT; ++i)
@@ -173,7 +188,7 @@ void main()
                     if (u_SpotLights[i].castShadow && u_ReceiveShadows)
                     {
                         vec4 tempCoords = u_SpotLights[i].lsMatrix * vec4(vf_Position, 1.0);
-                        shadow -= jop_CalculateDirSpotShadow((tempCoords.xyz / tempCoords.w) * 0.5 + 0.5, vf_Normal, u_SpotLights[i].position - vf_Position, u_SpotLightShadowMaps[i]);
+                        shadow -= jop_CalculateDirSpotShadow((tempCoords.xyz / tempCoords.w) * 0.5 + 0.5, vf_Normal, u_SpotLights[i].position - vf_Position, u_SpotLights[i].shadowTile);
                     }
                     
                     tempLight[0] += light[0];
@@ -13,10 +13,28 @@ JOP_ATTRIBUTE(1) vec2 a_TexCoords;
 JOP_ATTRIBUTE(2) vec3 a_Normal;
 JOP_ATTRIBUTE(3) vec4 a_Color;
 
-// Matrices
-uniform mat4 u_VMMatrix;
-uniform mat4 u_PVMMatrix;
-uniform mat3 u_NMatrix;
+#ifdef JDRW_INSTANCED
+
+    // Per-instance model matrix, occupies locations 4-7.
+    // a_Color is also per-instance
+    JOP_ATTRIBUTE(4) mat4 a_MMatrix;
+
+    // Matrices
+    #include <Jopnal/Blocks/Camera>
+
+    #ifndef JOP_UNIFORM_BLOCKS
+        uniform mat4 u_VMatrix;
+        uniform mat4 u_PVMatrix;
+    #endif
+
+#else
+
+    // Matrices
+    uniform mat4 u_VMMatrix;
+    uniform mat4 u_PVMMatrix;
+    uniform mat3 u_NMatrix;
+
+#endif
 
 // Vertex attributes to fragment shader
 JOP_VARYING_OUT vec3 vf_Position;
@@ -44,18 +62,28 @@ JOP_VARYING_OUT vec4 vf_Color;
 
 void main()
 {
+    #ifdef JDRW_INSTANCED
+        mat4 VMMatrix = u_VMatrix * a_MMatrix;
+        mat4 PVMMatrix = u_PVMatrix * a_MMatrix;
+        mat3 NMatrix = transpose(inverse(mat3(VMMatrix)));
+    #else
+        mat4 VMMatrix = u_VMMatrix;
+        mat4 PVMMatrix = u_PVMMatrix;
+        mat3 NMatrix = u_NMatrix;
+    #endif
+
     // Assign attributes
     vf_Position     = (
     #if !defined(JDRW_SKYBOX) && !defined(JDRW_SKYSPHERE)
-        u_VMMatrix * 
+        VMMatrix * 
     #endif
                       a_Position).xyz;
     vf_TexCoords    = a_TexCoords;
-    vf_Normal       = normalize(u_NMatrix * a_Normal);
+    vf_Normal       = normalize(NMatrix * a_Normal);
     vf_Color        = a_Color;
 
     // Calculate and assign position
-    gl_Position = (u_PVMMatrix * a_Position)
+    gl_Position = (PVMMatrix * a_Position)
     
     #if (defined(JDRW_SKYBOX) || defined(JDRW_SKYSPHERE))
         .xyww
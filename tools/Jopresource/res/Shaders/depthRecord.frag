@@ -4,14 +4,34 @@
 
 //////////////////////////////////////////////
 
+#include <Jopnal/Compat/Varyings>
+
 #ifdef JOP_PACK_DEPTH
 
     varying vec4 vf_Position;
 
 #endif
 
+#ifdef JOP_LINEAR_DEPTH
+
+    // Light position & far plane, used to map the distance to [0,1]
+    uniform vec3 u_LightPosition;
+    uniform float u_FarClippingPlane;
+
+    JOP_VARYING_IN vec3 vf_WorldPosition;
+
+#endif
+
 void main()
 {
+    // Point light shadow maps store the distance to the light instead of the depth
+
+#ifdef JOP_LINEAR_DEPTH
+
+    gl_FragDepth = length(vf_WorldPosition - u_LightPosition) / u_FarClippingPlane;
+
+#endif
+
     // Depth recording happens automatically, unless depth textures are unsupported,
     // in which case we'll need to pack the texture into a regular RGBA texture.
 
@@ -32,7 +52,7 @@ void main()
         1.0 / 256.0
     );
 
-    vec4 comp = fract((vPosition.z / vPosition.w + 1.0) * 0.5 * bitShift);
+    vec4 comp = fract((vf_Position.z / vf_Position.w + 1.0) * 0.5 * bitShift);
     comp -= comp.xxyz * bitMask;
     
     gl_FragColor = comp;
@@ -5,6 +5,7 @@
 //////////////////////////////////////////////
 
 #include <Jopnal/Compat/Attributes>
+#include <Jopnal/Compat/Varyings>
 
 // Perspective-view (light space) matrix
 uniform mat4 u_PVMatrix;
@@ -21,11 +22,22 @@ JOP_ATTRIBUTE(0) vec3 a_Position;
     varying vec4 vf_Position;
 #endif
 
+// World position, point lights record the distance to it
+#ifdef JOP_LINEAR_DEPTH
+    JOP_VARYING_OUT vec3 vf_WorldPosition;
+#endif
+
 void main()
 {
-    gl_Position = u_PVMatrix * a_MMatrix * vec4(a_Position, 1.0);
+    vec4 worldPosition = a_MMatrix * vec4(a_Position, 1.0);
+
+    gl_Position = u_PVMatrix * worldPosition;
 
     #ifdef JOP_PACK_DEPTH
         vf_Position = gl_Position;
     #endif
+
+    #ifdef JOP_LINEAR_DEPTH
+        vf_WorldPosition = worldPosition.xyz;
+    #endif
 }
\ No newline at end of file
@@ -17,7 +17,7 @@ uniform sampler2D u_DitherMatrix;
 uniform float u_Gamma;
 
 #ifdef JPP_BLOOM
-    uniform sampler2D u_Bloom[JPP_BLOOM_TEXTURES];
+    uniform sampler2D u_Bloom;
 #endif
 
 JOP_COLOR_OUT(0)
@@ -27,10 +27,7 @@ void main()
     vec4 tempColor = JOP_TEXTURE_2D(u_Scene, vf_TexCoords);
 
     #ifdef JPP_BLOOM
-
-        for (int i = 0; i < int(u_Bloom.length()); ++i)
-            tempColor += (JOP_TEXTURE_2D(u_Bloom[i], vf_TexCoords));
-
+        tempColor += JOP_TEXTURE_2D(u_Bloom, vf_TexCoords);
     #endif
 
     tempColor = vec4(